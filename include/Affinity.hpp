@@ -0,0 +1,62 @@
+#ifndef AFFINITY_HPP
+#define AFFINITY_HPP
+
+#include <string>
+
+namespace Affinity {
+
+/**
+ * @brief Placement policy for benchmark worker threads.
+ *
+ * - None:    threads float (OS scheduler decides), the historical behaviour.
+ * - Compact: worker slots fill one NUMA node before the next; hyperthread siblings are adjacent.
+ * - Scatter: worker slots alternate between NUMA nodes; distinct physical cores before siblings.
+ * - PerNuma: worker slots are bound round-robin to a whole NUMA node (any CPU of that node).
+ *
+ * Every policy other than None also sets the pinned thread's memory policy to prefer the NUMA
+ * node it was pinned to (MPOL_PREFERRED), so fill buffers and generated events are allocated on
+ * the worker's node. ROOT's implicit-MT threads are neither pinned nor bound.
+ */
+enum class Policy { None, Compact, Scatter, PerNuma };
+
+/**
+ * @brief Parses "none", "compact", "scatter" or "numa". Throws std::invalid_argument otherwise.
+ */
+Policy parsePolicy(const std::string& name);
+
+std::string policyName(Policy policy);
+
+/**
+ * @brief Selects the process-wide policy and discovers the CPU/NUMA topology (from sysfs,
+ * falling back to a single node holding the CPUs of the current affinity mask).
+ */
+void setPolicy(Policy policy);
+Policy getPolicy();
+
+/**
+ * @brief Pins the calling thread to the CPU(s) assigned to the given worker slot and records
+ * the placement. No-op for Policy::None. Returns false if pinning failed.
+ */
+bool pinCurrentThread(int slot);
+
+/**
+ * @brief Pins the calling thread to the next free slot (for workers without a stable index,
+ * such as reader chunks of several concurrently read ntuples).
+ */
+bool pinCurrentThreadToNextSlot();
+
+/**
+ * @brief Restarts slot numbering for pinCurrentThreadToNextSlot, e.g. at each timed call.
+ */
+void resetSlots();
+
+/**
+ * @brief Prints the topology, the policy and how many worker placements landed on each
+ * NUMA node and CPU since the last clearPlacementStats().
+ */
+void printPlacementReport(const std::string& title);
+void clearPlacementStats();
+
+} // namespace Affinity
+
+#endif // AFFINITY_HPP
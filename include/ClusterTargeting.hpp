@@ -0,0 +1,90 @@
+#ifndef CLUSTER_TARGETING_HPP
+#define CLUSTER_TARGETING_HPP
+
+#include <ROOT/RNTupleWriteOptions.hxx>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Writer-side cluster sizing so that readers get enough clusters to split.
+ *
+ * With clustersPerReader == 0 (the default) writers keep ROOT's default cluster size.
+ * Otherwise each ntuple's cluster size is chosen from its expected uncompressed size so that
+ * it ends up with at least clustersPerReader * readerThreads clusters, but no cluster is
+ * made smaller than minClusterBytes.
+ */
+struct ClusterTargetConfig {
+    int readerThreads = 1;
+    int clustersPerReader = 0;
+    std::uint64_t minClusterBytes = 1024 * 1024;
+    bool reportHistogram = true;
+};
+
+void setClusterTargetConfig(const ClusterTargetConfig& config);
+const ClusterTargetConfig& getClusterTargetConfig();
+
+/**
+ * @brief Fixed write options that take precedence over ROOT's defaults and over cluster
+ * targeting, e.g. for one cell of a parameter sweep. Zero or negative keeps the default.
+ */
+struct WriteOptionOverrides {
+    int compression = -1;            // ROOT compression setting, e.g. 505 for zstd level 5
+    std::uint64_t clusterBytes = 0;  // uncompressed cluster size
+    std::uint64_t pageBytes = 0;     // maximum uncompressed page size
+};
+
+void setWriteOptionOverrides(const WriteOptionOverrides& overrides);
+const WriteOptionOverrides& getWriteOptionOverrides();
+
+/**
+ * @brief Approximate uncompressed bytes one event contributes to each data product.
+ *
+ * wires counts only the wire header fields; rois counts every ROI of the event. With variable
+ * event sizes (see EventSizes.hpp) this is the mean over events.
+ */
+struct EventBytes {
+    std::uint64_t hits = 0;
+    std::uint64_t wires = 0;
+    std::uint64_t rois = 0;
+
+    std::uint64_t wiresWithRois() const { return wires + rois; }
+    std::uint64_t all() const { return hits + wires + rois; }
+};
+
+EventBytes estimateEventBytes(int hitsPerEvent, int wiresPerEvent, int roisPerWire);
+
+/**
+ * @brief Cluster size (uncompressed bytes) for an ntuple of expectedBytes.
+ *
+ * Returns 0 when targeting is disabled. Otherwise the result is expectedBytes split into
+ * clustersPerReader * readerThreads clusters, capped at defaultClusterBytes (targeting only
+ * ever shrinks clusters) and never below minClusterBytes.
+ */
+std::uint64_t targetClusterBytes(std::uint64_t expectedBytes, const ClusterTargetConfig& config,
+                                 std::uint64_t defaultClusterBytes);
+
+/**
+ * @brief Buffered write options for an ntuple of expectedBytes, with cluster and page
+ * limits lowered to the targeted cluster size when targeting is enabled. Write option
+ * overrides replace the compression, the cluster size and the page size.
+ *
+ * Every fill context flushes once its unzipped cluster reaches the target, so a context that
+ * fills share bytes contributes about share / target clusters.
+ */
+ROOT::RNTupleWriteOptions makeWriteOptions(std::uint64_t expectedBytes);
+
+/**
+ * @brief Uncompressed bytes a fill context writing an ntuple of expectedBytes with
+ * makeWriteOptions holds at least before it cuts a cluster: the approximate zipped cluster
+ * size, which compression only delays.
+ */
+std::uint64_t clusterCutBytes(std::uint64_t expectedBytes);
+
+/**
+ * @brief Prints, for every RNTuple in the file, the number of clusters and the min/avg/max
+ * entries and compressed bytes per cluster, plus a power-of-two histogram of cluster sizes.
+ * Ntuples with fewer clusters than clustersPerReader * readerThreads are flagged.
+ */
+void printClusterHistogram(const std::string& fileName);
+
+#endif // CLUSTER_TARGETING_HPP
@@ -0,0 +1,54 @@
+#ifndef COMPACTION_HPP
+#define COMPACTION_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct CompactionConfig {
+    std::uint64_t memoryBytes = 256ull * 1024 * 1024; // entry buffers over all sort threads
+    int nThreads = 1;
+};
+
+struct CompactionReport {
+    std::string ntupleName;
+    bool sorted = true;             // false: no EventID, copied in input order
+    std::uint64_t entries = 0;
+    std::uint64_t bytes = 0;        // uncompressed size of the ntuple
+    std::uint64_t runEntries = 0;   // entries buffered per sorted run
+    std::uint64_t peakRssBytes = 0; // measured process high-water mark, 0 if not measurable
+    int runs = 0;
+    int mergePasses = 0;            // passes over the data after the sort, the last writes the output
+    double sortSeconds = 0.0;       // load, sort and spill the runs (parallel)
+    double mergeSeconds = 0.0;      // k-way merge into the output
+};
+
+/**
+ * @brief "<dir>/<stem>_sorted.root" next to the input file.
+ */
+std::string compactedFileName(const std::string& fileName);
+
+/**
+ * @brief Rewrites every ntuple of inFile into outFile with entries ordered by (EventID, element
+ * index), see findEventKeyColumn. The element index is the WireID of ROI and union rows; other
+ * layouts store none and keep their input order within an event, which is the element order
+ * their writers emit. Ties keep the input order. Sidecars are not copied; entries without an
+ * EventID go last and ntuples without one (SOA ROIs) are copied unchanged.
+ *
+ * External merge sort: each thread takes a cluster-aligned range, cuts it into runs of at most
+ * runEntries entries (memoryBytes split over nThreads, using the average uncompressed entry
+ * size), sorts each run in memory and writes it to a temporary file. The runs are then merged
+ * k ways, at most memoryBytes / 4 MB (2 to 64) at a time, in as many passes as needed; each open
+ * run is read through small clusters and a window of sort keys, so the merge stays within
+ * memoryBytes whatever the ntuple size.
+ */
+std::vector<CompactionReport> compactFile(const std::string& inFile, const std::string& outFile, const CompactionConfig& config);
+
+/**
+ * @brief Compacts each file and prints throughput, merge passes and measured peak RSS, plus a before/after
+ * comparison of event locality (entry ranges per event), nLookups random event reads and a
+ * full sequential read.
+ */
+void runCompaction(const std::vector<std::string>& files, const CompactionConfig& config, int nLookups = 100);
+
+#endif // COMPACTION_HPP
@@ -0,0 +1,177 @@
+#ifndef EVENT_INDEX_HPP
+#define EVENT_INDEX_HPP
+
+#include <ROOT/RNTupleReader.hxx>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A run of consecutive entries of one ntuple that all belong to the same event.
+ *
+ * In the topObject and element layouts one event spans many entries; clusters written by
+ * different fill threads interleave, so an event usually maps to one range per cluster it
+ * touches rather than to a single range.
+ */
+struct EventEntryRange {
+    long long eventId = 0;
+    std::uint64_t firstEntry = 0;
+    std::uint32_t nEntries = 0;
+};
+
+/**
+ * @brief Name of the sidecar RNTuple holding the index of ntupleName ("<ntupleName>_eventIndex").
+ */
+std::string eventIndexName(const std::string& ntupleName);
+bool isEventIndexName(const std::string& ntupleName);
+
+/**
+ * @brief Enables writing the sidecar indexes after each writer benchmark (outAOS/outSOA).
+ */
+void setEmitEventIndex(bool enabled);
+bool getEmitEventIndex();
+
+/**
+ * @brief Path of the per-entry EventID field ("hit.EventID", "row.EventID", ...), i.e. an
+ * EventID subfield of a top-level record field. Empty if the ntuple has none (event and
+ * spill layouts keep EventID inside collections).
+ */
+std::string findEventIdField(ROOT::RNTupleReader& reader);
+
+/**
+ * @brief Where an ntuple keeps its EventID: a top-level field (spill_allDataProduct), a
+ * per-entry record subfield ("hit.EventID") or the first item of a collection in the event
+ * and spill layouts ("hits._0.EventID" for AOS, "hits.EventIDs._0" for SOA, possibly nested
+ * in a record such as "EventAOS").
+ */
+struct EventKeyColumn {
+    std::string field;
+    std::string collection; // "hits" when the key sits in collection items, empty otherwise
+};
+
+constexpr long long kNoEventKey = std::numeric_limits<long long>::min(); // entry with an empty collection
+
+/**
+ * @brief Finds the EventID column of an ntuple; false if it has none.
+ */
+bool findEventKeyColumn(ROOT::RNTupleReader& reader, EventKeyColumn& column);
+
+/**
+ * @brief Writes the EventID of entries [first, last) to out[0 .. last - first).
+ * Throws std::runtime_error if the field has an unsupported type.
+ */
+void readEventKeys(ROOT::RNTupleReader& reader, const EventKeyColumn& column, std::uint64_t first, std::uint64_t last, long long* out);
+
+/**
+ * @brief Sorts ranges by (eventId, firstEntry) and merges ranges of the same event that touch.
+ */
+std::vector<EventEntryRange> sortEventRanges(std::vector<EventEntryRange> ranges);
+
+/**
+ * @brief Reads the EventID column of an ntuple and returns its sorted event ranges. Entries
+ * with an empty key collection (kNoEventKey) belong to no range.
+ * Throws std::runtime_error if the field has an unsupported type.
+ */
+std::vector<EventEntryRange> scanEventRanges(ROOT::RNTupleReader& reader, const EventKeyColumn& column);
+
+/**
+ * @brief The keyed ntuple whose entries run parallel to ntupleName, for ntuples without any
+ * EventID: the SOAROI vectors of "<prefix>_rois" hold the ROIs of entry i of "<prefix>_wires".
+ * Empty if ntupleName is not such an ntuple or the partner is not in ntuples.
+ */
+std::string findParallelKeyNtuple(const std::string& ntupleName, const std::vector<std::string>& ntuples);
+
+struct EventIndexReport {
+    int ntuples = 0;
+    std::uint64_t ranges = 0;
+    double seconds = 0.0;
+};
+
+/**
+ * @brief Builds the index of every ntuple in the file that has an EventID column (see
+ * findEventKeyColumn) and appends it to the same file as an RNTuple with the fields EventID,
+ * firstEntry, nEntries. Ntuples without EventID get the index of their parallel ntuple (see
+ * findParallelKeyNtuple). Ntuples that are already indexed are skipped.
+ */
+EventIndexReport writeEventIndexes(const std::string& fileName);
+
+/**
+ * @brief In-memory EventID -> entry ranges map of one ntuple.
+ */
+class EventIndex {
+public:
+    EventIndex() = default;
+    explicit EventIndex(std::vector<EventEntryRange> ranges);
+
+    /**
+     * @brief Loads the sidecar index of ntupleName. Throws if the file has no index for it.
+     */
+    static EventIndex load(const std::string& fileName, const std::string& ntupleName);
+
+    /**
+     * @brief [first, last) entry ranges of the event in entry order; empty if unknown.
+     */
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> lookup(long long eventId) const;
+
+    std::size_t size() const { return fRanges.size(); }
+
+private:
+    std::vector<EventEntryRange> fRanges; // sorted by (eventId, firstEntry)
+};
+
+/**
+ * @brief Reads the given field for every entry of one event.
+ * @example
+ * auto hits = fetchEventObjects<HitIndividual>(*reader, index, "hit", 42);
+ */
+template <typename T>
+std::vector<T> fetchEventObjects(ROOT::RNTupleReader& reader, const EventIndex& index, const std::string& field, long long eventId) {
+    std::vector<T> objects;
+    auto view = reader.GetView<T>(field);
+    for (const auto& [first, last] : index.lookup(eventId)) {
+        for (auto i = first; i < last; ++i) objects.push_back(view(i));
+    }
+    return objects;
+}
+
+/**
+ * @brief All indexed ntuples of one file, for fetching whole events (hits, wires and ROIs).
+ */
+class EventLookup {
+public:
+    explicit EventLookup(const std::string& fileName);
+
+    /**
+     * @brief Loads every entry of the event in every indexed ntuple; returns the entry count.
+     */
+    std::size_t fetch(long long eventId);
+
+    /**
+     * @brief Same result without the index: scans the EventID column of every ntuple.
+     */
+    std::size_t fetchByScan(long long eventId);
+
+    const std::vector<std::string>& ntuples() const { return fNames; }
+
+private:
+    struct Indexed {
+        std::unique_ptr<ROOT::RNTupleReader> reader;
+        std::unique_ptr<ROOT::RNTupleReader> keyReader; // parallel ntuple if reader has no EventID
+        EventIndex index;
+        EventKeyColumn key;
+    };
+    std::vector<std::string> fNames;
+    std::vector<Indexed> fNtuples;
+};
+
+/**
+ * @brief Random single-event lookup latency per file: nLookups random EventIDs in
+ * [0, numEvents) through the index, plus a few full-scan lookups as the baseline.
+ * Files without indexed ntuples are listed as such.
+ */
+void benchmarkEventLookup(const std::vector<std::string>& files, int numEvents, int nLookups);
+
+#endif // EVENT_INDEX_HPP
@@ -0,0 +1,86 @@
+#ifndef EVENT_SIZES_HPP
+#define EVENT_SIZES_HPP
+
+#include <cstddef>
+#include <random>
+#include <string>
+
+/**
+ * @brief How the number of hits, wires and ROIs varies from event to event.
+ *
+ * Fixed (the default) gives every event exactly the configured counts. Poisson draws each
+ * count independently around it; LogNormal scales hits and wires of an event by one shared,
+ * heavy-tailed activity factor (mean 1, width sigma) and ROIs per wire by a second factor.
+ * Either way the ROI count is drawn once per event and shared by all of its wires.
+ * On top of either, a hugeFraction of the events is hugeFactor times larger. With
+ * roiLengthSigma > 0 every ROI has its own log-normal length around 10 samples.
+ *
+ * All draws are seeded from the event ID (and the wire for ROI lengths), so sizes do not
+ * depend on thread count or event split. Counts and ROI lengths are capped at maxEventScale()
+ * times their nominal value.
+ */
+enum class SizeDistribution { Fixed, Poisson, LogNormal };
+
+struct EventSizeConfig {
+    SizeDistribution distribution = SizeDistribution::Fixed;
+    double sigma = 0.5;            // LogNormal width
+    double hugeFraction = 0.0;
+    double hugeFactor = 10.0;
+    double roiLengthSigma = 0.0;   // 0 keeps every ROI at 10 samples
+};
+
+struct EventSize {
+    int hits = 0;
+    int wires = 0;
+    int roisPerWire = 0;
+};
+
+/**
+ * @brief Parses a comma-separated spec such as "lognormal:0.8,huge:0.01:20,roilen:0.5".
+ *
+ * Tokens: "fixed", "poisson", "lognormal[:sigma]", "huge:fraction[:factor]",
+ * "roilen[:sigma]". Throws std::invalid_argument on anything else.
+ */
+EventSizeConfig parseEventSizeSpec(const std::string& spec);
+std::string describeEventSizeConfig(const EventSizeConfig& config);
+
+/**
+ * @brief Selects the event sizes for all writers. Set before any writer thread starts.
+ */
+void setEventSizeConfig(const EventSizeConfig& config);
+const EventSizeConfig& getEventSizeConfig();
+
+/**
+ * @brief Counts of event eventID for the given nominal counts.
+ */
+EventSize eventSize(long long eventID, int hitsPerEvent, int wiresPerEvent, int roisPerWire);
+
+/**
+ * @brief Upper bound of eventSize over all events; the nominal counts for Fixed.
+ */
+EventSize maxEventSize(int hitsPerEvent, int wiresPerEvent, int roisPerWire);
+
+/**
+ * @brief Largest factor between a drawn count or ROI length and its nominal value.
+ */
+int maxEventScale();
+
+/**
+ * @brief Expected event size relative to the nominal one (above 1 only with huge events).
+ */
+double meanEventScale();
+
+/**
+ * @brief Sample count of the next ROI. Returns 10 without touching rng unless
+ * roiLengthSigma > 0.
+ */
+std::size_t drawROILength(std::mt19937& rng);
+std::size_t maxROILength();
+
+/**
+ * @brief Expected sample count of drawROILength, including its cap at maxROILength() and its
+ * floor of one sample; 10 without roilen.
+ */
+double meanROILength();
+
+#endif // EVENT_SIZES_HPP
@@ -0,0 +1,62 @@
+#ifndef FLAT_COLUMNS_HPP
+#define FLAT_COLUMNS_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A minimal hand-rolled columnar format for the hit/wire data model, the lower bound
+ * RNTuple is compared against.
+ *
+ * Every column is a raw file of fixed-width little-endian values, "<column>_<part>.bin" in one
+ * directory, one part per writer thread (so a single thread gives one file per column). Nesting
+ * is described by end-offset columns, as in RNTuple: per event the end of its hits and wires,
+ * per wire the end of its ROIs, per ROI the end of its samples. Offsets count from the start of
+ * their part. No header, no compression, no checksums: only the bytes of the data itself.
+ */
+struct FlatColumn {
+    const char* name;
+    std::size_t width; // bytes per value
+};
+
+/**
+ * @brief All columns in file order: event, hit, wire, ROI and sample columns.
+ */
+const std::vector<FlatColumn>& flatColumns();
+
+struct FlatColumnsStats {
+    std::uint64_t events = 0;
+    std::uint64_t hits = 0;
+    std::uint64_t wires = 0;
+    std::uint64_t rois = 0;
+    std::uint64_t samples = 0;
+    std::uint64_t bytes = 0;    // all column files together
+    std::uint64_t checksum = 0; // over the value columns, independent of the number of parts
+};
+
+/**
+ * @brief Writes numEvents events with the same deterministic generators and event sizes as the
+ * writer benchmarks into directory (created, previous parts removed), split into nThreads
+ * parts written in parallel. Throws std::runtime_error if a file cannot be written.
+ */
+FlatColumnsStats writeFlatColumns(const std::string& directory, int numEvents, int hitsPerEvent, int wiresPerEvent,
+                                  int roisPerWire, int nThreads);
+
+/**
+ * @brief Reads every column of every part back (one thread per part, at most nThreads) and
+ * checks the offsets against the column lengths. Throws std::runtime_error on a missing,
+ * truncated or inconsistent part.
+ */
+FlatColumnsStats readFlatColumns(const std::string& directory, int nThreads);
+
+/**
+ * @brief Writes and reads the flat columns, then every layout selected by mask with its default
+ * compression and uncompressed (files in ./output_flat), averaged over iter runs, and prints
+ * write time, read time and size of each, also relative to the flat columns. Reads run right
+ * after the writes, so all of them come from the page cache.
+ */
+void compareFlatColumns(int nThreads, int iter, int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire,
+                        int numSpills, int mask, bool runAOS, bool runSOA);
+
+#endif // FLAT_COLUMNS_HPP
@@ -1,7 +1,45 @@
 #pragma once
 #include "Hit.hpp"
 #include "Wire.hpp"
+#include <cstddef>
 #include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Distribution behind generateRandomHitIndividual and generateRandomWireIndividual.
+ *
+ * Uniform (default) draws every field and ROI sample independently and uniformly, which is
+ * close to incompressible. Physics models a 4-TPC, 3-plane detector: channels encode
+ * TPC/plane/wire, hits have correlated time, width, amplitude and integral fields, and ROI
+ * samples are a per-channel pedestal plus Gaussian noise and a unipolar (collection) or
+ * bipolar (induction) pulse, rounded to whole ADC counts. Both are deterministic for a given
+ * RNG state; the pedestals are derived from the channel with Utils::make_seed.
+ */
+enum class GeneratorMode { Uniform, Physics };
+
+// Bump whenever the generators or writers produce different data for the same configuration,
+// so that cached output files (see OutputCache.hpp) are written again
+constexpr int kGeneratorVersion = 1;
+
+GeneratorMode parseGeneratorMode(const std::string& name);
+std::string generatorModeName(GeneratorMode mode);
+
+/**
+ * @brief Selects the generator for all writers. Set before any writer thread starts.
+ */
+void setGeneratorMode(GeneratorMode mode);
+GeneratorMode getGeneratorMode();
+
+/**
+ * @brief size ROI samples for a wire on channel, drawn according to the generator mode.
+ */
+std::vector<float> generateROISamples(unsigned int channel, std::size_t size, std::mt19937& rng);
+
+/**
+ * @brief Channel and view of a wire generated without its ROIs, according to the generator mode.
+ */
+void generateWireChannelAndView(unsigned int& channel, int& view, std::mt19937& rng);
 
 /**
  * @brief Generates a random HitVector for a given event with specified hits.
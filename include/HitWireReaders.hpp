@@ -2,6 +2,7 @@
 #include <string>
 #include <vector>
 #include "ReaderResult.hpp"
+#include "Utils.hpp"
 
 double readAOS_event_allDataProduct(const std::string& fileName);
 double readAOS_event_perDataProduct(const std::string& fileName);
@@ -14,5 +15,17 @@ double readAOS_topObject_perGroup(const std::string& fileName);
 double readAOS_element_perDataProduct(const std::string& fileName);
 double readAOS_element_perGroup(const std::string& fileName);
 
+// How each reader divides an ntuple's entries between its threads (default: cluster count).
+// With dynamicQueue the static split is replaced by a shared queue from which threads grab
+// clustersPerGrab clusters at a time; per-thread cluster counts and idle time are printed.
+struct ReadSplitConfig {
+    bool byBytes = false;
+    Utils::ClusterWeight weight = Utils::ClusterWeight::CompressedBytes;
+    bool allowSubCluster = false;
+    bool dynamicQueue = false;
+    int clustersPerGrab = 1;
+};
+void setReadSplitConfig(const ReadSplitConfig& config);
+
 std::vector<ReaderResult> inAOS(int nThreads, int iter, const std::string& outputDir, int mask = -1);
 std::vector<ReaderResult> inSOA(int nThreads, int iter, const std::string& outputDir, int mask = -1); 
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <map>
 #include <utility>
 #include "WriterResult.hpp"
+#include "ScalingAnalysis.hpp"
 
 // Group 1: Event-level
 double AOS_event_allDataProduct(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads);
@@ -25,11 +26,46 @@ double AOS_element_perDataProduct(int numEvents, int hitsPerEvent, int wiresPerE
 double AOS_element_perGroup(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads); 
 double AOS_element_allDataProduct(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads);
 
+// Cluster commit order of the parallel writers. Free-for-all (default) commits clusters in
+// whatever order fill contexts flush them. Ordered cuts the event range into blocks of
+// blockEvents (0 -> about one cluster target, at most an even share per thread), stages each
+// block's clusters and commits the blocks in sequence, so entry order is the event order
+// regardless of thread count. Blocks are seeded by their first item, so with a fixed
+// blockEvents the content does not depend on the thread count either.
+struct WriterCommitConfig {
+    bool ordered = false;
+    int blockEvents = 0;
+};
+void setWriterCommitConfig(const WriterCommitConfig& config);
+const WriterCommitConfig& getWriterCommitConfig();
+
+// Offsets for the writers called on the current thread: events are numbered from firstEvent
+// and workers pin and take seeds from slot firstSlot on. Lets several writers, each with its
+// own file, cover disjoint parts of one event range.
+struct WriterShard {
+    int firstEvent = 0;
+    int firstSlot = 0;
+
+    // First work item of the shard for a layout with itemsPerEvent items per event (spills,
+    // topObject slots); shards are always cut at event boundaries
+    int firstItem(int itemsPerEvent) const { return firstEvent * itemsPerEvent; }
+};
+void setThreadWriterShard(const WriterShard& shard);
+
+// Runs the writer of one layout, named like its output file ("aos_event_all", "soa_spill_perGroup", ...)
+double writeLayout(const std::string& layout, int numEvents, int numSpills, int hitsPerEvent, int wiresPerEvent,
+                   int roisPerWire, const std::string& fileName, int nThreads);
+
 std::vector<WriterResult> outAOS(int nThreads, int iter, int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, int numSpills, const std::string& outputDir, int mask = -1, bool measureWallTime = false);
 std::vector<WriterResult> outSOA(int nThreads, int iter, int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, int numSpills, const std::string& outputDir, int mask = -1, bool measureWallTime = false);
-std::map<std::string, std::vector<std::pair<int, double>>> benchmarkAOSScaling(int maxThreads, int iter, int numEvents, int mask);
-std::map<std::string, std::vector<std::pair<int, double>>> benchmarkSOAScaling(int maxThreads, int iter, int numEvents, int mask);
+std::map<std::string, std::vector<std::pair<int, double>>> benchmarkAOSScaling(const std::vector<int>& threadCounts, int iter, int numEvents, const EventShape& shape, int mask);
+std::map<std::string, std::vector<std::pair<int, double>>> benchmarkSOAScaling(const std::vector<int>& threadCounts, int iter, int numEvents, const EventShape& shape, int mask);
 
 // SOA top/element allDataProduct
 double SOA_topObject_allDataProduct(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads);
-double SOA_element_allDataProduct(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads);
\ No newline at end of file
+double SOA_element_allDataProduct(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads);
+
+// Runs the selected writers with free-for-all and with ordered commit (wall-clock time, files
+// in ./output_ordered) and prints the throughput of both modes side by side.
+void compareCommitModes(int nThreads, int iter, int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire,
+                        int numSpills, int mask, bool runAOS, bool runSOA);
@@ -0,0 +1,109 @@
+#ifndef JOIN_READER_HPP
+#define JOIN_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ROOT { class RNTupleReader; }
+
+/**
+ * @brief How events are matched across the split ntuples.
+ *
+ * Merge walks all ntuples in key order and needs every EventID column to be non-decreasing
+ * (e.g. files written with --ordered-commit). Hash builds an EventID -> entry ranges table
+ * per ntuple and works for any entry order. Auto picks Merge when all columns are ordered.
+ * Window never holds all keys: it records the EventID range of every cluster, then joins one
+ * window of EventIDs at a time from the clusters whose range overlaps it. Auto never picks it.
+ */
+enum class JoinMode { Auto, Merge, Hash, Window };
+
+JoinMode parseJoinMode(const std::string& name);
+std::string joinModeName(JoinMode mode);
+
+constexpr std::uint64_t kDefaultJoinWindowEntries = std::uint64_t{1} << 22;
+
+/**
+ * @brief Entries per EventID window in Window mode, counted over the clusters that start in
+ * the window. Each thread holds one window of (EventID, entry) pairs.
+ */
+void setJoinWindowEntries(std::uint64_t entries);
+
+struct JoinResult {
+    JoinMode mode = JoinMode::Auto; // mode actually used
+    int sides = 0;
+    std::uint64_t events = 0;       // distinct EventIDs reassembled
+    std::uint64_t entries = 0;      // entries loaded over all sides
+    std::uint64_t keyedEntries = 0; // entries with an EventID over all sides
+    double keyScan = 0.0;           // seconds reading the EventID columns
+    double build = 0.0;             // seconds building hash tables / checking order
+    double probe = 0.0;             // seconds reassembling events
+
+    double total() const { return keyScan + build + probe; }
+};
+
+/**
+ * @brief Receives the events of one join chunk on the thread that owns the chunk: beginEvent,
+ * then visitRange for every entry range of every side holding the EventID, then endEvent.
+ * The reader is the chunk's own reader of that side and stays open for the whole chunk.
+ * In Window mode a chunk is one thread and its events come window by window.
+ */
+class JoinVisitor {
+public:
+    virtual ~JoinVisitor() = default;
+    virtual void beginEvent(long long /*key*/) {}
+    virtual void visitRange(std::size_t side, ROOT::RNTupleReader& reader, std::uint64_t first, std::uint64_t last) = 0;
+    virtual void endEvent() {}
+};
+
+/**
+ * @brief Creates the visitor of chunk c; called on the chunk's thread before its first event.
+ */
+using JoinVisitorFactory = std::function<std::unique_ptr<JoinVisitor>(std::size_t chunk)>;
+
+/**
+ * @brief Reconstructs every event of a perDataProduct/perGroup file by EventID across its
+ * ntuples and loads all their entries. The EventID is either a per-entry record subfield
+ * ("hit.EventID"), the EventID of the first item of a collection ("hits") or the first
+ * element of an SOA EventIDs vector ("hits.EventIDs"), see findEventKeyColumn. Ntuples without
+ * any EventID (SOA ROIs) take the EventIDs of their parallel ntuple, see findParallelKeyNtuple.
+ *
+ * Work is split by the clusters of the ntuple with the most entries (the driving side); each
+ * event is assembled once, by the thread owning the driving cluster of its first entry. Window
+ * mode instead hands whole EventID windows to the threads.
+ * Throws std::runtime_error if an ntuple has no EventID or Merge is forced on unordered keys.
+ *
+ * Merge and Hash hold the EventID of every entry of every ntuple in memory (8 bytes per entry),
+ * and Hash adds an EventID -> entry ranges table per ntuple. Window holds one window per thread,
+ * but clusters whose EventID range spans several windows are read once per window.
+ */
+JoinResult joinEventsByKey(const std::string& fileName, int nThreads, JoinMode mode = JoinMode::Auto);
+
+/**
+ * @brief Same join, but hands the entry ranges of every event to a visitor instead of loading
+ * them. Files with a single data ntuple are accepted; its entries are grouped by EventID.
+ */
+JoinResult joinEventsByKey(const std::string& fileName, int nThreads, JoinMode mode, const JoinVisitorFactory& makeVisitor);
+
+/**
+ * @brief Loads every entry of every ntuple of the file (sidecars excluded), parallel by cluster.
+ * Returns the wall time in seconds.
+ */
+double loadAllEntries(const std::string& fileName, int nThreads);
+
+/**
+ * @brief "<dir>/aos_event_all.root" for "<dir>/aos_event_perGroup.root" (or _perData); empty
+ * for files that are not a joinable split layout (spill entries hold several events).
+ */
+std::string allDataProductFileFor(const std::string& splitFile);
+
+/**
+ * @brief For each split file: join time, loading the same ntuples without a join, and loading
+ * the matching allDataProduct file; the last column is the join overhead relative to it.
+ */
+void benchmarkJoinRead(const std::vector<std::string>& files, int nThreads, JoinMode mode = JoinMode::Auto);
+
+#endif // JOIN_READER_HPP
@@ -0,0 +1,85 @@
+#ifndef LAYOUT_CONVERTER_HPP
+#define LAYOUT_CONVERTER_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One of the 24 storage layouts, named like the benchmark output files
+ * ("aos_event_all", "soa_element_perGroup", ...).
+ */
+enum class LayoutGroup { Event, Spill, TopObject, Element };
+enum class LayoutProduct { All, PerData, PerGroup };
+
+struct StorageLayout {
+    bool soa = false;
+    LayoutGroup group = LayoutGroup::Event;
+    LayoutProduct product = LayoutProduct::All;
+};
+
+/**
+ * @brief Parses "{aos,soa}_{event,spill,topObject,element}_{all,perData,perGroup}".
+ * Throws std::invalid_argument for anything else.
+ */
+StorageLayout parseStorageLayout(const std::string& name);
+std::string storageLayoutName(const StorageLayout& layout);
+
+/**
+ * @brief All 24 layouts, AOS first, in the order of the writer benchmarks.
+ */
+std::vector<StorageLayout> allStorageLayouts();
+
+/**
+ * @brief Calls fn for every layout of allStorageLayouts() that the writer mask and the AOS/SOA
+ * switches select. Bit i of mask is writer i within the AOS or SOA half (the order of
+ * outAOS/outSOA); a negative mask selects all of them.
+ */
+void forEachSelectedLayout(int mask, bool runAOS, bool runSOA, const std::function<void(const StorageLayout&)>& fn);
+
+struct ConversionConfig {
+    int nThreads = 1;
+    int numSpills = 1; // spills per event for Spill targets
+};
+
+struct ConversionResult {
+    std::uint64_t events = 0;
+    std::uint64_t hits = 0;
+    std::uint64_t wires = 0;
+    std::uint64_t rois = 0;
+    std::uint64_t skippedEntries = 0; // input entries without an EventID (e.g. events without hits)
+    std::uint64_t inputBytes = 0;     // uncompressed size of the input ntuples
+    double keyScan = 0.0;             // seconds reading and grouping the EventID columns
+    double convert = 0.0;             // seconds decoding, re-encoding and writing
+
+    double total() const { return keyScan + convert; }
+};
+
+/**
+ * @brief Rewrites every event of inFile into outFile in the target layout.
+ *
+ * The source layout is recognised from the field types of its ntuples, so any benchmark file
+ * (or a file with the same ntuple types) can be read. Events are grouped by EventID through
+ * joinEventsByKey in Window mode: threads take EventID windows and each event is decoded into
+ * one reusable per-thread buffer, encoded and filled into the thread's own fill contexts of an
+ * RNTupleParallelWriter. Key memory is one window per thread; decoded events are not kept.
+ *
+ * ROIs stored apart from their wire are matched to it by channel, in order. The SOAROI vectors
+ * of SOA perGroup files take the wires of the same entry of their parallel wire ntuple, and
+ * SOA perGroup targets commit both ntuples in lockstep to keep them parallel. Fields a layout
+ * does not store are left empty: SOA ROIs have no offset, SOA element_perData has no wire view.
+ * Throws std::runtime_error on an unknown field type or an ntuple without EventID and without
+ * a parallel keyed ntuple.
+ */
+ConversionResult convertLayout(const std::string& inFile, const std::string& outFile, const StorageLayout& target,
+                               const ConversionConfig& config);
+
+/**
+ * @brief Converts inFile into every target layout, writing "<outputDir>/<layout>.root", and
+ * prints events, elements, time and input throughput per target.
+ */
+void benchmarkConversion(const std::string& inFile, const std::vector<StorageLayout>& targets,
+                         const std::string& outputDir, const ConversionConfig& config);
+
+#endif // LAYOUT_CONVERTER_HPP
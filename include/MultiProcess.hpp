@@ -0,0 +1,86 @@
+#ifndef MULTI_PROCESS_HPP
+#define MULTI_PROCESS_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct MultiProcessConfig {
+    int ranks = 2;
+    int threadsPerRank = 1;
+    bool merge = false;                // merge the rank files into "<layout>_merged.root"
+    std::vector<std::string> rankArgs; // command line of every rank, before its --rank-task
+};
+
+struct MultiProcessResult {
+    std::string layout;
+    int ranks = 0;
+    double wall = 0.0;         // from the start signal until the last rank reported
+    double slowestRank = 0.0;  // longest write time measured inside a rank
+    double merge = 0.0;        // 0 unless config.merge
+    std::uint64_t bytes = 0;   // rank files together
+};
+
+/**
+ * @brief What one rank writes; passed on its command line as --rank-task.
+ */
+struct RankTask {
+    std::string layout;
+    std::string file;
+    int firstEvent = 0; // in events; the writer converts it to its spills or topObject slots
+    int events = 0;
+    int threads = 1;
+    int firstSlot = 0;
+    int goFd = -1;      // start signal from the parent
+    int resultFd = -1;  // ready signal and report to the parent
+};
+
+/**
+ * @brief Splits numEvents into config.ranks contiguous slices, the last taking the remainder,
+ * skipping empty ones. Rank r writes "<outputDir>/<layout>_rank<r>.root" pinned from slot
+ * r * threadsPerRank on. The pipe descriptors are left at -1.
+ */
+std::vector<RankTask> planRankTasks(const std::string& layout, const MultiProcessConfig& config, int numEvents,
+                                    const std::string& outputDir);
+
+/**
+ * @brief "layout,file,firstEvent,events,threads,firstSlot,goFd,resultFd" and back. parseRankTask
+ * throws std::invalid_argument for anything else (so file names cannot contain commas).
+ */
+std::string formatRankTask(const RankTask& task);
+RankTask parseRankTask(const std::string& text);
+
+/**
+ * @brief Runs the writer of one rank on the calling thread, without any signalling. Returns the
+ * write time in seconds.
+ */
+double writeRankSlice(const RankTask& task, int numSpills, int hitsPerEvent, int wiresPerEvent, int roisPerWire);
+
+/**
+ * @brief Writes one layout (named like its output file) with config.ranks local processes.
+ *
+ * Each rank is a fork of this process re-executing the binary with config.rankArgs plus a
+ * --rank-task argument (see runWriterRank). Rank r writes the r-th slice of planRankTasks with
+ * threadsPerRank fill threads. Ranks report over pipes: each signals once it has started up, all are
+ * released together, then each sends back its write time or error. Startup (dictionaries,
+ * thread pools) is therefore not timed. Linux only; throws std::runtime_error elsewhere or if a
+ * rank fails.
+ */
+MultiProcessResult runMultiProcessWrite(const std::string& layout, const MultiProcessConfig& config, int numEvents,
+                                        int numSpills, const std::string& outputDir);
+
+/**
+ * @brief Rank side of runMultiProcessWrite: parses the --rank-task argument, waits for the start
+ * signal, runs the writer and reports back. Returns the process exit code.
+ */
+int runWriterRank(const std::string& task, int numSpills, int hitsPerEvent, int wiresPerEvent, int roisPerWire);
+
+/**
+ * @brief For each writer selected by mask, writes nThreads-threaded into one shared file and
+ * with config.ranks processes (files in ./output_processes), averaged over iter runs, and prints
+ * wall time and event throughput of both.
+ */
+void compareProcessScaling(const MultiProcessConfig& config, int nThreads, int iter, int numEvents, int hitsPerEvent,
+                           int wiresPerEvent, int roisPerWire, int numSpills, int mask, bool runAOS, bool runSOA);
+
+#endif // MULTI_PROCESS_HPP
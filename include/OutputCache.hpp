@@ -0,0 +1,64 @@
+#ifndef OUTPUT_CACHE_HPP
+#define OUTPUT_CACHE_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Reuse of writer output files whose generating configuration has not changed.
+ *
+ * With reuse enabled, every file written by outAOS/outSOA is tagged with a description of
+ * everything that determines its content (see describeDataset) and a hash of it, and a writer
+ * is skipped when its output file already carries the hash of the current configuration.
+ * Without reuse the output files are left untouched.
+ * With a cacheDir, tagged files are also kept there as "<hash>.root" (hard-linked when
+ * possible), so switching between configurations restores earlier datasets instead of
+ * writing them again.
+ */
+struct OutputCacheConfig {
+    bool reuse = false;
+    std::string cacheDir; // empty -> only reuse files in place
+};
+
+void setOutputCacheConfig(const OutputCacheConfig& config);
+const OutputCacheConfig& getOutputCacheConfig();
+
+/**
+ * @brief Canonical description of the dataset a writer produces: layout, event shape, fill
+ * threads (they decide cluster boundaries and entry order), generator mode and version, event
+ * sizes, seed, write options, commit mode, sidecar ntuples and the ROOT version. Reads the
+ * current global configuration.
+ */
+std::string describeDataset(const std::string& layout, int numEvents, int numSpills, int hitsPerEvent,
+                            int wiresPerEvent, int roisPerWire, int nThreads);
+
+/**
+ * @brief 64-bit FNV-1a hash of a description, as 16 hex digits.
+ */
+std::string datasetHash(const std::string& description);
+
+/**
+ * @brief Hash fileName was tagged with; empty if it is missing, unreadable or untagged.
+ */
+std::string readDatasetHash(const std::string& fileName);
+
+/**
+ * @brief Makes fileName hold the dataset with the given hash if it or the cache has it.
+ * Returns false when the writer has to run.
+ */
+bool reuseCachedDataset(const std::string& fileName, const std::string& hash);
+
+/**
+ * @brief Tags a freshly written fileName with description and its hash and, with a cacheDir,
+ * adds it to the cache. Throws std::runtime_error if the file cannot be updated.
+ */
+void storeDataset(const std::string& fileName, const std::string& description);
+
+/**
+ * @brief storeDataset for every (file, description) pair if reuse is enabled, nothing
+ * otherwise. A file that cannot be tagged is reported and skipped.
+ */
+void storeDatasets(const std::vector<std::pair<std::string, std::string>>& datasets);
+
+#endif // OUTPUT_CACHE_HPP
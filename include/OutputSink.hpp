@@ -0,0 +1,46 @@
+#ifndef OUTPUT_SINK_HPP
+#define OUTPUT_SINK_HPP
+
+#include <TFile.h>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Where the writers send their output.
+ *
+ * - File:   a TFile on disk, the normal benchmark.
+ * - Memory: a TMemFile, so serialization and compression run but nothing reaches the file system.
+ * - Null:   a TMemFile that discards every byte it is given, so not even the memory copy is paid.
+ *
+ * Memory and Null leave no output file behind, so readers and every post-processing step
+ * need File.
+ */
+enum class SinkMode { File, Memory, Null };
+
+/**
+ * @brief Parses "file", "memory" or "null". Throws std::invalid_argument otherwise.
+ */
+SinkMode parseSinkMode(const std::string& name);
+std::string sinkModeName(SinkMode mode);
+
+/**
+ * @brief Selects the sink of all writers. Set before any writer starts.
+ */
+void setSinkMode(SinkMode mode);
+SinkMode getSinkMode();
+
+/**
+ * @brief Output file of a writer (recreated) in the current sink mode.
+ */
+std::unique_ptr<TFile> openOutputFile(const std::string& fileName);
+
+/**
+ * @brief For each writer selected by mask, writes with every sink (files in ./output_sinks) and
+ * once more into the null sink without compression, averaged over iter runs, and prints where
+ * the write time goes: storage (File - Null), compression (Null - uncompressed Null) and the
+ * rest (generation and serialization).
+ */
+void compareSinkModes(int nThreads, int iter, int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire,
+                      int numSpills, int mask, bool runAOS, bool runSOA);
+
+#endif // OUTPUT_SINK_HPP
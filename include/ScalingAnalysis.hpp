@@ -0,0 +1,111 @@
+#ifndef SCALING_ANALYSIS_HPP
+#define SCALING_ANALYSIS_HPP
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Raw scaling data as produced by benchmarkAOSScaling/benchmarkSOAScaling:
+// label -> list of (threads, average time in seconds).
+using ScalingData = std::map<std::string, std::vector<std::pair<int, double>>>;
+
+/**
+ * @brief Scaling model fitted to one benchmark label.
+ *
+ * Speedup is S(N) = T(base) / T(N) * base, i.e. relative to the 1-thread point when it was
+ * measured, otherwise relative to the smallest measured thread count (assumed ideal).
+ *
+ * Amdahl:  S(N) = N / (1 + s (N - 1))
+ * USL:     S(N) = N / (1 + sigma (N - 1) + kappa N (N - 1))
+ *
+ * Both are fitted by least squares on the linearized form N / S(N) - 1, with the
+ * coefficients constrained to be non-negative.
+ */
+struct ScalingFit {
+    std::string label;
+    std::vector<int> threads;
+    std::vector<double> times;
+    std::vector<double> speedup;
+    std::vector<double> efficiency;
+    int baselineThreads = 0;
+
+    double amdahlSerial = 0.0;   // serial fraction s
+    double uslSigma = 0.0;       // contention coefficient
+    double uslKappa = 0.0;       // coherency coefficient
+    double uslR2 = 0.0;          // coefficient of determination of the USL fit on S(N)
+
+    double optimalThreads = 0.0; // continuous USL optimum sqrt((1 - sigma) / kappa), 0 if unbounded
+    int optimalThreadsInt = 0;   // best integer thread count under the USL model, 0 if unbounded
+    double peakSpeedup = 0.0;    // predicted speedup at optimalThreadsInt (or Amdahl limit 1/s)
+
+    bool valid = false;          // false if fewer than two distinct thread counts were measured
+};
+
+/**
+ * @brief Evaluates the USL speedup model at N threads.
+ */
+double uslSpeedup(double sigma, double kappa, double n);
+
+/**
+ * @brief Computes speedup/efficiency and fits Amdahl and USL for one label.
+ *
+ * Points with non-positive time or thread count are ignored; duplicated thread counts keep
+ * the last measurement. Results are sorted by thread count.
+ */
+ScalingFit fitScaling(const std::string& label, const std::vector<std::pair<int, double>>& points);
+
+/**
+ * @brief Runs fitScaling for every label of a scaling run.
+ */
+std::vector<ScalingFit> analyzeScaling(const ScalingData& data);
+
+/**
+ * @brief Prints per-label speedup/efficiency and the fitted models as text tables.
+ */
+void printScalingAnalysis(const std::string& title, const std::vector<ScalingFit>& fits);
+
+/**
+ * @brief Event shape for one scaling sweep (the per-event workload passed to outAOS/outSOA).
+ */
+struct EventShape {
+    std::string name;
+    int hitsPerEvent = 100;
+    int wiresPerEvent = 100;
+    int roisPerWire = 10;
+    int numSpills = 10;
+};
+
+/**
+ * @brief Named shapes usable with --scaling-shapes: small, medium, huge, roiHeavy, hitHeavy.
+ */
+const std::vector<EventShape>& presetEventShapes();
+
+/**
+ * @brief Parses a shape list such as "small,huge,custom:200:50:20:10".
+ *
+ * Entries are preset names or "name:hits:wires:roisPerWire:spills". Unknown or malformed
+ * entries are skipped with a warning.
+ */
+std::vector<EventShape> parseEventShapes(const std::string& spec);
+
+/**
+ * @brief Writes the scaling table of one shape as CSV (label, threads, time, speedup,
+ * efficiency, USL sigma/kappa, N*). Returns false if the file could not be opened.
+ */
+bool writeScalingCsv(const std::string& path, const EventShape& shape, const std::vector<ScalingFit>& fits);
+
+/**
+ * @brief Default thread counts for a scaling sweep: powers of two up to maxThreads, plus
+ * maxThreads itself when it is not a power of two.
+ */
+std::vector<int> defaultScalingThreadCounts(int maxThreads);
+
+/**
+ * @brief Parses a thread-count list such as "1,2,3,6,12" or "1-8" (ranges are inclusive).
+ *
+ * Invalid or non-positive entries are skipped; the result is sorted and deduplicated.
+ */
+std::vector<int> parseThreadCounts(const std::string& spec);
+
+#endif // SCALING_ANALYSIS_HPP
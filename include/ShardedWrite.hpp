@@ -0,0 +1,45 @@
+#ifndef SHARDED_WRITE_HPP
+#define SHARDED_WRITE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct ShardedWriteResult {
+    std::string layout;
+    int shards = 0;
+    double shared = 0.0;        // one file through a shared RNTupleParallelWriter (wall-clock)
+    double shardWrite = 0.0;    // one file per thread, written concurrently (wall-clock)
+    double merge = 0.0;         // merging the shard files into one
+    std::uint64_t sharedBytes = 0;
+    std::uint64_t mergedBytes = 0;
+    bool entriesMatch = false;  // merged file has the entries of the shared one, ntuple by ntuple
+
+    double sharded() const { return shardWrite + merge; }
+};
+
+/**
+ * @brief Merges every ntuple of the inputs, in input order, into output with ROOT's RNTuple
+ * merger. The output is created with the default RNTuple compression, so pages the writers
+ * compressed with the same settings are copied as they are instead of being recompressed.
+ * Returns the wall-clock time in seconds.
+ */
+double mergeFiles(const std::vector<std::string>& inputs, const std::string& output);
+
+/**
+ * @brief Writes one layout (named like its output file) twice into outputDir: once with all
+ * nThreads filling one shared parallel writer ("<layout>.root"), once with every thread writing
+ * its own slice of the events into its own file, followed by mergeFiles into
+ * "<layout>_merged.root". The shard files are removed after merging.
+ */
+ShardedWriteResult runShardedWrite(const std::string& layout, int nThreads, int numEvents, int numSpills,
+                                   int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& outputDir);
+
+/**
+ * @brief Runs runShardedWrite for the writers selected by mask (AOS/SOA as enabled), averaged over
+ * iter runs, into ./output_sharded and prints both approaches side by side.
+ */
+void compareShardedWrite(int nThreads, int iter, int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire,
+                         int numSpills, int mask, bool runAOS, bool runSOA);
+
+#endif // SHARDED_WRITE_HPP
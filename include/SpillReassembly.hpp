@@ -0,0 +1,63 @@
+#ifndef SPILL_REASSEMBLY_HPP
+#define SPILL_REASSEMBLY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+struct EventAOS;
+struct EventSOA;
+
+/**
+ * @brief Which spill_allDataProduct ntuple to read: "aos_spills" (EventAOS) or
+ * "soa_spill_all" (EventSOA).
+ */
+enum class SpillLayout { AOS, SOA };
+
+struct SpillReassemblyResult {
+    std::uint64_t spills = 0;
+    std::uint64_t events = 0;           // complete events handed to the consumer
+    std::uint64_t mergedEvents = 0;     // of those, events whose spills were split between threads
+    std::uint64_t incompleteEvents = 0; // fewer than numSpills spills found
+    std::uint64_t hits = 0;             // hits over all complete events
+    std::uint64_t wires = 0;
+    std::size_t peakPending = 0;        // largest number of open events in one thread
+    std::size_t allocations = 0;        // event buffers allocated by the pools
+    double seconds = 0.0;
+};
+
+/**
+ * @brief Rebuilds whole events from the spill entries of a spill_allDataProduct file.
+ *
+ * Threads take cluster-aligned entry ranges and collect spills per EventID (the spill's
+ * top-level EventID field, which also keys spills without hits and wires) until numSpills
+ * of them arrived, in whatever order the parallel writers committed them. A complete event
+ * is put into SpillID order, so it matches the event_allDataProduct entry whatever the entry
+ * order; files without SpillID keep their spills in entry order. Event buffers come from a
+ * per-thread pool and are reused with their capacity, so steady state does not allocate.
+ * Events still open at the end of a range are merged on the calling thread.
+ */
+SpillReassemblyResult reassembleSpills(const std::string& fileName, SpillLayout layout, int numSpills, int nThreads);
+
+/**
+ * @brief Same, also handing every complete event and its EventID to onEvent. onEvent is
+ * called concurrently from the reader threads; the event is only valid during the call.
+ */
+SpillReassemblyResult reassembleSpills(const std::string& fileName, int numSpills, int nThreads,
+                                       const std::function<void(long long, const EventAOS&)>& onEvent);
+SpillReassemblyResult reassembleSpills(const std::string& fileName, int numSpills, int nThreads,
+                                       const std::function<void(long long, const EventSOA&)>& onEvent);
+
+/**
+ * @brief Reads every event of an event_allDataProduct file with the same consumer as
+ * reassembleSpills. Returns the wall time in seconds.
+ */
+double readEventsDirect(const std::string& fileName, SpillLayout layout, int nThreads);
+
+/**
+ * @brief Reassembly of <dir>/{aos,soa}_spill_all.root against reading <dir>/{aos,soa}_event_all.root.
+ */
+void benchmarkSpillReassembly(const std::string& outputDir, int numSpills, int nThreads, bool runAOS, bool runSOA);
+
+#endif // SPILL_REASSEMBLY_HPP
@@ -0,0 +1,69 @@
+#ifndef STORAGE_BASELINE_HPP
+#define STORAGE_BASELINE_HPP
+
+#include "ReaderResult.hpp"
+#include "WriterResult.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Raw bandwidth measurements that bound what the benchmarks could reach on a node.
+ *
+ * Every thread writes its own file of bytesPerThread in blocks of the given size into
+ * directory (fsync included), then reads it back; buffered reads start with the file's
+ * pages dropped from the page cache. With direct, each combination is repeated with O_DIRECT
+ * where the file system supports it. memcpy bandwidth uses per-thread buffers of at most
+ * 256 MiB.
+ */
+struct BaselineConfig {
+    std::string directory = "./output";
+    std::uint64_t bytesPerThread = 256ull << 20;
+    std::vector<std::size_t> blockSizes = {64 << 10, 1 << 20, 16 << 20};
+    std::vector<int> threads = {1};
+    bool direct = true;
+};
+
+struct BaselineResult {
+    std::string test;            // "write", "read" or "memcpy"
+    bool direct = false;
+    std::size_t blockBytes = 0;  // 0 for memcpy
+    int threads = 1;
+    std::uint64_t bytes = 0;     // all threads together
+    double seconds = 0.0;
+    bool supported = true;       // false if the file system refused O_DIRECT
+
+    double mbPerSecond() const { return seconds > 0.0 ? bytes / (1024.0 * 1024.0) / seconds : 0.0; }
+};
+
+/**
+ * @brief Best bandwidth (MiB/s) of each test over all block sizes, thread counts and modes.
+ */
+struct BaselineCeilings {
+    double writeMBps = 0.0;
+    double readMBps = 0.0;
+    double memcpyMBps = 0.0;
+};
+
+/**
+ * @brief Runs the write/read combinations and memcpy for every thread count. Throws
+ * std::runtime_error if the directory cannot be written or a file cannot be read back in full.
+ */
+std::vector<BaselineResult> runStorageBaseline(const BaselineConfig& config);
+BaselineCeilings baselineCeilings(const std::vector<BaselineResult>& results);
+void printBaselineTable(const std::vector<BaselineResult>& results);
+bool writeBaselineCsv(const std::string& path, const std::vector<BaselineResult>& results);
+
+/**
+ * @brief Prints each writer and reader result as bandwidth (file MiB over its time) and as a
+ * percentage of the ceilings: writes of the write ceiling, cold reads of the read ceiling and
+ * warm reads (page cache) of the memcpy ceiling. fileMBByLabel maps result labels
+ * ("AOS_event_allDataProduct", ...) to output file sizes; results without one are skipped.
+ */
+void printRooflineTable(const std::string& title, const BaselineCeilings& ceilings,
+                        const std::vector<WriterResult>& writers, const std::vector<ReaderResult>& readers,
+                        const std::map<std::string, double>& fileMBByLabel);
+
+#endif // STORAGE_BASELINE_HPP
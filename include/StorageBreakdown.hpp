@@ -0,0 +1,63 @@
+#ifndef STORAGE_BREAKDOWN_HPP
+#define STORAGE_BREAKDOWN_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Storage of one physical column, summed over all clusters of its ntuple.
+ *
+ * member names the column independently of the layout: the enclosing class and the data member
+ * ("FlatROI::EventID", "SOAHitVector::fChannel"), with "._0" appended for the items of a
+ * collection ("FlatROI::data._0"). Top-level fields keep their field name.
+ */
+struct ColumnStorage {
+    std::string ntuple;
+    std::string field;  // qualified field name, e.g. "rois._0.EventID"
+    std::string member;
+    bool offsets = false; // offset column of a collection field
+    std::uint32_t bitsOnStorage = 0;
+    std::uint64_t elements = 0;
+    std::uint64_t compressedBytes = 0;   // sum of the on-storage page sizes
+    std::uint64_t uncompressedBytes = 0; // elements * bitsOnStorage / 8
+    std::uint64_t pages = 0;
+
+    double avgPageBytes() const { return pages > 0 ? static_cast<double>(compressedBytes) / pages : 0.0; }
+    double ratio() const { return compressedBytes > 0 ? static_cast<double>(uncompressedBytes) / compressedBytes : 0.0; }
+};
+
+struct FileStorage {
+    std::string fileName;
+    std::uint64_t fileBytes = 0;         // TFile::GetSize, headers, footers and sidecars included
+    std::vector<ColumnStorage> columns;  // every column of every data ntuple, in descriptor order
+};
+
+/**
+ * @brief Walks the page lists of every data ntuple of the file (sidecars excluded, see
+ * listDataNtuples). Reads only the descriptors. Throws std::runtime_error if the file cannot
+ * be opened.
+ */
+FileStorage analyzeFileStorage(const std::string& fileName);
+
+/**
+ * @brief Sums the columns of all files by (member, offsets), sorted by compressed size,
+ * largest first. ntuple and field are left empty, bitsOnStorage is the widest seen.
+ */
+std::vector<ColumnStorage> aggregateByMember(const std::vector<FileStorage>& files);
+
+/**
+ * @brief One row per file, ntuple and column. Returns false if the file cannot be written.
+ */
+bool writeStorageBreakdownCsv(const std::string& path, const std::vector<FileStorage>& files);
+
+/**
+ * @brief Analyzes the existing files among fileNames and prints compressed and uncompressed
+ * size, pages, average page size, compression ratio and share of every member summed over
+ * those files, followed by what the files hold besides column pages. Writes the per-column
+ * rows to csvPath unless it is empty.
+ */
+void reportStorageBreakdown(const std::string& title, const std::vector<std::string>& fileNames,
+                            const std::string& csvPath = "");
+
+#endif // STORAGE_BREAKDOWN_HPP
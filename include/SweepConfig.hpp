@@ -0,0 +1,99 @@
+#ifndef SWEEP_CONFIG_HPP
+#define SWEEP_CONFIG_HPP
+
+#include "ScalingAnalysis.hpp"
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A parameter sweep read from a config file (see loadSweepConfig).
+ *
+ * Every list is one axis of the sweep; the run plan is their cartesian product. Layouts
+ * are writer names ("aos_event_all", ...) or "all", "aos", "soa". Shapes use the
+ * --scaling-shapes syntax, event sizes the --event-sizes syntax. Compression is "default",
+ * "none", "zlib", "lzma", "lz4" or "zstd" with an optional ":level", or a ROOT compression
+ * setting such as 505. Cluster and page sizes of 0 keep the writer's default (and cluster
+ * targeting, if enabled).
+ */
+struct SweepConfig {
+    std::string name = "sweep";
+    std::string outputDir = "./output_sweep";
+    int iterations = 3;
+    int numEvents = 10000;
+    std::vector<std::string> layouts = {"all"};
+    std::vector<int> threads = {1};
+    std::vector<EventShape> shapes = {{"default", 100, 100, 10, 10}};
+    std::vector<std::string> eventSizes = {"fixed"};
+    std::vector<std::string> generators = {"uniform"};
+    std::vector<std::string> compression = {"default"};
+    std::vector<double> clusterMB = {0.0};
+    std::vector<double> pageKB = {0.0};
+};
+
+/**
+ * @brief One cell of the run plan: a single writer run with fixed parameters.
+ */
+struct SweepCell {
+    std::string layout;
+    int threads = 1;
+    EventShape shape;
+    std::string eventSizes;
+    std::string generator;
+    std::string compression;
+    int compressionSetting = -1; // -1 keeps ROOT's default
+    double clusterMB = 0.0;
+    double pageKB = 0.0;
+    int numEvents = 0;
+
+    // Identifies the cell in the results file; equal keys mean the same measurement
+    std::string key() const;
+};
+
+/**
+ * @brief Parses the TOML subset used by sweep files: "key = value" lines with strings,
+ * numbers or [lists] (which may span lines) and # comments. Unknown keys, sections and
+ * invalid values throw std::runtime_error naming the line.
+ */
+SweepConfig parseSweepConfig(const std::string& text);
+SweepConfig loadSweepConfig(const std::string& path);
+
+/**
+ * @brief ROOT compression setting (algorithm * 100 + level) for a compression name,
+ * -1 for "default". Throws std::invalid_argument on unknown names or levels.
+ */
+int parseCompressionSetting(const std::string& name);
+
+/**
+ * @brief Expands the config into its cells, outermost axis first: shape, event sizes,
+ * generator, compression, cluster size, page size, layout, threads. "all", "aos" and
+ * "soa" are resolved against allLayouts; every other layout must be one of them.
+ * Throws std::invalid_argument on invalid axis values, so a bad config fails before it runs.
+ */
+std::vector<SweepCell> expandSweepPlan(const SweepConfig& config, const std::vector<std::string>& allLayouts);
+
+/**
+ * @brief Results of one finished cell, as appended to the results file.
+ */
+struct SweepCellResult {
+    double time = 0.0;     // average over the iterations, in s
+    double minTime = 0.0;
+    double fileMB = 0.0;
+    bool ok = false;
+    std::string error;
+};
+
+/**
+ * @brief Keys of the cells that finished successfully in an existing results file (empty if
+ * the file does not exist). Failed cells are not included and run again on resume.
+ */
+std::set<std::string> readCompletedCells(const std::string& path);
+
+/**
+ * @brief Appends the row of one cell to the results file, writing the header first if the
+ * file is new, and flushes it so an interrupted sweep keeps every finished cell.
+ */
+bool appendSweepResult(const std::string& path, const SweepConfig& config, const SweepCell& cell,
+                       const SweepCellResult& result);
+
+#endif // SWEEP_CONFIG_HPP
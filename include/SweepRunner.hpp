@@ -0,0 +1,19 @@
+#ifndef SWEEP_RUNNER_HPP
+#define SWEEP_RUNNER_HPP
+
+#include "SweepConfig.hpp"
+
+/**
+ * @brief Expands the sweep and runs every cell that has no successful row in
+ * "<outputDir>/results.csv" yet, so an interrupted sweep resumes where it stopped.
+ *
+ * Each cell selects its generator, event sizes and write option overrides, then writes its
+ * layout iterations times with its thread count as fill workers into
+ * "<outputDir>/<layout>.root". Its average and fastest wall-clock time and file size are
+ * appended to the results file as soon as the cell finishes; a failing cell is recorded as
+ * failed and retried on the next run. With planOnly the plan is printed, marking finished
+ * cells, without writing anything. Throws std::invalid_argument for an invalid config.
+ */
+void runSweep(const SweepConfig& config, bool planOnly);
+
+#endif // SWEEP_RUNNER_HPP
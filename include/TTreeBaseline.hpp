@@ -0,0 +1,55 @@
+#ifndef TTREE_BASELINE_HPP
+#define TTREE_BASELINE_HPP
+
+#include "ReaderResult.hpp"
+#include "WriterResult.hpp"
+#include <string>
+#include <vector>
+
+/**
+ * @brief TTree counterparts of the RNTuple writers, one per granularity, to measure what moving
+ * from TTree to RNTuple gains.
+ *
+ * - event:     one entry per event in tree "events", branches "hits" and "wires"
+ * - spill:     one entry per spill in tree "spills", branches "hits" and "wires"
+ * - topObject: one entry per hit in tree "hits" and per wire (with its ROIs) in tree "wires"
+ * - element:   one entry per hit, wire header and ROI in trees "hits", "wires" and "rois"
+ *
+ * AOS branches hold HitIndividual/WireIndividual objects (vectors of them for event and spill),
+ * SOA branches the SOA classes of the RNTuple writers, whose members become vector branches.
+ * Every branch is fully split. Content, event sizes and seeds are those of the RNTuple writers.
+ * Each fill thread fills its own trees in a TBufferMerger file and hands them to the merger
+ * whenever about one cluster (the RNTuple writers' compressed cluster target) is compressed;
+ * compression is the RNTuple writers' as well. Returns the wall time including the merge.
+ */
+double AOS_event_TTree(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads);
+double AOS_spill_TTree(int numEvents, int numSpills, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads);
+double AOS_topObject_TTree(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads);
+double AOS_element_TTree(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads);
+double SOA_event_TTree(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads);
+double SOA_spill_TTree(int numEvents, int numSpills, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads);
+double SOA_topObject_TTree(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads);
+double SOA_element_TTree(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads);
+
+/**
+ * @brief Reads every entry of every tree in the file, one tree after the other, each split by
+ * clusters over nThreads threads. Returns the wall time in seconds.
+ */
+double readTTreeFile(const std::string& fileName, int nThreads);
+
+/**
+ * @brief Output files of the TTree writers in outputDir ("aos_TTree_event.root", ...), in the
+ * order of the benchmarks.
+ */
+std::vector<std::string> ttreeFiles(bool soa, const std::string& outputDir);
+
+/**
+ * @brief TTree writer and reader benchmarks with the tables of outAOS/inAOS. Labels are
+ * "AOS_TTree_event", ...; a granularity runs if mask selects any of its RNTuple layouts
+ * (bits 0-2 event, 3-5 spill, 6-8 topObject, 9-11 element).
+ */
+std::vector<WriterResult> outTTree(bool soa, int nThreads, int iter, int numEvents, int hitsPerEvent, int wiresPerEvent,
+                                   int roisPerWire, int numSpills, const std::string& outputDir, int mask = -1);
+std::vector<ReaderResult> inTTree(bool soa, int nThreads, int iter, const std::string& outputDir, int mask = -1);
+
+#endif // TTREE_BASELINE_HPP
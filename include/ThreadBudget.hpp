@@ -0,0 +1,74 @@
+#ifndef THREAD_BUDGET_HPP
+#define THREAD_BUDGET_HPP
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Split of the available cores between the benchmark's thread consumers.
+ *
+ * Writers run fillWorkers fill threads while ROOT's implicit-MT pool (imtThreads) compresses
+ * pages; readers split readerThreads across the ntuples they read concurrently while the
+ * implicit-MT pool decompresses. Writers and readers never run at the same time, so
+ * fillWorkers and readerThreads each share the cores with imtThreads only.
+ */
+struct ThreadBudget {
+    int cores = 1;
+    int fillWorkers = 1;
+    int imtThreads = 0;    // 0 disables implicit MT
+    int readerThreads = 1;
+    bool legacy = true;    // no budget flag: every consumer assumes it owns all cores
+};
+
+/**
+ * @brief Builds a budget for the given number of cores.
+ *
+ * @param imtThreads Implicit-MT pool size. Negative selects the legacy oversubscribed split
+ *                   (imt = fill = reader = cores); otherwise it is clamped to [0, cores - 1].
+ * @param fillWorkers Fill worker count; negative means cores - imtThreads (at least 1).
+ * @param readerThreads Reader consumer count; negative means cores - imtThreads (at least 1).
+ */
+ThreadBudget makeThreadBudget(int cores, int imtThreads = -1, int fillWorkers = -1, int readerThreads = -1);
+
+/**
+ * @brief Resizes ROOT's implicit-MT pool to nThreads (0 disables it).
+ *
+ * ROOT::EnableImplicitMT is a no-op while implicit MT is already enabled, so the pool is
+ * disabled first to make the new size take effect.
+ */
+void applyImplicitMT(int nThreads);
+
+/**
+ * @brief Applies the implicit-MT part of a budget and, unless it is the legacy split, makes
+ * readers divide their threads across the ntuples they read concurrently.
+ */
+void applyThreadBudget(const ThreadBudget& budget);
+
+/**
+ * @brief Threads for each of nNtuples ntuples read concurrently by one reader: nThreads / nNtuples
+ * (at least 1) once a non-legacy budget was applied, nThreads otherwise.
+ */
+int readerThreadsPerNtuple(int nThreads, int nNtuples);
+
+/**
+ * @brief Short human readable form, e.g. "fill=6 imt=2 reader=6 (cores=8)".
+ */
+std::string describeThreadBudget(const ThreadBudget& budget);
+
+/**
+ * @brief Candidate splits for the budget sweep: the legacy oversubscribed split, no implicit
+ * MT, and implicit-MT pools of 1, cores/4, cores/2 and 3*cores/4 threads.
+ */
+std::vector<ThreadBudget> candidateThreadBudgets(int cores);
+
+/**
+ * @brief Runs the writer and reader benchmarks once per candidate split and prints, per
+ * layout, the split with the lowest write time and the lowest warm read time.
+ *
+ * Files go to ./output_budget; writerMask/readerMask select layouts as for outAOS/inAOS.
+ */
+void runThreadBudgetSweep(int cores, int iter, int numEvents, int hitsPerEvent, int wiresPerEvent,
+                          int roisPerWire, int numSpills, int writerMask, int readerMask,
+                          bool runAOS, bool runSOA);
+
+#endif // THREAD_BUDGET_HPP
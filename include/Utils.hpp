@@ -5,6 +5,7 @@
 #include <utility>
 #include <cstddef>
 #include <cstdint>
+#include <string>
 
 namespace ROOT { class RNTupleReader; }
 
@@ -41,6 +42,87 @@ std::vector<unsigned int> generateSeeds(int numThreads);
  */
 std::vector<std::pair<std::size_t, std::size_t>> split_range_by_clusters(ROOT::RNTupleReader& reader, int nChunks);
 
+/**
+ * @brief Per-cluster cost measure used by split_range_by_bytes.
+ */
+enum class ClusterWeight {
+    Entries,           ///< Number of entries (equivalent to balancing by entry count)
+    CompressedBytes,   ///< Sum of on-storage page sizes of all columns in the cluster
+    UncompressedBytes  ///< Sum over columns of nElements * bitsOnStorage / 8
+};
+
+/**
+ * @brief Entry range and cost of one cluster, as consumed by split_weighted_clusters.
+ */
+struct ClusterSpan {
+    std::size_t firstEntry = 0;
+    std::size_t nEntries = 0;
+    std::uint64_t weight = 0;
+};
+
+/**
+ * @brief Reads the entry range and the chosen weight of every cluster of an RNTuple.
+ *
+ * Byte weights are taken from the descriptor's page ranges and column ranges; suppressed
+ * columns are ignored. No page data is read.
+ */
+std::vector<ClusterSpan> cluster_spans(ROOT::RNTupleReader& reader, ClusterWeight weight);
+
+/**
+ * @brief Sum of the chosen weight over all clusters of an RNTuple, see cluster_spans.
+ */
+std::uint64_t total_weight(ROOT::RNTupleReader& reader, ClusterWeight weight);
+
+/**
+ * @brief Splits consecutive clusters into at most nChunks contiguous ranges minimizing the
+ * largest per-chunk weight.
+ *
+ * If allowSubCluster is set and there are fewer clusters than chunks, clusters are cut into
+ * equal-entry pieces (at least one per cluster, more for heavier clusters) so that nChunks
+ * ranges are produced where the entries allow it. Pieces of one cluster decompress the same
+ * pages, so this trades duplicated decompression for parallelism.
+ *
+ * Chunks never overlap, are sorted, and together cover all entries of the given clusters.
+ * If every weight is zero, entry counts are used instead.
+ *
+ * @return Vector of [start, end) entry ranges; empty if nChunks <= 0 or there are no entries.
+ */
+std::vector<std::pair<std::size_t, std::size_t>> split_weighted_clusters(const std::vector<ClusterSpan>& clusters, int nChunks, bool allowSubCluster = false);
+
+/**
+ * @brief Splits the entry range of an RNTuple into chunks balanced by bytes rather than by
+ * cluster count.
+ *
+ * Unlike split_range_by_clusters, a few large clusters (e.g. the last clusters flushed by each
+ * writer thread) do not end up sharing a chunk with many small ones.
+ *
+ * @param reader Open RNTupleReader for accessing the NTuple descriptor.
+ * @param nChunks Maximum number of chunks (typically the number of reader threads).
+ * @param weight Cost per cluster; compressed bytes by default.
+ * @param allowSubCluster Split inside clusters when there are fewer clusters than chunks.
+ * @return Vector of [start, end) entry ranges.
+ * @example
+ * auto chunks = Utils::split_range_by_bytes(*reader, 8, Utils::ClusterWeight::CompressedBytes, true);
+ */
+std::vector<std::pair<std::size_t, std::size_t>> split_range_by_bytes(ROOT::RNTupleReader& reader, int nChunks,
+                                                                      ClusterWeight weight = ClusterWeight::CompressedBytes,
+                                                                      bool allowSubCluster = false);
+
+/**
+ * @brief Names of all RNTuples stored in a ROOT file, in key order.
+ *
+ * @return Empty vector if the file cannot be opened.
+ */
+std::vector<std::string> list_ntuples(const std::string& fileName);
+
+/**
+ * @brief Path ("hit.fChannel", "row.EventID", ...) of the first subfield called name that sits
+ * directly under a top-level record field, i.e. that has exactly one value per entry.
+ *
+ * @return Empty string if no top-level field has such a subfield.
+ */
+std::string find_record_subfield(ROOT::RNTupleReader& reader, const std::string& name);
+
 // Deterministic seeding helpers for per-logical-entry RNG
 
 // Global base seed constant used to derive per-entry seeds deterministically.
@@ -11,6 +11,7 @@ struct WriterResult {
     std::vector<double> iterationTimes; // Store individual iteration times
     bool failed = false;
     std::string errorMessage = "";
+    bool cached = false; // output file reused, nothing was written or timed
 };
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,108 @@
+#ifndef ZONE_MAP_HPP
+#define ZONE_MAP_HPP
+
+#include <ROOT/RNTupleReader.hxx>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Min/max and value count of one field within one cluster.
+ */
+struct ZoneStats {
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    std::uint64_t count = 0;
+
+    void add(double value) {
+        if (value < min) min = value;
+        if (value > max) max = value;
+        ++count;
+    }
+};
+
+/**
+ * @brief Per-cluster statistics of one ntuple. stats[c][f] belongs to cluster c and fields[f].
+ */
+struct ZoneMap {
+    std::vector<std::string> fields; // full paths, e.g. "hit.fPeakAmplitude"
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> clusters; // [first, last) entries
+    std::vector<std::vector<ZoneStats>> stats;
+
+    /**
+     * @brief Index into fields of the path or of the leaf name ("fChannel"); -1 if absent.
+     */
+    int fieldIndex(const std::string& name) const;
+};
+
+/**
+ * @brief Closed value interval [lo, hi] on one field; use +-inf for open ends.
+ */
+struct RangePredicate {
+    std::string field;
+    double lo = -std::numeric_limits<double>::infinity();
+    double hi = std::numeric_limits<double>::infinity();
+
+    bool matches(double value) const { return value >= lo && value <= hi; }
+    bool mayMatch(const ZoneStats& s) const { return s.count > 0 && s.max >= lo && s.min <= hi; }
+};
+
+/**
+ * @brief Parses "field:lo:hi[,field:lo:hi...]"; lo/hi accept "inf"/"-inf". Bad entries are skipped.
+ */
+std::vector<RangePredicate> parseRangePredicates(const std::string& spec);
+
+/**
+ * @brief Leaf names recorded by default: EventID, fChannel, fPeakAmplitude, fWire_Channel.
+ */
+const std::vector<std::string>& defaultZoneMapFields();
+
+/**
+ * @brief Enables writing zone maps after each writer benchmark (outAOS/outSOA).
+ */
+void setEmitZoneMaps(bool enabled);
+bool getEmitZoneMaps();
+
+std::string zoneMapName(const std::string& ntupleName);
+bool isZoneMapName(const std::string& ntupleName);
+
+/**
+ * @brief Ntuples of the file without the EventID index and zone map sidecars.
+ */
+std::vector<std::string> listDataNtuples(const std::string& fileName);
+
+/**
+ * @brief Computes per-cluster statistics for every leaf name that the ntuple has as a
+ * per-entry record subfield (see Utils::find_record_subfield). Reads only those columns.
+ */
+ZoneMap buildZoneMap(ROOT::RNTupleReader& reader, const std::vector<std::string>& leafNames);
+
+/**
+ * @brief Builds zone maps for all ntuples of the file and appends each as an RNTuple
+ * "<ntuple>_zoneMap" (firstEntry, nEntries, field, min, max, count; one row per cluster and
+ * field). Sidecars and ntuples without any of the fields are skipped. Returns the number of
+ * zone maps written.
+ */
+int writeZoneMaps(const std::string& fileName, const std::vector<std::string>& leafNames = defaultZoneMapFields());
+
+/**
+ * @brief Loads the sidecar zone map of ntupleName. Throws if the file has none.
+ */
+ZoneMap loadZoneMap(const std::string& fileName, const std::string& ntupleName);
+
+/**
+ * @brief Entry ranges of the clusters whose statistics may satisfy the predicate. All clusters
+ * are kept if the predicate's field is not in the zone map.
+ */
+std::vector<std::pair<std::uint64_t, std::uint64_t>> selectClusters(const ZoneMap& zoneMap, const RangePredicate& predicate);
+
+/**
+ * @brief For every file and predicate, reads the matching entries of each ntuple that has the
+ * predicate field twice: scanning all clusters, and only the clusters kept by the zone map.
+ * Prints clusters skipped, matching entries and the speedup of the pruned read.
+ */
+void benchmarkFilteredRead(const std::vector<std::string>& files, const std::vector<RangePredicate>& predicates);
+
+#endif // ZONE_MAP_HPP
@@ -2,6 +2,7 @@
 #include <vector>
 #include "WriterResult.hpp"
 #include "ReaderResult.hpp"
+#include "ScalingAnalysis.hpp"
 #include <map>
 #include <utility>
 
@@ -9,13 +10,17 @@
 void visualize_aos_writer_results(const std::vector<WriterResult>& results);
 void visualize_aos_reader_results(const std::vector<ReaderResult>& results);
 void visualize_aos_file_sizes(const std::vector<std::pair<std::string, double>>& sizes);
-void visualize_aos_scaling(const std::map<std::string, std::vector<std::pair<int, double>>>& data);
+void visualize_aos_scaling(const std::map<std::string, std::vector<std::pair<int, double>>>& data, const std::string& tag = "");
 
 // SOA visualization functions
 void visualize_soa_writer_results(const std::vector<WriterResult>& results);
 void visualize_soa_reader_results(const std::vector<ReaderResult>& results);
 void visualize_soa_file_sizes(const std::vector<std::pair<std::string, double>>& sizes);
-void visualize_soa_scaling(const std::map<std::string, std::vector<std::pair<int, double>>>& data);
+void visualize_soa_scaling(const std::map<std::string, std::vector<std::pair<int, double>>>& data, const std::string& tag = "");
+
+// Speedup vs threads with the fitted USL curve; layout is "AOS" or "SOA".
+// A non-empty tag (e.g. the event shape name) is appended to the PDF file name.
+void visualize_scaling_speedup(const std::string& layout, const std::vector<ScalingFit>& fits, const std::string& tag = "");
 
 // Comparison functions for AOS vs SOA
 void visualize_comparison_writer_results(const std::vector<WriterResult>& aosResults, const std::vector<WriterResult>& soaResults);
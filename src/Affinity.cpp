@@ -0,0 +1,273 @@
+#include "Affinity.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if __has_include(<linux/mempolicy.h>)
+#include <linux/mempolicy.h>
+#endif
+#endif
+
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1
+#endif
+
+namespace Affinity {
+
+namespace {
+
+struct CpuInfo {
+    int cpu = 0;
+    int node = 0;
+    int package = 0;
+    int core = 0;
+    int siblingRank = 0; // 0 for the first hardware thread of a physical core
+};
+
+struct Topology {
+    std::vector<CpuInfo> cpus;
+    std::map<int, std::vector<int>> nodeCpus;
+    std::vector<int> compactOrder; // indices into cpus
+    std::vector<int> scatterOrder; // indices into cpus
+    std::vector<int> nodes;        // node ids in ascending order
+};
+
+Policy gPolicy = Policy::None;
+Topology gTopology;
+std::atomic<int> gNextSlot{0};
+std::mutex gStatsMutex;
+std::map<int, long> gCpuPlacements;
+std::map<int, long> gNodePlacements;
+long gMemoryPolicyFailures = 0;
+
+int readIntFile(const std::string& path, int fallback) {
+    std::ifstream in(path);
+    int value = fallback;
+    if (!(in >> value)) return fallback;
+    return value;
+}
+
+std::vector<int> allowedCpus() {
+    std::vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int c = 0; c < CPU_SETSIZE; ++c) {
+            if (CPU_ISSET(c, &set)) cpus.push_back(c);
+        }
+    }
+#endif
+    return cpus;
+}
+
+int nodeOfCpu(int cpu) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::path dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+        std::string name = it->path().filename().string();
+        if (name.rfind("node", 0) == 0 && name.size() > 4) {
+            try {
+                return std::stoi(name.substr(4));
+            } catch (const std::exception&) {
+            }
+        }
+    }
+    return 0;
+}
+
+Topology discoverTopology() {
+    Topology topo;
+    for (int cpu : allowedCpus()) {
+        CpuInfo info;
+        info.cpu = cpu;
+        info.node = nodeOfCpu(cpu);
+        std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+        info.package = readIntFile(base + "physical_package_id", 0);
+        info.core = readIntFile(base + "core_id", cpu);
+        topo.cpus.push_back(info);
+    }
+
+    // Hyperthread siblings share (package, core); rank them by CPU number
+    std::map<std::pair<int, int>, int> siblingsSeen;
+    for (auto& info : topo.cpus) {
+        info.siblingRank = siblingsSeen[{info.package, info.core}]++;
+        topo.nodeCpus[info.node].push_back(info.cpu);
+    }
+    for (const auto& [node, cpus] : topo.nodeCpus) topo.nodes.push_back(node);
+
+    std::vector<int> idx(topo.cpus.size());
+    for (size_t i = 0; i < idx.size(); ++i) idx[i] = static_cast<int>(i);
+
+    // Compact: node by node, siblings next to each other
+    topo.compactOrder = idx;
+    std::sort(topo.compactOrder.begin(), topo.compactOrder.end(), [&](int a, int b) {
+        const auto& x = topo.cpus[a];
+        const auto& y = topo.cpus[b];
+        return std::tie(x.node, x.package, x.core, x.siblingRank) < std::tie(y.node, y.package, y.core, y.siblingRank);
+    });
+
+    // Scatter: round-robin over nodes, all physical cores of a node before their siblings
+    std::map<int, std::vector<int>> perNode;
+    std::vector<int> byRank = idx;
+    std::sort(byRank.begin(), byRank.end(), [&](int a, int b) {
+        const auto& x = topo.cpus[a];
+        const auto& y = topo.cpus[b];
+        return std::tie(x.siblingRank, x.package, x.core) < std::tie(y.siblingRank, y.package, y.core);
+    });
+    for (int i : byRank) perNode[topo.cpus[i].node].push_back(i);
+    for (size_t round = 0; topo.scatterOrder.size() < idx.size(); ++round) {
+        for (const auto& [node, list] : perNode) {
+            if (round < list.size()) topo.scatterOrder.push_back(list[round]);
+        }
+    }
+    return topo;
+}
+
+void recordPlacement(int cpu, int node) {
+    std::lock_guard<std::mutex> lock(gStatsMutex);
+    if (cpu >= 0) ++gCpuPlacements[cpu];
+    ++gNodePlacements[node];
+}
+
+// MPOL_LOCAL would only restate the kernel default; preferring the node keeps allocations there
+// even when the thread later runs elsewhere, and falls back to other nodes instead of failing
+bool preferMemoryNode(int node) {
+#ifdef __linux__
+    if (node < 0) return false;
+    constexpr int kBits = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> mask(node / kBits + 1, 0);
+    mask[node / kBits] |= 1UL << (node % kBits);
+    // The kernel reads maxnode - 1 bits
+    return syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask.data(), mask.size() * kBits + 1) == 0;
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+bool pinToCpus(const std::vector<int>& cpus) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int c : cpus) CPU_SET(c, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+} // namespace
+
+Policy parsePolicy(const std::string& name) {
+    if (name == "none") return Policy::None;
+    if (name == "compact") return Policy::Compact;
+    if (name == "scatter") return Policy::Scatter;
+    if (name == "numa" || name == "per-numa") return Policy::PerNuma;
+    throw std::invalid_argument("unknown affinity policy '" + name + "' (expected none, compact, scatter or numa)");
+}
+
+std::string policyName(Policy policy) {
+    switch (policy) {
+        case Policy::None: return "none";
+        case Policy::Compact: return "compact";
+        case Policy::Scatter: return "scatter";
+        case Policy::PerNuma: return "numa";
+    }
+    return "unknown";
+}
+
+void setPolicy(Policy policy) {
+    gPolicy = policy;
+    if (policy != Policy::None) gTopology = discoverTopology();
+    clearPlacementStats();
+    resetSlots();
+}
+
+Policy getPolicy() {
+    return gPolicy;
+}
+
+bool pinCurrentThread(int slot) {
+    if (gPolicy == Policy::None || gTopology.cpus.empty() || slot < 0) return true;
+
+    bool ok = false;
+    int node = 0;
+    if (gPolicy == Policy::PerNuma) {
+        node = gTopology.nodes[slot % gTopology.nodes.size()];
+        ok = pinToCpus(gTopology.nodeCpus[node]);
+        if (ok) recordPlacement(-1, node);
+    } else {
+        const auto& order = (gPolicy == Policy::Compact) ? gTopology.compactOrder : gTopology.scatterOrder;
+        const auto& info = gTopology.cpus[order[slot % order.size()]];
+        node = info.node;
+        ok = pinToCpus({info.cpu});
+        if (ok) recordPlacement(info.cpu, info.node);
+    }
+    // Pages touched from now on by this thread (fill buffers, generated events) go to its node
+    if (ok && !preferMemoryNode(node)) {
+        std::lock_guard<std::mutex> lock(gStatsMutex);
+        ++gMemoryPolicyFailures;
+    }
+    return ok;
+}
+
+bool pinCurrentThreadToNextSlot() {
+    if (gPolicy == Policy::None) return true;
+    return pinCurrentThread(gNextSlot.fetch_add(1, std::memory_order_relaxed));
+}
+
+void resetSlots() {
+    gNextSlot.store(0, std::memory_order_relaxed);
+}
+
+void clearPlacementStats() {
+    std::lock_guard<std::mutex> lock(gStatsMutex);
+    gCpuPlacements.clear();
+    gNodePlacements.clear();
+    gMemoryPolicyFailures = 0;
+}
+
+void printPlacementReport(const std::string& title) {
+    std::cout << "\n" << title << std::endl;
+    std::cout << "  Policy: " << policyName(gPolicy) << std::endl;
+    if (gPolicy == Policy::None) {
+        std::cout << "  Threads are not pinned" << std::endl;
+        return;
+    }
+    std::cout << "  Topology: " << gTopology.cpus.size() << " CPUs on " << gTopology.nodes.size() << " NUMA node(s)" << std::endl;
+    for (const auto& [node, cpus] : gTopology.nodeCpus) {
+        std::cout << "    node " << node << ": " << cpus.size() << " CPUs" << std::endl;
+    }
+
+    std::lock_guard<std::mutex> lock(gStatsMutex);
+    std::cout << "  Worker placements per node:";
+    for (const auto& [node, count] : gNodePlacements) std::cout << " node" << node << "=" << count;
+    std::cout << std::endl;
+    if (!gCpuPlacements.empty()) {
+        std::cout << "  Worker placements per CPU:";
+        for (const auto& [cpu, count] : gCpuPlacements) std::cout << " " << cpu << ":" << count;
+        std::cout << std::endl;
+    }
+    if (gMemoryPolicyFailures > 0) {
+        std::cout << "  Memory node preference failed for " << gMemoryPolicyFailures
+                  << " placement(s); their pages follow the kernel default" << std::endl;
+    }
+}
+
+} // namespace Affinity
@@ -0,0 +1,168 @@
+#include "ClusterTargeting.hpp"
+#include "EventSizes.hpp"
+#include "Hit.hpp"
+#include "Utils.hpp"
+#include <ROOT/RNTupleReader.hxx>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+ClusterTargetConfig gClusterTarget;
+WriteOptionOverrides gWriteOverrides;
+
+// On-storage sizes: a vector/collection field adds an 8 byte offset column per entry
+constexpr std::uint64_t kCollectionIndexBytes = 8;
+constexpr std::uint64_t kWireHeaderBytes = sizeof(long long) + sizeof(unsigned int) + sizeof(int);
+
+// Offset, sample collection index and the samples of an ROI of mean length under the active
+// ROI length distribution
+std::uint64_t roiBytes() {
+    return sizeof(std::size_t) + kCollectionIndexBytes + static_cast<std::uint64_t>(meanROILength() * sizeof(float) + 0.5);
+}
+
+std::string formatBytes(std::uint64_t bytes) {
+    std::ostringstream os;
+    if (bytes >= 1024ull * 1024 * 1024) {
+        os << std::fixed << std::setprecision(1) << bytes / (1024.0 * 1024 * 1024) << " GiB";
+    } else if (bytes >= 1024ull * 1024) {
+        os << std::fixed << std::setprecision(1) << bytes / (1024.0 * 1024) << " MiB";
+    } else if (bytes >= 1024) {
+        os << std::fixed << std::setprecision(1) << bytes / 1024.0 << " KiB";
+    } else {
+        os << bytes << " B";
+    }
+    return os.str();
+}
+
+} // namespace
+
+void setClusterTargetConfig(const ClusterTargetConfig& config) {
+    gClusterTarget = config;
+    gClusterTarget.readerThreads = std::max(1, gClusterTarget.readerThreads);
+    gClusterTarget.clustersPerReader = std::max(0, gClusterTarget.clustersPerReader);
+}
+
+const ClusterTargetConfig& getClusterTargetConfig() {
+    return gClusterTarget;
+}
+
+void setWriteOptionOverrides(const WriteOptionOverrides& overrides) {
+    gWriteOverrides = overrides;
+}
+
+const WriteOptionOverrides& getWriteOptionOverrides() {
+    return gWriteOverrides;
+}
+
+EventBytes estimateEventBytes(int hitsPerEvent, int wiresPerEvent, int roisPerWire) {
+    // Size distributions keep the mean count, only huge events add to it
+    const double scale = meanEventScale();
+    auto scaled = [scale](std::uint64_t bytes) { return static_cast<std::uint64_t>(bytes * scale); };
+    EventBytes bytes;
+    bytes.hits = scaled(static_cast<std::uint64_t>(std::max(0, hitsPerEvent)) * sizeof(HitIndividual));
+    bytes.wires = scaled(static_cast<std::uint64_t>(std::max(0, wiresPerEvent)) * (kWireHeaderBytes + kCollectionIndexBytes));
+    bytes.rois = scaled(static_cast<std::uint64_t>(std::max(0, wiresPerEvent)) * std::max(0, roisPerWire) * roiBytes());
+    return bytes;
+}
+
+std::uint64_t targetClusterBytes(std::uint64_t expectedBytes, const ClusterTargetConfig& config,
+                                 std::uint64_t defaultClusterBytes) {
+    if (config.clustersPerReader <= 0) return 0;
+    std::uint64_t clusters = static_cast<std::uint64_t>(config.clustersPerReader) * std::max(1, config.readerThreads);
+    std::uint64_t target = expectedBytes / clusters;
+    if (defaultClusterBytes > 0) target = std::min(target, defaultClusterBytes);
+    return std::max(target, config.minClusterBytes);
+}
+
+ROOT::RNTupleWriteOptions makeWriteOptions(std::uint64_t expectedBytes) {
+    ROOT::RNTupleWriteOptions options;
+    options.SetUseBufferedWrite(true);
+    const auto& overrides = gWriteOverrides;
+    if (overrides.compression >= 0) options.SetCompression(overrides.compression);
+
+    std::uint64_t target = overrides.clusterBytes > 0
+                               ? overrides.clusterBytes
+                               : targetClusterBytes(expectedBytes, gClusterTarget, options.GetApproxZippedClusterSize());
+    std::uint64_t page = overrides.pageBytes > 0 ? overrides.pageBytes : options.GetMaxUnzippedPageSize();
+    if (target > 0) page = std::min(page, target);
+    if (target == 0 && overrides.pageBytes == 0) return options;
+
+    // Each setter validates page <= cluster and zipped <= unzipped, so grow clusters before
+    // pages and shrink pages before clusters
+    auto setClusters = [&options, target]() {
+        if (target == 0) return;
+        // Unzipped size reaches the limit before the compressed estimate does, so contexts cut
+        // clusters at a predictable number of uncompressed bytes
+        if (target > options.GetMaxUnzippedClusterSize()) {
+            options.SetMaxUnzippedClusterSize(target);
+            options.SetApproxZippedClusterSize(target);
+        } else {
+            options.SetApproxZippedClusterSize(target);
+            options.SetMaxUnzippedClusterSize(target);
+        }
+    };
+    const bool growClusters = target > options.GetMaxUnzippedClusterSize();
+    if (growClusters) setClusters();
+    if (options.GetInitialUnzippedPageSize() > page) options.SetInitialUnzippedPageSize(page);
+    options.SetMaxUnzippedPageSize(page);
+    if (!growClusters) setClusters();
+    return options;
+}
+
+std::uint64_t clusterCutBytes(std::uint64_t expectedBytes) {
+    return makeWriteOptions(expectedBytes).GetApproxZippedClusterSize();
+}
+
+void printClusterHistogram(const std::string& fileName) {
+    auto names = Utils::list_ntuples(fileName);
+
+    const auto& config = gClusterTarget;
+    const std::uint64_t wanted = static_cast<std::uint64_t>(config.clustersPerReader) * config.readerThreads;
+    std::cout << "Cluster histogram for " << fileName << std::endl;
+    for (const auto& name : names) {
+        auto reader = ROOT::RNTupleReader::Open(name, fileName);
+        auto entries = Utils::cluster_spans(*reader, Utils::ClusterWeight::Entries);
+        auto bytes = Utils::cluster_spans(*reader, Utils::ClusterWeight::CompressedBytes);
+        if (entries.empty()) {
+            std::cout << "  " << name << ": no clusters" << std::endl;
+            continue;
+        }
+
+        std::uint64_t minEntries = entries.front().nEntries, maxEntries = 0, sumEntries = 0;
+        for (const auto& s : entries) {
+            minEntries = std::min<std::uint64_t>(minEntries, s.nEntries);
+            maxEntries = std::max<std::uint64_t>(maxEntries, s.nEntries);
+            sumEntries += s.nEntries;
+        }
+        std::uint64_t minBytes = bytes.front().weight, maxBytes = 0, sumBytes = 0;
+        std::map<int, int> buckets; // log2(compressed KiB) -> cluster count
+        for (const auto& s : bytes) {
+            minBytes = std::min(minBytes, s.weight);
+            maxBytes = std::max(maxBytes, s.weight);
+            sumBytes += s.weight;
+            int bucket = 0;
+            for (std::uint64_t kib = s.weight / 1024; kib > 1; kib >>= 1) ++bucket;
+            ++buckets[s.weight < 1024 ? -1 : bucket];
+        }
+
+        std::cout << "  " << std::left << std::setw(24) << name
+                  << entries.size() << " clusters"
+                  << "  entries min/avg/max " << minEntries << "/" << sumEntries / entries.size() << "/" << maxEntries
+                  << "  zipped min/avg/max " << formatBytes(minBytes) << "/" << formatBytes(sumBytes / bytes.size())
+                  << "/" << formatBytes(maxBytes);
+        if (wanted > 0 && entries.size() < wanted) {
+            std::cout << "  (below target of " << wanted << ")";
+        }
+        std::cout << std::endl;
+        for (const auto& [bucket, count] : buckets) {
+            std::string range = bucket < 0 ? "< 1 KiB"
+                                           : "[" + formatBytes(1024ull << bucket) + ", " + formatBytes(2048ull << bucket) + ")";
+            std::cout << "    " << std::setw(22) << range << std::string(std::min(count, 60), '#') << " " << count << std::endl;
+        }
+    }
+}
@@ -0,0 +1,439 @@
+#include "Compaction.hpp"
+#include "Affinity.hpp"
+#include "EventIndex.hpp"
+#include "JoinReader.hpp"
+#include "Utils.hpp"
+#include "ZoneMap.hpp"
+#include <ROOT/REntry.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleReader.hxx>
+#include <ROOT/RNTupleWriter.hxx>
+#include <ROOT/RNTupleWriteOptions.hxx>
+#include <TFile.h>
+#include <TStopwatch.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+
+using Chunk = std::pair<std::size_t, std::size_t>;
+
+// Merge memory per open run at the largest fan-in; at least two runs are merged per pass
+constexpr std::uint64_t kMinMergeBufferBytes = 4ull * 1024 * 1024;
+constexpr std::size_t kMaxFanIn = 64;
+constexpr std::uint64_t kMinRunClusterBytes = 64 * 1024;
+constexpr std::size_t kKeyWindow = 4096; // sort keys read ahead per open run
+
+// (EventID, element index); entries without an EventID sort behind all others
+struct SortKey {
+    long long event = kNoEventKey;
+    long long element = 0;
+};
+
+bool keyLess(const SortKey& a, const SortKey& b) {
+    return std::make_tuple(a.event == kNoEventKey, a.event, a.element) <
+           std::make_tuple(b.event == kNoEventKey, b.event, b.element);
+}
+
+// The element index is the WireID of ROI and union rows. The other layouts store none; their
+// writers emit the elements of an event in order, so the input order, kept for ties, is the
+// element order.
+struct SortColumns {
+    EventKeyColumn event;   // field empty: no EventID
+    EventKeyColumn element; // field empty: no element index
+};
+
+SortColumns findSortColumns(ROOT::RNTupleReader& reader) {
+    SortColumns columns;
+    if (!findEventKeyColumn(reader, columns.event)) return SortColumns{}; // copied in input order
+    const auto& desc = reader.GetDescriptor();
+    columns.element.field = desc.FindFieldId("WireID") != ROOT::kInvalidDescriptorId
+                                ? "WireID"
+                                : Utils::find_record_subfield(reader, "WireID");
+    return columns;
+}
+
+void readSortKeys(ROOT::RNTupleReader& reader, const SortColumns& columns, std::uint64_t first, std::uint64_t last,
+                  std::vector<SortKey>& out, std::vector<long long>& scratch) {
+    const std::size_t n = last - first;
+    out.assign(n, SortKey{});
+    if (n == 0) return;
+    scratch.resize(n);
+    if (!columns.event.field.empty()) {
+        readEventKeys(reader, columns.event, first, last, scratch.data());
+        for (std::size_t j = 0; j < n; ++j) out[j].event = scratch[j];
+    }
+    if (!columns.element.field.empty()) {
+        readEventKeys(reader, columns.element, first, last, scratch.data());
+        for (std::size_t j = 0; j < n; ++j) out[j].element = scratch[j];
+    }
+}
+
+// Peak resident set of the process (VmHWM), 0 where /proc is not available
+std::uint64_t peakRssBytes() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) return std::stoull(line.substr(6)) * 1024;
+    }
+    return 0;
+}
+
+// Lowers VmHWM to the current resident set (Linux 4.0+), so the next peak covers one ntuple
+bool resetPeakRss() {
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+    return static_cast<bool>(clearRefs.flush());
+}
+
+std::vector<std::string> topLevelFields(ROOT::RNTupleReader& reader) {
+    std::vector<std::string> names;
+    const auto& desc = reader.GetDescriptor();
+    for (const auto& field : desc.GetFieldIterable(desc.GetFieldZeroId())) names.push_back(field.GetFieldName());
+    return names;
+}
+
+// Points the writer entry's values at the reader entry's, so Fill writes what LoadEntry read
+void bindValues(ROOT::REntry& writerEntry, const std::vector<ROOT::RFieldToken>& writerTokens, ROOT::REntry& readerEntry,
+                const std::vector<ROOT::RFieldToken>& readerTokens) {
+    for (std::size_t f = 0; f < writerTokens.size(); ++f) {
+        writerEntry.BindValue(writerTokens[f], readerEntry.GetPtr<void>(readerTokens[f]));
+    }
+}
+
+std::vector<ROOT::RFieldToken> fieldTokens(const ROOT::REntry& entry, const std::vector<std::string>& fields) {
+    std::vector<ROOT::RFieldToken> tokens;
+    for (const auto& name : fields) tokens.push_back(entry.GetToken(name));
+    return tokens;
+}
+
+// Temporary runs are cut into clusters of clusterBytes, so a merge reader holds about two of
+// them (the current and the prefetched cluster)
+ROOT::RNTupleWriteOptions runWriteOptions(std::uint64_t clusterBytes) {
+    ROOT::RNTupleWriteOptions options;
+    clusterBytes = std::max(clusterBytes, kMinRunClusterBytes);
+    // Shrink pages before clusters, each setter checks page <= cluster
+    if (clusterBytes < options.GetMaxUnzippedPageSize()) {
+        if (options.GetInitialUnzippedPageSize() > clusterBytes) options.SetInitialUnzippedPageSize(clusterBytes);
+        options.SetMaxUnzippedPageSize(clusterBytes);
+    }
+    if (clusterBytes < options.GetApproxZippedClusterSize()) {
+        options.SetApproxZippedClusterSize(clusterBytes);
+        options.SetMaxUnzippedClusterSize(clusterBytes);
+    }
+    return options;
+}
+
+// Phase 1 worker: loads, sorts and writes each run of its range
+void sortRuns(const std::string& fileName, const std::string& ntupleName, const SortColumns& columns,
+              const std::vector<std::string>& fields, const std::vector<std::pair<Chunk, std::string>>& runs,
+              std::uint64_t runClusterBytes) {
+    Affinity::pinCurrentThreadToNextSlot();
+    auto reader = ROOT::RNTupleReader::Open(ntupleName, fileName);
+    std::vector<std::unique_ptr<ROOT::REntry>> buffer;
+    std::vector<SortKey> keys;
+    std::vector<long long> scratch;
+    std::vector<std::size_t> order;
+    for (const auto& [range, path] : runs) {
+        const std::size_t n = range.second - range.first;
+        while (buffer.size() < n) buffer.push_back(reader->GetModel().CreateEntry());
+        readSortKeys(*reader, columns, range.first, range.second, keys, scratch);
+        for (std::size_t j = 0; j < n; ++j) reader->LoadEntry(range.first + j, *buffer[j]);
+
+        order.resize(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return keyLess(keys[a], keys[b]); });
+
+        auto writer = ROOT::RNTupleWriter::Recreate(reader->GetModel().Clone(), ntupleName, path, runWriteOptions(runClusterBytes));
+        auto writerEntry = writer->CreateEntry();
+        const auto writerTokens = fieldTokens(*writerEntry, fields);
+        const auto readerTokens = fieldTokens(*buffer.front(), fields);
+        for (std::size_t j = 0; j < n; ++j) {
+            bindValues(*writerEntry, writerTokens, *buffer[order[j]], readerTokens);
+            writer->Fill(*writerEntry);
+        }
+    }
+}
+
+// Reads a sorted run front to back; only a window of its sort keys is in memory
+class RunCursor {
+public:
+    RunCursor(const std::string& ntupleName, const std::string& path, const SortColumns& columns)
+        : fReader(ROOT::RNTupleReader::Open(ntupleName, path)), fColumns(columns), fEntries(fReader->GetNEntries()) {
+        refill();
+    }
+
+    bool done() const { return fPos >= fEntries; }
+    const SortKey& key() const { return fKeys[fPos - fWindowFirst]; }
+    ROOT::RNTupleReader& reader() { return *fReader; }
+    void load(ROOT::REntry& entry) { fReader->LoadEntry(fPos, entry); }
+
+    void next() {
+        if (++fPos >= fWindowFirst + fKeys.size()) refill();
+    }
+
+private:
+    void refill() {
+        fWindowFirst = fPos;
+        readSortKeys(*fReader, fColumns, fPos, std::min<std::uint64_t>(fEntries, fPos + kKeyWindow), fKeys, fScratch);
+    }
+
+    std::unique_ptr<ROOT::RNTupleReader> fReader;
+    const SortColumns& fColumns;
+    std::uint64_t fEntries;
+    std::uint64_t fPos = 0;
+    std::uint64_t fWindowFirst = 0;
+    std::vector<SortKey> fKeys;
+    std::vector<long long> fScratch;
+};
+
+// One k-way merge of sorted runs into writer; ties go to the earlier run to keep the input order
+void mergeRuns(const std::vector<std::string>& paths, const std::string& ntupleName, const SortColumns& columns,
+               const std::vector<std::string>& fields, ROOT::RNTupleWriter& writer) {
+    std::vector<std::unique_ptr<RunCursor>> cursors;
+    std::vector<std::unique_ptr<ROOT::REntry>> readerEntries, writerEntries;
+    for (const auto& path : paths) {
+        cursors.push_back(std::make_unique<RunCursor>(ntupleName, path, columns));
+        readerEntries.push_back(cursors.back()->reader().GetModel().CreateEntry());
+        writerEntries.push_back(writer.CreateEntry());
+        bindValues(*writerEntries.back(), fieldTokens(*writerEntries.back(), fields), *readerEntries.back(),
+                   fieldTokens(*readerEntries.back(), fields));
+    }
+
+    auto later = [&cursors](std::size_t a, std::size_t b) {
+        if (keyLess(cursors[b]->key(), cursors[a]->key())) return true;
+        if (keyLess(cursors[a]->key(), cursors[b]->key())) return false;
+        return a > b;
+    };
+    std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(later)> heads(later);
+    for (std::size_t r = 0; r < cursors.size(); ++r) {
+        if (!cursors[r]->done()) heads.push(r);
+    }
+    while (!heads.empty()) {
+        const std::size_t r = heads.top();
+        heads.pop();
+        cursors[r]->load(*readerEntries[r]);
+        writer.Fill(*writerEntries[r]);
+        cursors[r]->next();
+        if (!cursors[r]->done()) heads.push(r);
+    }
+}
+
+CompactionReport compactNtuple(const std::string& inFile, const std::string& ntupleName, const CompactionConfig& config, TFile& out) {
+    CompactionReport report;
+    report.ntupleName = ntupleName;
+    const bool rssReset = resetPeakRss();
+    auto source = ROOT::RNTupleReader::Open(ntupleName, inFile);
+    const SortColumns columns = findSortColumns(*source);
+    report.sorted = !columns.event.field.empty(); // otherwise copied in input order
+    const auto fields = topLevelFields(*source);
+    report.entries = source->GetNEntries();
+    report.bytes = Utils::total_weight(*source, Utils::ClusterWeight::UncompressedBytes);
+
+    const int nThreads = std::max(1, config.nThreads);
+    const std::uint64_t entryBytes = std::max<std::uint64_t>(1, report.entries > 0 ? report.bytes / report.entries : 1);
+    report.runEntries = std::max<std::uint64_t>(1, config.memoryBytes / nThreads / entryBytes);
+    const std::size_t fanIn = std::clamp<std::size_t>(config.memoryBytes / kMinMergeBufferBytes, 2, kMaxFanIn);
+    const std::uint64_t runClusterBytes = config.memoryBytes / fanIn / 2;
+
+    // Each thread cuts its cluster-aligned chunk into runs
+    const std::string tempPrefix = std::string(out.GetName()) + "." + ntupleName;
+    std::vector<std::string> tempFiles;
+    std::vector<std::vector<std::pair<Chunk, std::string>>> runsOfChunk;
+    for (const auto& chunk : Utils::split_range_by_clusters(*source, nThreads)) {
+        runsOfChunk.emplace_back();
+        for (auto first = chunk.first; first < chunk.second; first += report.runEntries) {
+            tempFiles.push_back(tempPrefix + ".run" + std::to_string(tempFiles.size()) + ".root");
+            runsOfChunk.back().push_back({{first, std::min<std::size_t>(chunk.second, first + report.runEntries)}, tempFiles.back()});
+        }
+    }
+    report.runs = static_cast<int>(tempFiles.size());
+    std::vector<std::string> runs = tempFiles; // in input order
+
+    TStopwatch sw; sw.Start();
+    std::vector<std::future<void>> futures;
+    for (const auto& mine : runsOfChunk) {
+        futures.emplace_back(std::async(std::launch::async, sortRuns, std::cref(inFile), std::cref(ntupleName),
+                                        std::cref(columns), std::cref(fields), std::cref(mine), runClusterBytes));
+    }
+    std::exception_ptr failure;
+    for (auto& f : futures) {
+        try { f.get(); } catch (...) { if (!failure) failure = std::current_exception(); }
+    }
+    sw.Stop();
+    report.sortSeconds = sw.RealTime();
+
+    if (!failure) {
+        sw.Start();
+        try {
+            // Intermediate passes merge groups of consecutive runs, so ties keep the input order
+            // and no more than fanIn runs are open at once
+            while (runs.size() > fanIn) {
+                std::vector<std::string> merged;
+                for (std::size_t g = 0; g < runs.size(); g += fanIn) {
+                    std::vector<std::string> group(runs.begin() + g, runs.begin() + std::min(runs.size(), g + fanIn));
+                    if (group.size() == 1) {
+                        merged.push_back(group.front());
+                        continue;
+                    }
+                    tempFiles.push_back(tempPrefix + ".pass" + std::to_string(report.mergePasses) + "." +
+                                        std::to_string(merged.size()) + ".root");
+                    {
+                        auto writer = ROOT::RNTupleWriter::Recreate(source->GetModel().Clone(), ntupleName, tempFiles.back(),
+                                                                    runWriteOptions(runClusterBytes));
+                        mergeRuns(group, ntupleName, columns, fields, *writer);
+                    }
+                    for (const auto& path : group) std::filesystem::remove(path);
+                    merged.push_back(tempFiles.back());
+                }
+                runs = std::move(merged);
+                ++report.mergePasses;
+            }
+            auto writer = ROOT::RNTupleWriter::Append(source->GetModel().Clone(), ntupleName, out);
+            mergeRuns(runs, ntupleName, columns, fields, *writer);
+            ++report.mergePasses;
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        sw.Stop();
+        report.mergeSeconds = sw.RealTime();
+    }
+    for (const auto& path : tempFiles) std::filesystem::remove(path);
+    if (failure) std::rethrow_exception(failure);
+    if (rssReset) report.peakRssBytes = peakRssBytes();
+    return report;
+}
+
+struct Locality {
+    double rangesPerEvent = 0.0;
+    double lookupSeconds = 0.0;
+};
+
+// Entry ranges per event and the time to load nLookups random events through an in-memory index
+Locality measureLocality(const std::string& fileName, const std::string& ntupleName, int nLookups) {
+    Locality locality;
+    auto reader = ROOT::RNTupleReader::Open(ntupleName, fileName);
+    EventKeyColumn key;
+    if (!findEventKeyColumn(*reader, key)) return locality;
+    std::vector<long long> keys(reader->GetNEntries());
+    readEventKeys(*reader, key, 0, keys.size(), keys.data());
+
+    std::vector<EventEntryRange> runs;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        if (keys[i] == kNoEventKey) continue;
+        if (!runs.empty() && runs.back().eventId == keys[i] && runs.back().firstEntry + runs.back().nEntries == i) {
+            ++runs.back().nEntries;
+        } else {
+            runs.push_back({keys[i], i, 1});
+        }
+    }
+    EventIndex index(runs);
+    std::vector<long long> events;
+    for (const auto& r : sortEventRanges(runs)) {
+        if (events.empty() || events.back() != r.eventId) events.push_back(r.eventId);
+    }
+    if (events.empty()) return locality;
+    locality.rangesPerEvent = static_cast<double>(index.size()) / events.size();
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::size_t> pick(0, events.size() - 1);
+    auto fresh = ROOT::RNTupleReader::Open(ntupleName, fileName);
+    TStopwatch sw; sw.Start();
+    for (int n = 0; n < nLookups; ++n) {
+        for (const auto& [first, last] : index.lookup(events[pick(rng)])) {
+            for (auto i = first; i < last; ++i) fresh->LoadEntry(i);
+        }
+    }
+    sw.Stop();
+    locality.lookupSeconds = sw.RealTime();
+    return locality;
+}
+
+} // namespace
+
+std::string compactedFileName(const std::string& fileName) {
+    auto path = std::filesystem::path(fileName);
+    path.replace_filename(path.stem().string() + "_sorted.root");
+    return path.string();
+}
+
+std::vector<CompactionReport> compactFile(const std::string& inFile, const std::string& outFile, const CompactionConfig& config) {
+    std::vector<CompactionReport> reports;
+    std::unique_ptr<TFile> out(TFile::Open(outFile.c_str(), "RECREATE"));
+    if (!out || out->IsZombie()) throw std::runtime_error("cannot create " + outFile);
+    for (const auto& name : listDataNtuples(inFile)) {
+        reports.push_back(compactNtuple(inFile, name, config, *out));
+    }
+    return reports;
+}
+
+void runCompaction(const std::vector<std::string>& files, const CompactionConfig& config, int nLookups) {
+    const int col1 = 36, col2 = 10, col3 = 12;
+    std::cout << "\nEventID Compaction (" << config.nThreads << " threads, "
+              << config.memoryBytes / (1024 * 1024) << " MB buffers)" << std::endl;
+    std::cout << std::left
+              << std::setw(col1) << "Ntuple"
+              << std::setw(col3) << "Entries"
+              << std::setw(col2) << "Runs"
+              << std::setw(col2) << "Passes"
+              << std::setw(col3) << "Peak RSS MB"
+              << std::setw(col2) << "Sort (s)"
+              << std::setw(col2) << "Merge (s)"
+              << std::setw(col2) << "MB/s"
+              << std::setw(col3) << "Ranges/evt"
+              << std::setw(col3) << "Lookup (s)"
+              << std::setw(col3) << "Scan (s)" << std::endl;
+    std::cout << std::string(col1 + 5 * col2 + 5 * col3, '-') << std::endl;
+
+    for (const auto& fileName : files) {
+        if (!std::filesystem::exists(fileName)) continue;
+        const std::string stem = std::filesystem::path(fileName).stem().string();
+        const std::string outFile = compactedFileName(fileName);
+        try {
+            Affinity::resetSlots();
+            auto reports = compactFile(fileName, outFile, config);
+            const int readThreads = std::max(1, config.nThreads);
+            const double scanBefore = loadAllEntries(fileName, readThreads);
+            const double scanAfter = loadAllEntries(outFile, readThreads);
+            for (std::size_t n = 0; n < reports.size(); ++n) {
+                const auto& r = reports[n];
+                auto before = measureLocality(fileName, r.ntupleName, nLookups);
+                auto after = measureLocality(outFile, r.ntupleName, nLookups);
+                const double seconds = r.sortSeconds + r.mergeSeconds;
+                std::ostringstream ranges, lookup, scan, rss;
+                if (r.peakRssBytes > 0) rss << std::setprecision(4) << r.peakRssBytes / (1024.0 * 1024.0); else rss << "-";
+                ranges << std::fixed << std::setprecision(1) << before.rangesPerEvent << "->" << after.rangesPerEvent;
+                lookup << std::setprecision(3) << before.lookupSeconds << "->" << after.lookupSeconds;
+                if (n == 0) scan << std::setprecision(3) << scanBefore << "->" << scanAfter;
+                std::cout << std::left
+                          << std::setw(col1) << (stem + "/" + r.ntupleName + (r.sorted ? "" : " (copied)"))
+                          << std::setw(col3) << r.entries
+                          << std::setw(col2) << r.runs
+                          << std::setw(col2) << r.mergePasses
+                          << std::setw(col3) << rss.str()
+                          << std::setw(col2) << r.sortSeconds
+                          << std::setw(col2) << r.mergeSeconds
+                          << std::setw(col2) << (seconds > 0.0 ? r.bytes / (1024.0 * 1024.0) / seconds : 0.0)
+                          << std::setw(col3) << ranges.str()
+                          << std::setw(col3) << lookup.str()
+                          << std::setw(col3) << scan.str() << std::endl;
+            }
+        } catch (const std::exception& e) {
+            std::cout << std::left << std::setw(col1) << stem << "FAILED: " << e.what() << std::endl;
+            std::filesystem::remove(outFile);
+        }
+    }
+    std::cout << std::string(col1 + 5 * col2 + 5 * col3, '-') << std::endl;
+    std::cout << "Ranges/evt, Lookup and Scan are before->after; Scan reads the whole file once." << std::endl;
+    std::cout << "Peak RSS is the process high-water mark while compacting the ntuple (- if /proc cannot reset it)." << std::endl;
+}
@@ -0,0 +1,368 @@
+#include "EventIndex.hpp"
+#include "Utils.hpp"
+#include <ROOT/RNTupleDescriptor.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleWriter.hxx>
+#include <TFile.h>
+#include <TStopwatch.h>
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+
+bool gEmitEventIndex = false;
+const std::string kIndexSuffix = "_eventIndex";
+
+const std::string kRoisSuffix = "_rois";
+const std::string kWiresSuffix = "_wires";
+constexpr std::uint64_t kKeyChunk = 1 << 16; // keys read per readEventKeys call
+
+// Calls f(first, keys) for consecutive chunks of the key column, keys[i] being entry first + i
+template <typename F>
+void forEachKeyChunk(ROOT::RNTupleReader& reader, const EventKeyColumn& column, F&& f) {
+    const std::uint64_t nEntries = reader.GetNEntries();
+    std::vector<long long> keys;
+    for (std::uint64_t first = 0; first < nEntries; first += kKeyChunk) {
+        const std::uint64_t last = std::min(nEntries, first + kKeyChunk);
+        keys.resize(last - first);
+        readEventKeys(reader, column, first, last, keys.data());
+        f(first, keys);
+    }
+}
+
+std::string eventIdType(ROOT::RNTupleReader& reader, const std::string& field) {
+    const auto& desc = reader.GetDescriptor();
+    return desc.GetFieldDescriptor(desc.FindFieldId(field)).GetTypeName();
+}
+
+template <typename T>
+void readKeys(ROOT::RNTupleReader& reader, const EventKeyColumn& column, std::uint64_t first, std::uint64_t last, long long* out) {
+    auto view = reader.GetView<T>(column.field);
+    if (column.collection.empty()) {
+        for (auto i = first; i < last; ++i) out[i - first] = static_cast<long long>(view(i));
+        return;
+    }
+    auto items = reader.GetCollectionView(column.collection);
+    for (auto i = first; i < last; ++i) {
+        auto range = items.GetCollectionRange(i);
+        out[i - first] = range.size() == 0 ? kNoEventKey : static_cast<long long>(view(*range.begin()));
+    }
+}
+
+// Depth-first through records for the first collection whose items carry the EventID:
+// vector<Hit> "hits" -> "hits._0.EventID", SOA vector<long long> "hits.EventIDs" -> "hits.EventIDs._0"
+bool findCollectionKey(const ROOT::RNTupleDescriptor& desc, ROOT::DescriptorId_t parentId, const std::string& prefix,
+                       EventKeyColumn& column) {
+    for (const auto& field : desc.GetFieldIterable(parentId)) {
+        const std::string path = prefix.empty() ? field.GetFieldName() : prefix + "." + field.GetFieldName();
+        if (field.GetStructure() == ROOT::ENTupleStructure::kCollection) {
+            auto itemId = desc.FindFieldId("_0", field.GetId());
+            if (itemId == ROOT::kInvalidDescriptorId) continue;
+            if (field.GetFieldName() == "EventIDs") {
+                column.collection = path;
+                column.field = path + "._0";
+                return true;
+            }
+            if (desc.FindFieldId("EventID", itemId) != ROOT::kInvalidDescriptorId) {
+                column.collection = path;
+                column.field = path + "._0.EventID";
+                return true;
+            }
+        } else if (field.GetStructure() == ROOT::ENTupleStructure::kRecord) {
+            if (findCollectionKey(desc, field.GetId(), path, column)) return true;
+        }
+    }
+    return false;
+}
+
+double percentile(std::vector<double> values, double q) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    std::size_t idx = static_cast<std::size_t>(q * (values.size() - 1) + 0.5);
+    return values[std::min(idx, values.size() - 1)];
+}
+
+} // namespace
+
+std::string eventIndexName(const std::string& ntupleName) {
+    return ntupleName + kIndexSuffix;
+}
+
+bool isEventIndexName(const std::string& ntupleName) {
+    return ntupleName.size() > kIndexSuffix.size() &&
+           ntupleName.compare(ntupleName.size() - kIndexSuffix.size(), kIndexSuffix.size(), kIndexSuffix) == 0;
+}
+
+void setEmitEventIndex(bool enabled) {
+    gEmitEventIndex = enabled;
+}
+
+bool getEmitEventIndex() {
+    return gEmitEventIndex;
+}
+
+std::string findEventIdField(ROOT::RNTupleReader& reader) {
+    return Utils::find_record_subfield(reader, "EventID");
+}
+
+bool findEventKeyColumn(ROOT::RNTupleReader& reader, EventKeyColumn& column) {
+    column.collection.clear();
+    const auto& desc = reader.GetDescriptor();
+    if (desc.FindFieldId("EventID") != ROOT::kInvalidDescriptorId) {
+        column.field = "EventID";
+        return true;
+    }
+    column.field = findEventIdField(reader);
+    if (!column.field.empty()) return true;
+    return findCollectionKey(desc, desc.GetFieldZeroId(), "", column);
+}
+
+void readEventKeys(ROOT::RNTupleReader& reader, const EventKeyColumn& column, std::uint64_t first, std::uint64_t last, long long* out) {
+    const std::string type = eventIdType(reader, column.field);
+    if (type == "std::int64_t") {
+        readKeys<std::int64_t>(reader, column, first, last, out);
+    } else if (type == "std::uint64_t") {
+        readKeys<std::uint64_t>(reader, column, first, last, out);
+    } else if (type == "std::int32_t") {
+        readKeys<std::int32_t>(reader, column, first, last, out);
+    } else if (type == "std::uint32_t") {
+        readKeys<std::uint32_t>(reader, column, first, last, out);
+    } else {
+        throw std::runtime_error("unsupported EventID type '" + type + "' in field " + column.field);
+    }
+}
+
+std::vector<EventEntryRange> sortEventRanges(std::vector<EventEntryRange> ranges) {
+    std::sort(ranges.begin(), ranges.end(), [](const EventEntryRange& a, const EventEntryRange& b) {
+        return std::tie(a.eventId, a.firstEntry) < std::tie(b.eventId, b.firstEntry);
+    });
+    std::vector<EventEntryRange> merged;
+    for (const auto& r : ranges) {
+        if (r.nEntries == 0) continue;
+        if (!merged.empty() && merged.back().eventId == r.eventId &&
+            merged.back().firstEntry + merged.back().nEntries == r.firstEntry) {
+            merged.back().nEntries += r.nEntries;
+        } else {
+            merged.push_back(r);
+        }
+    }
+    return merged;
+}
+
+std::vector<EventEntryRange> scanEventRanges(ROOT::RNTupleReader& reader, const EventKeyColumn& column) {
+    std::vector<EventEntryRange> runs;
+    forEachKeyChunk(reader, column, [&](std::uint64_t first, const std::vector<long long>& keys) {
+        for (std::size_t k = 0; k < keys.size(); ++k) {
+            const long long id = keys[k];
+            const std::uint64_t i = first + k;
+            if (id == kNoEventKey) continue;
+            if (!runs.empty() && runs.back().eventId == id && runs.back().firstEntry + runs.back().nEntries == i) {
+                ++runs.back().nEntries;
+            } else {
+                runs.push_back({id, i, 1});
+            }
+        }
+    });
+    return sortEventRanges(std::move(runs));
+}
+
+std::string findParallelKeyNtuple(const std::string& ntupleName, const std::vector<std::string>& ntuples) {
+    if (ntupleName.size() <= kRoisSuffix.size() ||
+        ntupleName.compare(ntupleName.size() - kRoisSuffix.size(), kRoisSuffix.size(), kRoisSuffix) != 0) {
+        return "";
+    }
+    std::string wires = ntupleName.substr(0, ntupleName.size() - kRoisSuffix.size()) + kWiresSuffix;
+    return std::find(ntuples.begin(), ntuples.end(), wires) != ntuples.end() ? wires : "";
+}
+
+EventIndexReport writeEventIndexes(const std::string& fileName) {
+    EventIndexReport report;
+    TStopwatch sw; sw.Start();
+
+    // Scan everything first; the file is reopened for update only once the readers are gone
+    auto names = Utils::list_ntuples(fileName);
+    std::map<std::string, std::vector<EventEntryRange>> indexes;
+    for (const auto& name : names) {
+        if (isEventIndexName(name)) continue;
+        if (std::find(names.begin(), names.end(), eventIndexName(name)) != names.end()) continue;
+        auto reader = ROOT::RNTupleReader::Open(name, fileName);
+        EventKeyColumn column;
+        if (findEventKeyColumn(*reader, column)) {
+            indexes[name] = scanEventRanges(*reader, column);
+            continue;
+        }
+        // No EventID at all: entry i belongs to the event of entry i of the parallel ntuple
+        const std::string parallel = findParallelKeyNtuple(name, names);
+        if (parallel.empty()) continue;
+        auto keyReader = ROOT::RNTupleReader::Open(parallel, fileName);
+        if (keyReader->GetNEntries() != reader->GetNEntries()) {
+            throw std::runtime_error(name + " has " + std::to_string(reader->GetNEntries()) + " entries but its parallel ntuple " +
+                                     parallel + " has " + std::to_string(keyReader->GetNEntries()));
+        }
+        if (!findEventKeyColumn(*keyReader, column)) continue;
+        indexes[name] = scanEventRanges(*keyReader, column);
+    }
+
+    if (!indexes.empty()) {
+        std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "UPDATE"));
+        if (!file || file->IsZombie()) throw std::runtime_error("cannot update " + fileName);
+        for (const auto& [name, ranges] : indexes) {
+            auto model = ROOT::RNTupleModel::Create();
+            auto eventId = model->MakeField<long long>("EventID");
+            auto firstEntry = model->MakeField<std::uint64_t>("firstEntry");
+            auto nEntries = model->MakeField<std::uint32_t>("nEntries");
+            auto writer = ROOT::RNTupleWriter::Append(std::move(model), eventIndexName(name), *file);
+            for (const auto& r : ranges) {
+                *eventId = r.eventId;
+                *firstEntry = r.firstEntry;
+                *nEntries = r.nEntries;
+                writer->Fill();
+            }
+            ++report.ntuples;
+            report.ranges += ranges.size();
+        }
+    }
+    sw.Stop();
+    report.seconds = sw.RealTime();
+    return report;
+}
+
+EventIndex::EventIndex(std::vector<EventEntryRange> ranges) : fRanges(sortEventRanges(std::move(ranges))) {}
+
+EventIndex EventIndex::load(const std::string& fileName, const std::string& ntupleName) {
+    auto reader = ROOT::RNTupleReader::Open(eventIndexName(ntupleName), fileName);
+    auto eventId = reader->GetView<long long>("EventID");
+    auto firstEntry = reader->GetView<std::uint64_t>("firstEntry");
+    auto nEntries = reader->GetView<std::uint32_t>("nEntries");
+    std::vector<EventEntryRange> ranges;
+    ranges.reserve(reader->GetNEntries());
+    for (auto i : reader->GetEntryRange()) {
+        ranges.push_back({eventId(i), firstEntry(i), nEntries(i)});
+    }
+    return EventIndex(std::move(ranges));
+}
+
+std::vector<std::pair<std::uint64_t, std::uint64_t>> EventIndex::lookup(long long eventId) const {
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> result;
+    auto it = std::lower_bound(fRanges.begin(), fRanges.end(), eventId,
+                               [](const EventEntryRange& r, long long id) { return r.eventId < id; });
+    for (; it != fRanges.end() && it->eventId == eventId; ++it) {
+        result.emplace_back(it->firstEntry, it->firstEntry + it->nEntries);
+    }
+    return result;
+}
+
+EventLookup::EventLookup(const std::string& fileName) {
+    auto names = Utils::list_ntuples(fileName);
+    for (const auto& name : names) {
+        if (isEventIndexName(name)) continue;
+        if (std::find(names.begin(), names.end(), eventIndexName(name)) == names.end()) continue;
+        Indexed indexed;
+        indexed.reader = ROOT::RNTupleReader::Open(name, fileName);
+        indexed.index = EventIndex::load(fileName, name);
+        if (!findEventKeyColumn(*indexed.reader, indexed.key)) {
+            const std::string parallel = findParallelKeyNtuple(name, names);
+            if (!parallel.empty()) {
+                indexed.keyReader = ROOT::RNTupleReader::Open(parallel, fileName);
+                if (!findEventKeyColumn(*indexed.keyReader, indexed.key)) indexed.keyReader.reset();
+            }
+        }
+        fNames.push_back(name);
+        fNtuples.push_back(std::move(indexed));
+    }
+}
+
+std::size_t EventLookup::fetch(long long eventId) {
+    std::size_t loaded = 0;
+    for (auto& n : fNtuples) {
+        for (const auto& [first, last] : n.index.lookup(eventId)) {
+            for (auto i = first; i < last; ++i) n.reader->LoadEntry(i);
+            loaded += last - first;
+        }
+    }
+    return loaded;
+}
+
+std::size_t EventLookup::fetchByScan(long long eventId) {
+    std::size_t loaded = 0;
+    for (auto& n : fNtuples) {
+        if (n.key.field.empty()) continue;
+        auto& keyReader = n.keyReader ? *n.keyReader : *n.reader;
+        forEachKeyChunk(keyReader, n.key, [&](std::uint64_t first, const std::vector<long long>& keys) {
+            for (std::size_t k = 0; k < keys.size(); ++k) {
+                if (keys[k] != eventId) continue;
+                n.reader->LoadEntry(first + k);
+                ++loaded;
+            }
+        });
+    }
+    return loaded;
+}
+
+void benchmarkEventLookup(const std::vector<std::string>& files, int numEvents, int nLookups) {
+    const int col1 = 28, col2 = 10, col3 = 14;
+    const int nScans = std::min(nLookups, 3);
+    std::cout << "\nRandom Event Lookup (" << nLookups << " lookups, latency in ms)" << std::endl;
+    std::cout << std::left
+              << std::setw(col1) << "File"
+              << std::setw(col2) << "Ntuples"
+              << std::setw(col2) << "Entries"
+              << std::setw(col2) << "Avg"
+              << std::setw(col2) << "P50"
+              << std::setw(col2) << "P99"
+              << std::setw(col3) << "Scan avg"
+              << std::setw(col2) << "Speedup" << std::endl;
+    std::cout << std::string(col1 + 6 * col2 + col3, '-') << std::endl;
+
+    for (const auto& fileName : files) {
+        if (!std::filesystem::exists(fileName)) continue;
+        const std::string label = std::filesystem::path(fileName).stem().string();
+        std::cout << std::left << std::setw(col1) << label;
+        try {
+            EventLookup lookup(fileName);
+            if (lookup.ntuples().empty()) {
+                std::cout << "not indexed (no EventID)" << std::endl;
+                continue;
+            }
+            std::mt19937 rng(42);
+            std::uniform_int_distribution<long long> pick(0, std::max(0, numEvents - 1));
+            std::vector<double> latencies;
+            std::size_t entries = 0;
+            for (int i = 0; i < nLookups; ++i) {
+                long long id = pick(rng);
+                TStopwatch sw; sw.Start();
+                entries += lookup.fetch(id);
+                sw.Stop();
+                latencies.push_back(sw.RealTime() * 1000.0);
+            }
+            double scanTotal = 0.0;
+            for (int i = 0; i < nScans; ++i) {
+                long long id = pick(rng);
+                TStopwatch sw; sw.Start();
+                lookup.fetchByScan(id);
+                sw.Stop();
+                scanTotal += sw.RealTime() * 1000.0;
+            }
+            double avg = 0.0;
+            for (double l : latencies) avg += l;
+            avg = latencies.empty() ? 0.0 : avg / latencies.size();
+            double scanAvg = nScans > 0 ? scanTotal / nScans : 0.0;
+            std::cout << std::setw(col2) << lookup.ntuples().size()
+                      << std::setw(col2) << (nLookups > 0 ? entries / nLookups : 0)
+                      << std::setw(col2) << avg
+                      << std::setw(col2) << percentile(latencies, 0.5)
+                      << std::setw(col2) << percentile(latencies, 0.99)
+                      << std::setw(col3) << scanAvg
+                      << std::setw(col2) << (avg > 0.0 ? scanAvg / avg : 0.0) << std::endl;
+        } catch (const std::exception& e) {
+            std::cout << "FAILED: " << e.what() << std::endl;
+        }
+    }
+    std::cout << std::string(col1 + 6 * col2 + col3, '-') << std::endl;
+}
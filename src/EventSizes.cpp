@@ -0,0 +1,165 @@
+#include "EventSizes.hpp"
+#include "Utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+EventSizeConfig gEventSizes;
+
+constexpr std::size_t kROISamples = 10; // nominal ROI length of all generators
+constexpr int kTailCap = 8;             // distribution tails are cut at 8x nominal
+
+std::vector<std::string> split(const std::string& s, char sep) {
+    std::vector<std::string> parts;
+    std::stringstream ss(s);
+    std::string part;
+    while (std::getline(ss, part, sep)) parts.push_back(part);
+    return parts;
+}
+
+double parseNumber(const std::string& token, const std::string& value) {
+    try {
+        std::size_t used = 0;
+        double v = std::stod(value, &used);
+        if (used == value.size()) return v;
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument("invalid number '" + value + "' in event size token '" + token + "'");
+}
+
+int clampCount(double value, int nominal, int scale) {
+    return static_cast<int>(std::clamp(std::lround(value), 0L, static_cast<long>(nominal) * scale));
+}
+
+} // namespace
+
+EventSizeConfig parseEventSizeSpec(const std::string& spec) {
+    EventSizeConfig config;
+    for (const auto& token : split(spec, ',')) {
+        const auto parts = split(token, ':');
+        if (parts.empty()) continue;
+        const std::string& name = parts[0];
+        if (name == "fixed" && parts.size() == 1) {
+            config.distribution = SizeDistribution::Fixed;
+        } else if (name == "poisson" && parts.size() == 1) {
+            config.distribution = SizeDistribution::Poisson;
+        } else if (name == "lognormal" && parts.size() <= 2) {
+            config.distribution = SizeDistribution::LogNormal;
+            if (parts.size() == 2) config.sigma = parseNumber(token, parts[1]);
+            if (config.sigma <= 0.0) throw std::invalid_argument("lognormal sigma must be positive");
+        } else if (name == "huge" && (parts.size() == 2 || parts.size() == 3)) {
+            config.hugeFraction = parseNumber(token, parts[1]);
+            if (parts.size() == 3) config.hugeFactor = parseNumber(token, parts[2]);
+            if (config.hugeFraction < 0.0 || config.hugeFraction > 1.0 || config.hugeFactor < 1.0) {
+                throw std::invalid_argument("huge needs a fraction in [0, 1] and a factor >= 1");
+            }
+        } else if (name == "roilen" && parts.size() <= 2) {
+            config.roiLengthSigma = parts.size() == 2 ? parseNumber(token, parts[1]) : 0.5;
+            if (config.roiLengthSigma <= 0.0) throw std::invalid_argument("roilen sigma must be positive");
+        } else {
+            throw std::invalid_argument("unknown event size token '" + token +
+                                        "' (expected fixed, poisson, lognormal[:sigma], huge:fraction[:factor], roilen[:sigma])");
+        }
+    }
+    return config;
+}
+
+std::string describeEventSizeConfig(const EventSizeConfig& config) {
+    std::ostringstream os;
+    switch (config.distribution) {
+        case SizeDistribution::Fixed: os << "fixed"; break;
+        case SizeDistribution::Poisson: os << "poisson"; break;
+        case SizeDistribution::LogNormal: os << "lognormal(sigma=" << config.sigma << ")"; break;
+    }
+    if (config.hugeFraction > 0.0) os << " huge(" << config.hugeFraction * 100.0 << "% x" << config.hugeFactor << ")";
+    if (config.roiLengthSigma > 0.0) os << " roilen(sigma=" << config.roiLengthSigma << ")";
+    return os.str();
+}
+
+void setEventSizeConfig(const EventSizeConfig& config) {
+    gEventSizes = config;
+}
+
+const EventSizeConfig& getEventSizeConfig() {
+    return gEventSizes;
+}
+
+int maxEventScale() {
+    int scale = gEventSizes.distribution == SizeDistribution::Fixed ? 1 : kTailCap;
+    if (gEventSizes.hugeFraction > 0.0) scale *= static_cast<int>(std::ceil(gEventSizes.hugeFactor));
+    return scale;
+}
+
+double meanEventScale() {
+    return 1.0 + gEventSizes.hugeFraction * (gEventSizes.hugeFactor - 1.0);
+}
+
+EventSize maxEventSize(int hitsPerEvent, int wiresPerEvent, int roisPerWire) {
+    const int scale = maxEventScale();
+    const int roiScale = gEventSizes.distribution == SizeDistribution::Fixed ? 1 : kTailCap;
+    return {hitsPerEvent * scale, wiresPerEvent * scale, roisPerWire * roiScale};
+}
+
+EventSize eventSize(long long eventID, int hitsPerEvent, int wiresPerEvent, int roisPerWire) {
+    const auto& config = gEventSizes;
+    if (config.distribution == SizeDistribution::Fixed && config.hugeFraction <= 0.0) {
+        return {hitsPerEvent, wiresPerEvent, roisPerWire};
+    }
+    std::mt19937 rng(Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('S'), static_cast<std::uint64_t>(eventID)));
+    double hits = hitsPerEvent, wires = wiresPerEvent, rois = roisPerWire;
+    auto poisson = [&rng](double mean) { return mean > 0.0 ? std::poisson_distribution<int>(mean)(rng) : 0; };
+    if (config.distribution == SizeDistribution::Poisson) {
+        hits = poisson(hits);
+        wires = poisson(wires);
+        rois = poisson(rois);
+    } else if (config.distribution == SizeDistribution::LogNormal) {
+        // mu = -sigma^2 / 2 keeps the mean at the nominal count
+        std::lognormal_distribution<double> distScale(-0.5 * config.sigma * config.sigma, config.sigma);
+        const double activity = distScale(rng);
+        hits *= activity;
+        wires *= activity;
+        rois *= distScale(rng);
+    }
+    // A huge event has more hits and wires, not longer wires
+    if (config.hugeFraction > 0.0 && std::uniform_real_distribution<double>(0.0, 1.0)(rng) < config.hugeFraction) {
+        hits *= config.hugeFactor;
+        wires *= config.hugeFactor;
+    }
+    const EventSize cap = maxEventSize(1, 1, 1);
+    return {clampCount(hits, hitsPerEvent, cap.hits), clampCount(wires, wiresPerEvent, cap.wires),
+            clampCount(rois, roisPerWire, cap.roisPerWire)};
+}
+
+std::size_t maxROILength() {
+    return gEventSizes.roiLengthSigma > 0.0 ? kROISamples * kTailCap : kROISamples;
+}
+
+std::size_t drawROILength(std::mt19937& rng) {
+    const double sigma = gEventSizes.roiLengthSigma;
+    if (sigma <= 0.0) return kROISamples;
+    std::lognormal_distribution<double> distLength(-0.5 * sigma * sigma, sigma);
+    const long length = std::lround(kROISamples * distLength(rng));
+    return static_cast<std::size_t>(std::clamp(length, 1L, static_cast<long>(maxROILength())));
+}
+
+double meanROILength() {
+    const double sigma = gEventSizes.roiLengthSigma;
+    if (sigma <= 0.0) return static_cast<double>(kROISamples);
+    // Integrate the clamped length over the standard normal behind the log-normal
+    const double lo = 1.0, hi = static_cast<double>(maxROILength());
+    const int steps = 4000;
+    const double range = 8.0;
+    double sum = 0.0, weight = 0.0;
+    for (int i = 0; i <= steps; ++i) {
+        const double z = -range + 2.0 * range * i / steps;
+        const double w = std::exp(-0.5 * z * z);
+        const double length = kROISamples * std::exp(sigma * z - 0.5 * sigma * sigma);
+        sum += w * std::clamp(length, lo, hi);
+        weight += w;
+    }
+    return sum / weight;
+}
@@ -0,0 +1,364 @@
+#include "FlatColumns.hpp"
+#include "ClusterTargeting.hpp"
+#include "EventSizes.hpp"
+#include "HitWireWriterHelpers.hpp"
+#include "HitWireWriters.hpp"
+#include "JoinReader.hpp"
+#include "LayoutConverter.hpp"
+#include <TStopwatch.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace {
+
+// Column indices, in the order of flatColumns()
+enum Column : std::size_t {
+    EventID, EventHitsEnd, EventWiresEnd,
+    HitChannel, HitView, HitStartTick, HitEndTick, HitPeakTime, HitSigmaPeakTime, HitRMS, HitPeakAmplitude,
+    HitSigmaPeakAmplitude, HitROISummedADC, HitHitSummedADC, HitIntegral, HitSigmaIntegral, HitMultiplicity,
+    HitLocalIndex, HitGoodnessOfFit, HitNDF, HitSignalType, HitWireCryostat, HitWireTPC, HitWirePlane, HitWireWire,
+    WireChannel, WireView, WireROIsEnd,
+    ROIOffset, ROISamplesEnd,
+    SampleData,
+    NumColumns
+};
+
+// Offset columns describe the structure; they differ with the number of parts
+bool isOffsetColumn(std::size_t c) {
+    return c == EventHitsEnd || c == EventWiresEnd || c == WireROIsEnd || c == ROISamplesEnd;
+}
+
+constexpr std::size_t kFlushBytes = 4 << 20; // buffered per part before it goes to the files
+
+std::string columnPath(const std::string& directory, std::size_t column, int part) {
+    return directory + "/" + flatColumns()[column].name + "_" + std::to_string(part) + ".bin";
+}
+
+// One part: a buffer and an output file per column
+class PartWriter {
+public:
+    PartWriter(const std::string& directory, int part) : buffers_(NumColumns), files_(NumColumns) {
+        for (std::size_t c = 0; c < NumColumns; ++c) {
+            files_[c].open(columnPath(directory, c, part), std::ios::binary | std::ios::trunc);
+            if (!files_[c]) throw std::runtime_error("cannot create " + columnPath(directory, c, part));
+        }
+    }
+
+    template <typename T>
+    void put(Column c, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto* p = reinterpret_cast<const char*>(&value);
+        buffers_[c].insert(buffers_[c].end(), p, p + sizeof(T));
+        buffered_ += sizeof(T);
+    }
+
+    void putSamples(const std::vector<float>& data) {
+        const auto* p = reinterpret_cast<const char*>(data.data());
+        buffers_[SampleData].insert(buffers_[SampleData].end(), p, p + data.size() * sizeof(float));
+        buffered_ += data.size() * sizeof(float);
+    }
+
+    void flush(bool force) {
+        if (!force && buffered_ < kFlushBytes) return;
+        for (std::size_t c = 0; c < NumColumns; ++c) {
+            files_[c].write(buffers_[c].data(), static_cast<std::streamsize>(buffers_[c].size()));
+            if (!files_[c]) throw std::runtime_error(std::string("writing column ") + flatColumns()[c].name + " failed");
+            buffers_[c].clear();
+        }
+        buffered_ = 0;
+    }
+
+    void close() {
+        flush(true);
+        for (auto& file : files_) file.close();
+    }
+
+private:
+    std::vector<std::vector<char>> buffers_;
+    std::vector<std::ofstream> files_;
+    std::size_t buffered_ = 0;
+};
+
+void writePart(const std::string& directory, int part, int first, int last, int hitsPerEvent, int wiresPerEvent,
+               int roisPerWire) {
+    PartWriter out(directory, part);
+    std::uint64_t hitsEnd = 0, wiresEnd = 0, roisEnd = 0, samplesEnd = 0;
+    for (int evt = first; evt < last; ++evt) {
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
+        for (const auto& h : generateEventHitsDeterministic(evt, size.hits)) {
+            out.put(HitChannel, h.fChannel);
+            out.put(HitView, h.fView);
+            out.put(HitStartTick, h.fStartTick);
+            out.put(HitEndTick, h.fEndTick);
+            out.put(HitPeakTime, h.fPeakTime);
+            out.put(HitSigmaPeakTime, h.fSigmaPeakTime);
+            out.put(HitRMS, h.fRMS);
+            out.put(HitPeakAmplitude, h.fPeakAmplitude);
+            out.put(HitSigmaPeakAmplitude, h.fSigmaPeakAmplitude);
+            out.put(HitROISummedADC, h.fROISummedADC);
+            out.put(HitHitSummedADC, h.fHitSummedADC);
+            out.put(HitIntegral, h.fIntegral);
+            out.put(HitSigmaIntegral, h.fSigmaIntegral);
+            out.put(HitMultiplicity, h.fMultiplicity);
+            out.put(HitLocalIndex, h.fLocalIndex);
+            out.put(HitGoodnessOfFit, h.fGoodnessOfFit);
+            out.put(HitNDF, h.fNDF);
+            out.put(HitSignalType, h.fSignalType);
+            out.put(HitWireCryostat, h.fWireID_Cryostat);
+            out.put(HitWireTPC, h.fWireID_TPC);
+            out.put(HitWirePlane, h.fWireID_Plane);
+            out.put(HitWireWire, h.fWireID_Wire);
+            ++hitsEnd;
+        }
+        for (const auto& w : generateEventWiresDeterministic(evt, size.wires, size.roisPerWire)) {
+            out.put(WireChannel, w.fWire_Channel);
+            out.put(WireView, w.fWire_View);
+            for (const auto& roi : w.getSignalROI()) {
+                out.put(ROIOffset, static_cast<std::uint64_t>(roi.offset));
+                out.putSamples(roi.data);
+                samplesEnd += roi.data.size();
+                out.put(ROISamplesEnd, samplesEnd);
+                ++roisEnd;
+            }
+            out.put(WireROIsEnd, roisEnd);
+            ++wiresEnd;
+        }
+        out.put(EventID, static_cast<std::int64_t>(evt));
+        out.put(EventHitsEnd, hitsEnd);
+        out.put(EventWiresEnd, wiresEnd);
+        out.flush(false);
+    }
+    out.close();
+}
+
+std::vector<char> readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) throw std::runtime_error("cannot open " + path);
+    std::vector<char> data(static_cast<std::size_t>(in.tellg()));
+    in.seekg(0);
+    in.read(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!in) throw std::runtime_error("cannot read " + path);
+    return data;
+}
+
+std::uint64_t lastOffset(const std::vector<char>& column) {
+    std::uint64_t v = 0;
+    if (column.size() >= sizeof(v)) std::memcpy(&v, column.data() + column.size() - sizeof(v), sizeof(v));
+    return v;
+}
+
+// Reads one part; columnSums gets the sum of the raw values of each column
+FlatColumnsStats readPart(const std::string& directory, int part, std::vector<std::uint64_t>& columnSums) {
+    const auto& columns = flatColumns();
+    std::vector<std::vector<char>> data(NumColumns);
+    std::vector<std::uint64_t> counts(NumColumns);
+    FlatColumnsStats stats;
+    for (std::size_t c = 0; c < NumColumns; ++c) {
+        data[c] = readFile(columnPath(directory, c, part));
+        if (data[c].size() % columns[c].width != 0) {
+            throw std::runtime_error(std::string("truncated column ") + columns[c].name + " in part " + std::to_string(part));
+        }
+        counts[c] = data[c].size() / columns[c].width;
+        stats.bytes += data[c].size();
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < data[c].size(); i += columns[c].width) {
+            std::uint64_t v = 0;
+            std::memcpy(&v, data[c].data() + i, columns[c].width);
+            sum += v;
+        }
+        columnSums[c] = sum;
+    }
+
+    auto expectCount = [&](std::size_t first, std::size_t last, std::uint64_t count, const char* what) {
+        for (std::size_t c = first; c <= last; ++c) {
+            if (counts[c] != count) {
+                throw std::runtime_error(std::string("column ") + columns[c].name + " of part " + std::to_string(part) +
+                                         " does not match the number of " + what);
+            }
+        }
+    };
+    stats.events = counts[EventID];
+    stats.hits = lastOffset(data[EventHitsEnd]);
+    stats.wires = lastOffset(data[EventWiresEnd]);
+    stats.rois = lastOffset(data[WireROIsEnd]);
+    stats.samples = lastOffset(data[ROISamplesEnd]);
+    expectCount(EventID, EventWiresEnd, stats.events, "events");
+    expectCount(HitChannel, HitWireWire, stats.hits, "hits");
+    expectCount(WireChannel, WireROIsEnd, stats.wires, "wires");
+    expectCount(ROIOffset, ROISamplesEnd, stats.rois, "ROIs");
+    expectCount(SampleData, SampleData, stats.samples, "samples");
+    return stats;
+}
+
+} // namespace
+
+const std::vector<FlatColumn>& flatColumns() {
+    static const std::vector<FlatColumn> columns = {
+        {"event_id", 8}, {"event_hits_end", 8}, {"event_wires_end", 8},
+        {"hit_channel", 4}, {"hit_view", 4}, {"hit_start_tick", 4}, {"hit_end_tick", 4}, {"hit_peak_time", 4},
+        {"hit_sigma_peak_time", 4}, {"hit_rms", 4}, {"hit_peak_amplitude", 4}, {"hit_sigma_peak_amplitude", 4},
+        {"hit_roi_summed_adc", 4}, {"hit_hit_summed_adc", 4}, {"hit_integral", 4}, {"hit_sigma_integral", 4},
+        {"hit_multiplicity", 2}, {"hit_local_index", 2}, {"hit_goodness_of_fit", 4}, {"hit_ndf", 4},
+        {"hit_signal_type", 4}, {"hit_wire_cryostat", 4}, {"hit_wire_tpc", 4}, {"hit_wire_plane", 4},
+        {"hit_wire_wire", 4},
+        {"wire_channel", 4}, {"wire_view", 4}, {"wire_rois_end", 8},
+        {"roi_offset", 8}, {"roi_samples_end", 8},
+        {"sample_data", 4},
+    };
+    return columns;
+}
+
+FlatColumnsStats writeFlatColumns(const std::string& directory, int numEvents, int hitsPerEvent, int wiresPerEvent,
+                                  int roisPerWire, int nThreads) {
+    std::filesystem::create_directories(directory);
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if (entry.path().extension() == ".bin") std::filesystem::remove(entry.path());
+    }
+
+    // Same event split as the other writers: contiguous ranges, the last one takes the rest
+    nThreads = std::max(1, nThreads);
+    const int chunk = numEvents / nThreads;
+    std::vector<std::future<void>> futures;
+    int parts = 0;
+    for (int th = 0; th < nThreads; ++th) {
+        const int first = th * chunk;
+        const int last = (th == nThreads - 1) ? numEvents : first + chunk;
+        if (first >= last) continue;
+        futures.push_back(std::async(std::launch::async, [&, first, last, part = parts]() {
+            writePart(directory, part, first, last, hitsPerEvent, wiresPerEvent, roisPerWire);
+        }));
+        ++parts;
+    }
+    for (auto& f : futures) f.get();
+
+    FlatColumnsStats stats;
+    for (int part = 0; part < parts; ++part) {
+        for (std::size_t c = 0; c < NumColumns; ++c) stats.bytes += std::filesystem::file_size(columnPath(directory, c, part));
+    }
+    return stats;
+}
+
+FlatColumnsStats readFlatColumns(const std::string& directory, int nThreads) {
+    int parts = 0;
+    while (std::filesystem::exists(columnPath(directory, EventID, parts))) ++parts;
+    if (parts == 0) throw std::runtime_error("no flat columns in " + directory);
+
+    std::vector<FlatColumnsStats> partStats(parts);
+    std::vector<std::vector<std::uint64_t>> partSums(parts, std::vector<std::uint64_t>(NumColumns));
+    const int workers = std::clamp(nThreads, 1, parts);
+    std::vector<std::future<void>> futures;
+    for (int th = 0; th < workers; ++th) {
+        futures.push_back(std::async(std::launch::async, [&, th]() {
+            for (int part = th; part < parts; part += workers) partStats[part] = readPart(directory, part, partSums[part]);
+        }));
+    }
+    for (auto& f : futures) f.get();
+
+    FlatColumnsStats stats;
+    std::vector<std::uint64_t> columnSums(NumColumns);
+    for (int part = 0; part < parts; ++part) {
+        stats.events += partStats[part].events;
+        stats.hits += partStats[part].hits;
+        stats.wires += partStats[part].wires;
+        stats.rois += partStats[part].rois;
+        stats.samples += partStats[part].samples;
+        stats.bytes += partStats[part].bytes;
+        for (std::size_t c = 0; c < NumColumns; ++c) columnSums[c] += partSums[part][c];
+    }
+    for (std::size_t c = 0; c < NumColumns; ++c) {
+        if (!isOffsetColumn(c)) stats.checksum = stats.checksum * 1099511628211ull + columnSums[c];
+    }
+    return stats;
+}
+
+void compareFlatColumns(int nThreads, int iter, int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire,
+                        int numSpills, int mask, bool runAOS, bool runSOA) {
+    const std::string outputDir = "./output_flat";
+    std::filesystem::create_directories(outputDir);
+    const WriteOptionOverrides savedOverrides = getWriteOptionOverrides();
+    WriteOptionOverrides uncompressed = savedOverrides;
+    uncompressed.compression = 0;
+
+    const int col1 = 28, col2 = 12;
+    std::cout << "\nRNTuple vs Flat Columns (wall-clock, " << nThreads << " threads, times in s, reads from page cache)"
+              << std::endl;
+    std::cout << std::left
+              << std::setw(col1) << "Layout"
+              << std::setw(col2) << "Write"
+              << std::setw(col2) << "Read"
+              << std::setw(col2) << "MB"
+              << std::setw(col2) << "Write ev/s"
+              << std::setw(col2) << "Write x"
+              << std::setw(col2) << "Read x"
+              << std::setw(col2) << "Size x" << std::endl;
+    std::cout << std::string(col1 + 7 * col2, '-') << std::endl;
+
+    double flatWrite = 0.0, flatRead = 0.0, flatMB = 0.0;
+    auto printRow = [&](double write, double read, double mb) {
+        std::cout << std::setw(col2) << write
+                  << std::setw(col2) << read
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(col2) << mb
+                  << std::setprecision(0)
+                  << std::setw(col2) << (write > 0.0 ? numEvents / write : 0.0)
+                  << std::setprecision(2)
+                  << std::setw(col2) << (flatWrite > 0.0 ? write / flatWrite : 0.0)
+                  << std::setw(col2) << (flatRead > 0.0 ? read / flatRead : 0.0)
+                  << std::setw(col2) << (flatMB > 0.0 ? mb / flatMB : 0.0) << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setprecision(6);
+    };
+
+    std::cout << std::left << std::setw(col1) << "flat_columns" << std::flush;
+    try {
+        const std::string flatDir = outputDir + "/flat_columns";
+        for (int it = 0; it < iter; ++it) {
+            TStopwatch sw; sw.Start();
+            const auto written = writeFlatColumns(flatDir, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, nThreads);
+            sw.Stop();
+            flatWrite += sw.RealTime() / iter;
+            sw.Start();
+            const auto read = readFlatColumns(flatDir, nThreads);
+            sw.Stop();
+            flatRead += sw.RealTime() / iter;
+            if (read.events != static_cast<std::uint64_t>(numEvents)) throw std::runtime_error("event count mismatch");
+            flatMB = written.bytes / (1024.0 * 1024.0);
+        }
+        printRow(flatWrite, flatRead, flatMB);
+    } catch (const std::exception& e) {
+        std::cout << "FAILED: " << e.what() << std::endl;
+        flatWrite = flatRead = flatMB = 0.0;
+    }
+
+    forEachSelectedLayout(mask, runAOS, runSOA, [&](const StorageLayout& layout) {
+        const std::string name = storageLayoutName(layout);
+        const std::string fileName = outputDir + "/" + name + ".root";
+        for (bool raw : {false, true}) {
+            std::cout << std::left << std::setw(col1) << (raw ? name + " raw" : name) << std::flush;
+            try {
+                setWriteOptionOverrides(raw ? uncompressed : savedOverrides);
+                double write = 0.0, read = 0.0;
+                for (int it = 0; it < iter; ++it) {
+                    TStopwatch sw; sw.Start();
+                    writeLayout(name, numEvents, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire, fileName, nThreads);
+                    sw.Stop();
+                    write += sw.RealTime() / iter;
+                    read += loadAllEntries(fileName, nThreads) / iter;
+                }
+                setWriteOptionOverrides(savedOverrides);
+                printRow(write, read, std::filesystem::file_size(fileName) / (1024.0 * 1024.0));
+            } catch (const std::exception& e) {
+                setWriteOptionOverrides(savedOverrides);
+                std::cout << "FAILED: " << e.what() << std::endl;
+            }
+        }
+    });
+    std::cout << std::string(col1 + 7 * col2, '-') << std::endl;
+}
@@ -1,6 +1,166 @@
 #include "HitWireGenerators.hpp"
 #include "Wire.hpp"
+#include "Utils.hpp"
+#include "EventSizes.hpp"
+#include <algorithm>
+#include <cmath>
 #include <random>
+#include <stdexcept>
+
+namespace {
+
+GeneratorMode gGeneratorMode = GeneratorMode::Uniform;
+
+// Physics mode detector: channel = (tpc * kPlanes + plane) * kWiresPerPlane + wire
+constexpr int kTPCs = 4;
+constexpr int kPlanes = 3; // planes 0 and 1 induction, 2 collection
+constexpr int kWiresPerPlane = 800;
+constexpr float kReadoutTicks = 6000.0f;
+constexpr float kNoiseADC = 2.5f;
+constexpr float kSqrt2Pi = 2.5066283f;
+
+int planeOf(unsigned int channel) {
+    return static_cast<int>(channel / kWiresPerPlane) % kPlanes;
+}
+
+bool isCollection(int plane) {
+    return plane == kPlanes - 1;
+}
+
+// Induction planes see about half the collection charge
+float drawAmplitude(int plane, std::mt19937& rng) {
+    std::gamma_distribution<float> distAmp(2.0f, 15.0f);
+    return distAmp(rng) * (isCollection(plane) ? 1.0f : 0.5f);
+}
+
+float drawWidth(std::mt19937& rng) {
+    std::gamma_distribution<float> distWidth(9.0f, 1.0f / 3.0f); // about 3 ticks
+    return std::max(0.5f, distWidth(rng));
+}
+
+HitIndividual generatePhysicsHit(long long eventID, std::mt19937& rng) {
+    std::uniform_int_distribution<int> distTPC(0, kTPCs - 1);
+    std::uniform_int_distribution<int> distPlane(0, kPlanes - 1);
+    std::uniform_int_distribution<int> distWire(0, kWiresPerPlane - 1);
+    std::uniform_real_distribution<float> distTime(50.0f, kReadoutTicks - 50.0f);
+    std::normal_distribution<float> distRel(0.0f, 1.0f);
+    std::discrete_distribution<int> distExtraHits({80, 15, 5});
+    std::gamma_distribution<float> distChi2(4.0f, 0.25f); // chi2/ndf around 1
+
+    HitIndividual hit;
+    const int tpc = distTPC(rng);
+    const int plane = distPlane(rng);
+    const int wire = distWire(rng);
+    hit.EventID = eventID;
+    hit.fChannel = static_cast<unsigned int>((tpc * kPlanes + plane) * kWiresPerPlane + wire);
+    hit.fView = plane;
+    hit.fPeakTime = distTime(rng);
+    hit.fRMS = drawWidth(rng);
+    hit.fPeakAmplitude = drawAmplitude(plane, rng);
+    hit.fStartTick = static_cast<int>(hit.fPeakTime - 3.0f * hit.fRMS);
+    hit.fEndTick = static_cast<int>(hit.fPeakTime + 3.0f * hit.fRMS) + 1;
+    hit.fSigmaPeakTime = hit.fRMS * kNoiseADC / (hit.fPeakAmplitude + kNoiseADC);
+    hit.fSigmaPeakAmplitude = kNoiseADC * (1.0f + 0.1f * std::abs(distRel(rng)));
+    hit.fIntegral = hit.fPeakAmplitude * hit.fRMS * kSqrt2Pi;
+    hit.fSigmaIntegral = kNoiseADC * std::sqrt(hit.fRMS * kSqrt2Pi);
+    hit.fHitSummedADC = hit.fIntegral * (1.0f + 0.02f * distRel(rng));
+    hit.fMultiplicity = static_cast<short>(1 + distExtraHits(rng));
+    hit.fLocalIndex = static_cast<short>(std::uniform_int_distribution<int>(0, hit.fMultiplicity - 1)(rng));
+    hit.fROISummedADC = hit.fHitSummedADC * hit.fMultiplicity * (1.0f + 0.05f * std::abs(distRel(rng)));
+    hit.fGoodnessOfFit = distChi2(rng);
+    hit.fNDF = std::max(1, hit.fEndTick - hit.fStartTick - 3 * hit.fMultiplicity);
+    hit.fSignalType = isCollection(plane) ? 1 : 0; // geo::kCollection : geo::kInduction
+    hit.fWireID_Cryostat = 0;
+    hit.fWireID_TPC = tpc;
+    hit.fWireID_Plane = plane;
+    hit.fWireID_Wire = wire;
+    return hit;
+}
+
+// Pedestal plus noise plus one pulse near the middle of the ROI
+std::vector<float> generatePhysicsSamples(unsigned int channel, std::size_t size, std::mt19937& rng) {
+    const int plane = planeOf(channel);
+    const bool collection = isCollection(plane);
+    // The pedestal belongs to the channel, so it repeats across events as in real data
+    const float pedestal = (collection ? 400.0f : 2048.0f) +
+                           static_cast<float>(Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('P'),
+                                                               static_cast<std::uint64_t>(channel)) % 41) - 20.0f;
+    const float amplitude = drawAmplitude(plane, rng);
+    const float width = drawWidth(rng);
+    const float center = 0.5f * static_cast<float>(size - 1) + std::uniform_real_distribution<float>(-1.0f, 1.0f)(rng);
+    std::normal_distribution<float> distNoise(0.0f, kNoiseADC);
+
+    std::vector<float> data(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        const float x = (static_cast<float>(i) - center) / width;
+        const float pulse = collection ? amplitude * std::exp(-0.5f * x * x)
+                                       : -amplitude * x * std::exp(0.5f - 0.5f * x * x); // peaks of +-amplitude
+        data[i] = std::round(pedestal + pulse + distNoise(rng));
+    }
+    return data;
+}
+
+void generatePhysicsChannel(unsigned int& channel, int& view, std::mt19937& rng) {
+    std::uniform_int_distribution<int> distTPC(0, kTPCs - 1);
+    std::uniform_int_distribution<int> distPlane(0, kPlanes - 1);
+    std::uniform_int_distribution<int> distWire(0, kWiresPerPlane - 1);
+    const int tpc = distTPC(rng);
+    view = distPlane(rng);
+    channel = static_cast<unsigned int>((tpc * kPlanes + view) * kWiresPerPlane + distWire(rng));
+}
+
+WireIndividual generatePhysicsWire(long long eventID, int numROIs, std::mt19937& rng) {
+    WireIndividual wire;
+    wire.EventID = eventID;
+    generatePhysicsChannel(wire.fWire_Channel, wire.fWire_View, rng);
+    // Ordered, non-overlapping ROIs: one per equal slice of the readout window
+    const std::size_t slice = std::max<std::size_t>(maxROILength(), static_cast<std::size_t>(kReadoutTicks) / std::max(1, numROIs));
+    for (int roiIndex = 0; roiIndex < numROIs; ++roiIndex) {
+        const std::size_t size = drawROILength(rng);
+        RegionOfInterest roi;
+        roi.offset = roiIndex * slice + std::uniform_int_distribution<std::size_t>(0, slice - size)(rng);
+        roi.data = generatePhysicsSamples(wire.fWire_Channel, size, rng);
+        wire.fSignalROI.push_back(std::move(roi));
+    }
+    return wire;
+}
+
+} // namespace
+
+GeneratorMode parseGeneratorMode(const std::string& name) {
+    if (name == "uniform") return GeneratorMode::Uniform;
+    if (name == "physics") return GeneratorMode::Physics;
+    throw std::invalid_argument("unknown generator '" + name + "' (expected uniform or physics)");
+}
+
+std::string generatorModeName(GeneratorMode mode) {
+    return mode == GeneratorMode::Physics ? "physics" : "uniform";
+}
+
+void setGeneratorMode(GeneratorMode mode) {
+    gGeneratorMode = mode;
+}
+
+GeneratorMode getGeneratorMode() {
+    return gGeneratorMode;
+}
+
+std::vector<float> generateROISamples(unsigned int channel, std::size_t size, std::mt19937& rng) {
+    if (gGeneratorMode == GeneratorMode::Physics) return generatePhysicsSamples(channel, size, rng);
+    std::uniform_real_distribution<float> distADC(0.0f, 100.0f);
+    std::vector<float> data(size);
+    for (auto& val : data) val = distADC(rng);
+    return data;
+}
+
+void generateWireChannelAndView(unsigned int& channel, int& view, std::mt19937& rng) {
+    if (gGeneratorMode == GeneratorMode::Physics) {
+        generatePhysicsChannel(channel, view, rng);
+        return;
+    }
+    channel = rng() % 1024;
+    view = rng() % 7;
+}
 
 HitVector generateRandomHitVector(long long eventID, int hitsPerEvent, std::mt19937& rng) {
     std::uniform_int_distribution<unsigned int> distChannel(0, 999);
@@ -99,6 +259,7 @@ WireVector generateRandomWireVector(long long eventID, int wiresPerEvent, std::m
 }
 
 HitIndividual generateRandomHitIndividual(long long eventID, std::mt19937& rng) {
+    if (gGeneratorMode == GeneratorMode::Physics) return generatePhysicsHit(eventID, rng);
     std::uniform_int_distribution<unsigned int> distChannel(0, 999);
     std::uniform_int_distribution<int> distTick(0, 5000);
     std::uniform_real_distribution<float> distFloat(0.0f, 100.0f);
@@ -135,6 +296,7 @@ HitIndividual generateRandomHitIndividual(long long eventID, std::mt19937& rng)
 }
 
 WireIndividual generateRandomWireIndividual(long long eventID, int numROIs, std::mt19937& rng) {
+    if (gGeneratorMode == GeneratorMode::Physics) return generatePhysicsWire(eventID, numROIs, rng);
     std::uniform_int_distribution<unsigned int> distWireChannel(0, 1023);
     std::uniform_int_distribution<int> distWireEnum(0, 6);
     std::uniform_int_distribution<int> distOffset(0, 500);
@@ -148,9 +310,9 @@ WireIndividual generateRandomWireIndividual(long long eventID, int numROIs, std:
     for (int roiIndex = 0; roiIndex < numROIs; ++roiIndex) {
         RegionOfInterest roi;
         roi.offset = distOffset(rng);
-        constexpr int size = 10;  // Fixed size for ROI data vector
+        const std::size_t size = drawROILength(rng);  // 10 unless ROI lengths vary
         
-        for (int dataIndex = 0; dataIndex < size; ++dataIndex) {
+        for (std::size_t dataIndex = 0; dataIndex < size; ++dataIndex) {
             float val = distADC(rng);
             roi.data.push_back(val);
         }
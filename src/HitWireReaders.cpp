@@ -12,14 +12,22 @@
 #include <future>
 #include <thread>
 #include <vector>
-#include "Utils.hpp" // For split_range_by_clusters
+#include "Utils.hpp" // For split_range_by_clusters / split_range_by_bytes
+#include "HitWireReaders.hpp"
+#include "Affinity.hpp"
 #include "ProgressiveTablePrinter.hpp"
 #include <exception>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
 
 
 
 template <typename ViewType>
 void processNtupleRange(const std::string& fileName, const std::string& ntupleName, const std::string& fieldName, const std::pair<std::size_t, std::size_t>& chunk) {
+    Affinity::pinCurrentThreadToNextSlot();
     auto ntuple = ROOT::RNTupleReader::Open(ntupleName, fileName);
     auto view = ntuple->GetView<ViewType>(fieldName);
     for (std::size_t i = chunk.first; i < chunk.second; ++i) {
@@ -28,10 +36,118 @@ void processNtupleRange(const std::string& fileName, const std::string& ntupleNa
     }
 }
 
+// Per-thread accounting of the dynamic cluster queue
+struct QueueThreadStats {
+    int grabs = 0;
+    std::size_t clusters = 0;
+    double busy = 0.0; // seconds spent traversing entries
+    double idle = 0.0; // seconds of the ntuple's wall time not spent traversing (setup + waiting for others)
+};
+
+struct QueueNtupleStats {
+    std::string ntupleName;
+    double wall = 0.0;
+    std::vector<QueueThreadStats> threads;
+};
+
+static ReadSplitConfig gReadSplit;
+static std::mutex gQueueStatsMutex;
+static std::vector<QueueNtupleStats> gQueueStats;
+
+void setReadSplitConfig(const ReadSplitConfig& config) {
+    gReadSplit = config;
+}
+
+static void clearReadQueueStats() {
+    std::lock_guard<std::mutex> lock(gQueueStatsMutex);
+    gQueueStats.clear();
+}
+
+// One line per ntuple read in the last timed call: cluster counts and idle time across threads
+static void printReadQueueStats() {
+    std::lock_guard<std::mutex> lock(gQueueStatsMutex);
+    for (const auto& nt : gQueueStats) {
+        if (nt.threads.empty()) continue;
+        std::size_t minClusters = nt.threads.front().clusters, maxClusters = 0;
+        double idleSum = 0.0, idleMax = 0.0;
+        for (const auto& t : nt.threads) {
+            minClusters = std::min(minClusters, t.clusters);
+            maxClusters = std::max(maxClusters, t.clusters);
+            idleSum += t.idle;
+            idleMax = std::max(idleMax, t.idle);
+        }
+        std::cout << std::left << std::setw(32) << ""
+                  << "queue " << nt.ntupleName << ": " << nt.threads.size() << " threads, clusters/thread "
+                  << minClusters << ".." << maxClusters << ", idle avg "
+                  << 1000.0 * idleSum / nt.threads.size() << " ms, max " << 1000.0 * idleMax
+                  << " ms (wall " << 1000.0 * nt.wall << " ms)" << std::endl;
+    }
+}
+
+// Worker of the dynamic schedule: grabs clustersPerGrab clusters at a time until none are left
+template <typename ViewType>
+void processNtupleQueue(const std::string& fileName, const std::string& ntupleName, const std::string& fieldName,
+                        const std::vector<Utils::ClusterSpan>& clusters, std::atomic<std::size_t>& next,
+                        std::size_t clustersPerGrab, QueueThreadStats& stats) {
+    Affinity::pinCurrentThreadToNextSlot();
+    auto ntuple = ROOT::RNTupleReader::Open(ntupleName, fileName);
+    auto view = ntuple->GetView<ViewType>(fieldName);
+    for (;;) {
+        std::size_t first = next.fetch_add(clustersPerGrab, std::memory_order_relaxed);
+        if (first >= clusters.size()) break;
+        std::size_t last = std::min(first + clustersPerGrab, clusters.size());
+        auto t0 = std::chrono::steady_clock::now();
+        std::size_t end = clusters[last - 1].firstEntry + clusters[last - 1].nEntries;
+        for (std::size_t i = clusters[first].firstEntry; i < end; ++i) {
+            const auto& val = view(i);
+            traverse(val);
+        }
+        stats.busy += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        stats.clusters += last - first;
+        ++stats.grabs;
+    }
+}
+
+template <typename ViewType>
+void processNtupleDynamic(const std::string& fileName, const std::string& ntupleName, const std::string& fieldName,
+                          ROOT::RNTupleReader& pilot, int nThreads) {
+    std::vector<Utils::ClusterSpan> clusters;
+    for (const auto& span : Utils::cluster_spans(pilot, Utils::ClusterWeight::Entries)) {
+        if (span.nEntries > 0) clusters.push_back(span);
+    }
+    if (clusters.empty()) return;
+    const std::size_t perGrab = static_cast<std::size_t>(std::max(1, gReadSplit.clustersPerGrab));
+    const std::size_t grabs = (clusters.size() + perGrab - 1) / perGrab;
+    const int workers = static_cast<int>(std::min<std::size_t>(std::max(1, nThreads), grabs));
+
+    std::atomic<std::size_t> next{0};
+    QueueNtupleStats ntStats;
+    ntStats.ntupleName = ntupleName;
+    ntStats.threads.resize(workers);
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::future<void>> futures;
+    for (int th = 0; th < workers; ++th) {
+        futures.emplace_back(std::async(std::launch::async, processNtupleQueue<ViewType>, std::cref(fileName), std::cref(ntupleName),
+                                        std::cref(fieldName), std::cref(clusters), std::ref(next), perGrab, std::ref(ntStats.threads[th])));
+    }
+    for (auto& f : futures) f.get();
+    ntStats.wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    for (auto& t : ntStats.threads) t.idle = std::max(0.0, ntStats.wall - t.busy);
+
+    std::lock_guard<std::mutex> lock(gQueueStatsMutex);
+    gQueueStats.push_back(std::move(ntStats));
+}
+
 template <typename ViewType>
 double processNtuple(const std::string& fileName, const std::string& ntupleName, const std::string& fieldName, int nThreads) {
     auto pilot = ROOT::RNTupleReader::Open(ntupleName, fileName);
-    auto chunks = Utils::split_range_by_clusters(*pilot, nThreads);
+    if (gReadSplit.dynamicQueue) {
+        processNtupleDynamic<ViewType>(fileName, ntupleName, fieldName, *pilot, nThreads);
+        return 0.0;
+    }
+    auto chunks = gReadSplit.byBytes
+        ? Utils::split_range_by_bytes(*pilot, nThreads, gReadSplit.weight, gReadSplit.allowSubCluster)
+        : Utils::split_range_by_clusters(*pilot, nThreads);
     std::vector<std::future<void>> futures;
     for (const auto& chunk : chunks) {
         futures.emplace_back(std::async(std::launch::async, processNtupleRange<ViewType>, fileName, ntupleName, fieldName, chunk));
@@ -51,8 +167,9 @@ double readAOS_event_allDataProduct(const std::string& fileName, int nThreads) {
 double readAOS_event_perDataProduct(const std::string& fileName, int nThreads) {
     TStopwatch sw;
     sw.Start();
-    auto hitsFuture = std::async(std::launch::async, processNtuple<std::vector<HitIndividual>>, fileName, "aos_hits", "hits", nThreads);
-    auto wiresFuture = std::async(std::launch::async, processNtuple<std::vector<WireIndividual>>, fileName, "aos_wires", "wires", nThreads);
+    int localThreads = readerThreadsPerNtuple(nThreads, 2);
+    auto hitsFuture = std::async(std::launch::async, processNtuple<std::vector<HitIndividual>>, fileName, "aos_hits", "hits", localThreads);
+    auto wiresFuture = std::async(std::launch::async, processNtuple<std::vector<WireIndividual>>, fileName, "aos_wires", "wires", localThreads);
     hitsFuture.get();
     wiresFuture.get();
     sw.Stop();
@@ -62,9 +179,10 @@ double readAOS_event_perDataProduct(const std::string& fileName, int nThreads) {
 double readAOS_event_perGroup(const std::string& fileName, int nThreads) {
     TStopwatch sw;
     sw.Start();
-    auto hitsFuture = std::async(std::launch::async, processNtuple<std::vector<HitIndividual>>, fileName, "aos_hits", "hits", nThreads);
-    auto wiresFuture = std::async(std::launch::async, processNtuple<std::vector<WireBase>>, fileName, "aos_wires", "wires", nThreads);
-    auto roisFuture = std::async(std::launch::async, processNtuple<std::vector<FlatROI>>, fileName, "aos_rois", "rois", nThreads);
+    int localThreads = readerThreadsPerNtuple(nThreads, 3);
+    auto hitsFuture = std::async(std::launch::async, processNtuple<std::vector<HitIndividual>>, fileName, "aos_hits", "hits", localThreads);
+    auto wiresFuture = std::async(std::launch::async, processNtuple<std::vector<WireBase>>, fileName, "aos_wires", "wires", localThreads);
+    auto roisFuture = std::async(std::launch::async, processNtuple<std::vector<FlatROI>>, fileName, "aos_rois", "rois", localThreads);
     hitsFuture.get();
     wiresFuture.get();
     roisFuture.get();
@@ -83,8 +201,9 @@ double readAOS_spill_allDataProduct(const std::string& fileName, int nThreads) {
 double readAOS_spill_perDataProduct(const std::string& fileName, int nThreads) {
     TStopwatch sw;
     sw.Start();
-    auto hitsFuture = std::async(std::launch::async, processNtuple<std::vector<HitIndividual>>, fileName, "aos_spill_hits", "hits", nThreads);
-    auto wiresFuture = std::async(std::launch::async, processNtuple<std::vector<WireIndividual>>, fileName, "aos_spill_wires", "wires", nThreads);
+    int localThreads = readerThreadsPerNtuple(nThreads, 2);
+    auto hitsFuture = std::async(std::launch::async, processNtuple<std::vector<HitIndividual>>, fileName, "aos_spill_hits", "hits", localThreads);
+    auto wiresFuture = std::async(std::launch::async, processNtuple<std::vector<WireIndividual>>, fileName, "aos_spill_wires", "wires", localThreads);
     hitsFuture.get();
     wiresFuture.get();
     sw.Stop();
@@ -94,9 +213,10 @@ double readAOS_spill_perDataProduct(const std::string& fileName, int nThreads) {
 double readAOS_spill_perGroup(const std::string& fileName, int nThreads) {
     TStopwatch sw;
     sw.Start();
-    auto hitsFuture = std::async(std::launch::async, processNtuple<std::vector<HitIndividual>>, fileName, "aos_spill_hits", "hits", nThreads);
-    auto wiresFuture = std::async(std::launch::async, processNtuple<std::vector<WireBase>>, fileName, "aos_spill_wires", "wires", nThreads);
-    auto roisFuture = std::async(std::launch::async, processNtuple<std::vector<FlatROI>>, fileName, "aos_spill_rois", "rois", nThreads);
+    int localThreads = readerThreadsPerNtuple(nThreads, 3);
+    auto hitsFuture = std::async(std::launch::async, processNtuple<std::vector<HitIndividual>>, fileName, "aos_spill_hits", "hits", localThreads);
+    auto wiresFuture = std::async(std::launch::async, processNtuple<std::vector<WireBase>>, fileName, "aos_spill_wires", "wires", localThreads);
+    auto roisFuture = std::async(std::launch::async, processNtuple<std::vector<FlatROI>>, fileName, "aos_spill_rois", "rois", localThreads);
     hitsFuture.get();
     wiresFuture.get();
     roisFuture.get();
@@ -107,8 +227,9 @@ double readAOS_spill_perGroup(const std::string& fileName, int nThreads) {
 double readAOS_topObject_perDataProduct(const std::string& fileName, int nThreads) {
     TStopwatch sw;
     sw.Start();
-    auto hitsFuture = std::async(std::launch::async, processNtuple<HitIndividual>, fileName, "aos_top_hits", "hit", nThreads);
-    auto wiresFuture = std::async(std::launch::async, processNtuple<WireIndividual>, fileName, "aos_top_wires", "wire", nThreads);
+    int localThreads = readerThreadsPerNtuple(nThreads, 2);
+    auto hitsFuture = std::async(std::launch::async, processNtuple<HitIndividual>, fileName, "aos_top_hits", "hit", localThreads);
+    auto wiresFuture = std::async(std::launch::async, processNtuple<WireIndividual>, fileName, "aos_top_wires", "wire", localThreads);
     hitsFuture.get();
     wiresFuture.get();
     sw.Stop();
@@ -118,9 +239,10 @@ double readAOS_topObject_perDataProduct(const std::string& fileName, int nThread
 double readAOS_topObject_perGroup(const std::string& fileName, int nThreads) {
     TStopwatch sw;
     sw.Start();
-    auto hitsFuture = std::async(std::launch::async, processNtuple<HitIndividual>, fileName, "aos_top_hits", "hit", nThreads);
-    auto wiresFuture = std::async(std::launch::async, processNtuple<WireBase>, fileName, "aos_top_wires", "wire", nThreads);
-    auto roisFuture = std::async(std::launch::async, processNtuple<std::vector<FlatROI>>, fileName, "aos_top_rois", "rois", nThreads);
+    int localThreads = readerThreadsPerNtuple(nThreads, 3);
+    auto hitsFuture = std::async(std::launch::async, processNtuple<HitIndividual>, fileName, "aos_top_hits", "hit", localThreads);
+    auto wiresFuture = std::async(std::launch::async, processNtuple<WireBase>, fileName, "aos_top_wires", "wire", localThreads);
+    auto roisFuture = std::async(std::launch::async, processNtuple<std::vector<FlatROI>>, fileName, "aos_top_rois", "rois", localThreads);
     hitsFuture.get();
     wiresFuture.get();
     roisFuture.get();
@@ -131,8 +253,9 @@ double readAOS_topObject_perGroup(const std::string& fileName, int nThreads) {
 double readAOS_element_perDataProduct(const std::string& fileName, int nThreads) {
     TStopwatch sw;
     sw.Start();
-    auto hitsFuture = std::async(std::launch::async, processNtuple<HitIndividual>, fileName, "element_hits", "hit", nThreads);
-    auto wireROIFuture = std::async(std::launch::async, processNtuple<WireROI>, fileName, "element_wire_rois", "wire_roi", nThreads);
+    int localThreads = readerThreadsPerNtuple(nThreads, 2);
+    auto hitsFuture = std::async(std::launch::async, processNtuple<HitIndividual>, fileName, "element_hits", "hit", localThreads);
+    auto wireROIFuture = std::async(std::launch::async, processNtuple<WireROI>, fileName, "element_wire_rois", "wire_roi", localThreads);
     hitsFuture.get();
     wireROIFuture.get();
     sw.Stop();
@@ -142,9 +265,10 @@ double readAOS_element_perDataProduct(const std::string& fileName, int nThreads)
 double readAOS_element_perGroup(const std::string& fileName, int nThreads) {
     TStopwatch sw;
     sw.Start();
-    auto hitsFuture = std::async(std::launch::async, processNtuple<HitIndividual>, fileName, "element_hits", "hit", nThreads);
-    auto wiresFuture = std::async(std::launch::async, processNtuple<WireBase>, fileName, "element_wires", "wire", nThreads);
-    auto roisFuture = std::async(std::launch::async, processNtuple<FlatROI>, fileName, "element_rois", "roi", nThreads);
+    int localThreads = readerThreadsPerNtuple(nThreads, 3);
+    auto hitsFuture = std::async(std::launch::async, processNtuple<HitIndividual>, fileName, "element_hits", "hit", localThreads);
+    auto wiresFuture = std::async(std::launch::async, processNtuple<WireBase>, fileName, "element_wires", "wire", localThreads);
+    auto roisFuture = std::async(std::launch::async, processNtuple<FlatROI>, fileName, "element_rois", "roi", localThreads);
     hitsFuture.get();
     wiresFuture.get();
     roisFuture.get();
@@ -240,8 +364,9 @@ double readSOA_event_allDataProduct(const std::string& fileName, int nThreads) {
 double readSOA_event_perDataProduct(const std::string& fileName, int nThreads) {
     TStopwatch sw;
     sw.Start();
-    auto hitsFuture = std::async(std::launch::async, processNtuple<SOAHitVector>, fileName, "soa_hits", "hits", nThreads);
-    auto wiresFuture = std::async(std::launch::async, processNtuple<SOAWireVector>, fileName, "soa_wires", "wires", nThreads);
+    int localThreads = readerThreadsPerNtuple(nThreads, 2);
+    auto hitsFuture = std::async(std::launch::async, processNtuple<SOAHitVector>, fileName, "soa_hits", "hits", localThreads);
+    auto wiresFuture = std::async(std::launch::async, processNtuple<SOAWireVector>, fileName, "soa_wires", "wires", localThreads);
     hitsFuture.get();
     wiresFuture.get();
     sw.Stop();
@@ -251,9 +376,10 @@ double readSOA_event_perDataProduct(const std::string& fileName, int nThreads) {
 double readSOA_event_perGroup(const std::string& fileName, int nThreads) {
     TStopwatch sw;
     sw.Start();
-    auto hitsFuture = std::async(std::launch::async, processNtuple<SOAHitVector>, fileName, "soa_hits", "hits", nThreads);
-    auto wiresFuture = std::async(std::launch::async, processNtuple<std::vector<SOAWireBase>>, fileName, "soa_wires", "wires", nThreads);
-    auto roisFuture = std::async(std::launch::async, processNtuple<std::vector<SOAROI>>, fileName, "soa_rois", "rois", nThreads);
+    int localThreads = readerThreadsPerNtuple(nThreads, 3);
+    auto hitsFuture = std::async(std::launch::async, processNtuple<SOAHitVector>, fileName, "soa_hits", "hits", localThreads);
+    auto wiresFuture = std::async(std::launch::async, processNtuple<std::vector<SOAWireBase>>, fileName, "soa_wires", "wires", localThreads);
+    auto roisFuture = std::async(std::launch::async, processNtuple<std::vector<SOAROI>>, fileName, "soa_rois", "rois", localThreads);
     hitsFuture.get();
     wiresFuture.get();
     roisFuture.get();
@@ -274,8 +400,9 @@ double readSOA_spill_allDataProduct(const std::string& fileName, int nThreads) {
 double readSOA_spill_perDataProduct(const std::string& fileName, int nThreads) {
     TStopwatch sw;
     sw.Start();
-    auto hitsFuture = std::async(std::launch::async, processNtuple<SOAHitVector>, fileName, "soa_spill_hits", "hits", nThreads);
-    auto wiresFuture = std::async(std::launch::async, processNtuple<SOAWireVector>, fileName, "soa_spill_wires", "wires", nThreads);
+    int localThreads = readerThreadsPerNtuple(nThreads, 2);
+    auto hitsFuture = std::async(std::launch::async, processNtuple<SOAHitVector>, fileName, "soa_spill_hits", "hits", localThreads);
+    auto wiresFuture = std::async(std::launch::async, processNtuple<SOAWireVector>, fileName, "soa_spill_wires", "wires", localThreads);
     hitsFuture.get();
     wiresFuture.get();
     sw.Stop();
@@ -285,9 +412,10 @@ double readSOA_spill_perDataProduct(const std::string& fileName, int nThreads) {
 double readSOA_spill_perGroup(const std::string& fileName, int nThreads) {
     TStopwatch sw;
     sw.Start();
-    auto hitsFuture = std::async(std::launch::async, processNtuple<SOAHitVector>, fileName, "soa_spill_hits", "hits", nThreads);
-    auto wiresFuture = std::async(std::launch::async, processNtuple<std::vector<SOAWireBase>>, fileName, "soa_spill_wires", "wires", nThreads);
-    auto roisFuture = std::async(std::launch::async, processNtuple<std::vector<SOAROI>>, fileName, "soa_spill_rois", "rois", nThreads);
+    int localThreads = readerThreadsPerNtuple(nThreads, 3);
+    auto hitsFuture = std::async(std::launch::async, processNtuple<SOAHitVector>, fileName, "soa_spill_hits", "hits", localThreads);
+    auto wiresFuture = std::async(std::launch::async, processNtuple<std::vector<SOAWireBase>>, fileName, "soa_spill_wires", "wires", localThreads);
+    auto roisFuture = std::async(std::launch::async, processNtuple<std::vector<SOAROI>>, fileName, "soa_spill_rois", "rois", localThreads);
     hitsFuture.get();
     wiresFuture.get();
     roisFuture.get();
@@ -301,8 +429,9 @@ double readSOA_spill_perGroup(const std::string& fileName, int nThreads) {
 double readSOA_topObject_perDataProduct(const std::string& fileName, int nThreads) {
     TStopwatch sw;
     sw.Start();
-    auto hitsFuture = std::async(std::launch::async, processNtuple<SOAHit>, fileName, "soa_top_hits", "hit", nThreads);
-    auto wiresFuture = std::async(std::launch::async, processNtuple<SOAWire>, fileName, "soa_top_wires", "wire", nThreads);
+    int localThreads = readerThreadsPerNtuple(nThreads, 2);
+    auto hitsFuture = std::async(std::launch::async, processNtuple<SOAHit>, fileName, "soa_top_hits", "hit", localThreads);
+    auto wiresFuture = std::async(std::launch::async, processNtuple<SOAWire>, fileName, "soa_top_wires", "wire", localThreads);
     hitsFuture.get();
     wiresFuture.get();
     sw.Stop();
@@ -333,9 +462,10 @@ void traverse(const SOAWireBase& wire) {
 double readSOA_element_perDataProduct(const std::string& fileName, int nThreads) {
     TStopwatch sw;
     sw.Start();
-    auto hitsFuture = std::async(std::launch::async, processNtuple<SOAHit>, fileName, "soa_element_hits", "hit", nThreads);
+    int localThreads = readerThreadsPerNtuple(nThreads, 2);
+    auto hitsFuture = std::async(std::launch::async, processNtuple<SOAHit>, fileName, "soa_element_hits", "hit", localThreads);
     // After switching perDataProduct to ROI-per-row, read FlatSOAROI from soa_element_rois
-    auto roisFuture = std::async(std::launch::async, processNtuple<FlatSOAROI>, fileName, "soa_element_rois", "roi", nThreads);
+    auto roisFuture = std::async(std::launch::async, processNtuple<FlatSOAROI>, fileName, "soa_element_rois", "roi", localThreads);
     hitsFuture.get();
     roisFuture.get();
     sw.Stop();
@@ -387,9 +517,10 @@ void traverse(const SOAUnionRow& row) {
 double readSOA_topObject_perGroup(const std::string& fileName, int nThreads) {
     TStopwatch sw;
     sw.Start();
-    auto hitsFuture = std::async(std::launch::async, processNtuple<SOAHit>, fileName, "soa_top_hits", "hit", nThreads);
-    auto wiresFuture = std::async(std::launch::async, processNtuple<SOAWireBase>, fileName, "soa_top_wires", "wire", nThreads);
-    auto roisFuture = std::async(std::launch::async, processNtuple<std::vector<SOAROI>>, fileName, "soa_top_rois", "rois", nThreads);
+    int localThreads = readerThreadsPerNtuple(nThreads, 3);
+    auto hitsFuture = std::async(std::launch::async, processNtuple<SOAHit>, fileName, "soa_top_hits", "hit", localThreads);
+    auto wiresFuture = std::async(std::launch::async, processNtuple<SOAWireBase>, fileName, "soa_top_wires", "wire", localThreads);
+    auto roisFuture = std::async(std::launch::async, processNtuple<std::vector<SOAROI>>, fileName, "soa_top_rois", "rois", localThreads);
     hitsFuture.get();
     wiresFuture.get();
     roisFuture.get();
@@ -443,10 +574,14 @@ std::vector<ReaderResult> inAOS(int nThreads, int iter, const std::string& outpu
         try {
             std::vector<double> coldTimes, warmTimes;
             if (iter > 0) {
+                Affinity::resetSlots();
+                clearReadQueueStats();
                 double cold = readerFunc(file, nThreads);
                 coldTimes.push_back(cold);
             }
             for (int i = 1; i < iter; ++i) {
+                Affinity::resetSlots();
+                clearReadQueueStats();
                 double warm = readerFunc(file, nThreads);
                 warmTimes.push_back(warm);
             }
@@ -476,6 +611,7 @@ std::vector<ReaderResult> inAOS(int nThreads, int iter, const std::string& outpu
         
         results.push_back(result);
         tablePrinter.addRow(result);
+        if (gReadSplit.dynamicQueue && !result.failed) printReadQueueStats();
     };
 
     auto shouldRun = [&](int idx) { return mask < 0 || ((mask & (1 << idx)) != 0); };
@@ -512,10 +648,14 @@ std::vector<ReaderResult> inSOA(int nThreads, int iter, const std::string& outpu
         try {
             std::vector<double> coldTimes, warmTimes;
             if (iter > 0) {
+                Affinity::resetSlots();
+                clearReadQueueStats();
                 double cold = readerFunc(file, nThreads);
                 coldTimes.push_back(cold);
             }
             for (int i = 1; i < iter; ++i) {
+                Affinity::resetSlots();
+                clearReadQueueStats();
                 double warm = readerFunc(file, nThreads);
                 warmTimes.push_back(warm);
             }
@@ -545,6 +685,7 @@ std::vector<ReaderResult> inSOA(int nThreads, int iter, const std::string& outpu
         
         results.push_back(result);
         tablePrinter.addRow(result);
+        if (gReadSplit.dynamicQueue && !result.failed) printReadQueueStats();
     };
 
     auto shouldRun = [&](int idx) { return mask < 0 || ((mask & (1 << idx)) != 0); };
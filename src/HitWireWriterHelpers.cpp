@@ -7,6 +7,7 @@
 #include <ROOT/RRawPtrWriteEntry.hxx>
 #include <ROOT/RNTupleFillContext.hxx>
 #include <ROOT/RNTupleFillStatus.hxx>
+#include <algorithm>
 #include <unordered_map>
 #include <random>
 #include <vector>
@@ -17,6 +18,7 @@
 #include "TopBatchRow.hpp"
 #include "TopBatchRowSOA.hpp"
 #include "Utils.hpp"
+#include "EventSizes.hpp"
 
 // Data generation (adapt from existing generators)
 std::vector<HitIndividual> generateEventHits(long long eventID, int numHits, std::mt19937& rng) {
@@ -122,6 +124,17 @@ auto CreateAOSAllDataProductModelAndToken() -> std::pair<std::unique_ptr<ROOT::R
     return {std::move(model), model->GetToken("EventAOS")};
 }
 
+auto CreateAOSSpillModelAndTokens() -> std::tuple<std::unique_ptr<ROOT::RNTupleModel>, ROOT::RFieldToken, ROOT::RFieldToken, ROOT::RFieldToken> {
+    auto model = ROOT::RNTupleModel::Create();
+    model->MakeField<EventAOS>("EventAOS");
+    model->MakeField<long long>("EventID");
+    model->MakeField<int>("SpillID");
+    auto token = model->GetToken("EventAOS");
+    auto eventIdToken = model->GetToken("EventID");
+    auto spillIdToken = model->GetToken("SpillID");
+    return {std::move(model), token, eventIdToken, spillIdToken};
+}
+
 // Union models for allDataProduct (per-top/element rows)
 auto CreateAOSUnionModelAndToken(const std::string& fieldName) -> std::pair<std::unique_ptr<ROOT::RNTupleModel>, ROOT::RFieldToken> {
     auto model = ROOT::RNTupleModel::Create();
@@ -152,27 +165,29 @@ double RunAOS_top_allDataProductWorkFunc(int firstEvt, int lastEvt, unsigned /*s
     ROOT::Experimental::RNTupleFillContext& ctx, ROOT::Experimental::Detail::RRawPtrWriteEntry& entry,
     ROOT::RFieldToken token, std::mutex& mutex, int hitsPerEvent, int wiresPerEvent, int roisPerWire) {
     TStopwatch sw; double totalTime = 0.0;
+    const EventSize maxSize = maxEventSize(hitsPerEvent, wiresPerEvent, roisPerWire); // hit ID stride
     for (int evt = firstEvt; evt < lastEvt; ++evt) {
-        const int K = (hitsPerEvent > wiresPerEvent) ? hitsPerEvent : wiresPerEvent;
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
+        const int K = (size.hits > size.wires) ? size.hits : size.wires;
         for (int k = 0; k < K; ++k) {
             AOSTopBatchRow row{}; row.EventID = static_cast<unsigned int>(evt);
-            if (k < hitsPerEvent) {
+            if (k < size.hits) {
                 std::uint32_t hSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('H'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(k));
         std::mt19937 hRng(hSeed);
                 row.hasHit = true;
-                row.hit = generateRandomHitIndividual(static_cast<long long>(evt) * hitsPerEvent + k, hRng);
+                row.hit = generateRandomHitIndividual(static_cast<long long>(evt) * maxSize.hits + k, hRng);
             } else {
                 row.hasHit = false;
             }
-            if (k < wiresPerEvent) {
+            if (k < size.wires) {
                 std::uint32_t wSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('W'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(k));
         std::mt19937 wRng(wSeed);
-                WireIndividual wi = generateRandomWireIndividual(evt, roisPerWire, wRng);
+                WireIndividual wi = generateRandomWireIndividual(evt, size.roisPerWire, wRng);
                 row.hasWire = true;
                 row.wire = extractWireBase(wi);
                 row.rois.clear();
-                row.rois.reserve(roisPerWire);
-                for (int r = 0; r < roisPerWire; ++r) {
+                row.rois.reserve(size.roisPerWire);
+                for (int r = 0; r < size.roisPerWire; ++r) {
                     FlatROI flat{};
                     flat.EventID = static_cast<unsigned int>(evt);
                     flat.WireID  = wi.fWire_Channel;
@@ -199,29 +214,31 @@ double RunAOS_element_allDataProductWorkFunc(int firstEvt, int lastEvt, unsigned
     ROOT::Experimental::RNTupleFillContext& ctx, ROOT::Experimental::Detail::RRawPtrWriteEntry& entry,
     ROOT::RFieldToken token, std::mutex& mutex, int hitsPerEvent, int wiresPerEvent, int roisPerWire) {
     TStopwatch sw; double totalTime = 0.0;
+    const EventSize maxSize = maxEventSize(hitsPerEvent, wiresPerEvent, roisPerWire); // hit ID stride
     for (int evt = firstEvt; evt < lastEvt; ++evt) {
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
         // Hit elements
-        for (int h = 0; h < hitsPerEvent; ++h) {
+        for (int h = 0; h < size.hits; ++h) {
             std::uint32_t hSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('H'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(h));
             std::mt19937 hRng(hSeed);
-            HitIndividual hi = generateRandomHitIndividual(static_cast<long long>(evt) * hitsPerEvent + h, hRng);
+            HitIndividual hi = generateRandomHitIndividual(static_cast<long long>(evt) * maxSize.hits + h, hRng);
             AOSUnionRow row{}; row.EventID = evt; row.recordType = 0; row.WireID = 0; row.hit = hi;
             sw.Start(); entry.BindRawPtr(token, &row);
             { ROOT::RNTupleFillStatus st; ctx.FillNoFlush(entry, st); if (st.ShouldFlushCluster()) { ctx.FlushColumns(); std::lock_guard<std::mutex> lk(mutex); ctx.FlushCluster(); } }
             totalTime += sw.RealTime();
         }
         // Wire elements and their ROI elements
-        for (int w = 0; w < wiresPerEvent; ++w) {
+        for (int w = 0; w < size.wires; ++w) {
             std::uint32_t wSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('W'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(w));
             std::mt19937 wRng(wSeed);
-            WireIndividual wi = generateRandomWireIndividual(evt, roisPerWire, wRng);
+            WireIndividual wi = generateRandomWireIndividual(evt, size.roisPerWire, wRng);
             // Wire element row
             AOSUnionRow rowW{}; rowW.EventID = evt; rowW.recordType = 1; rowW.WireID = wi.fWire_Channel; rowW.wire = extractWireBase(wi);
             sw.Start(); entry.BindRawPtr(token, &rowW);
             { ROOT::RNTupleFillStatus st; ctx.FillNoFlush(entry, st); if (st.ShouldFlushCluster()) { ctx.FlushColumns(); std::lock_guard<std::mutex> lk(mutex); ctx.FlushCluster(); } }
             totalTime += sw.RealTime();
             // ROI element rows
-            for (int r = 0; r < roisPerWire; ++r) {
+            for (int r = 0; r < size.roisPerWire; ++r) {
                 AOSUnionRow rowR{}; rowR.EventID = evt; rowR.recordType = 2; rowR.WireID = wi.fWire_Channel;
                 rowR.roi.EventID = evt; rowR.roi.WireID = wi.fWire_Channel; rowR.roi.offset = wi.getSignalROI()[r].offset; rowR.roi.data = wi.getSignalROI()[r].data;
                 sw.Start(); entry.BindRawPtr(token, &rowR);
@@ -238,14 +255,16 @@ double RunSOA_top_allDataProductWorkFunc(int firstEvt, int lastEvt, unsigned /*s
     ROOT::Experimental::RNTupleFillContext& ctx, ROOT::Experimental::Detail::RRawPtrWriteEntry& entry,
     ROOT::RFieldToken token, std::mutex& mutex, int hitsPerEvent, int wiresPerEvent, int roisPerWire) {
     TStopwatch sw; double totalTime = 0.0;
+    const EventSize maxSize = maxEventSize(hitsPerEvent, wiresPerEvent, roisPerWire); // hit ID stride
     for (int evt = firstEvt; evt < lastEvt; ++evt) {
-        const int K = (hitsPerEvent > wiresPerEvent) ? hitsPerEvent : wiresPerEvent;
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
+        const int K = (size.hits > size.wires) ? size.hits : size.wires;
         for (int k = 0; k < K; ++k) {
             SOATopBatchRow row{}; row.EventID = static_cast<unsigned int>(evt);
-            if (k < hitsPerEvent) {
+            if (k < size.hits) {
                 std::uint32_t hSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('H'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(k));
         std::mt19937 hRng(hSeed);
-                HitIndividual hInd = generateRandomHitIndividual(static_cast<long long>(evt) * hitsPerEvent + k, hRng);
+                HitIndividual hInd = generateRandomHitIndividual(static_cast<long long>(evt) * maxSize.hits + k, hRng);
                 row.hasHit = true;
                 row.hit.EventID = hInd.EventID;
                 row.hit.fChannel = hInd.fChannel;
@@ -273,17 +292,17 @@ double RunSOA_top_allDataProductWorkFunc(int firstEvt, int lastEvt, unsigned /*s
             } else {
                 row.hasHit = false;
             }
-            if (k < wiresPerEvent) {
+            if (k < size.wires) {
                 std::uint32_t wSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('W'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(k));
         std::mt19937 wRng(wSeed);
-        WireIndividual wInd = generateRandomWireIndividual(evt, roisPerWire, wRng);
+        WireIndividual wInd = generateRandomWireIndividual(evt, size.roisPerWire, wRng);
                 row.hasWire = true;
                 row.wire.EventID = evt;
                 row.wire.fWire_Channel = wInd.fWire_Channel;
                 row.wire.fWire_View = wInd.fWire_View;
                 row.rois.clear();
-                row.rois.resize(roisPerWire);
-        for (int r = 0; r < roisPerWire; ++r) {
+                row.rois.resize(size.roisPerWire);
+        for (int r = 0; r < size.roisPerWire; ++r) {
                     row.rois[r].data = wInd.getSignalROI()[r].data;
                 }
             } else {
@@ -305,11 +324,13 @@ double RunSOA_element_allDataProductWorkFunc(int firstEvt, int lastEvt, unsigned
     ROOT::Experimental::RNTupleFillContext& ctx, ROOT::Experimental::Detail::RRawPtrWriteEntry& entry,
     ROOT::RFieldToken token, std::mutex& mutex, int hitsPerEvent, int wiresPerEvent, int roisPerWire) {
     TStopwatch sw; double totalTime = 0.0;
+    const EventSize maxSize = maxEventSize(hitsPerEvent, wiresPerEvent, roisPerWire); // hit ID stride
     for (int evt = firstEvt; evt < lastEvt; ++evt) {
-        for (int h = 0; h < hitsPerEvent; ++h) {
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
+        for (int h = 0; h < size.hits; ++h) {
             std::uint32_t hSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('H'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(h));
             std::mt19937 hRng(hSeed);
-            HitIndividual hInd = generateRandomHitIndividual(static_cast<long long>(evt) * hitsPerEvent + h, hRng);
+            HitIndividual hInd = generateRandomHitIndividual(static_cast<long long>(evt) * maxSize.hits + h, hRng);
             SOAUnionRow row{}; row.EventID = evt; row.recordType = 0; row.WireID = 0;
             row.hit.EventID = hInd.EventID; row.hit.fChannel = hInd.fChannel; row.hit.fView = hInd.fView;
             row.hit.fStartTick = hInd.fStartTick; row.hit.fEndTick = hInd.fEndTick; row.hit.fPeakTime = hInd.fPeakTime; row.hit.fSigmaPeakTime = hInd.fSigmaPeakTime;
@@ -319,13 +340,13 @@ double RunSOA_element_allDataProductWorkFunc(int firstEvt, int lastEvt, unsigned
             row.hit.fNDF = hInd.fNDF; row.hit.fSignalType = hInd.fSignalType; row.hit.fWireID_Cryostat = hInd.fWireID_Cryostat; row.hit.fWireID_TPC = hInd.fWireID_TPC; row.hit.fWireID_Plane = hInd.fWireID_Plane; row.hit.fWireID_Wire = hInd.fWireID_Wire;
             sw.Start(); entry.BindRawPtr(token, &row); { ROOT::RNTupleFillStatus st; ctx.FillNoFlush(entry, st); if (st.ShouldFlushCluster()) { ctx.FlushColumns(); std::lock_guard<std::mutex> lk(mutex); ctx.FlushCluster(); } } totalTime += sw.RealTime();
         }
-        for (int w = 0; w < wiresPerEvent; ++w) {
+        for (int w = 0; w < size.wires; ++w) {
             std::uint32_t wSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('W'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(w));
             std::mt19937 wRng(wSeed);
-            WireIndividual wInd = generateRandomWireIndividual(evt, roisPerWire, wRng);
+            WireIndividual wInd = generateRandomWireIndividual(evt, size.roisPerWire, wRng);
             SOAUnionRow rowW{}; rowW.EventID = evt; rowW.recordType = 1; rowW.WireID = wInd.fWire_Channel; rowW.wire.EventID = evt; rowW.wire.fWire_Channel = wInd.fWire_Channel; rowW.wire.fWire_View = wInd.fWire_View;
             sw.Start(); entry.BindRawPtr(token, &rowW); { ROOT::RNTupleFillStatus st; ctx.FillNoFlush(entry, st); if (st.ShouldFlushCluster()) { ctx.FlushColumns(); std::lock_guard<std::mutex> lk(mutex); ctx.FlushCluster(); } } totalTime += sw.RealTime();
-            for (int r = 0; r < roisPerWire; ++r) {
+            for (int r = 0; r < size.roisPerWire; ++r) {
                 SOAUnionRow rowR{}; rowR.EventID = evt; rowR.recordType = 2; rowR.WireID = wInd.fWire_Channel; rowR.roi.EventID = evt; rowR.roi.WireID = wInd.fWire_Channel; rowR.roi.offset = wInd.getSignalROI()[r].offset; rowR.roi.data = wInd.getSignalROI()[r].data;
                 sw.Start(); entry.BindRawPtr(token, &rowR); { ROOT::RNTupleFillStatus st; ctx.FillNoFlush(entry, st); if (st.ShouldFlushCluster()) { ctx.FlushColumns(); std::lock_guard<std::mutex> lk(mutex); ctx.FlushCluster(); } } totalTime += sw.RealTime();
             }
@@ -367,9 +388,10 @@ double RunAOS_event_allDataProductWorkFunc(int first, int last, unsigned seed, R
     // double dataGenTime = 0.0, serializeTime = 0.0, flushColumnsTime = 0.0, flushClusterTime = 0.0;
     double totalTime = 0.0;
     for (int evt = first; evt < last; ++evt) {
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
         EventAOS eventData;
-        eventData.hits = generateEventHitsDeterministic(evt, hitsPerEvent);
-        eventData.wires = generateEventWiresDeterministic(evt, wiresPerEvent, roisPerWire);
+        eventData.hits = generateEventHitsDeterministic(evt, size.hits);
+        eventData.wires = generateEventWiresDeterministic(evt, size.wires, size.roisPerWire);
 
         sw.Start();
         entry.BindRawPtr(token, &eventData);
@@ -414,9 +436,10 @@ double RunAOS_event_perDataProductWorkFunc(int first, int last, unsigned seed, R
     TStopwatch sw;
     double totalTime = 0.0;
     for (int evt = first; evt < last; ++evt) {
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
         // Deterministic content independent of thread/config
-        auto hits = generateEventHitsDeterministic(evt, hitsPerEvent);
-        auto wires = generateEventWiresDeterministic(evt, wiresPerEvent, roisPerWire);
+        auto hits = generateEventHitsDeterministic(evt, size.hits);
+        auto wires = generateEventWiresDeterministic(evt, size.wires, size.roisPerWire);
         sw.Start();
         // Fill hits
         hitsEntry.BindRawPtr(hitsToken, &hits);
@@ -445,9 +468,10 @@ double RunAOS_event_perGroupWorkFunc(int first, int last, unsigned seed, ROOT::E
     TStopwatch sw;
     double totalTime = 0.0;
     for (int evt = first; evt < last; ++evt) {
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
         // Deterministic content independent of thread/config
-        auto hits = generateEventHitsDeterministic(evt, hitsPerEvent);
-        auto wires = generateEventWiresDeterministic(evt, wiresPerEvent, roisPerWire);
+        auto hits = generateEventHitsDeterministic(evt, size.hits);
+        auto wires = generateEventWiresDeterministic(evt, size.wires, size.roisPerWire);
         auto rois = flattenROIs(wires);
         std::vector<WireBase> baseWires;
         for(const auto& w : wires) baseWires.push_back(extractWireBase(w));
@@ -485,21 +509,28 @@ double RunAOS_event_perGroupWorkFunc(int first, int last, unsigned seed, ROOT::E
 // No change needed if passing adjusted params
 
 // Work function for spill allDataProduct
-double RunAOS_spill_allDataProductWorkFunc(int first, int last, unsigned seed, ROOT::Experimental::RNTupleFillContext& context, ROOT::Experimental::Detail::RRawPtrWriteEntry& entry, ROOT::RFieldToken token, std::mutex& mutex, int numSpills, int adjustedHits, int adjustedWires, int roisPerWire) {
+double RunAOS_spill_allDataProductWorkFunc(int first, int last, unsigned seed, ROOT::Experimental::RNTupleFillContext& context, ROOT::Experimental::Detail::RRawPtrWriteEntry& entry, ROOT::RFieldToken token, ROOT::RFieldToken eventIdToken, ROOT::RFieldToken spillIdToken, std::mutex& mutex, int numSpills, int hitsPerEvent, int wiresPerEvent, int roisPerWire) {
     std::mt19937 rng(seed);
     TStopwatch sw;
     double totalTime = 0.0;
     for (int idx = first; idx < last; ++idx) {
         int evt = idx / numSpills;
         int spill = idx % numSpills;
-        int startHit = spill * adjustedHits;
-        int startWire = spill * adjustedWires;
+        // Every spill gets an equal share of its event, the remainder is dropped as before
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
+        const int spillHits = size.hits / numSpills;
+        const int spillWires = size.wires / numSpills;
+        int startHit = spill * spillHits;
+        int startWire = spill * spillWires;
         EventAOS spillData;
         // Deterministic slices from the same event content
-        spillData.hits = generateEventHitsDeterministicRange(evt, startHit, adjustedHits);
-        spillData.wires = generateEventWiresDeterministicRange(evt, startWire, adjustedWires, roisPerWire);
+        spillData.hits = generateEventHitsDeterministicRange(evt, startHit, spillHits);
+        spillData.wires = generateEventWiresDeterministicRange(evt, startWire, spillWires, size.roisPerWire);
+        long long eventId = evt;
         sw.Start();
         entry.BindRawPtr(token, &spillData);
+        entry.BindRawPtr(eventIdToken, &eventId);
+        entry.BindRawPtr(spillIdToken, &spill);
         ROOT::RNTupleFillStatus status;
         context.FillNoFlush(entry, status);
         if (status.ShouldFlushCluster()) {
@@ -512,17 +543,21 @@ double RunAOS_spill_allDataProductWorkFunc(int first, int last, unsigned seed, R
 }
 
 // Similar for perDataProduct and perGroup with adjustments
-double RunAOS_spill_perDataProductWorkFunc(int first, int last, unsigned seed, ROOT::Experimental::RNTupleFillContext& hitsContext, ROOT::Experimental::Detail::RRawPtrWriteEntry& hitsEntry, ROOT::RFieldToken hitsToken, ROOT::Experimental::RNTupleFillContext& wiresContext, ROOT::Experimental::Detail::RRawPtrWriteEntry& wiresEntry, ROOT::RFieldToken wiresToken, std::mutex& mutex, int numSpills, int adjustedHits, int adjustedWires, int roisPerWire) {
+double RunAOS_spill_perDataProductWorkFunc(int first, int last, unsigned seed, ROOT::Experimental::RNTupleFillContext& hitsContext, ROOT::Experimental::Detail::RRawPtrWriteEntry& hitsEntry, ROOT::RFieldToken hitsToken, ROOT::Experimental::RNTupleFillContext& wiresContext, ROOT::Experimental::Detail::RRawPtrWriteEntry& wiresEntry, ROOT::RFieldToken wiresToken, std::mutex& mutex, int numSpills, int hitsPerEvent, int wiresPerEvent, int roisPerWire) {
     TStopwatch sw;
     double totalTime = 0.0;
     for (int idx = first; idx < last; ++idx) {
         int evt = idx / numSpills;
         int spill = idx % numSpills;
-        int startHit = spill * adjustedHits;
-        int startWire = spill * adjustedWires;
+        // Every spill gets an equal share of its event, the remainder is dropped as before
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
+        const int spillHits = size.hits / numSpills;
+        const int spillWires = size.wires / numSpills;
+        int startHit = spill * spillHits;
+        int startWire = spill * spillWires;
         // Deterministic slices from event-level content
-        auto hits = generateEventHitsDeterministicRange(evt, startHit, adjustedHits);
-        auto wires = generateEventWiresDeterministicRange(evt, startWire, adjustedWires, roisPerWire);
+        auto hits = generateEventHitsDeterministicRange(evt, startHit, spillHits);
+        auto wires = generateEventWiresDeterministicRange(evt, startWire, spillWires, size.roisPerWire);
         sw.Start();
         hitsEntry.BindRawPtr(hitsToken, &hits);
         ROOT::RNTupleFillStatus hitsStatus;
@@ -543,15 +578,19 @@ double RunAOS_spill_perDataProductWorkFunc(int first, int last, unsigned seed, R
     return totalTime;
 }
 
-double RunAOS_spill_perGroupWorkFunc(int first, int last, unsigned seed, ROOT::Experimental::RNTupleFillContext& hitsContext, ROOT::Experimental::Detail::RRawPtrWriteEntry& hitsEntry, ROOT::RFieldToken hitsToken, ROOT::Experimental::RNTupleFillContext& wiresContext, ROOT::Experimental::Detail::RRawPtrWriteEntry& wiresEntry, ROOT::RFieldToken wiresToken, ROOT::Experimental::RNTupleFillContext& roisContext, ROOT::Experimental::Detail::RRawPtrWriteEntry& roisEntry, ROOT::RFieldToken roisToken, std::mutex& mutex, int numSpills, int adjustedHits, int adjustedWires, int roisPerWire) {
+double RunAOS_spill_perGroupWorkFunc(int first, int last, unsigned seed, ROOT::Experimental::RNTupleFillContext& hitsContext, ROOT::Experimental::Detail::RRawPtrWriteEntry& hitsEntry, ROOT::RFieldToken hitsToken, ROOT::Experimental::RNTupleFillContext& wiresContext, ROOT::Experimental::Detail::RRawPtrWriteEntry& wiresEntry, ROOT::RFieldToken wiresToken, ROOT::Experimental::RNTupleFillContext& roisContext, ROOT::Experimental::Detail::RRawPtrWriteEntry& roisEntry, ROOT::RFieldToken roisToken, std::mutex& mutex, int numSpills, int hitsPerEvent, int wiresPerEvent, int roisPerWire) {
     std::mt19937 rng(seed);
     TStopwatch sw;
     double totalTime = 0.0;
     for (int idx = first; idx < last; ++idx) {
         int evt = idx / numSpills;
         int spill = idx % numSpills;
-        auto hits = generateEventHits(evt * numSpills + spill, adjustedHits, rng);
-        auto wires = generateEventWires(evt * numSpills + spill, adjustedWires, roisPerWire, rng);
+        // Every spill gets an equal share of its event, the remainder is dropped as before
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
+        const int spillHits = size.hits / numSpills;
+        const int spillWires = size.wires / numSpills;
+        auto hits = generateEventHits(evt * numSpills + spill, spillHits, rng);
+        auto wires = generateEventWires(evt * numSpills + spill, spillWires, size.roisPerWire, rng);
         auto rois = flattenROIs(wires);
         std::vector<WireBase> baseWires;
         for(const auto& w : wires) baseWires.push_back(extractWireBase(w));
@@ -602,15 +641,23 @@ double RunAOS_topObject_perDataProductWorkFunc(int first, int last, unsigned see
     double totalTime = 0.0;
     auto hitPtr = hitsEntry.GetPtr<HitIndividual>("hit");
     auto wirePtr = wiresEntry.GetPtr<WireIndividual>("wire");
-    const int K = (hitsPerEvent > wiresPerEvent) ? hitsPerEvent : wiresPerEvent;
+    // K slots per event, enough for the largest event; slots past its size stay empty
+    const EventSize maxSize = maxEventSize(hitsPerEvent, wiresPerEvent, roisPerWire);
+    const int K = std::max(maxSize.hits, maxSize.wires);
+    EventSize size;
+    int sizeEvt = -1;
     for (int idx = first; idx < last; ++idx) {
         int evt = idx / K;
         int k   = idx % K;
+        if (evt != sizeEvt) {
+            size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
+            sizeEvt = evt;
+        }
         sw.Start();
-        if (k < hitsPerEvent) {
+        if (k < size.hits) {
             std::uint32_t hSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('H'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(k));
             std::mt19937 hRng(hSeed);
-            *hitPtr = generateRandomHitIndividual(static_cast<long long>(evt) * hitsPerEvent + k, hRng);
+            *hitPtr = generateRandomHitIndividual(static_cast<long long>(evt) * maxSize.hits + k, hRng);
             ROOT::RNTupleFillStatus hitsStatus;
             hitsContext.FillNoFlush(hitsEntry, hitsStatus);
             if (hitsStatus.ShouldFlushCluster()) {
@@ -618,10 +665,10 @@ double RunAOS_topObject_perDataProductWorkFunc(int first, int last, unsigned see
                 { std::lock_guard<std::mutex> lock(mutex); hitsContext.FlushCluster(); }
             }
         }
-        if (k < wiresPerEvent) {
+        if (k < size.wires) {
             std::uint32_t wSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('W'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(k));
             std::mt19937 wRng(wSeed);
-            *wirePtr = generateRandomWireIndividual(evt, roisPerWire, wRng);
+            *wirePtr = generateRandomWireIndividual(evt, size.roisPerWire, wRng);
             ROOT::RNTupleFillStatus wiresStatus;
             wiresContext.FillNoFlush(wiresEntry, wiresStatus);
             if (wiresStatus.ShouldFlushCluster()) {
@@ -643,15 +690,23 @@ double RunAOS_topObject_perGroupWorkFunc(int first, int last, unsigned seed, ROO
     auto hitPtr = hitsEntry.GetPtr<HitIndividual>("hit");
     auto wirePtr = wiresEntry.GetPtr<WireBase>("wire");
     auto roisPtr = roisEntry.GetPtr<std::vector<FlatROI>>("rois");
-    const int K = (hitsPerEvent > wiresPerEvent) ? hitsPerEvent : wiresPerEvent;
+    // K slots per event, enough for the largest event; slots past its size stay empty
+    const EventSize maxSize = maxEventSize(hitsPerEvent, wiresPerEvent, roisPerWire);
+    const int K = std::max(maxSize.hits, maxSize.wires);
+    EventSize size;
+    int sizeEvt = -1;
     for (int idx = first; idx < last; ++idx) {
         int evt = idx / K;
         int k   = idx % K;
+        if (evt != sizeEvt) {
+            size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
+            sizeEvt = evt;
+        }
         sw.Start();
-        if (k < hitsPerEvent) {
+        if (k < size.hits) {
             std::uint32_t hSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('H'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(k));
             std::mt19937 hRng(hSeed);
-            *hitPtr = generateRandomHitIndividual(static_cast<long long>(evt) * hitsPerEvent + k, hRng);
+            *hitPtr = generateRandomHitIndividual(static_cast<long long>(evt) * maxSize.hits + k, hRng);
             ROOT::RNTupleFillStatus hitsStatus;
             hitsContext.FillNoFlush(hitsEntry, hitsStatus);
             if (hitsStatus.ShouldFlushCluster()) {
@@ -659,10 +714,10 @@ double RunAOS_topObject_perGroupWorkFunc(int first, int last, unsigned seed, ROO
                 { std::lock_guard<std::mutex> lock(mutex); hitsContext.FlushCluster(); }
             }
         }
-        if (k < wiresPerEvent) {
+        if (k < size.wires) {
             std::uint32_t wSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('W'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(k));
             std::mt19937 wRng(wSeed);
-            WireIndividual fullWire = generateRandomWireIndividual(evt, roisPerWire, wRng);
+            WireIndividual fullWire = generateRandomWireIndividual(evt, size.roisPerWire, wRng);
             *wirePtr = extractWireBase(fullWire);
             ROOT::RNTupleFillStatus wiresStatus;
             wiresContext.FillNoFlush(wiresEntry, wiresStatus);
@@ -722,16 +777,14 @@ double RunAOS_element_hitsWorkFunc(int first, int last, unsigned seed, ROOT::Exp
 double RunAOS_element_wireROIWorkFunc(int first, int last, unsigned seed, ROOT::Experimental::RNTupleFillContext& context, ROOT::REntry& entry, std::mutex& mutex, int roisPerWire) {
     std::mt19937 rng(seed);
     TStopwatch sw;
-    std::uniform_real_distribution<float> distADC(0.0f, 100.0f);
     double totalTime = 0.0;
     auto wroiPtr = entry.GetPtr<WireROI>("wire_roi");
     for (int idx = first; idx < last; ++idx) {
         wroiPtr->EventID = idx / roisPerWire;
-        wroiPtr->fWire_Channel = rng() % 1024;
-        wroiPtr->fWire_View = rng() % 7;
+        generateWireChannelAndView(wroiPtr->fWire_Channel, wroiPtr->fWire_View, rng);
         wroiPtr->roi.offset = rng() % 500;
-        wroiPtr->roi.data.resize(10);
-        for (auto& val : wroiPtr->roi.data) val = distADC(rng);
+        const std::size_t length = drawROILength(rng);
+        wroiPtr->roi.data = generateROISamples(wroiPtr->fWire_Channel, length, rng);
         sw.Start();
         ROOT::RNTupleFillStatus status;
         context.FillNoFlush(entry, status);
@@ -753,8 +806,7 @@ double RunAOS_element_wiresWorkFunc(int first, int last, unsigned seed, ROOT::Ex
     auto wirePtr = entry.GetPtr<WireBase>("wire");
     for (int idx = first; idx < last; ++idx) {
         wirePtr->EventID = idx;
-        wirePtr->fWire_Channel = rng() % 1024;
-        wirePtr->fWire_View = rng() % 7;
+        generateWireChannelAndView(wirePtr->fWire_Channel, wirePtr->fWire_View, rng);
         sw.Start();
         ROOT::RNTupleFillStatus status;
         context.FillNoFlush(entry, status);
@@ -772,17 +824,19 @@ double RunAOS_element_wiresWorkFunc(int first, int last, unsigned seed, ROOT::Ex
 double RunAOS_element_roisWorkFunc(int first, int last, unsigned seed, ROOT::Experimental::RNTupleFillContext& context, ROOT::REntry& entry, std::mutex& mutex, int roisPerWire) {
     std::mt19937 rng(seed);
     TStopwatch sw;
-    std::uniform_real_distribution<float> distADC(0.0f, 100.0f);
     double totalTime = 0.0;
     auto roiPtr = entry.GetPtr<FlatROI>("roi");
+    unsigned int channel = 0;
+    int view = 0;
     for (int idx = first; idx < last; ++idx) {
         unsigned int eventID = idx / (roisPerWire * 1000000); // rough grouping; adjust as needed
-        unsigned int wireIdx = (idx / roisPerWire) % 1000000;
+        // Every roisPerWire ROIs belong to one wire; its channel shapes the samples
+        if (idx == first || idx % roisPerWire == 0) generateWireChannelAndView(channel, view, rng);
         roiPtr->EventID = eventID;
-        roiPtr->WireID  = wireIdx;
+        roiPtr->WireID  = channel;
         roiPtr->offset  = rng() % 500;
-        roiPtr->data.resize(10);
-        for (auto& val : roiPtr->data) val = distADC(rng);
+        const std::size_t length = drawROILength(rng);
+        roiPtr->data = generateROISamples(channel, length, rng);
         sw.Start();
         ROOT::RNTupleFillStatus status;
         context.FillNoFlush(entry, status);
@@ -808,10 +862,12 @@ double RunAOS_element_perDataProductCombinedWorkFunc(int firstEvt, int lastEvt,
     auto hitPtr   = hitsEntry.GetPtr<HitIndividual>("hit");
     auto wroiPtr  = wireROIEntry.GetPtr<WireROI>("wire_roi");
 
+    const EventSize maxSize = maxEventSize(hitsPerEvent, wiresPerEvent, roisPerWire); // hit ID stride
     for (int evt = firstEvt; evt < lastEvt; ++evt) {
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
         // hits (deterministic per-entry)
-        for (int h = 0; h < hitsPerEvent; ++h) {
-            long long gid = static_cast<long long>(evt) * hitsPerEvent + h;
+        for (int h = 0; h < size.hits; ++h) {
+            long long gid = static_cast<long long>(evt) * maxSize.hits + h;
             std::uint32_t hSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('H'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(h));
             std::mt19937 hRng(hSeed);
             *hitPtr = generateRandomHitIndividual(gid, hRng);
@@ -825,12 +881,12 @@ double RunAOS_element_perDataProductCombinedWorkFunc(int firstEvt, int lastEvt,
             totalTime += sw.RealTime();
         }
         // wire ROIs (deterministic per wire and ROI)
-        for (int w = 0; w < wiresPerEvent; ++w) {
+        for (int w = 0; w < size.wires; ++w) {
             // Build deterministic wire to source channel/view and ROI count
             std::uint32_t wSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('W'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(w));
             std::mt19937 wRng(wSeed);
-            WireIndividual wInd = generateRandomWireIndividual(evt, roisPerWire, wRng);
-            for (int r = 0; r < roisPerWire; ++r) {
+            WireIndividual wInd = generateRandomWireIndividual(evt, size.roisPerWire, wRng);
+            for (int r = 0; r < size.roisPerWire; ++r) {
                 wroiPtr->EventID       = evt;
                 wroiPtr->fWire_Channel = wInd.fWire_Channel;
                 wroiPtr->fWire_View    = wInd.fWire_View;
@@ -869,9 +925,11 @@ double RunSOA_element_perDataProductCombinedWorkFunc(int firstEvt, int lastEvt,
     auto hitPtr  = hitsEntry.GetPtr<SOAHit>("hit");
     auto roiPtr  = roisEntry.GetPtr<FlatSOAROI>("roi");
 
+    const EventSize maxSize = maxEventSize(hitsPerEvent, wiresPerEvent, roisPerWire); // hit ID stride
     for (int evt = firstEvt; evt < lastEvt; ++evt) {
-        for (int h = 0; h < hitsPerEvent; ++h) {
-            long long gid = static_cast<long long>(evt) * hitsPerEvent + h;
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
+        for (int h = 0; h < size.hits; ++h) {
+            long long gid = static_cast<long long>(evt) * maxSize.hits + h;
             std::uint32_t hSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('H'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(h));
             std::mt19937 hRng(hSeed);
             HitIndividual hInd = generateRandomHitIndividual(gid, hRng);
@@ -909,12 +967,12 @@ double RunSOA_element_perDataProductCombinedWorkFunc(int firstEvt, int lastEvt,
                 { std::lock_guard<std::mutex> lock(mutex); hitsContext.FlushCluster(); }
             }
         }
-        for (int w = 0; w < wiresPerEvent; ++w) {
+        for (int w = 0; w < size.wires; ++w) {
             // Deterministic wire/ROI mapping to FlatSOAROI
             std::uint32_t wSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('W'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(w));
             std::mt19937 wRng(wSeed);
-            WireIndividual wInd = generateRandomWireIndividual(evt, roisPerWire, wRng);
-            for (int r = 0; r < roisPerWire; ++r) {
+            WireIndividual wInd = generateRandomWireIndividual(evt, size.roisPerWire, wRng);
+            for (int r = 0; r < size.roisPerWire; ++r) {
                 roiPtr->EventID = static_cast<unsigned int>(evt);
                 roiPtr->WireID  = static_cast<unsigned int>(wInd.fWire_Channel);
                 roiPtr->data    = wInd.getSignalROI()[r].data;
@@ -950,10 +1008,12 @@ double RunAOS_element_perGroupCombinedWorkFunc(int firstEvt, int lastEvt, unsign
     auto wirePtr = wiresEntry.GetPtr<WireBase>("wire");
     auto roiPtr  = roisEntry.GetPtr<FlatROI>("roi");
 
+    const EventSize maxSize = maxEventSize(hitsPerEvent, wiresPerEvent, roisPerWire); // hit ID stride
     for (int evt = firstEvt; evt < lastEvt; ++evt) {
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
         // hits (deterministic per-entry)
-        for (int h = 0; h < hitsPerEvent; ++h) {
-            long long gid = static_cast<long long>(evt) * hitsPerEvent + h;
+        for (int h = 0; h < size.hits; ++h) {
+            long long gid = static_cast<long long>(evt) * maxSize.hits + h;
             std::uint32_t hSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('H'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(h));
             std::mt19937 hRng(hSeed);
             *hitPtr = generateRandomHitIndividual(gid, hRng);
@@ -967,10 +1027,10 @@ double RunAOS_element_perGroupCombinedWorkFunc(int firstEvt, int lastEvt, unsign
             totalTime += sw.RealTime();
         }
         // wires & ROIs (deterministic per wire and ROI)
-        for (int w = 0; w < wiresPerEvent; ++w) {
+        for (int w = 0; w < size.wires; ++w) {
             std::uint32_t wSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('W'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(w));
             std::mt19937 wRng(wSeed);
-            WireIndividual wInd = generateRandomWireIndividual(evt, roisPerWire, wRng);
+            WireIndividual wInd = generateRandomWireIndividual(evt, size.roisPerWire, wRng);
             // base wire
             wirePtr->EventID = evt;
             wirePtr->fWire_Channel = wInd.fWire_Channel;
@@ -985,7 +1045,7 @@ double RunAOS_element_perGroupCombinedWorkFunc(int firstEvt, int lastEvt, unsign
             }
 
             // its ROIs (deterministic)
-            for (int r = 0; r < roisPerWire; ++r) {
+            for (int r = 0; r < size.roisPerWire; ++r) {
                 roiPtr->EventID = evt;
                 roiPtr->WireID  = wInd.fWire_Channel;
                 roiPtr->offset  = wInd.getSignalROI()[r].offset;
@@ -1018,7 +1078,6 @@ double RunSOA_element_perGroupCombinedWorkFunc(int firstEvt, int lastEvt, unsign
     ROOT::Experimental::RNTupleFillContext& wiresContext, ROOT::REntry& wiresEntry,
     ROOT::Experimental::RNTupleFillContext& roisContext, ROOT::REntry& roisEntry,
     std::mutex& mutex, int hitsPerEvent, int wiresPerEvent, int roisPerWire) {
-    std::mt19937 rng(seed);
     TStopwatch sw;
     double totalTime = 0.0;
 
@@ -1026,9 +1085,14 @@ double RunSOA_element_perGroupCombinedWorkFunc(int firstEvt, int lastEvt, unsign
     auto wirePtr = wiresEntry.GetPtr<SOAWireBase>("wire");
     auto roiPtr  = roisEntry.GetPtr<FlatSOAROI>("roi");
 
+    const EventSize maxSize = maxEventSize(hitsPerEvent, wiresPerEvent, roisPerWire); // hit ID stride
     for (int evt = firstEvt; evt < lastEvt; ++evt) {
-        for (int h = 0; h < hitsPerEvent; ++h) {
-            *hitPtr = generateSOASingleHit(static_cast<long long>(evt) * hitsPerEvent + h, rng);
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
+        // hits (deterministic per-entry, the same hits as the other layouts)
+        for (int h = 0; h < size.hits; ++h) {
+            std::uint32_t hSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('H'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(h));
+            std::mt19937 hRng(hSeed);
+            *hitPtr = generateSOASingleHit(static_cast<long long>(evt) * maxSize.hits + h, hRng);
             sw.Start();
             ROOT::RNTupleFillStatus hitStatus;
             hitsContext.FillNoFlush(hitsEntry, hitStatus);
@@ -1038,10 +1102,14 @@ double RunSOA_element_perGroupCombinedWorkFunc(int firstEvt, int lastEvt, unsign
                 { std::lock_guard<std::mutex> lock(mutex); hitsContext.FlushCluster(); }
             }
         }
-        for (int w = 0; w < wiresPerEvent; ++w) {
+        // wires & ROIs (deterministic per wire, the same wires as the event layouts)
+        for (int w = 0; w < size.wires; ++w) {
+            std::uint32_t wSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('W'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(w));
+            std::mt19937 wRng(wSeed);
+            WireIndividual wInd = generateRandomWireIndividual(evt, size.roisPerWire, wRng);
             wirePtr->EventID = evt;
-            wirePtr->fWire_Channel = rng() % 1024;
-            wirePtr->fWire_View    = rng() % 7;
+            wirePtr->fWire_Channel = wInd.fWire_Channel;
+            wirePtr->fWire_View = wInd.fWire_View;
             sw.Start();
             ROOT::RNTupleFillStatus wireStatus;
             wiresContext.FillNoFlush(wiresEntry, wireStatus);
@@ -1050,8 +1118,11 @@ double RunSOA_element_perGroupCombinedWorkFunc(int firstEvt, int lastEvt, unsign
                 wiresContext.FlushColumns();
                 { std::lock_guard<std::mutex> lock(mutex); wiresContext.FlushCluster(); }
             }
-            for (int r = 0; r < roisPerWire; ++r) {
-                *roiPtr = generateSOASingleROI(evt, w, rng);
+            for (int r = 0; r < size.roisPerWire; ++r) {
+                roiPtr->EventID = static_cast<unsigned int>(evt);
+                roiPtr->WireID  = wInd.fWire_Channel;
+                roiPtr->offset  = wInd.getSignalROI()[r].offset;
+                roiPtr->data    = wInd.getSignalROI()[r].data;
                 sw.Start();
                 ROOT::RNTupleFillStatus roiStatus;
                 roisContext.FillNoFlush(roisEntry, roiStatus);
@@ -1171,6 +1242,17 @@ auto CreateSOAAllDataProductModelAndToken() -> std::pair<std::unique_ptr<ROOT::R
     return {std::move(model), model->GetToken("EventSOA")};
 }
 
+auto CreateSOASpillModelAndTokens() -> std::tuple<std::unique_ptr<ROOT::RNTupleModel>, ROOT::RFieldToken, ROOT::RFieldToken, ROOT::RFieldToken> {
+    auto model = ROOT::RNTupleModel::Create();
+    model->MakeField<EventSOA>("EventSOA");
+    model->MakeField<long long>("EventID");
+    model->MakeField<int>("SpillID");
+    auto token = model->GetToken("EventSOA");
+    auto eventIdToken = model->GetToken("EventID");
+    auto spillIdToken = model->GetToken("SpillID");
+    return {std::move(model), token, eventIdToken, spillIdToken};
+}
+
 auto CreateSOAHitsModelAndToken() -> std::pair<std::unique_ptr<ROOT::RNTupleModel>, ROOT::RFieldToken> {
     auto model = ROOT::RNTupleModel::Create();
     model->MakeField<SOAHitVector>("hits");
@@ -1200,35 +1282,36 @@ double RunSOA_event_allDataProductWorkFunc(int first, int last, unsigned seed, R
     TStopwatch sw;
     double totalTime = 0.0;
     for (int evt = first; evt < last; ++evt) {
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
         EventSOA eventData;
         // Deterministic generation independent of thread/config
         // Build SOA vectors from deterministic AOS individuals to avoid duplication
-        auto aosHits = generateEventHitsDeterministic(evt, hitsPerEvent);
+        auto aosHits = generateEventHitsDeterministic(evt, size.hits);
         SOAHitVector soaHits;
-        soaHits.EventIDs.resize(hitsPerEvent, evt);
-        soaHits.fChannel.resize(hitsPerEvent);
-        soaHits.fView.resize(hitsPerEvent);
-        soaHits.fStartTick.resize(hitsPerEvent);
-        soaHits.fEndTick.resize(hitsPerEvent);
-        soaHits.fPeakTime.resize(hitsPerEvent);
-        soaHits.fSigmaPeakTime.resize(hitsPerEvent);
-        soaHits.fRMS.resize(hitsPerEvent);
-        soaHits.fPeakAmplitude.resize(hitsPerEvent);
-        soaHits.fSigmaPeakAmplitude.resize(hitsPerEvent);
-        soaHits.fROISummedADC.resize(hitsPerEvent);
-        soaHits.fHitSummedADC.resize(hitsPerEvent);
-        soaHits.fIntegral.resize(hitsPerEvent);
-        soaHits.fSigmaIntegral.resize(hitsPerEvent);
-        soaHits.fMultiplicity.resize(hitsPerEvent);
-        soaHits.fLocalIndex.resize(hitsPerEvent);
-        soaHits.fGoodnessOfFit.resize(hitsPerEvent);
-        soaHits.fNDF.resize(hitsPerEvent);
-        soaHits.fSignalType.resize(hitsPerEvent);
-        soaHits.fWireID_Cryostat.resize(hitsPerEvent);
-        soaHits.fWireID_TPC.resize(hitsPerEvent);
-        soaHits.fWireID_Plane.resize(hitsPerEvent);
-        soaHits.fWireID_Wire.resize(hitsPerEvent);
-        for (int i = 0; i < hitsPerEvent; ++i) {
+        soaHits.EventIDs.resize(size.hits, evt);
+        soaHits.fChannel.resize(size.hits);
+        soaHits.fView.resize(size.hits);
+        soaHits.fStartTick.resize(size.hits);
+        soaHits.fEndTick.resize(size.hits);
+        soaHits.fPeakTime.resize(size.hits);
+        soaHits.fSigmaPeakTime.resize(size.hits);
+        soaHits.fRMS.resize(size.hits);
+        soaHits.fPeakAmplitude.resize(size.hits);
+        soaHits.fSigmaPeakAmplitude.resize(size.hits);
+        soaHits.fROISummedADC.resize(size.hits);
+        soaHits.fHitSummedADC.resize(size.hits);
+        soaHits.fIntegral.resize(size.hits);
+        soaHits.fSigmaIntegral.resize(size.hits);
+        soaHits.fMultiplicity.resize(size.hits);
+        soaHits.fLocalIndex.resize(size.hits);
+        soaHits.fGoodnessOfFit.resize(size.hits);
+        soaHits.fNDF.resize(size.hits);
+        soaHits.fSignalType.resize(size.hits);
+        soaHits.fWireID_Cryostat.resize(size.hits);
+        soaHits.fWireID_TPC.resize(size.hits);
+        soaHits.fWireID_Plane.resize(size.hits);
+        soaHits.fWireID_Wire.resize(size.hits);
+        for (int i = 0; i < size.hits; ++i) {
             const auto& h = aosHits[i];
             soaHits.fChannel[i] = h.fChannel;
             soaHits.fView[i] = h.fView;
@@ -1254,13 +1337,13 @@ double RunSOA_event_allDataProductWorkFunc(int first, int last, unsigned seed, R
             soaHits.fWireID_Wire[i] = h.fWireID_Wire;
         }
 
-        auto aosWires = generateEventWiresDeterministic(evt, wiresPerEvent, roisPerWire);
+        auto aosWires = generateEventWiresDeterministic(evt, size.wires, size.roisPerWire);
         SOAWireVector soaWires;
-        soaWires.EventIDs.resize(wiresPerEvent, evt);
-        soaWires.fWire_Channel.resize(wiresPerEvent);
-        soaWires.fWire_View.resize(wiresPerEvent);
-        soaWires.fSignalROI.resize(wiresPerEvent);
-        for (int w = 0; w < wiresPerEvent; ++w) {
+        soaWires.EventIDs.resize(size.wires, evt);
+        soaWires.fWire_Channel.resize(size.wires);
+        soaWires.fWire_View.resize(size.wires);
+        soaWires.fSignalROI.resize(size.wires);
+        for (int w = 0; w < size.wires; ++w) {
             const auto& wi = aosWires[w];
             soaWires.fWire_Channel[w] = wi.fWire_Channel;
             soaWires.fWire_View[w] = wi.fWire_View;
@@ -1290,33 +1373,34 @@ double RunSOA_event_perDataProductWorkFunc(int first, int last, unsigned seed, R
     TStopwatch sw;
     double totalTime = 0.0;
     for (int evt = first; evt < last; ++evt) {
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
         // Deterministic generation by building SOA from deterministic AOS individuals
-        auto aosHits = generateEventHitsDeterministic(evt, hitsPerEvent);
+        auto aosHits = generateEventHitsDeterministic(evt, size.hits);
         SOAHitVector hits;
-        hits.EventIDs.resize(hitsPerEvent, evt);
-        hits.fChannel.resize(hitsPerEvent);
-        hits.fView.resize(hitsPerEvent);
-        hits.fStartTick.resize(hitsPerEvent);
-        hits.fEndTick.resize(hitsPerEvent);
-        hits.fPeakTime.resize(hitsPerEvent);
-        hits.fSigmaPeakTime.resize(hitsPerEvent);
-        hits.fRMS.resize(hitsPerEvent);
-        hits.fPeakAmplitude.resize(hitsPerEvent);
-        hits.fSigmaPeakAmplitude.resize(hitsPerEvent);
-        hits.fROISummedADC.resize(hitsPerEvent);
-        hits.fHitSummedADC.resize(hitsPerEvent);
-        hits.fIntegral.resize(hitsPerEvent);
-        hits.fSigmaIntegral.resize(hitsPerEvent);
-        hits.fMultiplicity.resize(hitsPerEvent);
-        hits.fLocalIndex.resize(hitsPerEvent);
-        hits.fGoodnessOfFit.resize(hitsPerEvent);
-        hits.fNDF.resize(hitsPerEvent);
-        hits.fSignalType.resize(hitsPerEvent);
-        hits.fWireID_Cryostat.resize(hitsPerEvent);
-        hits.fWireID_TPC.resize(hitsPerEvent);
-        hits.fWireID_Plane.resize(hitsPerEvent);
-        hits.fWireID_Wire.resize(hitsPerEvent);
-        for (int i = 0; i < hitsPerEvent; ++i) {
+        hits.EventIDs.resize(size.hits, evt);
+        hits.fChannel.resize(size.hits);
+        hits.fView.resize(size.hits);
+        hits.fStartTick.resize(size.hits);
+        hits.fEndTick.resize(size.hits);
+        hits.fPeakTime.resize(size.hits);
+        hits.fSigmaPeakTime.resize(size.hits);
+        hits.fRMS.resize(size.hits);
+        hits.fPeakAmplitude.resize(size.hits);
+        hits.fSigmaPeakAmplitude.resize(size.hits);
+        hits.fROISummedADC.resize(size.hits);
+        hits.fHitSummedADC.resize(size.hits);
+        hits.fIntegral.resize(size.hits);
+        hits.fSigmaIntegral.resize(size.hits);
+        hits.fMultiplicity.resize(size.hits);
+        hits.fLocalIndex.resize(size.hits);
+        hits.fGoodnessOfFit.resize(size.hits);
+        hits.fNDF.resize(size.hits);
+        hits.fSignalType.resize(size.hits);
+        hits.fWireID_Cryostat.resize(size.hits);
+        hits.fWireID_TPC.resize(size.hits);
+        hits.fWireID_Plane.resize(size.hits);
+        hits.fWireID_Wire.resize(size.hits);
+        for (int i = 0; i < size.hits; ++i) {
             const auto& h = aosHits[i];
             hits.fChannel[i] = h.fChannel;
             hits.fView[i] = h.fView;
@@ -1342,13 +1426,13 @@ double RunSOA_event_perDataProductWorkFunc(int first, int last, unsigned seed, R
             hits.fWireID_Wire[i] = h.fWireID_Wire;
         }
 
-        auto aosWires = generateEventWiresDeterministic(evt, wiresPerEvent, roisPerWire);
+        auto aosWires = generateEventWiresDeterministic(evt, size.wires, size.roisPerWire);
         SOAWireVector wires;
-        wires.EventIDs.resize(wiresPerEvent, evt);
-        wires.fWire_Channel.resize(wiresPerEvent);
-        wires.fWire_View.resize(wiresPerEvent);
-        wires.fSignalROI.resize(wiresPerEvent);
-        for (int w = 0; w < wiresPerEvent; ++w) {
+        wires.EventIDs.resize(size.wires, evt);
+        wires.fWire_Channel.resize(size.wires);
+        wires.fWire_View.resize(size.wires);
+        wires.fSignalROI.resize(size.wires);
+        for (int w = 0; w < size.wires; ++w) {
             const auto& wi = aosWires[w];
             wires.fWire_Channel[w] = wi.fWire_Channel;
             wires.fWire_View[w] = wi.fWire_View;
@@ -1381,33 +1465,34 @@ double RunSOA_event_perGroupWorkFunc(int first, int last, unsigned seed, ROOT::E
     TStopwatch sw;
     double totalTime = 0.0;
     for (int evt = first; evt < last; ++evt) {
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
         // Deterministic generation by building SOA from deterministic AOS individuals
-        auto aosHits = generateEventHitsDeterministic(evt, hitsPerEvent);
+        auto aosHits = generateEventHitsDeterministic(evt, size.hits);
         SOAHitVector hits;
-        hits.EventIDs.resize(hitsPerEvent, evt);
-        hits.fChannel.resize(hitsPerEvent);
-        hits.fView.resize(hitsPerEvent);
-        hits.fStartTick.resize(hitsPerEvent);
-        hits.fEndTick.resize(hitsPerEvent);
-        hits.fPeakTime.resize(hitsPerEvent);
-        hits.fSigmaPeakTime.resize(hitsPerEvent);
-        hits.fRMS.resize(hitsPerEvent);
-        hits.fPeakAmplitude.resize(hitsPerEvent);
-        hits.fSigmaPeakAmplitude.resize(hitsPerEvent);
-        hits.fROISummedADC.resize(hitsPerEvent);
-        hits.fHitSummedADC.resize(hitsPerEvent);
-        hits.fIntegral.resize(hitsPerEvent);
-        hits.fSigmaIntegral.resize(hitsPerEvent);
-        hits.fMultiplicity.resize(hitsPerEvent);
-        hits.fLocalIndex.resize(hitsPerEvent);
-        hits.fGoodnessOfFit.resize(hitsPerEvent);
-        hits.fNDF.resize(hitsPerEvent);
-        hits.fSignalType.resize(hitsPerEvent);
-        hits.fWireID_Cryostat.resize(hitsPerEvent);
-        hits.fWireID_TPC.resize(hitsPerEvent);
-        hits.fWireID_Plane.resize(hitsPerEvent);
-        hits.fWireID_Wire.resize(hitsPerEvent);
-        for (int i = 0; i < hitsPerEvent; ++i) {
+        hits.EventIDs.resize(size.hits, evt);
+        hits.fChannel.resize(size.hits);
+        hits.fView.resize(size.hits);
+        hits.fStartTick.resize(size.hits);
+        hits.fEndTick.resize(size.hits);
+        hits.fPeakTime.resize(size.hits);
+        hits.fSigmaPeakTime.resize(size.hits);
+        hits.fRMS.resize(size.hits);
+        hits.fPeakAmplitude.resize(size.hits);
+        hits.fSigmaPeakAmplitude.resize(size.hits);
+        hits.fROISummedADC.resize(size.hits);
+        hits.fHitSummedADC.resize(size.hits);
+        hits.fIntegral.resize(size.hits);
+        hits.fSigmaIntegral.resize(size.hits);
+        hits.fMultiplicity.resize(size.hits);
+        hits.fLocalIndex.resize(size.hits);
+        hits.fGoodnessOfFit.resize(size.hits);
+        hits.fNDF.resize(size.hits);
+        hits.fSignalType.resize(size.hits);
+        hits.fWireID_Cryostat.resize(size.hits);
+        hits.fWireID_TPC.resize(size.hits);
+        hits.fWireID_Plane.resize(size.hits);
+        hits.fWireID_Wire.resize(size.hits);
+        for (int i = 0; i < size.hits; ++i) {
             const auto& h = aosHits[i];
             hits.fChannel[i] = h.fChannel;
             hits.fView[i] = h.fView;
@@ -1433,13 +1518,13 @@ double RunSOA_event_perGroupWorkFunc(int first, int last, unsigned seed, ROOT::E
             hits.fWireID_Wire[i] = h.fWireID_Wire;
         }
 
-        auto aosWires = generateEventWiresDeterministic(evt, wiresPerEvent, roisPerWire);
+        auto aosWires = generateEventWiresDeterministic(evt, size.wires, size.roisPerWire);
         SOAWireVector wires;
-        wires.EventIDs.resize(wiresPerEvent, evt);
-        wires.fWire_Channel.resize(wiresPerEvent);
-        wires.fWire_View.resize(wiresPerEvent);
-        wires.fSignalROI.resize(wiresPerEvent);
-        for (int w = 0; w < wiresPerEvent; ++w) {
+        wires.EventIDs.resize(size.wires, evt);
+        wires.fWire_Channel.resize(size.wires);
+        wires.fWire_View.resize(size.wires);
+        wires.fSignalROI.resize(size.wires);
+        for (int w = 0; w < size.wires; ++w) {
             const auto& wi = aosWires[w];
             wires.fWire_Channel[w] = wi.fWire_Channel;
             wires.fWire_View[w] = wi.fWire_View;
@@ -1459,18 +1544,15 @@ double RunSOA_event_perGroupWorkFunc(int first, int last, unsigned seed, ROOT::E
             { std::lock_guard<std::mutex> lock(mutex); hitsContext.FlushCluster(); }
         }
         wiresEntry.BindRawPtr(wiresToken, &baseWires);
-        ROOT::RNTupleFillStatus wiresStatus;
-        wiresContext.FillNoFlush(wiresEntry, wiresStatus);
-        if (wiresStatus.ShouldFlushCluster()) {
-            wiresContext.FlushColumns();
-            { std::lock_guard<std::mutex> lock(mutex); wiresContext.FlushCluster(); }
-        }
         roisEntry.BindRawPtr(roisToken, &rois);
-        ROOT::RNTupleFillStatus roisStatus;
+        ROOT::RNTupleFillStatus wiresStatus, roisStatus;
+        wiresContext.FillNoFlush(wiresEntry, wiresStatus);
         roisContext.FillNoFlush(roisEntry, roisStatus);
-        if (roisStatus.ShouldFlushCluster()) {
+        // The SOAROI vectors have no EventID: shared cluster boundaries keep them parallel to the wires
+        if (wiresStatus.ShouldFlushCluster() || roisStatus.ShouldFlushCluster()) {
+            wiresContext.FlushColumns();
             roisContext.FlushColumns();
-            { std::lock_guard<std::mutex> lock(mutex); roisContext.FlushCluster(); }
+            { std::lock_guard<std::mutex> lock(mutex); wiresContext.FlushCluster(); roisContext.FlushCluster(); }
         }
         totalTime += sw.RealTime();
     }
@@ -1529,13 +1611,12 @@ SOAWire generateSOASingleWire(long long id, int roisPerWire, std::mt19937& rng)
     return wire;
 }
 
-FlatSOAROI generateSOASingleROI(unsigned int eventID, unsigned int wireID, std::mt19937& rng) {
+FlatSOAROI generateSOASingleROI(unsigned int eventID, unsigned int channel, std::mt19937& rng) {
     FlatSOAROI roi;
-    std::uniform_real_distribution<float> distADC(0.0f, 100.0f);
     roi.EventID = eventID;
-    roi.WireID  = wireID;
-    roi.data.resize(10);
-    for (auto& val : roi.data) val = distADC(rng);
+    roi.WireID  = channel;
+    const std::size_t length = drawROILength(rng);
+    roi.data = generateROISamples(channel, length, rng);
     return roi;
 }
 
@@ -1554,43 +1635,47 @@ std::vector<FlatSOAROI> flattenSOAROIsWithID(const SOAWireVector& wires) {
 }
 
 // SOA spill work functions (mirror AOS but use SOA gen)
-double RunSOA_spill_allDataProductWorkFunc(int first, int last, unsigned seed, ROOT::Experimental::RNTupleFillContext& context, ROOT::Experimental::Detail::RRawPtrWriteEntry& entry, ROOT::RFieldToken token, std::mutex& mutex, int numSpills, int adjustedHits, int adjustedWires, int roisPerWire) {
+double RunSOA_spill_allDataProductWorkFunc(int first, int last, unsigned seed, ROOT::Experimental::RNTupleFillContext& context, ROOT::Experimental::Detail::RRawPtrWriteEntry& entry, ROOT::RFieldToken token, ROOT::RFieldToken eventIdToken, ROOT::RFieldToken spillIdToken, std::mutex& mutex, int numSpills, int hitsPerEvent, int wiresPerEvent, int roisPerWire) {
     std::mt19937 rng(seed);
     TStopwatch sw;
     double totalTime = 0.0;
     for (int idx = first; idx < last; ++idx) {
         int evt = idx / numSpills;
         int spill = idx % numSpills;
-        int startHit = spill * adjustedHits;
-        int startWire = spill * adjustedWires;
+        // Every spill gets an equal share of its event, the remainder is dropped as before
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
+        const int spillHits = size.hits / numSpills;
+        const int spillWires = size.wires / numSpills;
+        int startHit = spill * spillHits;
+        int startWire = spill * spillWires;
         EventSOA spillData;
         // Build deterministic SOA from deterministic AOS slices
-        auto aosHits = generateEventHitsDeterministicRange(evt, startHit, adjustedHits);
+        auto aosHits = generateEventHitsDeterministicRange(evt, startHit, spillHits);
         SOAHitVector hits;
-        hits.EventIDs.resize(adjustedHits, evt);
-        hits.fChannel.resize(adjustedHits);
-        hits.fView.resize(adjustedHits);
-        hits.fStartTick.resize(adjustedHits);
-        hits.fEndTick.resize(adjustedHits);
-        hits.fPeakTime.resize(adjustedHits);
-        hits.fSigmaPeakTime.resize(adjustedHits);
-        hits.fRMS.resize(adjustedHits);
-        hits.fPeakAmplitude.resize(adjustedHits);
-        hits.fSigmaPeakAmplitude.resize(adjustedHits);
-        hits.fROISummedADC.resize(adjustedHits);
-        hits.fHitSummedADC.resize(adjustedHits);
-        hits.fIntegral.resize(adjustedHits);
-        hits.fSigmaIntegral.resize(adjustedHits);
-        hits.fMultiplicity.resize(adjustedHits);
-        hits.fLocalIndex.resize(adjustedHits);
-        hits.fGoodnessOfFit.resize(adjustedHits);
-        hits.fNDF.resize(adjustedHits);
-        hits.fSignalType.resize(adjustedHits);
-        hits.fWireID_Cryostat.resize(adjustedHits);
-        hits.fWireID_TPC.resize(adjustedHits);
-        hits.fWireID_Plane.resize(adjustedHits);
-        hits.fWireID_Wire.resize(adjustedHits);
-        for (int i = 0; i < adjustedHits; ++i) {
+        hits.EventIDs.resize(spillHits, evt);
+        hits.fChannel.resize(spillHits);
+        hits.fView.resize(spillHits);
+        hits.fStartTick.resize(spillHits);
+        hits.fEndTick.resize(spillHits);
+        hits.fPeakTime.resize(spillHits);
+        hits.fSigmaPeakTime.resize(spillHits);
+        hits.fRMS.resize(spillHits);
+        hits.fPeakAmplitude.resize(spillHits);
+        hits.fSigmaPeakAmplitude.resize(spillHits);
+        hits.fROISummedADC.resize(spillHits);
+        hits.fHitSummedADC.resize(spillHits);
+        hits.fIntegral.resize(spillHits);
+        hits.fSigmaIntegral.resize(spillHits);
+        hits.fMultiplicity.resize(spillHits);
+        hits.fLocalIndex.resize(spillHits);
+        hits.fGoodnessOfFit.resize(spillHits);
+        hits.fNDF.resize(spillHits);
+        hits.fSignalType.resize(spillHits);
+        hits.fWireID_Cryostat.resize(spillHits);
+        hits.fWireID_TPC.resize(spillHits);
+        hits.fWireID_Plane.resize(spillHits);
+        hits.fWireID_Wire.resize(spillHits);
+        for (int i = 0; i < spillHits; ++i) {
             const auto& h = aosHits[i];
             hits.fChannel[i] = h.fChannel;
             hits.fView[i] = h.fView;
@@ -1616,13 +1701,13 @@ double RunSOA_spill_allDataProductWorkFunc(int first, int last, unsigned seed, R
             hits.fWireID_Wire[i] = h.fWireID_Wire;
         }
 
-        auto aosWires = generateEventWiresDeterministicRange(evt, startWire, adjustedWires, roisPerWire);
+        auto aosWires = generateEventWiresDeterministicRange(evt, startWire, spillWires, size.roisPerWire);
         SOAWireVector wires;
-        wires.EventIDs.resize(adjustedWires, evt);
-        wires.fWire_Channel.resize(adjustedWires);
-        wires.fWire_View.resize(adjustedWires);
-        wires.fSignalROI.resize(adjustedWires);
-        for (int w = 0; w < adjustedWires; ++w) {
+        wires.EventIDs.resize(spillWires, evt);
+        wires.fWire_Channel.resize(spillWires);
+        wires.fWire_View.resize(spillWires);
+        wires.fSignalROI.resize(spillWires);
+        for (int w = 0; w < spillWires; ++w) {
             const auto& wi = aosWires[w];
             wires.fWire_Channel[w] = wi.fWire_Channel;
             wires.fWire_View[w] = wi.fWire_View;
@@ -1633,8 +1718,11 @@ double RunSOA_spill_allDataProductWorkFunc(int first, int last, unsigned seed, R
         }
         spillData.hits = std::move(hits);
         spillData.wires = std::move(wires);
+        long long eventId = evt;
         sw.Start();
         entry.BindRawPtr(token, &spillData);
+        entry.BindRawPtr(eventIdToken, &eventId);
+        entry.BindRawPtr(spillIdToken, &spill);
         ROOT::RNTupleFillStatus status;
         context.FillNoFlush(entry, status);
         if (status.ShouldFlushCluster()) {
@@ -1646,42 +1734,46 @@ double RunSOA_spill_allDataProductWorkFunc(int first, int last, unsigned seed, R
     return totalTime;
 }
 
-double RunSOA_spill_perDataProductWorkFunc(int first, int last, unsigned seed, ROOT::Experimental::RNTupleFillContext& hitsContext, ROOT::Experimental::Detail::RRawPtrWriteEntry& hitsEntry, ROOT::RFieldToken hitsToken, ROOT::Experimental::RNTupleFillContext& wiresContext, ROOT::Experimental::Detail::RRawPtrWriteEntry& wiresEntry, ROOT::RFieldToken wiresToken, std::mutex& mutex, int numSpills, int adjustedHits, int adjustedWires, int roisPerWire) {
+double RunSOA_spill_perDataProductWorkFunc(int first, int last, unsigned seed, ROOT::Experimental::RNTupleFillContext& hitsContext, ROOT::Experimental::Detail::RRawPtrWriteEntry& hitsEntry, ROOT::RFieldToken hitsToken, ROOT::Experimental::RNTupleFillContext& wiresContext, ROOT::Experimental::Detail::RRawPtrWriteEntry& wiresEntry, ROOT::RFieldToken wiresToken, std::mutex& mutex, int numSpills, int hitsPerEvent, int wiresPerEvent, int roisPerWire) {
     TStopwatch sw;
     double totalTime = 0.0;
     for (int idx = first; idx < last; ++idx) {
         int evt = idx / numSpills;
         int spill = idx % numSpills;
-        int startHit = spill * adjustedHits;
-        int startWire = spill * adjustedWires;
+        // Every spill gets an equal share of its event, the remainder is dropped as before
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
+        const int spillHits = size.hits / numSpills;
+        const int spillWires = size.wires / numSpills;
+        int startHit = spill * spillHits;
+        int startWire = spill * spillWires;
 
         // Build SOA from deterministic AOS slices
-        auto aosHits = generateEventHitsDeterministicRange(evt, startHit, adjustedHits);
+        auto aosHits = generateEventHitsDeterministicRange(evt, startHit, spillHits);
         SOAHitVector hits;
-        hits.EventIDs.resize(adjustedHits, evt);
-        hits.fChannel.resize(adjustedHits);
-        hits.fView.resize(adjustedHits);
-        hits.fStartTick.resize(adjustedHits);
-        hits.fEndTick.resize(adjustedHits);
-        hits.fPeakTime.resize(adjustedHits);
-        hits.fSigmaPeakTime.resize(adjustedHits);
-        hits.fRMS.resize(adjustedHits);
-        hits.fPeakAmplitude.resize(adjustedHits);
-        hits.fSigmaPeakAmplitude.resize(adjustedHits);
-        hits.fROISummedADC.resize(adjustedHits);
-        hits.fHitSummedADC.resize(adjustedHits);
-        hits.fIntegral.resize(adjustedHits);
-        hits.fSigmaIntegral.resize(adjustedHits);
-        hits.fMultiplicity.resize(adjustedHits);
-        hits.fLocalIndex.resize(adjustedHits);
-        hits.fGoodnessOfFit.resize(adjustedHits);
-        hits.fNDF.resize(adjustedHits);
-        hits.fSignalType.resize(adjustedHits);
-        hits.fWireID_Cryostat.resize(adjustedHits);
-        hits.fWireID_TPC.resize(adjustedHits);
-        hits.fWireID_Plane.resize(adjustedHits);
-        hits.fWireID_Wire.resize(adjustedHits);
-        for (int i = 0; i < adjustedHits; ++i) {
+        hits.EventIDs.resize(spillHits, evt);
+        hits.fChannel.resize(spillHits);
+        hits.fView.resize(spillHits);
+        hits.fStartTick.resize(spillHits);
+        hits.fEndTick.resize(spillHits);
+        hits.fPeakTime.resize(spillHits);
+        hits.fSigmaPeakTime.resize(spillHits);
+        hits.fRMS.resize(spillHits);
+        hits.fPeakAmplitude.resize(spillHits);
+        hits.fSigmaPeakAmplitude.resize(spillHits);
+        hits.fROISummedADC.resize(spillHits);
+        hits.fHitSummedADC.resize(spillHits);
+        hits.fIntegral.resize(spillHits);
+        hits.fSigmaIntegral.resize(spillHits);
+        hits.fMultiplicity.resize(spillHits);
+        hits.fLocalIndex.resize(spillHits);
+        hits.fGoodnessOfFit.resize(spillHits);
+        hits.fNDF.resize(spillHits);
+        hits.fSignalType.resize(spillHits);
+        hits.fWireID_Cryostat.resize(spillHits);
+        hits.fWireID_TPC.resize(spillHits);
+        hits.fWireID_Plane.resize(spillHits);
+        hits.fWireID_Wire.resize(spillHits);
+        for (int i = 0; i < spillHits; ++i) {
             const auto& h = aosHits[i];
             hits.fChannel[i] = h.fChannel;
             hits.fView[i] = h.fView;
@@ -1707,13 +1799,13 @@ double RunSOA_spill_perDataProductWorkFunc(int first, int last, unsigned seed, R
             hits.fWireID_Wire[i] = h.fWireID_Wire;
         }
 
-        auto aosWires = generateEventWiresDeterministicRange(evt, startWire, adjustedWires, roisPerWire);
+        auto aosWires = generateEventWiresDeterministicRange(evt, startWire, spillWires, size.roisPerWire);
         SOAWireVector wires;
-        wires.EventIDs.resize(adjustedWires, evt);
-        wires.fWire_Channel.resize(adjustedWires);
-        wires.fWire_View.resize(adjustedWires);
-        wires.fSignalROI.resize(adjustedWires);
-        for (int w = 0; w < adjustedWires; ++w) {
+        wires.EventIDs.resize(spillWires, evt);
+        wires.fWire_Channel.resize(spillWires);
+        wires.fWire_View.resize(spillWires);
+        wires.fSignalROI.resize(spillWires);
+        for (int w = 0; w < spillWires; ++w) {
             const auto& wi = aosWires[w];
             wires.fWire_Channel[w] = wi.fWire_Channel;
             wires.fWire_View[w] = wi.fWire_View;
@@ -1742,41 +1834,45 @@ double RunSOA_spill_perDataProductWorkFunc(int first, int last, unsigned seed, R
     return totalTime;
 }
 
-double RunSOA_spill_perGroupWorkFunc(int first, int last, unsigned seed, ROOT::Experimental::RNTupleFillContext& hitsContext, ROOT::Experimental::Detail::RRawPtrWriteEntry& hitsEntry, ROOT::RFieldToken hitsToken, ROOT::Experimental::RNTupleFillContext& wiresContext, ROOT::Experimental::Detail::RRawPtrWriteEntry& wiresEntry, ROOT::RFieldToken wiresToken, ROOT::Experimental::RNTupleFillContext& roisContext, ROOT::Experimental::Detail::RRawPtrWriteEntry& roisEntry, ROOT::RFieldToken roisToken, std::mutex& mutex, int numSpills, int adjustedHits, int adjustedWires, int roisPerWire) {
+double RunSOA_spill_perGroupWorkFunc(int first, int last, unsigned seed, ROOT::Experimental::RNTupleFillContext& hitsContext, ROOT::Experimental::Detail::RRawPtrWriteEntry& hitsEntry, ROOT::RFieldToken hitsToken, ROOT::Experimental::RNTupleFillContext& wiresContext, ROOT::Experimental::Detail::RRawPtrWriteEntry& wiresEntry, ROOT::RFieldToken wiresToken, ROOT::Experimental::RNTupleFillContext& roisContext, ROOT::Experimental::Detail::RRawPtrWriteEntry& roisEntry, ROOT::RFieldToken roisToken, std::mutex& mutex, int numSpills, int hitsPerEvent, int wiresPerEvent, int roisPerWire) {
     TStopwatch sw;
     double totalTime = 0.0;
     for (int idx = first; idx < last; ++idx) {
         int evt = idx / numSpills;
         int spill = idx % numSpills;
-        int startHit = spill * adjustedHits;
-        int startWire = spill * adjustedWires;
+        // Every spill gets an equal share of its event, the remainder is dropped as before
+        const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
+        const int spillHits = size.hits / numSpills;
+        const int spillWires = size.wires / numSpills;
+        int startHit = spill * spillHits;
+        int startWire = spill * spillWires;
         // Build SOA from deterministic AOS slices for consistency
-        auto aosHits = generateEventHitsDeterministicRange(evt, startHit, adjustedHits);
+        auto aosHits = generateEventHitsDeterministicRange(evt, startHit, spillHits);
         SOAHitVector hits;
-        hits.EventIDs.resize(adjustedHits, evt);
-        hits.fChannel.resize(adjustedHits);
-        hits.fView.resize(adjustedHits);
-        hits.fStartTick.resize(adjustedHits);
-        hits.fEndTick.resize(adjustedHits);
-        hits.fPeakTime.resize(adjustedHits);
-        hits.fSigmaPeakTime.resize(adjustedHits);
-        hits.fRMS.resize(adjustedHits);
-        hits.fPeakAmplitude.resize(adjustedHits);
-        hits.fSigmaPeakAmplitude.resize(adjustedHits);
-        hits.fROISummedADC.resize(adjustedHits);
-        hits.fHitSummedADC.resize(adjustedHits);
-        hits.fIntegral.resize(adjustedHits);
-        hits.fSigmaIntegral.resize(adjustedHits);
-        hits.fMultiplicity.resize(adjustedHits);
-        hits.fLocalIndex.resize(adjustedHits);
-        hits.fGoodnessOfFit.resize(adjustedHits);
-        hits.fNDF.resize(adjustedHits);
-        hits.fSignalType.resize(adjustedHits);
-        hits.fWireID_Cryostat.resize(adjustedHits);
-        hits.fWireID_TPC.resize(adjustedHits);
-        hits.fWireID_Plane.resize(adjustedHits);
-        hits.fWireID_Wire.resize(adjustedHits);
-        for (int i = 0; i < adjustedHits; ++i) {
+        hits.EventIDs.resize(spillHits, evt);
+        hits.fChannel.resize(spillHits);
+        hits.fView.resize(spillHits);
+        hits.fStartTick.resize(spillHits);
+        hits.fEndTick.resize(spillHits);
+        hits.fPeakTime.resize(spillHits);
+        hits.fSigmaPeakTime.resize(spillHits);
+        hits.fRMS.resize(spillHits);
+        hits.fPeakAmplitude.resize(spillHits);
+        hits.fSigmaPeakAmplitude.resize(spillHits);
+        hits.fROISummedADC.resize(spillHits);
+        hits.fHitSummedADC.resize(spillHits);
+        hits.fIntegral.resize(spillHits);
+        hits.fSigmaIntegral.resize(spillHits);
+        hits.fMultiplicity.resize(spillHits);
+        hits.fLocalIndex.resize(spillHits);
+        hits.fGoodnessOfFit.resize(spillHits);
+        hits.fNDF.resize(spillHits);
+        hits.fSignalType.resize(spillHits);
+        hits.fWireID_Cryostat.resize(spillHits);
+        hits.fWireID_TPC.resize(spillHits);
+        hits.fWireID_Plane.resize(spillHits);
+        hits.fWireID_Wire.resize(spillHits);
+        for (int i = 0; i < spillHits; ++i) {
             const auto& h = aosHits[i];
             hits.fChannel[i] = h.fChannel;
             hits.fView[i] = h.fView;
@@ -1802,13 +1898,13 @@ double RunSOA_spill_perGroupWorkFunc(int first, int last, unsigned seed, ROOT::E
             hits.fWireID_Wire[i] = h.fWireID_Wire;
         }
 
-        auto aosWires = generateEventWiresDeterministicRange(evt, startWire, adjustedWires, roisPerWire);
+        auto aosWires = generateEventWiresDeterministicRange(evt, startWire, spillWires, size.roisPerWire);
         SOAWireVector wires;
-        wires.EventIDs.resize(adjustedWires, evt);
-        wires.fWire_Channel.resize(adjustedWires);
-        wires.fWire_View.resize(adjustedWires);
-        wires.fSignalROI.resize(adjustedWires);
-        for (int w = 0; w < adjustedWires; ++w) {
+        wires.EventIDs.resize(spillWires, evt);
+        wires.fWire_Channel.resize(spillWires);
+        wires.fWire_View.resize(spillWires);
+        wires.fSignalROI.resize(spillWires);
+        for (int w = 0; w < spillWires; ++w) {
             const auto& wi = aosWires[w];
             wires.fWire_Channel[w] = wi.fWire_Channel;
             wires.fWire_View[w] = wi.fWire_View;
@@ -1828,18 +1924,15 @@ double RunSOA_spill_perGroupWorkFunc(int first, int last, unsigned seed, ROOT::E
             { std::lock_guard<std::mutex> lock(mutex); hitsContext.FlushCluster(); }
         }
         wiresEntry.BindRawPtr(wiresToken, &baseWires);
-        ROOT::RNTupleFillStatus wiresStatus;
-        wiresContext.FillNoFlush(wiresEntry, wiresStatus);
-        if (wiresStatus.ShouldFlushCluster()) {
-            wiresContext.FlushColumns();
-            { std::lock_guard<std::mutex> lock(mutex); wiresContext.FlushCluster(); }
-        }
         roisEntry.BindRawPtr(roisToken, &rois);
-        ROOT::RNTupleFillStatus roisStatus;
+        ROOT::RNTupleFillStatus wiresStatus, roisStatus;
+        wiresContext.FillNoFlush(wiresEntry, wiresStatus);
         roisContext.FillNoFlush(roisEntry, roisStatus);
-        if (roisStatus.ShouldFlushCluster()) {
+        // The SOAROI vectors have no EventID: shared cluster boundaries keep them parallel to the wires
+        if (wiresStatus.ShouldFlushCluster() || roisStatus.ShouldFlushCluster()) {
+            wiresContext.FlushColumns();
             roisContext.FlushColumns();
-            { std::lock_guard<std::mutex> lock(mutex); roisContext.FlushCluster(); }
+            { std::lock_guard<std::mutex> lock(mutex); wiresContext.FlushCluster(); roisContext.FlushCluster(); }
         }
         totalTime += sw.RealTime();
     }
@@ -1860,15 +1953,23 @@ double RunSOA_topObject_perDataProductWorkFunc(int first, int last, unsigned see
     double totalTime = 0.0;
     auto hitPtr = hitsEntry.GetPtr<SOAHit>("hit");
     auto wirePtr = wiresEntry.GetPtr<SOAWire>("wire");
-    const int K = (hitsPerEvent > wiresPerEvent) ? hitsPerEvent : wiresPerEvent;
+    // K slots per event, enough for the largest event; slots past its size stay empty
+    const EventSize maxSize = maxEventSize(hitsPerEvent, wiresPerEvent, roisPerWire);
+    const int K = std::max(maxSize.hits, maxSize.wires);
+    EventSize size;
+    int sizeEvt = -1;
     for (int idx = first; idx < last; ++idx) {
         int evt = idx / K;
         int k   = idx % K;
+        if (evt != sizeEvt) {
+            size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
+            sizeEvt = evt;
+        }
         sw.Start();
-        if (k < hitsPerEvent) {
+        if (k < size.hits) {
             std::uint32_t hSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('H'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(k));
             std::mt19937 hRng(hSeed);
-            HitIndividual hInd = generateRandomHitIndividual(static_cast<long long>(evt) * hitsPerEvent + k, hRng);
+            HitIndividual hInd = generateRandomHitIndividual(static_cast<long long>(evt) * maxSize.hits + k, hRng);
             SOAHit hit;
             hit.EventID = hInd.EventID;
             hit.fChannel = hInd.fChannel;
@@ -1901,10 +2002,10 @@ double RunSOA_topObject_perDataProductWorkFunc(int first, int last, unsigned see
                 { std::lock_guard<std::mutex> lock(mutex); hitsContext.FlushCluster(); }
             }
         }
-        if (k < wiresPerEvent) {
+        if (k < size.wires) {
             std::uint32_t wSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('W'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(k));
             std::mt19937 wRng(wSeed);
-            WireIndividual wInd = generateRandomWireIndividual(evt, roisPerWire, wRng);
+            WireIndividual wInd = generateRandomWireIndividual(evt, size.roisPerWire, wRng);
             SOAWire wire;
             wire.EventID = wInd.EventID;
             wire.fWire_Channel = wInd.fWire_Channel;
@@ -1962,15 +2063,23 @@ double RunSOA_topObject_perGroupWorkFunc(int first, int last, unsigned seed, ROO
     auto hitPtr = hitsEntry.GetPtr<SOAHit>("hit");
     auto wirePtr = wiresEntry.GetPtr<SOAWireBase>("wire");
     auto roisPtr = roisEntry.GetPtr<std::vector<SOAROI>>("rois");
-    const int K = (hitsPerEvent > wiresPerEvent) ? hitsPerEvent : wiresPerEvent;
+    // K slots per event, enough for the largest event; slots past its size stay empty
+    const EventSize maxSize = maxEventSize(hitsPerEvent, wiresPerEvent, roisPerWire);
+    const int K = std::max(maxSize.hits, maxSize.wires);
+    EventSize size;
+    int sizeEvt = -1;
     for (int idx = first; idx < last; ++idx) {
         int evt = idx / K;
         int k   = idx % K;
+        if (evt != sizeEvt) {
+            size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
+            sizeEvt = evt;
+        }
         sw.Start();
-        if (k < hitsPerEvent) {
+        if (k < size.hits) {
             std::uint32_t hSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('H'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(k));
             std::mt19937 hRng(hSeed);
-            *hitPtr = generateSOASingleHit(static_cast<long long>(evt) * hitsPerEvent + k, hRng);
+            *hitPtr = generateSOASingleHit(static_cast<long long>(evt) * maxSize.hits + k, hRng);
             ROOT::RNTupleFillStatus hitsStatus;
             hitsContext.FillNoFlush(hitsEntry, hitsStatus);
             if (hitsStatus.ShouldFlushCluster()) {
@@ -1978,27 +2087,25 @@ double RunSOA_topObject_perGroupWorkFunc(int first, int last, unsigned seed, ROO
                 { std::lock_guard<std::mutex> lock(mutex); hitsContext.FlushCluster(); }
             }
         }
-        if (k < wiresPerEvent) {
+        if (k < size.wires) {
             std::uint32_t wSeed = Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('W'), static_cast<std::uint64_t>(evt), static_cast<std::uint64_t>(k));
             std::mt19937 wRng(wSeed);
-            SOAWire fullWire = generateSOASingleWire(evt, roisPerWire, wRng);
+            SOAWire fullWire = generateSOASingleWire(evt, size.roisPerWire, wRng);
             SOAWireBase wireBase;
             wireBase.EventID = fullWire.EventID;
             wireBase.fWire_Channel = fullWire.fWire_Channel;
             wireBase.fWire_View = fullWire.fWire_View;
             *wirePtr = wireBase;
-            ROOT::RNTupleFillStatus wiresStatus;
-            wiresContext.FillNoFlush(wiresEntry, wiresStatus);
-            if (wiresStatus.ShouldFlushCluster()) {
-                wiresContext.FlushColumns();
-                { std::lock_guard<std::mutex> lock(mutex); wiresContext.FlushCluster(); }
-            }
             *roisPtr = fullWire.fSignalROI;
-            ROOT::RNTupleFillStatus roisStatus;
+            ROOT::RNTupleFillStatus wiresStatus, roisStatus;
+            wiresContext.FillNoFlush(wiresEntry, wiresStatus);
             roisContext.FillNoFlush(roisEntry, roisStatus);
-            if (roisStatus.ShouldFlushCluster()) {
+            // SOAROI has no EventID: wires and ROIs share cluster boundaries so that entry i of
+            // soa_top_rois stays the ROIs of entry i of soa_top_wires
+            if (wiresStatus.ShouldFlushCluster() || roisStatus.ShouldFlushCluster()) {
+                wiresContext.FlushColumns();
                 roisContext.FlushColumns();
-                { std::lock_guard<std::mutex> lock(mutex); roisContext.FlushCluster(); }
+                { std::lock_guard<std::mutex> lock(mutex); wiresContext.FlushCluster(); roisContext.FlushCluster(); }
             }
         }
         totalTime += sw.RealTime();
@@ -2039,8 +2146,7 @@ double RunSOA_element_wiresWorkFunc(int first, int last, unsigned seed, ROOT::Ex
     auto wirePtr = entry.GetPtr<SOAWireBase>("wire");
     for (int idx = first; idx < last; ++idx) {
         wirePtr->EventID = idx;
-        wirePtr->fWire_Channel = rng() % 1024;
-        wirePtr->fWire_View = rng() % 7;
+        generateWireChannelAndView(wirePtr->fWire_Channel, wirePtr->fWire_View, rng);
         sw.Start();
         ROOT::RNTupleFillStatus status;
         context.FillNoFlush(entry, status);
@@ -2060,11 +2166,14 @@ double RunSOA_element_roisWorkFunc(int first, int last, unsigned seed, ROOT::Exp
     TStopwatch sw;
     double totalTime = 0.0;
     auto roiPtr = entry.GetPtr<FlatSOAROI>("roi");
+    unsigned int channel = 0;
+    int view = 0;
     for (int idx = first; idx < last; ++idx) {
         {
             unsigned int eventID = idx / (roisPerWire); // approximate mapping when standalone
-            unsigned int wireIdx = idx % roisPerWire;   // assuming sequential order within event
-            *roiPtr = generateSOASingleROI(eventID, wireIdx, rng);
+            // Every roisPerWire ROIs belong to one wire; its channel shapes the samples
+            if (idx == first || idx % roisPerWire == 0) generateWireChannelAndView(channel, view, rng);
+            *roiPtr = generateSOASingleROI(eventID, channel, rng);
         }
         sw.Start();
         ROOT::RNTupleFillStatus status;
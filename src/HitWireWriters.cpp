@@ -2,6 +2,7 @@
 #include "Wire.hpp"
 #include "Utils.hpp" // Assuming this exists for utilities like generateSeeds
 #include "HitWireWriterHelpers.hpp"
+#include "HitWireWriters.hpp"
 #include <ROOT/RNTupleModel.hxx>
 #include <ROOT/RNTupleWriter.hxx>
 #include <ROOT/RNTupleParallelWriter.hxx>
@@ -13,15 +14,28 @@
 #include <future>
 #include <vector>
 #include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <algorithm>
 #include <numeric>
 #include <cmath>
 #include <iomanip>
 #include <map>
 #include <utility>
 #include "ProgressiveTablePrinter.hpp"
+#include "ScalingAnalysis.hpp"
+#include "ThreadBudget.hpp"
+#include "Affinity.hpp"
+#include "ClusterTargeting.hpp"
+#include "OutputCache.hpp"
+#include "OutputSink.hpp"
+#include "EventSizes.hpp"
+#include "EventIndex.hpp"
+#include "ZoneMap.hpp"
 #include "WriterResult.hpp"
 #include <functional>
 #include <exception>
+#include <stdexcept>
 #include <TROOT.h>
 #include "UnionRow.hpp"
 #include "UnionRowSOA.hpp"
@@ -63,14 +77,24 @@ double RunSOA_element_perGroupCombinedWorkFunc(int firstEvt, int lastEvt, unsign
     ROOT::Experimental::RNTupleFillContext& roisContext, ROOT::REntry& roisEntry,
     std::mutex& mutex, int hitsPerEvent, int wiresPerEvent, int roisPerWire);
 
+// Event and pin-slot offsets of the writers running on this thread, see setThreadWriterShard
+static thread_local WriterShard tShard;
+
+void setThreadWriterShard(const WriterShard& shard) {
+    tShard = shard;
+}
+
 // Move executeInParallel to the top of the file, before any function implementations
+// totalEvents counts work items; itemsPerEvent converts the shard start into them
 static double executeInParallel(int totalEvents, int nThreads, const std::function<double(int, int, unsigned, int)>& workFunc,
-                                double* launchOut = nullptr, double* waitOut = nullptr, double* wallOut = nullptr) {
+                                int itemsPerEvent = 1, double* launchOut = nullptr, double* waitOut = nullptr, double* wallOut = nullptr) {
     // Internal overall wall timer
     TStopwatch swWall; swWall.Start();
     if (nThreads <= 0 || totalEvents < 0) return 0.0;
     if (totalEvents == 0) return 0.0;
-    auto seeds = Utils::generateSeeds(nThreads);
+    const WriterShard shard = tShard;
+    const int firstItem = shard.firstItem(itemsPerEvent);
+    auto seeds = Utils::generateSeeds(shard.firstSlot + nThreads);
     int chunk = totalEvents / nThreads;
     std::vector<std::future<double>> futures;
     // Phase 2.1 — Launch
@@ -81,7 +105,11 @@ static double executeInParallel(int totalEvents, int nThreads, const std::functi
             int start = th * chunk;
             int end = (th == nThreads - 1) ? totalEvents : start + chunk;
             if (start >= end) continue;
-            futures.push_back(std::async(std::launch::async, workFunc, start, end, seeds[th], th));
+            futures.push_back(std::async(std::launch::async, [&workFunc, start, end, shard, firstItem, seed = seeds[shard.firstSlot + th], th]() {
+                // Pin before the worker touches its buffers so they are allocated on its node
+                Affinity::pinCurrentThread(shard.firstSlot + th);
+                return workFunc(firstItem + start, firstItem + end, seed, th);
+            }));
         }
         swLaunch.Stop();
         launchTime = swLaunch.RealTime();
@@ -105,6 +133,132 @@ static double executeInParallel(int totalEvents, int nThreads, const std::functi
     return totalTime;
 }
 
+using ContextGroups = std::vector<std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>>*>;
+
+static WriterCommitConfig gCommitConfig;
+
+void setWriterCommitConfig(const WriterCommitConfig& config) {
+    gCommitConfig = config;
+}
+
+const WriterCommitConfig& getWriterCommitConfig() {
+    return gCommitConfig;
+}
+
+// Ordered commit: the range is cut into blocks handed out in sequence. Each worker fills a
+// block, stages the resulting clusters of all its contexts, and commits them once every
+// earlier block has been committed, so entries land in block order in every ntuple.
+// A block holds about one cluster target of event data (eventBytes per event), or the
+// per-thread share of a smaller range, so blocks end where free-for-all contexts would cut
+// their clusters anyway. Seeds follow the block, not the thread that claims it.
+static double executeInOrder(int totalItems, int nThreads, const std::function<double(int, int, unsigned, int)>& workFunc,
+                             const ContextGroups& groups, std::uint64_t eventBytes, int itemsPerEvent = 1) {
+    if (nThreads <= 0 || totalItems <= 0) return 0.0;
+    int blockItems = 0;
+    if (gCommitConfig.blockEvents > 0) {
+        blockItems = gCommitConfig.blockEvents * itemsPerEvent;
+    } else {
+        const int numEvents = std::max(1, totalItems / itemsPerEvent);
+        const std::uint64_t cut = clusterCutBytes(numEvents * eventBytes);
+        const std::uint64_t cutItems = eventBytes > 0 ? cut * itemsPerEvent / eventBytes : totalItems;
+        const int shareItems = (totalItems + nThreads - 1) / nThreads;
+        blockItems = static_cast<int>(std::min<std::uint64_t>(cutItems, shareItems));
+    }
+    blockItems = std::max(1, blockItems);
+    int nBlocks = (totalItems + blockItems - 1) / blockItems;
+    for (auto* group : groups) {
+        for (auto& context : *group) context->EnableStagedClusterCommitting();
+    }
+
+    const WriterShard shard = tShard;
+    const int firstItem = shard.firstItem(itemsPerEvent);
+    std::atomic<int> nextBlock{0};
+    int nextCommit = 0;
+    bool aborted = false;
+    std::mutex seqMutex;
+    std::condition_variable seqCv;
+
+    auto worker = [&](int th) {
+        Affinity::pinCurrentThread(shard.firstSlot + th);
+        double total = 0.0;
+        try {
+            for (int b = nextBlock.fetch_add(1); b < nBlocks; b = nextBlock.fetch_add(1)) {
+                int first = b * blockItems;
+                int last = std::min(totalItems, first + blockItems);
+                total += workFunc(firstItem + first, firstItem + last,
+                                  Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('O'),
+                                                   static_cast<std::uint64_t>(firstItem + first)), th);
+
+                // Staging, waiting for the sequencer and committing count as writer time
+                TStopwatch sw; sw.Start();
+                for (auto* group : groups) {
+                    (*group)[th]->FlushColumns();
+                    (*group)[th]->FlushCluster();
+                }
+                std::unique_lock<std::mutex> lock(seqMutex);
+                seqCv.wait(lock, [&] { return nextCommit == b || aborted; });
+                if (aborted) break;
+                for (auto* group : groups) (*group)[th]->CommitStagedClusters();
+                ++nextCommit;
+                lock.unlock();
+                seqCv.notify_all();
+                total += sw.RealTime();
+            }
+        } catch (...) {
+            { std::lock_guard<std::mutex> lock(seqMutex); aborted = true; }
+            seqCv.notify_all();
+            throw;
+        }
+        return total;
+    };
+
+    std::vector<std::future<double>> futures;
+    for (int th = 0; th < nThreads; ++th) {
+        futures.push_back(std::async(std::launch::async, worker, th));
+    }
+    double totalTime = 0.0;
+    for (auto& f : futures) totalTime += f.get();
+    return totalTime;
+}
+
+// Dispatches to the free-for-all or the ordered commit executor
+// eventBytes is the uncompressed size of one event over all groups, used to size ordered blocks
+static double executeWriter(int totalEvents, int nThreads, const std::function<double(int, int, unsigned, int)>& workFunc,
+                            const ContextGroups& groups, std::uint64_t eventBytes, int itemsPerEvent = 1) {
+    if (gCommitConfig.ordered) return executeInOrder(totalEvents, nThreads, workFunc, groups, eventBytes, itemsPerEvent);
+    return executeInParallel(totalEvents, nThreads, workFunc, itemsPerEvent);
+}
+
+// Appends the requested sidecar ntuples to every written file. Called after the timed
+// iterations, so building them never counts as write time.
+static void emitSidecars(const std::vector<std::string>& writtenFiles) {
+    if (getEmitEventIndex()) {
+        for (const auto& f : writtenFiles) {
+            try {
+                auto report = writeEventIndexes(f);
+                if (report.ntuples > 0) {
+                    std::cout << "Event index for " << f << ": " << report.ntuples << " ntuples, "
+                              << report.ranges << " ranges, " << report.seconds << " s" << std::endl;
+                }
+            } catch (const std::exception& e) {
+                std::cout << "Event index for " << f << " failed: " << e.what() << std::endl;
+            }
+        }
+    }
+    if (getEmitZoneMaps()) {
+        for (const auto& f : writtenFiles) {
+            try {
+                TStopwatch sw; sw.Start();
+                int n = writeZoneMaps(f);
+                sw.Stop();
+                if (n > 0) std::cout << "Zone maps for " << f << ": " << n << " ntuples, " << sw.RealTime() << " s" << std::endl;
+            } catch (const std::exception& e) {
+                std::cout << "Zone maps for " << f << " failed: " << e.what() << std::endl;
+            }
+        }
+    }
+}
+
 // One-pass implementation with single EventAOS ntuple (matches reader expectations)
 double AOS_event_allDataProduct(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
     // NOTE: Detailed timing instrumentation intentionally kept (commented out) so we can
@@ -125,14 +279,13 @@ double AOS_event_allDataProduct(int numEvents, int hitsPerEvent, int wiresPerEve
         // Time 1: Writer and thread-local setup
         // TStopwatch swSetup; swSetup.Start();
 
-        auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+        auto file = openOutputFile(fileName);
         std::mutex mutex;
 
-        ROOT::RNTupleWriteOptions options;
-        options.SetUseBufferedWrite(true);
+        const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
 
         auto [model, token] = CreateAOSAllDataProductModelAndToken();
-        auto writer = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(model), "aos_events", *file, options);
+        auto writer = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(model), "aos_events", *file, makeWriteOptions(numEvents * bytes.all()));
 
         // Thread-local contexts and entries
         std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> contexts(nThreads);
@@ -158,10 +311,10 @@ double AOS_event_allDataProduct(int numEvents, int hitsPerEvent, int wiresPerEve
         // Time 2: Parallel dispatch and timing (wall-clock)
         // TStopwatch swExec; swExec.Start();
         // double launchT=0.0, waitT=0.0, wallT=0.0;
-        // workerSumTime = executeInParallel(numEvents, nThreads, workFunc, &launchT, &waitT, &wallT);
+        // workerSumTime = executeInParallel(numEvents, nThreads, workFunc, 1, &launchT, &waitT, &wallT);
         // swExec.Stop();
         // executeTime = swExec.RealTime();
-        workerSumTime = executeInParallel(numEvents, nThreads, workFunc);
+        workerSumTime = executeWriter(numEvents, nThreads, workFunc, {&contexts}, bytes.all());
 
         // Time 3: Destruction and implicit final flushes
         // swTeardown.Start();
@@ -172,15 +325,14 @@ double AOS_event_allDataProduct(int numEvents, int hitsPerEvent, int wiresPerEve
 
 // Implementation for perDataProduct
 double AOS_event_perDataProduct(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options;
-    options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     
     auto [hitsModel, hitsToken] = CreateAOSHitsModelAndToken();
-    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "aos_hits", *file, options);
+    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "aos_hits", *file, makeWriteOptions(numEvents * bytes.hits));
     auto [wiresModel, wiresToken] = CreateAOSWiresModelAndToken();
-    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "aos_wires", *file, options);
+    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "aos_wires", *file, makeWriteOptions(numEvents * bytes.wiresWithRois()));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> hitsContexts(nThreads);
     std::vector<std::unique_ptr<ROOT::Experimental::Detail::RRawPtrWriteEntry>> hitsEntries(nThreads);
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> wiresContexts(nThreads);
@@ -194,23 +346,22 @@ double AOS_event_perDataProduct(int numEvents, int hitsPerEvent, int wiresPerEve
     auto workFunc = [&](int first, int last, unsigned seed, int th) {
         return RunAOS_event_perDataProductWorkFunc(first, last, seed, *hitsContexts[th], *hitsEntries[th], hitsToken, *wiresContexts[th], *wiresEntries[th], wiresToken, mutex, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    double totalTime = executeInParallel(numEvents, nThreads, workFunc);
+    double totalTime = executeWriter(numEvents, nThreads, workFunc, {&hitsContexts, &wiresContexts}, bytes.all());
     return totalTime;
 }
 
 // Implementation for perGroup (similar, with added rois writer)
 double AOS_event_perGroup(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options;
-    options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     
     auto [hitsModel, hitsToken] = CreateAOSHitsModelAndToken();
-    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "aos_hits", *file, options);
+    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "aos_hits", *file, makeWriteOptions(numEvents * bytes.hits));
     auto [wiresModel, wiresToken] = CreateAOSBaseWiresModelAndToken();
-    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "aos_wires", *file, options);
+    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "aos_wires", *file, makeWriteOptions(numEvents * bytes.wires));
     auto [roisModel, roisToken] = CreateAOSROIsModelAndToken();
-    auto roisWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(roisModel), "aos_rois", *file, options);
+    auto roisWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(roisModel), "aos_rois", *file, makeWriteOptions(numEvents * bytes.rois));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> hitsContexts(nThreads);
     std::vector<std::unique_ptr<ROOT::Experimental::Detail::RRawPtrWriteEntry>> hitsEntries(nThreads);
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> wiresContexts(nThreads);
@@ -228,19 +379,18 @@ double AOS_event_perGroup(int numEvents, int hitsPerEvent, int wiresPerEvent, in
     auto workFunc = [&](int first, int last, unsigned seed, int th) {
         return RunAOS_event_perGroupWorkFunc(first, last, seed, *hitsContexts[th], *hitsEntries[th], hitsToken, *wiresContexts[th], *wiresEntries[th], wiresToken, *roisContexts[th], *roisEntries[th], roisToken, mutex, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    double totalTime = executeInParallel(numEvents, nThreads, workFunc);
+    double totalTime = executeWriter(numEvents, nThreads, workFunc, {&hitsContexts, &wiresContexts, &roisContexts}, bytes.all());
     return totalTime;
 }
 
 // SOA_event_allDataProduct
 double SOA_event_allDataProduct(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options;
-    options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     
     auto [model, token] = CreateSOAAllDataProductModelAndToken();
-    auto writer = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(model), "soa_events", *file, options);
+    auto writer = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(model), "soa_events", *file, makeWriteOptions(numEvents * bytes.all()));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> contexts(nThreads);
     std::vector<std::unique_ptr<ROOT::Experimental::Detail::RRawPtrWriteEntry>> entries(nThreads);
     for (int th = 0; th < nThreads; ++th) {
@@ -250,21 +400,20 @@ double SOA_event_allDataProduct(int numEvents, int hitsPerEvent, int wiresPerEve
     auto workFunc = [&](int first, int last, unsigned seed, int th) {
         return RunSOA_event_allDataProductWorkFunc(first, last, seed, *contexts[th], *entries[th], token, mutex, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    double totalTime = executeInParallel(numEvents, nThreads, workFunc);
+    double totalTime = executeWriter(numEvents, nThreads, workFunc, {&contexts}, bytes.all());
     return totalTime;
 }
 
 // SOA_event_perDataProduct
 double SOA_event_perDataProduct(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options;
-    options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     
     auto [hitsModel, hitsToken] = CreateSOAHitsModelAndToken();
-    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "soa_hits", *file, options);
+    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "soa_hits", *file, makeWriteOptions(numEvents * bytes.hits));
     auto [wiresModel, wiresToken] = CreateSOAWiresModelAndToken();
-    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "soa_wires", *file, options);
+    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "soa_wires", *file, makeWriteOptions(numEvents * bytes.wiresWithRois()));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> hitsContexts(nThreads);
     std::vector<std::unique_ptr<ROOT::Experimental::Detail::RRawPtrWriteEntry>> hitsEntries(nThreads);
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> wiresContexts(nThreads);
@@ -278,23 +427,22 @@ double SOA_event_perDataProduct(int numEvents, int hitsPerEvent, int wiresPerEve
     auto workFunc = [&](int first, int last, unsigned seed, int th) {
         return RunSOA_event_perDataProductWorkFunc(first, last, seed, *hitsContexts[th], *hitsEntries[th], hitsToken, *wiresContexts[th], *wiresEntries[th], wiresToken, mutex, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    double totalTime = executeInParallel(numEvents, nThreads, workFunc);
+    double totalTime = executeWriter(numEvents, nThreads, workFunc, {&hitsContexts, &wiresContexts}, bytes.all());
     return totalTime;
 }
 
 // SOA_event_perGroup
 double SOA_event_perGroup(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options;
-    options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     
     auto [hitsModel, hitsToken] = CreateSOAHitsModelAndToken();
-    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "soa_hits", *file, options);
+    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "soa_hits", *file, makeWriteOptions(numEvents * bytes.hits));
     auto [wiresModel, wiresToken] = CreateSOABaseWiresModelAndToken();
-    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "soa_wires", *file, options);
+    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "soa_wires", *file, makeWriteOptions(numEvents * bytes.wires));
     auto [roisModel, roisToken] = CreateSOAROIsModelAndToken();
-    auto roisWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(roisModel), "soa_rois", *file, options);
+    auto roisWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(roisModel), "soa_rois", *file, makeWriteOptions(numEvents * bytes.rois));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> hitsContexts(nThreads);
     std::vector<std::unique_ptr<ROOT::Experimental::Detail::RRawPtrWriteEntry>> hitsEntries(nThreads);
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> wiresContexts(nThreads);
@@ -312,23 +460,20 @@ double SOA_event_perGroup(int numEvents, int hitsPerEvent, int wiresPerEvent, in
     auto workFunc = [&](int first, int last, unsigned seed, int th) {
         return RunSOA_event_perGroupWorkFunc(first, last, seed, *hitsContexts[th], *hitsEntries[th], hitsToken, *wiresContexts[th], *wiresEntries[th], wiresToken, *roisContexts[th], *roisEntries[th], roisToken, mutex, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    double totalTime = executeInParallel(numEvents, nThreads, workFunc);
+    double totalTime = executeWriter(numEvents, nThreads, workFunc, {&hitsContexts, &wiresContexts, &roisContexts}, bytes.all());
     return totalTime;
 }
 
 // Add any shared helpers here, e.g., executeInParallel from existing code (duplicated to avoid changes)
 
 double AOS_spill_allDataProduct(int numEvents, int numSpills, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    int adjustedHits = hitsPerEvent / numSpills;
-    int adjustedWires = wiresPerEvent / numSpills;
     int totalEntries = numEvents * numSpills;
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options;
-    options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     
-    auto [model, token] = CreateAOSAllDataProductModelAndToken();
-    auto writer = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(model), "aos_spills", *file, options);
+    auto [model, token, eventIdToken, spillIdToken] = CreateAOSSpillModelAndTokens();
+    auto writer = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(model), "aos_spills", *file, makeWriteOptions(numEvents * bytes.all()));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> contexts(nThreads);
     std::vector<std::unique_ptr<ROOT::Experimental::Detail::RRawPtrWriteEntry>> entries(nThreads);
     for (int th = 0; th < nThreads; ++th) {
@@ -336,27 +481,24 @@ double AOS_spill_allDataProduct(int numEvents, int numSpills, int hitsPerEvent,
         entries[th] = contexts[th]->GetModel().CreateRawPtrWriteEntry();
     }
     auto workFunc = [&](int first, int last, unsigned seed, int th) {
-        return RunAOS_spill_allDataProductWorkFunc(first, last, seed, *contexts[th], *entries[th], token, mutex, numSpills, adjustedHits, adjustedWires, roisPerWire);
+        return RunAOS_spill_allDataProductWorkFunc(first, last, seed, *contexts[th], *entries[th], token, eventIdToken, spillIdToken, mutex, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    double totalTime = executeInParallel(totalEntries, nThreads, workFunc);
+    double totalTime = executeWriter(totalEntries, nThreads, workFunc, {&contexts}, bytes.all(), numSpills);
     return totalTime;
 }
 
 // Similarly implement AOS_spill_perDataProduct and AOS_spill_perGroup 
 
 double AOS_spill_perDataProduct(int numEvents, int numSpills, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    int adjustedHits = hitsPerEvent / numSpills;
-    int adjustedWires = wiresPerEvent / numSpills;
     int totalEntries = numEvents * numSpills;
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options;
-    options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     
     auto [hitsModel, hitsToken] = CreateAOSHitsModelAndToken();
-    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "aos_spill_hits", *file, options);
+    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "aos_spill_hits", *file, makeWriteOptions(numEvents * bytes.hits));
     auto [wiresModel, wiresToken] = CreateAOSWiresModelAndToken();
-    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "aos_spill_wires", *file, options);
+    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "aos_spill_wires", *file, makeWriteOptions(numEvents * bytes.wiresWithRois()));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> hitsContexts(nThreads);
     std::vector<std::unique_ptr<ROOT::Experimental::Detail::RRawPtrWriteEntry>> hitsEntries(nThreads);
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> wiresContexts(nThreads);
@@ -368,27 +510,24 @@ double AOS_spill_perDataProduct(int numEvents, int numSpills, int hitsPerEvent,
         wiresEntries[th] = wiresContexts[th]->GetModel().CreateRawPtrWriteEntry();
     }
     auto workFunc = [&](int first, int last, unsigned seed, int th) {
-        return RunAOS_spill_perDataProductWorkFunc(first, last, seed, *hitsContexts[th], *hitsEntries[th], hitsToken, *wiresContexts[th], *wiresEntries[th], wiresToken, mutex, numSpills, adjustedHits, adjustedWires, roisPerWire);
+        return RunAOS_spill_perDataProductWorkFunc(first, last, seed, *hitsContexts[th], *hitsEntries[th], hitsToken, *wiresContexts[th], *wiresEntries[th], wiresToken, mutex, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    double totalTime = executeInParallel(totalEntries, nThreads, workFunc);
+    double totalTime = executeWriter(totalEntries, nThreads, workFunc, {&hitsContexts, &wiresContexts}, bytes.all(), numSpills);
     return totalTime;
 }
 
 double AOS_spill_perGroup(int numEvents, int numSpills, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    int adjustedHits = hitsPerEvent / numSpills;
-    int adjustedWires = wiresPerEvent / numSpills;
     int totalEntries = numEvents * numSpills;
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options;
-    options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     
     auto [hitsModel, hitsToken] = CreateAOSHitsModelAndToken();
-    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "aos_spill_hits", *file, options);
+    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "aos_spill_hits", *file, makeWriteOptions(numEvents * bytes.hits));
     auto [wiresModel, wiresToken] = CreateAOSBaseWiresModelAndToken();
-    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "aos_spill_wires", *file, options);
+    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "aos_spill_wires", *file, makeWriteOptions(numEvents * bytes.wires));
     auto [roisModel, roisToken] = CreateAOSROIsModelAndToken();
-    auto roisWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(roisModel), "aos_spill_rois", *file, options);
+    auto roisWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(roisModel), "aos_spill_rois", *file, makeWriteOptions(numEvents * bytes.rois));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> hitsContexts(nThreads);
     std::vector<std::unique_ptr<ROOT::Experimental::Detail::RRawPtrWriteEntry>> hitsEntries(nThreads);
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> wiresContexts(nThreads);
@@ -404,27 +543,27 @@ double AOS_spill_perGroup(int numEvents, int numSpills, int hitsPerEvent, int wi
         roisEntries[th] = roisContexts[th]->GetModel().CreateRawPtrWriteEntry();
     }
     auto workFunc = [&](int first, int last, unsigned seed, int th) {
-        return RunAOS_spill_perGroupWorkFunc(first, last, seed, *hitsContexts[th], *hitsEntries[th], hitsToken, *wiresContexts[th], *wiresEntries[th], wiresToken, *roisContexts[th], *roisEntries[th], roisToken, mutex, numSpills, adjustedHits, adjustedWires, roisPerWire);
+        return RunAOS_spill_perGroupWorkFunc(first, last, seed, *hitsContexts[th], *hitsEntries[th], hitsToken, *wiresContexts[th], *wiresEntries[th], wiresToken, *roisContexts[th], *roisEntries[th], roisToken, mutex, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    double totalTime = executeInParallel(totalEntries, nThreads, workFunc);
+    double totalTime = executeWriter(totalEntries, nThreads, workFunc, {&hitsContexts, &wiresContexts, &roisContexts}, bytes.all(), numSpills);
     return totalTime;
 } 
 
 
 double AOS_topObject_perDataProduct(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    const int K = (hitsPerEvent > wiresPerEvent) ? hitsPerEvent : wiresPerEvent;
+    const EventSize maxSize = maxEventSize(hitsPerEvent, wiresPerEvent, roisPerWire);
+    const int K = std::max(maxSize.hits, maxSize.wires); // work items per event, see the work function
     int totalEntries = numEvents * K;
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options;
-    options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     
     auto hitsModel = ROOT::RNTupleModel::Create();
     hitsModel->MakeField<HitIndividual>("hit");
-    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "aos_top_hits", *file, options);
+    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "aos_top_hits", *file, makeWriteOptions(numEvents * bytes.hits));
     auto wiresModel = ROOT::RNTupleModel::Create();
     wiresModel->MakeField<WireIndividual>("wire");
-    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "aos_top_wires", *file, options);
+    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "aos_top_wires", *file, makeWriteOptions(numEvents * bytes.wiresWithRois()));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> hitsContexts(nThreads), wiresContexts(nThreads);
     std::vector<std::unique_ptr<ROOT::REntry>> hitsEntries(nThreads), wiresEntries(nThreads);
     for (int th = 0; th < nThreads; ++th) {
@@ -436,28 +575,28 @@ double AOS_topObject_perDataProduct(int numEvents, int hitsPerEvent, int wiresPe
     auto workFunc = [&](int first, int last, unsigned seed, int th) -> double {
         return RunAOS_topObject_perDataProductWorkFunc(first, last, seed, *hitsContexts[th], *hitsEntries[th], *wiresContexts[th], *wiresEntries[th], mutex, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    double totalTime = executeInParallel(totalEntries, nThreads, workFunc);
+    double totalTime = executeWriter(totalEntries, nThreads, workFunc, {&hitsContexts, &wiresContexts}, bytes.all(), K);
     return totalTime;
 }
 
 
 double AOS_topObject_perGroup(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    const int K = (hitsPerEvent > wiresPerEvent) ? hitsPerEvent : wiresPerEvent;
+    const EventSize maxSize = maxEventSize(hitsPerEvent, wiresPerEvent, roisPerWire);
+    const int K = std::max(maxSize.hits, maxSize.wires); // work items per event, see the work function
     int totalEntries = numEvents * K;
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options;
-    options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     
     auto hitsModel = ROOT::RNTupleModel::Create();
     hitsModel->MakeField<HitIndividual>("hit");
-    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "aos_top_hits", *file, options);
+    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "aos_top_hits", *file, makeWriteOptions(numEvents * bytes.hits));
     auto wiresModel = ROOT::RNTupleModel::Create();
     wiresModel->MakeField<WireBase>("wire");
-    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "aos_top_wires", *file, options);
+    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "aos_top_wires", *file, makeWriteOptions(numEvents * bytes.wires));
     auto roisModel = ROOT::RNTupleModel::Create();
     roisModel->MakeField<std::vector<FlatROI>>("rois");
-    auto roisWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(roisModel), "aos_top_rois", *file, options);
+    auto roisWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(roisModel), "aos_top_rois", *file, makeWriteOptions(numEvents * bytes.rois));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> hitsContexts(nThreads), wiresContexts(nThreads), roisContexts(nThreads);
     std::vector<std::unique_ptr<ROOT::REntry>> hitsEntries(nThreads), wiresEntries(nThreads), roisEntries(nThreads);
     for (int th = 0; th < nThreads; ++th) {
@@ -471,26 +610,25 @@ double AOS_topObject_perGroup(int numEvents, int hitsPerEvent, int wiresPerEvent
     auto workFunc = [&](int first, int last, unsigned seed, int th) -> double {
         return RunAOS_topObject_perGroupWorkFunc(first, last, seed, *hitsContexts[th], *hitsEntries[th], *wiresContexts[th], *wiresEntries[th], *roisContexts[th], *roisEntries[th], mutex, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    double totalTime = executeInParallel(totalEntries, nThreads, workFunc);
+    double totalTime = executeWriter(totalEntries, nThreads, workFunc, {&hitsContexts, &wiresContexts, &roisContexts}, bytes.all(), K);
     return totalTime;
 } 
 
 double AOS_element_perDataProduct(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options;
-    options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     
 
     // Hits model and writer
     auto hitsModel = ROOT::RNTupleModel::Create();
     auto hitField = hitsModel->MakeField<HitIndividual>("hit");
-    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "element_hits", *file, options);
+    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "element_hits", *file, makeWriteOptions(numEvents * bytes.hits));
 
     // WireROI model and writer
     auto wireROIModel = ROOT::RNTupleModel::Create();
     auto wireROIField = wireROIModel->MakeField<WireROI>("wire_roi");
-    auto wireROIWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wireROIModel), "element_wire_rois", *file, options);
+    auto wireROIWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wireROIModel), "element_wire_rois", *file, makeWriteOptions(numEvents * bytes.wiresWithRois()));
 
     // Contexts and entries for hits
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> hitsContexts(nThreads);
@@ -514,31 +652,30 @@ double AOS_element_perDataProduct(int numEvents, int hitsPerEvent, int wiresPerE
                                                              *wireROIContexts[th], *wireROIEntries[th],
                                                              mutex, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    double totalTime = executeInParallel(numEvents, nThreads, workFunc);
+    double totalTime = executeWriter(numEvents, nThreads, workFunc, {&hitsContexts, &wireROIContexts}, bytes.all());
     return totalTime;
 }
 
 double AOS_element_perGroup(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options;
-    options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     
 
     // Hits model and writer (single HitIndividual per row)
     auto hitsModel = ROOT::RNTupleModel::Create();
     auto hitField = hitsModel->MakeField<HitIndividual>("hit");
-    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "element_hits", *file, options);
+    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "element_hits", *file, makeWriteOptions(numEvents * bytes.hits));
 
     // Wires model and writer (single WireBase per row)
     auto wiresModel = ROOT::RNTupleModel::Create();
     auto wireField = wiresModel->MakeField<WireBase>("wire");
-    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "element_wires", *file, options);
+    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "element_wires", *file, makeWriteOptions(numEvents * bytes.wires));
 
     // ROIs model and writer (single FlatROI per row)
     auto roisModel = ROOT::RNTupleModel::Create();
     auto roiField = roisModel->MakeField<FlatROI>("roi");
-    auto roisWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(roisModel), "element_rois", *file, options);
+    auto roisWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(roisModel), "element_rois", *file, makeWriteOptions(numEvents * bytes.rois));
 
     // Contexts and entries
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> hitsContexts(nThreads), wiresContexts(nThreads), roisContexts(nThreads);
@@ -561,7 +698,7 @@ double AOS_element_perGroup(int numEvents, int hitsPerEvent, int wiresPerEvent,
                                                        *roisContexts[th], *roisEntries[th],
                                                        mutex, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    double totalTime = executeInParallel(numEvents, nThreads, workFunc);
+    double totalTime = executeWriter(numEvents, nThreads, workFunc, {&hitsContexts, &wiresContexts, &roisContexts}, bytes.all());
     return totalTime;
 } 
 
@@ -575,19 +712,31 @@ std::vector<WriterResult> outAOS(int nThreads, int iter, int numEvents, int hits
         {32, 16, 16, 12, 12, 12}
     );
     
-    auto benchmark = [&](const std::string& label, auto func, auto&&... args) {
+    std::vector<std::string> writtenFiles;
+    std::vector<std::pair<std::string, std::string>> writtenDatasets; // file, describeDataset
+    // Every writer takes the output file and the thread count after its shape arguments
+    auto benchmark = [&](const std::string& label, const std::string& fileName, auto func, auto&&... args) {
         WriterResult result = {label, 0.0, 0.0, {}, false, ""};
-        
+        const std::string dataset = describeDataset(std::filesystem::path(fileName).stem().string(), numEvents, numSpills,
+                                                    hitsPerEvent, wiresPerEvent, roisPerWire, nThreads);
+        const bool toFile = getSinkMode() == SinkMode::File;
+        if (toFile && getOutputCacheConfig().reuse && reuseCachedDataset(fileName, datasetHash(dataset))) {
+            result.cached = true;
+            results.push_back(result);
+            tablePrinter.addRow(result);
+            return;
+        }
+
         try {
             std::vector<double> times;
             for (int i = 0; i < iter; ++i) {
                 if (measureWallTime) {
                     TStopwatch sw; sw.Start();
-                    (void)func(args...);
+                    (void)func(args..., fileName, nThreads);
                     sw.Stop();
                     times.push_back(sw.RealTime());
                 } else {
-                    double t = func(args...);
+                    double t = func(args..., fileName, nThreads);
                     times.push_back(t);
                 }
             }
@@ -600,6 +749,11 @@ std::vector<WriterResult> outAOS(int nThreads, int iter, int numEvents, int hits
             result.avg = avg;
             result.stddev = stddev;
             result.iterationTimes = times; // Store individual iteration times
+            // Memory and null sinks leave nothing to post-process
+            if (toFile) {
+                writtenFiles.push_back(fileName);
+                writtenDatasets.emplace_back(fileName, dataset);
+            }
         } catch (const std::exception& e) {
             std::cout << "Running " << label << "... FAILED" << std::endl;
             result.failed = true;
@@ -614,39 +768,47 @@ std::vector<WriterResult> outAOS(int nThreads, int iter, int numEvents, int hits
         tablePrinter.addRow(result);
     };
     auto shouldRun = [&](int idx) { return mask < 0 || ((mask & (1 << idx)) != 0); };
-    if (shouldRun(0))  benchmark("AOS_event_allDataProduct",   AOS_event_allDataProduct,   numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/aos_event_all.root",          nThreads);
-    if (shouldRun(1))  benchmark("AOS_event_perDataProduct",   AOS_event_perDataProduct,   numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/aos_event_perData.root",      nThreads);
-    if (shouldRun(2))  benchmark("AOS_event_perGroup",         AOS_event_perGroup,         numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/aos_event_perGroup.root",     nThreads);
-    if (shouldRun(3))  benchmark("AOS_spill_allDataProduct",   AOS_spill_allDataProduct,   numEvents, numSpills,    hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/aos_spill_all.root",      nThreads);
-    if (shouldRun(4))  benchmark("AOS_spill_perDataProduct",   AOS_spill_perDataProduct,   numEvents, numSpills,    hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/aos_spill_perData.root",  nThreads);
-    if (shouldRun(5))  benchmark("AOS_spill_perGroup",         AOS_spill_perGroup,         numEvents, numSpills,    hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/aos_spill_perGroup.root",nThreads);
-    if (shouldRun(6))  benchmark("AOS_topObject_allDataProduct", AOS_topObject_allDataProduct, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/aos_topObject_all.root",   nThreads);
-    if (shouldRun(7))  benchmark("AOS_topObject_perDataProduct", AOS_topObject_perDataProduct, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/aos_topObject_perData.root",   nThreads);
-    if (shouldRun(8))  benchmark("AOS_topObject_perGroup",     AOS_topObject_perGroup,     numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/aos_topObject_perGroup.root", nThreads);
-    if (shouldRun(9))  benchmark("AOS_element_allDataProduct", AOS_element_allDataProduct, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/aos_element_all.root",      nThreads);
-    if (shouldRun(10)) benchmark("AOS_element_perDataProduct", AOS_element_perDataProduct, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/aos_element_perData.root",   nThreads);
-    if (shouldRun(11)) benchmark("AOS_element_perGroup",       AOS_element_perGroup,       numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/aos_element_perGroup.root", nThreads);
+    if (shouldRun(0))  benchmark("AOS_event_allDataProduct",   outputDir + "/aos_event_all.root", AOS_event_allDataProduct, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(1))  benchmark("AOS_event_perDataProduct",   outputDir + "/aos_event_perData.root", AOS_event_perDataProduct, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(2))  benchmark("AOS_event_perGroup",         outputDir + "/aos_event_perGroup.root", AOS_event_perGroup, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(3))  benchmark("AOS_spill_allDataProduct",   outputDir + "/aos_spill_all.root", AOS_spill_allDataProduct, numEvents, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(4))  benchmark("AOS_spill_perDataProduct",   outputDir + "/aos_spill_perData.root", AOS_spill_perDataProduct, numEvents, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(5))  benchmark("AOS_spill_perGroup",         outputDir + "/aos_spill_perGroup.root", AOS_spill_perGroup, numEvents, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(6))  benchmark("AOS_topObject_allDataProduct", outputDir + "/aos_topObject_all.root", AOS_topObject_allDataProduct, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(7))  benchmark("AOS_topObject_perDataProduct", outputDir + "/aos_topObject_perData.root", AOS_topObject_perDataProduct, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(8))  benchmark("AOS_topObject_perGroup",     outputDir + "/aos_topObject_perGroup.root", AOS_topObject_perGroup, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(9))  benchmark("AOS_element_allDataProduct", outputDir + "/aos_element_all.root", AOS_element_allDataProduct, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(10)) benchmark("AOS_element_perDataProduct", outputDir + "/aos_element_perData.root", AOS_element_perDataProduct, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(11)) benchmark("AOS_element_perGroup",       outputDir + "/aos_element_perGroup.root", AOS_element_perGroup, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire);
 
     tablePrinter.printFooter();
+    if (getClusterTargetConfig().reportHistogram) {
+        for (const auto& f : writtenFiles) {
+            try {
+                printClusterHistogram(f);
+            } catch (const std::exception& e) {
+                std::cout << "Cluster histogram for " << f << " failed: " << e.what() << std::endl;
+            }
+        }
+    }
+    emitSidecars(writtenFiles);
+    // Tagged last, so a reused file already has its sidecar ntuples
+    storeDatasets(writtenDatasets);
     return results;
 } 
 
 // Forward declaration (defined later in this file)
 std::vector<WriterResult> outSOA(int nThreads, int iter, int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, int numSpills, const std::string& outputDir, int mask, bool measureWallTime);
 
-std::map<std::string, std::vector<std::pair<int, double>>> benchmarkAOSScaling(int maxThreads, int iter, int numEvents, int mask) {
-    // Powers of two up to maxThreads (e.g. maxThreads=10 -> 1,2,4,8)
-    std::vector<int> threadCounts;
-    for (int t = 1; t > 0 && t <= maxThreads; t *= 2) {
-        threadCounts.push_back(t);
-    }
+std::map<std::string, std::vector<std::pair<int, double>>> benchmarkAOSScaling(const std::vector<int>& threadCounts, int iter, int numEvents, const EventShape& shape, int mask) {
     std::map<std::string, std::vector<std::pair<int, double>>> data;
-    // Ensure output directory exists (ROOT/TFile won't create parent dirs)
-    std::filesystem::create_directories("./output_scaling");
+    // Use a separate output dir per shape to avoid mixing with normal benchmark outputs
+    // (ROOT/TFile won't create parent dirs)
+    const std::string outputDir = "./output_scaling/" + shape.name;
+    std::filesystem::create_directories(outputDir);
     for (int threads : threadCounts) {
-        ROOT::EnableImplicitMT(threads);
-        // Use a separate output dir to avoid mixing with normal benchmark outputs
-        auto results = outAOS(threads, iter, numEvents, 100, 100, 10, 10, "./output_scaling", mask, /*measureWallTime=*/true);
+        applyImplicitMT(threads);
+        auto results = outAOS(threads, iter, numEvents, shape.hitsPerEvent, shape.wiresPerEvent, shape.roisPerWire, shape.numSpills, outputDir, mask, /*measureWallTime=*/true);
         for (const auto& res : results) {
             data[res.label].emplace_back(threads, res.avg);
         }
@@ -655,19 +817,15 @@ std::map<std::string, std::vector<std::pair<int, double>>> benchmarkAOSScaling(i
     return data;
 } 
 
-std::map<std::string, std::vector<std::pair<int, double>>> benchmarkSOAScaling(int maxThreads, int iter, int numEvents, int mask) {
-    // Powers of two up to maxThreads (e.g. maxThreads=10 -> 1,2,4,8)
-    std::vector<int> threadCounts;
-    for (int t = 1; t > 0 && t <= maxThreads; t *= 2) {
-        threadCounts.push_back(t);
-    }
+std::map<std::string, std::vector<std::pair<int, double>>> benchmarkSOAScaling(const std::vector<int>& threadCounts, int iter, int numEvents, const EventShape& shape, int mask) {
     std::map<std::string, std::vector<std::pair<int, double>>> data;
-    // Ensure output directory exists (ROOT/TFile won't create parent dirs)
-    std::filesystem::create_directories("./output_scaling");
+    // Use a separate output dir per shape to avoid mixing with normal benchmark outputs
+    // (ROOT/TFile won't create parent dirs)
+    const std::string outputDir = "./output_scaling/" + shape.name;
+    std::filesystem::create_directories(outputDir);
     for (int threads : threadCounts) {
-        ROOT::EnableImplicitMT(threads);
-        // Use a separate output dir to avoid mixing with normal benchmark outputs
-        auto results = outSOA(threads, iter, numEvents, 100, 100, 10, 10, "./output_scaling", mask, /*measureWallTime=*/true);
+        applyImplicitMT(threads);
+        auto results = outSOA(threads, iter, numEvents, shape.hitsPerEvent, shape.wiresPerEvent, shape.roisPerWire, shape.numSpills, outputDir, mask, /*measureWallTime=*/true);
         for (const auto& res : results) {
             data[res.label].emplace_back(threads, res.avg);
         }
@@ -678,18 +836,15 @@ std::map<std::string, std::vector<std::pair<int, double>>> benchmarkSOAScaling(i
 
 // Group 2: SOA spill functions - complete perData and perGroup
 double SOA_spill_perDataProduct(int numEvents, int numSpills, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    int adjustedHits = hitsPerEvent / numSpills;
-    int adjustedWires = wiresPerEvent / numSpills;
     int totalEntries = numEvents * numSpills;
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options;
-    options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     
     auto [hitsModel, hitsToken] = CreateSOAHitsModelAndToken();
-    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "soa_spill_hits", *file, options);
+    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "soa_spill_hits", *file, makeWriteOptions(numEvents * bytes.hits));
     auto [wiresModel, wiresToken] = CreateSOAWiresModelAndToken();
-    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "soa_spill_wires", *file, options);
+    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "soa_spill_wires", *file, makeWriteOptions(numEvents * bytes.wiresWithRois()));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> hitsContexts(nThreads);
     std::vector<std::unique_ptr<ROOT::Experimental::Detail::RRawPtrWriteEntry>> hitsEntries(nThreads);
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> wiresContexts(nThreads);
@@ -701,19 +856,19 @@ double SOA_spill_perDataProduct(int numEvents, int numSpills, int hitsPerEvent,
         wiresEntries[th] = wiresContexts[th]->GetModel().CreateRawPtrWriteEntry();
     }
     auto workFunc = [&](int first, int last, unsigned seed, int th) {
-        return RunSOA_spill_perDataProductWorkFunc(first, last, seed, *hitsContexts[th], *hitsEntries[th], hitsToken, *wiresContexts[th], *wiresEntries[th], wiresToken, mutex, numSpills, adjustedHits, adjustedWires, roisPerWire);
+        return RunSOA_spill_perDataProductWorkFunc(first, last, seed, *hitsContexts[th], *hitsEntries[th], hitsToken, *wiresContexts[th], *wiresEntries[th], wiresToken, mutex, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    double totalTime = executeInParallel(totalEntries, nThreads, workFunc);
+    double totalTime = executeWriter(totalEntries, nThreads, workFunc, {&hitsContexts, &wiresContexts}, bytes.all(), numSpills);
     return totalTime;
 }
 
 // TopObject allDataProduct (AOS) - K fills per event using batch row (K = max(H, W))
 double AOS_topObject_allDataProduct(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options; options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     auto [model, token] = CreateAOSTopBatchModelAndToken("row");
-    auto writer = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(model), "aos_top_all", *file, options);
+    auto writer = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(model), "aos_top_all", *file, makeWriteOptions(numEvents * bytes.all()));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> contexts(nThreads);
     std::vector<std::unique_ptr<ROOT::Experimental::Detail::RRawPtrWriteEntry>> entries(nThreads);
     for (int th = 0; th < nThreads; ++th) {
@@ -723,16 +878,16 @@ double AOS_topObject_allDataProduct(int numEvents, int hitsPerEvent, int wiresPe
     auto workFunc = [&](int first, int last, unsigned seed, int th) -> double {
         return RunAOS_top_allDataProductWorkFunc(first, last, seed, *contexts[th], *entries[th], token, mutex, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    return executeInParallel(numEvents, nThreads, workFunc);
+    return executeWriter(numEvents, nThreads, workFunc, {&contexts}, bytes.all());
 }
 
 // Element allDataProduct (AOS) - 1 fill per element using union row
 double AOS_element_allDataProduct(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options; options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     auto [model, token] = CreateAOSUnionModelAndToken("row");
-    auto writer = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(model), "aos_element_all", *file, options);
+    auto writer = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(model), "aos_element_all", *file, makeWriteOptions(numEvents * bytes.all()));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> contexts(nThreads);
     std::vector<std::unique_ptr<ROOT::Experimental::Detail::RRawPtrWriteEntry>> entries(nThreads);
     for (int th = 0; th < nThreads; ++th) {
@@ -742,24 +897,21 @@ double AOS_element_allDataProduct(int numEvents, int hitsPerEvent, int wiresPerE
     auto workFunc = [&](int first, int last, unsigned seed, int th) -> double {
         return RunAOS_element_allDataProductWorkFunc(first, last, seed, *contexts[th], *entries[th], token, mutex, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    return executeInParallel(numEvents, nThreads, workFunc);
+    return executeWriter(numEvents, nThreads, workFunc, {&contexts}, bytes.all());
 }
 
 double SOA_spill_perGroup(int numEvents, int numSpills, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    int adjustedHits = hitsPerEvent / numSpills;
-    int adjustedWires = wiresPerEvent / numSpills;
     int totalEntries = numEvents * numSpills;
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options;
-    options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     
     auto [hitsModel, hitsToken] = CreateSOAHitsModelAndToken();
-    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "soa_spill_hits", *file, options);
+    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "soa_spill_hits", *file, makeWriteOptions(numEvents * bytes.hits));
     auto [wiresModel, wiresToken] = CreateSOABaseWiresModelAndToken();
-    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "soa_spill_wires", *file, options);
+    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "soa_spill_wires", *file, makeWriteOptions(numEvents * bytes.wires));
     auto [roisModel, roisToken] = CreateSOAROIsModelAndToken();
-    auto roisWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(roisModel), "soa_spill_rois", *file, options);
+    auto roisWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(roisModel), "soa_spill_rois", *file, makeWriteOptions(numEvents * bytes.rois));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> hitsContexts(nThreads), wiresContexts(nThreads), roisContexts(nThreads);
     std::vector<std::unique_ptr<ROOT::Experimental::Detail::RRawPtrWriteEntry>> hitsEntries(nThreads), wiresEntries(nThreads), roisEntries(nThreads);
     for (int th = 0; th < nThreads; ++th) {
@@ -771,60 +923,60 @@ double SOA_spill_perGroup(int numEvents, int numSpills, int hitsPerEvent, int wi
         roisEntries[th] = roisContexts[th]->GetModel().CreateRawPtrWriteEntry();
     }
     auto workFunc = [&](int first, int last, unsigned seed, int th) {
-        return RunSOA_spill_perGroupWorkFunc(first, last, seed, *hitsContexts[th], *hitsEntries[th], hitsToken, *wiresContexts[th], *wiresEntries[th], wiresToken, *roisContexts[th], *roisEntries[th], roisToken, mutex, numSpills, adjustedHits, adjustedWires, roisPerWire);
+        return RunSOA_spill_perGroupWorkFunc(first, last, seed, *hitsContexts[th], *hitsEntries[th], hitsToken, *wiresContexts[th], *wiresEntries[th], wiresToken, *roisContexts[th], *roisEntries[th], roisToken, mutex, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    double totalTime = executeInParallel(totalEntries, nThreads, workFunc);
+    double totalTime = executeWriter(totalEntries, nThreads, workFunc, {&hitsContexts, &wiresContexts, &roisContexts}, bytes.all(), numSpills);
     return totalTime;
 }
 
 // TopObject allDataProduct (SOA) - K fills per event using batch row (K = max(H, W))
 double SOA_topObject_allDataProduct(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
-    std::mutex mutex; ROOT::RNTupleWriteOptions options; options.SetUseBufferedWrite(true);
+    auto file = openOutputFile(fileName);
+    std::mutex mutex; const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     auto [model, token] = CreateSOATopBatchModelAndToken("row");
-    auto writer = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(model), "soa_top_all", *file, options);
+    auto writer = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(model), "soa_top_all", *file, makeWriteOptions(numEvents * bytes.all()));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> contexts(nThreads);
     std::vector<std::unique_ptr<ROOT::Experimental::Detail::RRawPtrWriteEntry>> entries(nThreads);
     for (int th = 0; th < nThreads; ++th) { contexts[th] = writer->CreateFillContext(); entries[th] = contexts[th]->GetModel().CreateRawPtrWriteEntry(); }
     auto workFunc = [&](int first, int last, unsigned seed, int th) -> double {
         return RunSOA_top_allDataProductWorkFunc(first, last, seed, *contexts[th], *entries[th], token, mutex, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    return executeInParallel(numEvents, nThreads, workFunc);
+    return executeWriter(numEvents, nThreads, workFunc, {&contexts}, bytes.all());
 }
 
 // Element allDataProduct (SOA) - 1 fill per element using union row
 double SOA_element_allDataProduct(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
-    std::mutex mutex; ROOT::RNTupleWriteOptions options; options.SetUseBufferedWrite(true);
+    auto file = openOutputFile(fileName);
+    std::mutex mutex; const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     auto [model, token] = CreateSOAUnionModelAndToken("row");
-    auto writer = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(model), "soa_element_all", *file, options);
+    auto writer = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(model), "soa_element_all", *file, makeWriteOptions(numEvents * bytes.all()));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> contexts(nThreads);
     std::vector<std::unique_ptr<ROOT::Experimental::Detail::RRawPtrWriteEntry>> entries(nThreads);
     for (int th = 0; th < nThreads; ++th) { contexts[th] = writer->CreateFillContext(); entries[th] = contexts[th]->GetModel().CreateRawPtrWriteEntry(); }
     auto workFunc = [&](int first, int last, unsigned seed, int th) -> double {
         return RunSOA_element_allDataProductWorkFunc(first, last, seed, *contexts[th], *entries[th], token, mutex, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    return executeInParallel(numEvents, nThreads, workFunc);
+    return executeWriter(numEvents, nThreads, workFunc, {&contexts}, bytes.all());
 }
 
 // Group 3: Complete topObject perGroup
 double SOA_topObject_perGroup(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    const int K = (hitsPerEvent > wiresPerEvent) ? hitsPerEvent : wiresPerEvent;
+    const EventSize maxSize = maxEventSize(hitsPerEvent, wiresPerEvent, roisPerWire);
+    const int K = std::max(maxSize.hits, maxSize.wires); // work items per event, see the work function
     int totalEntries = numEvents * K;
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options;
-    options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     
     auto hitsModel = ROOT::RNTupleModel::Create();
     hitsModel->MakeField<SOAHit>("hit");
-    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "soa_top_hits", *file, options);
+    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "soa_top_hits", *file, makeWriteOptions(numEvents * bytes.hits));
     auto wiresModel = ROOT::RNTupleModel::Create();
     wiresModel->MakeField<SOAWireBase>("wire");
-    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "soa_top_wires", *file, options);
+    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "soa_top_wires", *file, makeWriteOptions(numEvents * bytes.wires));
     auto roisModel = ROOT::RNTupleModel::Create();
     roisModel->MakeField<std::vector<SOAROI>>("rois");
-    auto roisWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(roisModel), "soa_top_rois", *file, options);
+    auto roisWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(roisModel), "soa_top_rois", *file, makeWriteOptions(numEvents * bytes.rois));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> hitsContexts(nThreads), wiresContexts(nThreads), roisContexts(nThreads);
     std::vector<std::unique_ptr<ROOT::REntry>> hitsEntries(nThreads), wiresEntries(nThreads), roisEntries(nThreads);
     for (int th = 0; th < nThreads; ++th) {
@@ -838,23 +990,22 @@ double SOA_topObject_perGroup(int numEvents, int hitsPerEvent, int wiresPerEvent
     auto workFunc = [&](int first, int last, unsigned seed, int th) -> double {
         return RunSOA_topObject_perGroupWorkFunc(first, last, seed, *hitsContexts[th], *hitsEntries[th], *wiresContexts[th], *wiresEntries[th], *roisContexts[th], *roisEntries[th], mutex, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    double totalTime = executeInParallel(totalEntries, nThreads, workFunc);
+    double totalTime = executeWriter(totalEntries, nThreads, workFunc, {&hitsContexts, &wiresContexts, &roisContexts}, bytes.all(), K);
     return totalTime;
 }
 
 // Group 4: Complete element perData and perGroup
 double SOA_element_perDataProduct(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options;
-    options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     
     auto hitsModel = ROOT::RNTupleModel::Create();
     hitsModel->MakeField<SOAHit>("hit");
-    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "soa_element_hits", *file, options);
+    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "soa_element_hits", *file, makeWriteOptions(numEvents * bytes.hits));
     auto roisModel = ROOT::RNTupleModel::Create();
     roisModel->MakeField<FlatSOAROI>("roi");
-    auto roisWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(roisModel), "soa_element_rois", *file, options);
+    auto roisWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(roisModel), "soa_element_rois", *file, makeWriteOptions(numEvents * bytes.wiresWithRois()));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> hitsContexts(nThreads);
     std::vector<std::unique_ptr<ROOT::REntry>> hitsEntries(nThreads);
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> roisContexts(nThreads);
@@ -871,25 +1022,24 @@ double SOA_element_perDataProduct(int numEvents, int hitsPerEvent, int wiresPerE
                                                              *roisContexts[th], *roisEntries[th],
                                                              mutex, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    double totalTime = executeInParallel(numEvents, nThreads, workFunc);
+    double totalTime = executeWriter(numEvents, nThreads, workFunc, {&hitsContexts, &roisContexts}, bytes.all());
     return totalTime;
 }
 
 double SOA_element_perGroup(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options;
-    options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     
     auto hitsModel = ROOT::RNTupleModel::Create();
     hitsModel->MakeField<SOAHit>("hit");
-    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "soa_element_hits", *file, options);
+    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "soa_element_hits", *file, makeWriteOptions(numEvents * bytes.hits));
     auto wiresModel = ROOT::RNTupleModel::Create();
     wiresModel->MakeField<SOAWireBase>("wire");
-    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "soa_element_wires", *file, options);
+    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "soa_element_wires", *file, makeWriteOptions(numEvents * bytes.wires));
     auto roisModel = ROOT::RNTupleModel::Create();
     roisModel->MakeField<FlatSOAROI>("roi");
-    auto roisWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(roisModel), "soa_element_rois", *file, options);
+    auto roisWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(roisModel), "soa_element_rois", *file, makeWriteOptions(numEvents * bytes.rois));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> hitsContexts(nThreads);
     std::vector<std::unique_ptr<ROOT::REntry>> hitsEntries(nThreads);
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> wiresContexts(nThreads);
@@ -911,21 +1061,18 @@ double SOA_element_perGroup(int numEvents, int hitsPerEvent, int wiresPerEvent,
             *roisContexts[th], *roisEntries[th],
             mutex, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    double totalTime = executeInParallel(numEvents, nThreads, workFunc);
+    double totalTime = executeWriter(numEvents, nThreads, workFunc, {&hitsContexts, &wiresContexts, &roisContexts}, bytes.all());
     return totalTime;
 } 
 
 double SOA_spill_allDataProduct(int numEvents, int numSpills, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    int adjustedHits = hitsPerEvent / numSpills;
-    int adjustedWires = wiresPerEvent / numSpills;
     int totalEntries = numEvents * numSpills;
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options;
-    options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     
-    auto [model, token] = CreateSOAAllDataProductModelAndToken();
-    auto writer = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(model), "soa_spill_all", *file, options);
+    auto [model, token, eventIdToken, spillIdToken] = CreateSOASpillModelAndTokens();
+    auto writer = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(model), "soa_spill_all", *file, makeWriteOptions(numEvents * bytes.all()));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> contexts(nThreads);
     std::vector<std::unique_ptr<ROOT::Experimental::Detail::RRawPtrWriteEntry>> entries(nThreads);
     for (int th = 0; th < nThreads; ++th) {
@@ -933,26 +1080,26 @@ double SOA_spill_allDataProduct(int numEvents, int numSpills, int hitsPerEvent,
         entries[th] = contexts[th]->GetModel().CreateRawPtrWriteEntry();
     }
     auto workFunc = [&](int first, int last, unsigned seed, int th) {
-        return RunSOA_spill_allDataProductWorkFunc(first, last, seed, *contexts[th], *entries[th], token, mutex, numSpills, adjustedHits, adjustedWires, roisPerWire);
+        return RunSOA_spill_allDataProductWorkFunc(first, last, seed, *contexts[th], *entries[th], token, eventIdToken, spillIdToken, mutex, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    double totalTime = executeInParallel(totalEntries, nThreads, workFunc);
+    double totalTime = executeWriter(totalEntries, nThreads, workFunc, {&contexts}, bytes.all(), numSpills);
     return totalTime;
 }
 
 double SOA_topObject_perDataProduct(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
-    const int K = (hitsPerEvent > wiresPerEvent) ? hitsPerEvent : wiresPerEvent;
+    const EventSize maxSize = maxEventSize(hitsPerEvent, wiresPerEvent, roisPerWire);
+    const int K = std::max(maxSize.hits, maxSize.wires); // work items per event, see the work function
     int totalEntries = numEvents * K;
-    auto file = std::make_unique<TFile>(fileName.c_str(), "RECREATE");
+    auto file = openOutputFile(fileName);
     std::mutex mutex;
-    ROOT::RNTupleWriteOptions options;
-    options.SetUseBufferedWrite(true);
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
     
     auto hitsModel = ROOT::RNTupleModel::Create();
     hitsModel->MakeField<SOAHit>("hit");
-    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "soa_top_hits", *file, options);
+    auto hitsWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(hitsModel), "soa_top_hits", *file, makeWriteOptions(numEvents * bytes.hits));
     auto wiresModel = ROOT::RNTupleModel::Create();
     wiresModel->MakeField<SOAWire>("wire");
-    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "soa_top_wires", *file, options);
+    auto wiresWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(wiresModel), "soa_top_wires", *file, makeWriteOptions(numEvents * bytes.wiresWithRois()));
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> hitsContexts(nThreads);
     std::vector<std::unique_ptr<ROOT::REntry>> hitsEntries(nThreads);
     std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> wiresContexts(nThreads);
@@ -966,7 +1113,7 @@ double SOA_topObject_perDataProduct(int numEvents, int hitsPerEvent, int wiresPe
     auto workFunc = [&](int first, int last, unsigned seed, int th) {
         return RunSOA_topObject_perDataProductWorkFunc(first, last, seed, *hitsContexts[th], *hitsEntries[th], *wiresContexts[th], *wiresEntries[th], mutex, hitsPerEvent, wiresPerEvent, roisPerWire);
     };
-    double totalTime = executeInParallel(totalEntries, nThreads, workFunc);
+    double totalTime = executeWriter(totalEntries, nThreads, workFunc, {&hitsContexts, &wiresContexts}, bytes.all(), K);
     return totalTime;
 } 
 
@@ -980,19 +1127,31 @@ std::vector<WriterResult> outSOA(int nThreads, int iter, int numEvents, int hits
         {32, 16, 16, 12, 12, 12}
     );
     
-    auto benchmark = [&](const std::string& label, auto func, auto&&... args) {
+    std::vector<std::string> writtenFiles;
+    std::vector<std::pair<std::string, std::string>> writtenDatasets; // file, describeDataset
+    // Every writer takes the output file and the thread count after its shape arguments
+    auto benchmark = [&](const std::string& label, const std::string& fileName, auto func, auto&&... args) {
         WriterResult result = {label, 0.0, 0.0, {}, false, ""};
-        
+        const std::string dataset = describeDataset(std::filesystem::path(fileName).stem().string(), numEvents, numSpills,
+                                                    hitsPerEvent, wiresPerEvent, roisPerWire, nThreads);
+        const bool toFile = getSinkMode() == SinkMode::File;
+        if (toFile && getOutputCacheConfig().reuse && reuseCachedDataset(fileName, datasetHash(dataset))) {
+            result.cached = true;
+            results.push_back(result);
+            tablePrinter.addRow(result);
+            return;
+        }
+
         try {
             std::vector<double> times;
             for (int i = 0; i < iter; ++i) {
                 if (measureWallTime) {
                     TStopwatch sw; sw.Start();
-                    (void)func(args...);
+                    (void)func(args..., fileName, nThreads);
                     sw.Stop();
                     times.push_back(sw.RealTime());
                 } else {
-                    double t = func(args...);
+                    double t = func(args..., fileName, nThreads);
                     times.push_back(t);
                 }
             }
@@ -1005,6 +1164,11 @@ std::vector<WriterResult> outSOA(int nThreads, int iter, int numEvents, int hits
             result.avg = avg;
             result.stddev = stddev;
             result.iterationTimes = times; // Store individual iteration times
+            // Memory and null sinks leave nothing to post-process
+            if (toFile) {
+                writtenFiles.push_back(fileName);
+                writtenDatasets.emplace_back(fileName, dataset);
+            }
         } catch (const std::exception& e) {
             std::cout << "Running " << label << "... FAILED" << std::endl;
             result.failed = true;
@@ -1019,19 +1183,131 @@ std::vector<WriterResult> outSOA(int nThreads, int iter, int numEvents, int hits
         tablePrinter.addRow(result);
     };
     auto shouldRun = [&](int idx) { return mask < 0 || ((mask & (1 << idx)) != 0); };
-    if (shouldRun(0))  benchmark("SOA_event_allDataProduct",     SOA_event_allDataProduct,     numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/soa_event_all.root",          nThreads);
-    if (shouldRun(1))  benchmark("SOA_event_perDataProduct",     SOA_event_perDataProduct,     numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/soa_event_perData.root",      nThreads);
-    if (shouldRun(2))  benchmark("SOA_event_perGroup",           SOA_event_perGroup,           numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/soa_event_perGroup.root",     nThreads);
-    if (shouldRun(3))  benchmark("SOA_spill_allDataProduct",     SOA_spill_allDataProduct,     numEvents, numSpills,    hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/soa_spill_all.root",      nThreads);
-    if (shouldRun(4))  benchmark("SOA_spill_perDataProduct",     SOA_spill_perDataProduct,     numEvents, numSpills,    hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/soa_spill_perData.root",  nThreads);
-    if (shouldRun(5))  benchmark("SOA_spill_perGroup",           SOA_spill_perGroup,           numEvents, numSpills,    hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/soa_spill_perGroup.root",nThreads);
-    if (shouldRun(6))  benchmark("SOA_topObject_allDataProduct", SOA_topObject_allDataProduct, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/soa_topObject_all.root",     nThreads);
-    if (shouldRun(7))  benchmark("SOA_topObject_perDataProduct", SOA_topObject_perDataProduct, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/soa_topObject_perData.root",   nThreads);
-    if (shouldRun(8))  benchmark("SOA_topObject_perGroup",       SOA_topObject_perGroup,       numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/soa_topObject_perGroup.root", nThreads);
-    if (shouldRun(9))  benchmark("SOA_element_allDataProduct",   SOA_element_allDataProduct,   numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/soa_element_all.root",      nThreads);
-    if (shouldRun(10)) benchmark("SOA_element_perDataProduct",   SOA_element_perDataProduct,   numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/soa_element_perData.root",   nThreads);
-    if (shouldRun(11)) benchmark("SOA_element_perGroup",         SOA_element_perGroup,         numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, outputDir + "/soa_element_perGroup.root", nThreads);
+    if (shouldRun(0))  benchmark("SOA_event_allDataProduct",     outputDir + "/soa_event_all.root", SOA_event_allDataProduct, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(1))  benchmark("SOA_event_perDataProduct",     outputDir + "/soa_event_perData.root", SOA_event_perDataProduct, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(2))  benchmark("SOA_event_perGroup",           outputDir + "/soa_event_perGroup.root", SOA_event_perGroup, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(3))  benchmark("SOA_spill_allDataProduct",     outputDir + "/soa_spill_all.root", SOA_spill_allDataProduct, numEvents, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(4))  benchmark("SOA_spill_perDataProduct",     outputDir + "/soa_spill_perData.root", SOA_spill_perDataProduct, numEvents, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(5))  benchmark("SOA_spill_perGroup",           outputDir + "/soa_spill_perGroup.root", SOA_spill_perGroup, numEvents, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(6))  benchmark("SOA_topObject_allDataProduct", outputDir + "/soa_topObject_all.root", SOA_topObject_allDataProduct, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(7))  benchmark("SOA_topObject_perDataProduct", outputDir + "/soa_topObject_perData.root", SOA_topObject_perDataProduct, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(8))  benchmark("SOA_topObject_perGroup",       outputDir + "/soa_topObject_perGroup.root", SOA_topObject_perGroup, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(9))  benchmark("SOA_element_allDataProduct",   outputDir + "/soa_element_all.root", SOA_element_allDataProduct, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(10)) benchmark("SOA_element_perDataProduct",   outputDir + "/soa_element_perData.root", SOA_element_perDataProduct, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire);
+    if (shouldRun(11)) benchmark("SOA_element_perGroup",         outputDir + "/soa_element_perGroup.root", SOA_element_perGroup, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire);
 
     tablePrinter.printFooter();
+    if (getClusterTargetConfig().reportHistogram) {
+        for (const auto& f : writtenFiles) {
+            try {
+                printClusterHistogram(f);
+            } catch (const std::exception& e) {
+                std::cout << "Cluster histogram for " << f << " failed: " << e.what() << std::endl;
+            }
+        }
+    }
+    emitSidecars(writtenFiles);
+    // Tagged last, so a reused file already has its sidecar ntuples
+    storeDatasets(writtenDatasets);
     return results;
-} 
\ No newline at end of file
+} 
+
+void compareCommitModes(int nThreads, int iter, int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire,
+                        int numSpills, int mask, bool runAOS, bool runSOA) {
+    const std::string outputDir = "./output_ordered";
+    std::filesystem::create_directories(outputDir);
+    const WriterCommitConfig saved = gCommitConfig;
+
+    auto runAll = [&](bool ordered) {
+        WriterCommitConfig config = saved;
+        config.ordered = ordered;
+        setWriterCommitConfig(config);
+        std::vector<WriterResult> results;
+        if (runAOS) {
+            auto r = outAOS(nThreads, iter, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, numSpills, outputDir, mask, /*measureWallTime=*/true);
+            results.insert(results.end(), r.begin(), r.end());
+        }
+        if (runSOA) {
+            auto r = outSOA(nThreads, iter, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, numSpills, outputDir, mask, /*measureWallTime=*/true);
+            results.insert(results.end(), r.begin(), r.end());
+        }
+        return results;
+    };
+    auto freeResults = runAll(false);
+    auto orderedResults = runAll(true);
+    setWriterCommitConfig(saved);
+
+    std::map<std::string, const WriterResult*> ordered;
+    for (const auto& r : orderedResults) ordered[r.label] = &r;
+
+    const int col1 = 32, col2 = 14;
+    std::cout << "\nCommit Mode Comparison (wall-clock, " << nThreads << " threads)" << std::endl;
+    std::cout << std::left
+              << std::setw(col1) << "Writer"
+              << std::setw(col2) << "Free (s)"
+              << std::setw(col2) << "Ordered (s)"
+              << std::setw(col2) << "Overhead %"
+              << std::setw(col2) << "Free ev/s"
+              << std::setw(col2) << "Ordered ev/s" << std::endl;
+    std::cout << std::string(col1 + 5 * col2, '-') << std::endl;
+    for (const auto& f : freeResults) {
+        auto it = ordered.find(f.label);
+        if (it == ordered.end()) continue;
+        const WriterResult& o = *it->second;
+        std::cout << std::left << std::setw(col1) << f.label;
+        if (f.failed || o.failed || f.avg <= 0.0 || o.avg <= 0.0) {
+            std::cout << std::setw(col2) << (f.failed ? "FAILED" : std::to_string(f.avg))
+                      << std::setw(col2) << (o.failed ? "FAILED" : std::to_string(o.avg)) << std::endl;
+            continue;
+        }
+        std::cout << std::setw(col2) << f.avg
+                  << std::setw(col2) << o.avg
+                  << std::setw(col2) << std::fixed << std::setprecision(1) << 100.0 * (o.avg - f.avg) / f.avg
+                  << std::setw(col2) << std::setprecision(0) << numEvents / f.avg
+                  << std::setw(col2) << numEvents / o.avg << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setprecision(6);
+    }
+    std::cout << std::string(col1 + 5 * col2, '-') << std::endl;
+}
+
+double writeLayout(const std::string& layout, int numEvents, int numSpills, int hitsPerEvent, int wiresPerEvent,
+                   int roisPerWire, const std::string& fileName, int nThreads) {
+    using EventWriter = double (*)(int, int, int, int, const std::string&, int);
+    using SpillWriter = double (*)(int, int, int, int, int, const std::string&, int);
+    static const std::map<std::string, EventWriter> eventWriters = {
+        {"aos_event_all", AOS_event_allDataProduct},
+        {"aos_event_perData", AOS_event_perDataProduct},
+        {"aos_event_perGroup", AOS_event_perGroup},
+        {"aos_topObject_all", AOS_topObject_allDataProduct},
+        {"aos_topObject_perData", AOS_topObject_perDataProduct},
+        {"aos_topObject_perGroup", AOS_topObject_perGroup},
+        {"aos_element_all", AOS_element_allDataProduct},
+        {"aos_element_perData", AOS_element_perDataProduct},
+        {"aos_element_perGroup", AOS_element_perGroup},
+        {"soa_event_all", SOA_event_allDataProduct},
+        {"soa_event_perData", SOA_event_perDataProduct},
+        {"soa_event_perGroup", SOA_event_perGroup},
+        {"soa_topObject_all", SOA_topObject_allDataProduct},
+        {"soa_topObject_perData", SOA_topObject_perDataProduct},
+        {"soa_topObject_perGroup", SOA_topObject_perGroup},
+        {"soa_element_all", SOA_element_allDataProduct},
+        {"soa_element_perData", SOA_element_perDataProduct},
+        {"soa_element_perGroup", SOA_element_perGroup},
+    };
+    static const std::map<std::string, SpillWriter> spillWriters = {
+        {"aos_spill_all", AOS_spill_allDataProduct},
+        {"aos_spill_perData", AOS_spill_perDataProduct},
+        {"aos_spill_perGroup", AOS_spill_perGroup},
+        {"soa_spill_all", SOA_spill_allDataProduct},
+        {"soa_spill_perData", SOA_spill_perDataProduct},
+        {"soa_spill_perGroup", SOA_spill_perGroup},
+    };
+    if (auto it = eventWriters.find(layout); it != eventWriters.end()) {
+        return it->second(numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, fileName, nThreads);
+    }
+    if (auto it = spillWriters.find(layout); it != spillWriters.end()) {
+        return it->second(numEvents, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire, fileName, nThreads);
+    }
+    throw std::invalid_argument("unknown writer layout '" + layout + "'");
+}
@@ -0,0 +1,476 @@
+#include "JoinReader.hpp"
+#include "Affinity.hpp"
+#include "EventIndex.hpp"
+#include "Utils.hpp"
+#include "ZoneMap.hpp"
+#include <ROOT/RNTupleReader.hxx>
+#include <TStopwatch.h>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+using EntryRanges = std::vector<std::pair<std::uint64_t, std::uint64_t>>;
+using Chunk = std::pair<std::size_t, std::size_t>;
+
+std::uint64_t gWindowEntries = kDefaultJoinWindowEntries;
+
+// EventID range of one cluster; window mode only
+struct ClusterKeys {
+    std::uint64_t first = 0;
+    std::uint64_t last = 0;
+    std::uint64_t keyed = 0; // entries with an EventID; minKey/maxKey are unset without any
+    long long minKey = 0;
+    long long maxKey = 0;
+};
+
+struct JoinSide {
+    std::string ntupleName;
+    std::string keyNtupleName; // ntupleName, or the parallel ntuple the EventIDs are read from
+    EventKeyColumn key;
+    std::uint64_t nEntries = 0;
+    std::vector<long long> keys; // per entry; kNoEventKey for empty collections
+    std::vector<Chunk> chunks;
+    std::unordered_map<long long, EntryRanges> table; // hash mode only
+    std::vector<ClusterKeys> clusters;                // window mode only
+};
+
+// EventIDs [lo, hi] joined by one window-mode task
+struct KeyWindow {
+    long long lo = 0;
+    long long hi = 0;
+};
+
+// Readers and buffers of one window-mode thread
+struct WindowWorker {
+    std::vector<std::unique_ptr<ROOT::RNTupleReader>> readers;
+    std::vector<std::unique_ptr<ROOT::RNTupleReader>> keyReaders;
+    std::vector<std::vector<std::pair<long long, std::uint64_t>>> matches; // (EventID, entry) per side
+    std::vector<long long> keys;
+};
+
+// Runs fn(chunkIndex) for every chunk on its own pinned thread
+template <typename Fn>
+void runChunks(std::size_t nChunks, Fn&& fn) {
+    std::vector<std::future<void>> futures;
+    for (std::size_t c = 0; c < nChunks; ++c) {
+        futures.emplace_back(std::async(std::launch::async, [&fn, c]() {
+            Affinity::pinCurrentThreadToNextSlot();
+            fn(c);
+        }));
+    }
+    for (auto& f : futures) f.get();
+}
+
+bool keysOrdered(const std::vector<long long>& keys) {
+    return std::find(keys.begin(), keys.end(), kNoEventKey) == keys.end() && std::is_sorted(keys.begin(), keys.end());
+}
+
+void buildTable(JoinSide& side) {
+    side.table.clear();
+    for (std::size_t i = 0; i < side.keys.size(); ++i) {
+        const long long key = side.keys[i];
+        if (key == kNoEventKey) continue;
+        auto& ranges = side.table[key];
+        if (!ranges.empty() && ranges.back().second == i) {
+            ++ranges.back().second;
+        } else {
+            ranges.emplace_back(i, i + 1);
+        }
+    }
+}
+
+std::uint64_t loadRange(ROOT::RNTupleReader& reader, std::uint64_t first, std::uint64_t last) {
+    for (auto e = first; e < last; ++e) reader.LoadEntry(e);
+    return last - first;
+}
+
+// Default visitor: loads every entry of the event
+class LoadVisitor : public JoinVisitor {
+public:
+    void visitRange(std::size_t, ROOT::RNTupleReader& reader, std::uint64_t first, std::uint64_t last) override {
+        loadRange(reader, first, last);
+    }
+};
+
+// Assembles the events whose first driving entry lies in the chunk, looked up through the tables
+void probeHash(const std::string& fileName, const std::vector<JoinSide>& sides, const Chunk& chunk,
+               JoinVisitor& visitor, std::uint64_t& events, std::uint64_t& entries) {
+    std::vector<std::unique_ptr<ROOT::RNTupleReader>> readers;
+    for (const auto& side : sides) readers.push_back(ROOT::RNTupleReader::Open(side.ntupleName, fileName));
+    const auto& driving = sides.front();
+    for (auto i = chunk.first; i < chunk.second; ++i) {
+        const long long key = driving.keys[i];
+        if (key == kNoEventKey) continue;
+        if (driving.table.at(key).front().first != i) continue; // owned by the chunk of its first entry
+        ++events;
+        visitor.beginEvent(key);
+        for (std::size_t s = 0; s < sides.size(); ++s) {
+            auto it = sides[s].table.find(key);
+            if (it == sides[s].table.end()) continue;
+            for (const auto& [first, last] : it->second) {
+                visitor.visitRange(s, *readers[s], first, last);
+                entries += last - first;
+            }
+        }
+        visitor.endEvent();
+    }
+}
+
+// Same on key-ordered ntuples: one forward cursor per side, started by binary search
+void probeMerge(const std::string& fileName, const std::vector<JoinSide>& sides, const Chunk& chunk,
+                JoinVisitor& visitor, std::uint64_t& events, std::uint64_t& entries) {
+    const auto& d = sides.front().keys;
+    std::size_t i = chunk.first;
+    if (i > 0) {
+        while (i < chunk.second && d[i] == d[chunk.first - 1]) ++i; // run started in the previous chunk
+    }
+    if (i >= chunk.second) return;
+
+    std::vector<std::unique_ptr<ROOT::RNTupleReader>> readers;
+    std::vector<std::size_t> cursor;
+    for (const auto& side : sides) {
+        readers.push_back(ROOT::RNTupleReader::Open(side.ntupleName, fileName));
+        cursor.push_back(std::lower_bound(side.keys.begin(), side.keys.end(), d[i]) - side.keys.begin());
+    }
+    while (i < chunk.second) {
+        const long long key = d[i];
+        ++events;
+        visitor.beginEvent(key);
+        for (std::size_t s = 0; s < sides.size(); ++s) {
+            const auto& keys = sides[s].keys;
+            auto& c = cursor[s];
+            while (c < keys.size() && keys[c] < key) ++c; // EventIDs missing from the driving side
+            std::size_t first = c;
+            while (c < keys.size() && keys[c] == key) ++c;
+            if (c > first) visitor.visitRange(s, *readers[s], first, c);
+            entries += c - first;
+        }
+        visitor.endEvent();
+        i = std::max(i + 1, cursor.front());
+    }
+}
+
+// Window mode, first pass: the EventID range of every cluster of the side
+void scanClusterKeys(const std::string& fileName, JoinSide& side) {
+    auto pilot = ROOT::RNTupleReader::Open(side.keyNtupleName, fileName);
+    for (const auto& span : Utils::cluster_spans(*pilot, Utils::ClusterWeight::Entries)) {
+        ClusterKeys cluster;
+        cluster.first = span.firstEntry;
+        cluster.last = span.firstEntry + span.nEntries;
+        side.clusters.push_back(cluster);
+    }
+    runChunks(side.chunks.size(), [&](std::size_t c) {
+        auto reader = ROOT::RNTupleReader::Open(side.keyNtupleName, fileName);
+        std::vector<long long> keys;
+        for (auto& cluster : side.clusters) {
+            if (cluster.first < side.chunks[c].first || cluster.first >= side.chunks[c].second) continue;
+            keys.resize(cluster.last - cluster.first);
+            readEventKeys(*reader, side.key, cluster.first, cluster.last, keys.data());
+            for (long long key : keys) {
+                if (key == kNoEventKey) continue;
+                if (cluster.keyed++ == 0) cluster.minKey = cluster.maxKey = key;
+                cluster.minKey = std::min(cluster.minKey, key);
+                cluster.maxKey = std::max(cluster.maxKey, key);
+            }
+        }
+    });
+}
+
+// Cuts the EventID axis in front of a cluster once the clusters starting in the current window
+// reach the entry budget. Clusters with overlapping ranges may push a window past it.
+std::vector<KeyWindow> planWindows(const std::vector<JoinSide>& sides, std::uint64_t budget) {
+    std::vector<const ClusterKeys*> clusters;
+    for (const auto& side : sides) {
+        for (const auto& cluster : side.clusters) {
+            if (cluster.keyed > 0) clusters.push_back(&cluster);
+        }
+    }
+    std::vector<KeyWindow> windows;
+    if (clusters.empty()) return windows;
+    std::stable_sort(clusters.begin(), clusters.end(),
+                     [](const ClusterKeys* a, const ClusterKeys* b) { return a->minKey < b->minKey; });
+    windows.push_back({clusters.front()->minKey, std::numeric_limits<long long>::max()});
+    std::uint64_t entries = 0;
+    for (const auto* cluster : clusters) {
+        const std::uint64_t n = cluster->last - cluster->first;
+        if (entries > 0 && entries + n > budget && cluster->minKey > windows.back().lo) {
+            windows.back().hi = cluster->minKey - 1;
+            windows.push_back({cluster->minKey, std::numeric_limits<long long>::max()});
+            entries = 0;
+        }
+        entries += n;
+    }
+    return windows;
+}
+
+// Assembles the events of the window whose EventID occurs in the driving side, reading the keys
+// of the overlapping clusters only
+void probeWindow(const std::vector<JoinSide>& sides, const KeyWindow& window, WindowWorker& worker,
+                 JoinVisitor& visitor, std::uint64_t& events, std::uint64_t& entries) {
+    for (std::size_t s = 0; s < sides.size(); ++s) {
+        auto& matches = worker.matches[s];
+        matches.clear();
+        for (const auto& cluster : sides[s].clusters) {
+            if (cluster.keyed == 0 || cluster.maxKey < window.lo || cluster.minKey > window.hi) continue;
+            worker.keys.resize(cluster.last - cluster.first);
+            readEventKeys(*worker.keyReaders[s], sides[s].key, cluster.first, cluster.last, worker.keys.data());
+            for (std::size_t i = 0; i < worker.keys.size(); ++i) {
+                const long long key = worker.keys[i];
+                if (key != kNoEventKey && key >= window.lo && key <= window.hi) matches.emplace_back(key, cluster.first + i);
+            }
+        }
+        std::sort(matches.begin(), matches.end());
+    }
+
+    std::vector<std::size_t> cursor(sides.size(), 0);
+    const auto& driving = worker.matches.front();
+    for (std::size_t i = 0; i < driving.size(); i = cursor.front()) {
+        const long long key = driving[i].first;
+        ++events;
+        visitor.beginEvent(key);
+        for (std::size_t s = 0; s < sides.size(); ++s) {
+            const auto& matches = worker.matches[s];
+            auto& c = cursor[s];
+            while (c < matches.size() && matches[c].first < key) ++c; // EventIDs missing from the driving side
+            while (c < matches.size() && matches[c].first == key) {
+                const std::uint64_t first = matches[c].second;
+                std::uint64_t last = first + 1;
+                while (++c < matches.size() && matches[c].first == key && matches[c].second == last) ++last;
+                visitor.visitRange(s, *worker.readers[s], first, last);
+                entries += last - first;
+            }
+        }
+        visitor.endEvent();
+    }
+}
+
+JoinResult joinByWindows(const std::string& fileName, int nThreads, std::vector<JoinSide>& sides,
+                         const JoinVisitorFactory& makeVisitor, JoinResult& result) {
+    result.mode = JoinMode::Window;
+    TStopwatch sw; sw.Start();
+    for (auto& side : sides) {
+        scanClusterKeys(fileName, side);
+        for (const auto& cluster : side.clusters) result.keyedEntries += cluster.keyed;
+    }
+    sw.Stop();
+    result.keyScan = sw.RealTime();
+
+    sw.Start();
+    const auto windows = planWindows(sides, gWindowEntries);
+    sw.Stop();
+    result.build = sw.RealTime();
+
+    sw.Start();
+    const std::size_t nWorkers = std::min<std::size_t>(std::max(1, nThreads), windows.size());
+    std::vector<std::uint64_t> events(nWorkers, 0), entries(nWorkers, 0);
+    std::atomic<std::size_t> next{0};
+    runChunks(nWorkers, [&](std::size_t t) {
+        auto visitor = makeVisitor(t);
+        WindowWorker worker;
+        for (const auto& side : sides) {
+            worker.readers.push_back(ROOT::RNTupleReader::Open(side.ntupleName, fileName));
+            worker.keyReaders.push_back(ROOT::RNTupleReader::Open(side.keyNtupleName, fileName));
+        }
+        worker.matches.resize(sides.size());
+        for (std::size_t w = next++; w < windows.size(); w = next++) {
+            probeWindow(sides, windows[w], worker, *visitor, events[t], entries[t]);
+        }
+    });
+    sw.Stop();
+    result.probe = sw.RealTime();
+    for (std::size_t t = 0; t < nWorkers; ++t) {
+        result.events += events[t];
+        result.entries += entries[t];
+    }
+    return result;
+}
+
+} // namespace
+
+void setJoinWindowEntries(std::uint64_t entries) {
+    gWindowEntries = std::max<std::uint64_t>(1, entries);
+}
+
+JoinMode parseJoinMode(const std::string& name) {
+    if (name == "auto") return JoinMode::Auto;
+    if (name == "merge") return JoinMode::Merge;
+    if (name == "hash") return JoinMode::Hash;
+    if (name == "window") return JoinMode::Window;
+    throw std::invalid_argument("unknown join mode '" + name + "' (expected auto, merge, hash or window)");
+}
+
+std::string joinModeName(JoinMode mode) {
+    switch (mode) {
+        case JoinMode::Auto: return "auto";
+        case JoinMode::Merge: return "merge";
+        case JoinMode::Hash: return "hash";
+        case JoinMode::Window: return "window";
+    }
+    return "unknown";
+}
+
+JoinResult joinEventsByKey(const std::string& fileName, int nThreads, JoinMode mode) {
+    if (listDataNtuples(fileName).size() < 2) throw std::runtime_error("nothing to join in " + fileName);
+    return joinEventsByKey(fileName, nThreads, mode, [](std::size_t) { return std::make_unique<LoadVisitor>(); });
+}
+
+JoinResult joinEventsByKey(const std::string& fileName, int nThreads, JoinMode mode, const JoinVisitorFactory& makeVisitor) {
+    JoinResult result;
+    std::vector<JoinSide> sides;
+    const auto names = listDataNtuples(fileName);
+    for (const auto& name : names) {
+        JoinSide side;
+        side.ntupleName = name;
+        side.keyNtupleName = name;
+        auto pilot = ROOT::RNTupleReader::Open(name, fileName);
+        side.nEntries = pilot->GetNEntries();
+        if (!findEventKeyColumn(*pilot, side.key)) {
+            // SOA ROIs: entry i belongs to the event of entry i of the parallel wire ntuple
+            side.keyNtupleName = findParallelKeyNtuple(name, names);
+            if (side.keyNtupleName.empty()) throw std::runtime_error(name + " has no EventID to join on");
+            auto keyPilot = ROOT::RNTupleReader::Open(side.keyNtupleName, fileName);
+            if (keyPilot->GetNEntries() != side.nEntries || !findEventKeyColumn(*keyPilot, side.key)) {
+                throw std::runtime_error(name + " does not run parallel to " + side.keyNtupleName);
+            }
+        }
+        side.chunks = Utils::split_range_by_clusters(*pilot, nThreads);
+        sides.push_back(std::move(side));
+    }
+    if (sides.empty()) throw std::runtime_error("no data ntuples in " + fileName);
+    // The ntuple with the most entries has the finest cluster split, so it drives the work
+    std::stable_sort(sides.begin(), sides.end(),
+                     [](const JoinSide& a, const JoinSide& b) { return a.nEntries > b.nEntries; });
+    result.sides = static_cast<int>(sides.size());
+    if (mode == JoinMode::Window) return joinByWindows(fileName, nThreads, sides, makeVisitor, result);
+
+    TStopwatch sw; sw.Start();
+    for (auto& side : sides) {
+        side.keys.assign(side.nEntries, kNoEventKey);
+        runChunks(side.chunks.size(), [&](std::size_t c) {
+            auto reader = ROOT::RNTupleReader::Open(side.keyNtupleName, fileName);
+            const auto& chunk = side.chunks[c];
+            readEventKeys(*reader, side.key, chunk.first, chunk.second, side.keys.data() + chunk.first);
+        });
+    }
+    sw.Stop();
+    result.keyScan = sw.RealTime();
+
+    sw.Start();
+    bool ordered = true;
+    for (const auto& side : sides) ordered = ordered && keysOrdered(side.keys);
+    if (mode == JoinMode::Merge && !ordered) throw std::runtime_error("merge join needs EventID-ordered ntuples");
+    result.mode = (mode == JoinMode::Auto) ? (ordered ? JoinMode::Merge : JoinMode::Hash) : mode;
+    if (result.mode == JoinMode::Hash) {
+        for (auto& side : sides) buildTable(side);
+    }
+    for (const auto& side : sides) {
+        result.keyedEntries += side.keys.size() - std::count(side.keys.begin(), side.keys.end(), kNoEventKey);
+    }
+    sw.Stop();
+    result.build = sw.RealTime();
+
+    sw.Start();
+    const auto& chunks = sides.front().chunks;
+    std::vector<std::uint64_t> events(chunks.size(), 0), entries(chunks.size(), 0);
+    runChunks(chunks.size(), [&](std::size_t c) {
+        auto visitor = makeVisitor(c);
+        if (result.mode == JoinMode::Merge) {
+            probeMerge(fileName, sides, chunks[c], *visitor, events[c], entries[c]);
+        } else {
+            probeHash(fileName, sides, chunks[c], *visitor, events[c], entries[c]);
+        }
+    });
+    sw.Stop();
+    result.probe = sw.RealTime();
+    for (std::size_t c = 0; c < chunks.size(); ++c) {
+        result.events += events[c];
+        result.entries += entries[c];
+    }
+    return result;
+}
+
+double loadAllEntries(const std::string& fileName, int nThreads) {
+    TStopwatch sw; sw.Start();
+    for (const auto& name : listDataNtuples(fileName)) {
+        auto pilot = ROOT::RNTupleReader::Open(name, fileName);
+        auto chunks = Utils::split_range_by_clusters(*pilot, nThreads);
+        runChunks(chunks.size(), [&](std::size_t c) {
+            auto reader = ROOT::RNTupleReader::Open(name, fileName);
+            loadRange(*reader, chunks[c].first, chunks[c].second);
+        });
+    }
+    sw.Stop();
+    return sw.RealTime();
+}
+
+std::string allDataProductFileFor(const std::string& splitFile) {
+    const std::string stem = std::filesystem::path(splitFile).stem().string();
+    if (stem.find("_spill_") != std::string::npos) return "";
+    for (const std::string suffix : {"_perData", "_perGroup"}) {
+        if (stem.size() > suffix.size() && stem.compare(stem.size() - suffix.size(), suffix.size(), suffix) == 0) {
+            auto all = std::filesystem::path(splitFile);
+            all.replace_filename(stem.substr(0, stem.size() - suffix.size()) + "_all.root");
+            return all.string();
+        }
+    }
+    return "";
+}
+
+void benchmarkJoinRead(const std::vector<std::string>& files, int nThreads, JoinMode mode) {
+    const int col1 = 28, col2 = 8, col3 = 12;
+    std::cout << "\nEvent Join Read (" << nThreads << " threads, times in s)" << std::endl;
+    std::cout << std::left
+              << std::setw(col1) << "File"
+              << std::setw(col2) << "Sides"
+              << std::setw(col2) << "Mode"
+              << std::setw(col3) << "Events"
+              << std::setw(col3) << "Unmatched"
+              << std::setw(col3) << "Key scan"
+              << std::setw(col3) << "Join"
+              << std::setw(col3) << "No join"
+              << std::setw(col3) << "All"
+              << std::setw(col3) << "Join/All" << std::endl;
+    std::cout << std::string(col1 + 2 * col2 + 7 * col3, '-') << std::endl;
+
+    for (const auto& fileName : files) {
+        const std::string allFile = allDataProductFileFor(fileName);
+        if (allFile.empty() || !std::filesystem::exists(fileName)) continue;
+        std::cout << std::left << std::setw(col1) << std::filesystem::path(fileName).stem().string();
+        try {
+            Affinity::resetSlots();
+            JoinResult join = joinEventsByKey(fileName, nThreads, mode);
+            Affinity::resetSlots();
+            double separate = loadAllEntries(fileName, nThreads);
+            double all = 0.0;
+            if (std::filesystem::exists(allFile)) {
+                Affinity::resetSlots();
+                all = loadAllEntries(allFile, nThreads);
+            }
+            std::cout << std::setw(col2) << join.sides
+                      << std::setw(col2) << joinModeName(join.mode)
+                      << std::setw(col3) << join.events
+                      << std::setw(col3) << (join.keyedEntries - join.entries)
+                      << std::setw(col3) << join.keyScan
+                      << std::setw(col3) << join.total()
+                      << std::setw(col3) << separate;
+            if (all > 0.0) {
+                std::cout << std::setw(col3) << all << std::setw(col3) << join.total() / all;
+            } else {
+                std::cout << std::setw(col3) << "-" << std::setw(col3) << "-";
+            }
+            std::cout << std::endl;
+        } catch (const std::exception& e) {
+            std::cout << "FAILED: " << e.what() << std::endl;
+        }
+    }
+    std::cout << std::string(col1 + 2 * col2 + 7 * col3, '-') << std::endl;
+}
@@ -0,0 +1,1044 @@
+#include "LayoutConverter.hpp"
+#include "HitWireWriterHelpers.hpp"
+#include "UnionRow.hpp"
+#include "UnionRowSOA.hpp"
+#include "TopBatchRow.hpp"
+#include "TopBatchRowSOA.hpp"
+#include "ClusterTargeting.hpp"
+#include "EventIndex.hpp"
+#include "JoinReader.hpp"
+#include "Affinity.hpp"
+#include "Utils.hpp"
+#include "ZoneMap.hpp"
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleReader.hxx>
+#include <ROOT/RNTupleParallelWriter.hxx>
+#include <ROOT/RNTupleFillContext.hxx>
+#include <ROOT/RRawPtrWriteEntry.hxx>
+#include <TFile.h>
+#include <TStopwatch.h>
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+
+namespace {
+
+const char* const kGroupNames[] = {"event", "spill", "topObject", "element"};
+const char* const kProductNames[] = {"all", "perData", "perGroup"};
+
+// HitIndividual and SOAHit have the same members
+template <typename From, typename To>
+void copyHit(const From& in, To& out) {
+    out.EventID = in.EventID;
+    out.fChannel = in.fChannel;
+    out.fView = in.fView;
+    out.fStartTick = in.fStartTick;
+    out.fEndTick = in.fEndTick;
+    out.fPeakTime = in.fPeakTime;
+    out.fSigmaPeakTime = in.fSigmaPeakTime;
+    out.fRMS = in.fRMS;
+    out.fPeakAmplitude = in.fPeakAmplitude;
+    out.fSigmaPeakAmplitude = in.fSigmaPeakAmplitude;
+    out.fROISummedADC = in.fROISummedADC;
+    out.fHitSummedADC = in.fHitSummedADC;
+    out.fIntegral = in.fIntegral;
+    out.fSigmaIntegral = in.fSigmaIntegral;
+    out.fMultiplicity = in.fMultiplicity;
+    out.fLocalIndex = in.fLocalIndex;
+    out.fGoodnessOfFit = in.fGoodnessOfFit;
+    out.fNDF = in.fNDF;
+    out.fSignalType = in.fSignalType;
+    out.fWireID_Cryostat = in.fWireID_Cryostat;
+    out.fWireID_TPC = in.fWireID_TPC;
+    out.fWireID_Plane = in.fWireID_Plane;
+    out.fWireID_Wire = in.fWireID_Wire;
+}
+
+HitIndividual hitAt(const SOAHitVector& hits, std::size_t i) {
+    HitIndividual hit;
+    hit.EventID = hits.EventIDs[i];
+    hit.fChannel = hits.fChannel[i];
+    hit.fView = hits.fView[i];
+    hit.fStartTick = hits.fStartTick[i];
+    hit.fEndTick = hits.fEndTick[i];
+    hit.fPeakTime = hits.fPeakTime[i];
+    hit.fSigmaPeakTime = hits.fSigmaPeakTime[i];
+    hit.fRMS = hits.fRMS[i];
+    hit.fPeakAmplitude = hits.fPeakAmplitude[i];
+    hit.fSigmaPeakAmplitude = hits.fSigmaPeakAmplitude[i];
+    hit.fROISummedADC = hits.fROISummedADC[i];
+    hit.fHitSummedADC = hits.fHitSummedADC[i];
+    hit.fIntegral = hits.fIntegral[i];
+    hit.fSigmaIntegral = hits.fSigmaIntegral[i];
+    hit.fMultiplicity = hits.fMultiplicity[i];
+    hit.fLocalIndex = hits.fLocalIndex[i];
+    hit.fGoodnessOfFit = hits.fGoodnessOfFit[i];
+    hit.fNDF = hits.fNDF[i];
+    hit.fSignalType = hits.fSignalType[i];
+    hit.fWireID_Cryostat = hits.fWireID_Cryostat[i];
+    hit.fWireID_TPC = hits.fWireID_TPC[i];
+    hit.fWireID_Plane = hits.fWireID_Plane[i];
+    hit.fWireID_Wire = hits.fWireID_Wire[i];
+    return hit;
+}
+
+// Clears the columns but keeps their capacity, so per-thread buffers stop allocating
+void toSOAHits(const std::vector<HitIndividual>& in, SOAHitVector& out) {
+    out.EventIDs.clear(); out.fChannel.clear(); out.fView.clear(); out.fStartTick.clear(); out.fEndTick.clear();
+    out.fPeakTime.clear(); out.fSigmaPeakTime.clear(); out.fRMS.clear(); out.fPeakAmplitude.clear();
+    out.fSigmaPeakAmplitude.clear(); out.fROISummedADC.clear(); out.fHitSummedADC.clear(); out.fIntegral.clear();
+    out.fSigmaIntegral.clear(); out.fMultiplicity.clear(); out.fLocalIndex.clear(); out.fGoodnessOfFit.clear();
+    out.fNDF.clear(); out.fSignalType.clear(); out.fWireID_Cryostat.clear(); out.fWireID_TPC.clear();
+    out.fWireID_Plane.clear(); out.fWireID_Wire.clear();
+    for (const auto& hit : in) {
+        out.EventIDs.push_back(hit.EventID);
+        out.fChannel.push_back(hit.fChannel);
+        out.fView.push_back(hit.fView);
+        out.fStartTick.push_back(hit.fStartTick);
+        out.fEndTick.push_back(hit.fEndTick);
+        out.fPeakTime.push_back(hit.fPeakTime);
+        out.fSigmaPeakTime.push_back(hit.fSigmaPeakTime);
+        out.fRMS.push_back(hit.fRMS);
+        out.fPeakAmplitude.push_back(hit.fPeakAmplitude);
+        out.fSigmaPeakAmplitude.push_back(hit.fSigmaPeakAmplitude);
+        out.fROISummedADC.push_back(hit.fROISummedADC);
+        out.fHitSummedADC.push_back(hit.fHitSummedADC);
+        out.fIntegral.push_back(hit.fIntegral);
+        out.fSigmaIntegral.push_back(hit.fSigmaIntegral);
+        out.fMultiplicity.push_back(hit.fMultiplicity);
+        out.fLocalIndex.push_back(hit.fLocalIndex);
+        out.fGoodnessOfFit.push_back(hit.fGoodnessOfFit);
+        out.fNDF.push_back(hit.fNDF);
+        out.fSignalType.push_back(hit.fSignalType);
+        out.fWireID_Cryostat.push_back(hit.fWireID_Cryostat);
+        out.fWireID_TPC.push_back(hit.fWireID_TPC);
+        out.fWireID_Plane.push_back(hit.fWireID_Plane);
+        out.fWireID_Wire.push_back(hit.fWireID_Wire);
+    }
+}
+
+void toSOARois(const RegionsOfInterest_t& in, std::vector<SOAROI>& out) {
+    out.resize(in.size());
+    for (std::size_t r = 0; r < in.size(); ++r) out[r].data = in[r].data;
+}
+
+void toSOAWires(const std::vector<WireIndividual>& in, SOAWireVector& out) {
+    out.EventIDs.clear();
+    out.fWire_Channel.clear();
+    out.fWire_View.clear();
+    out.fSignalROI.resize(in.size());
+    for (std::size_t w = 0; w < in.size(); ++w) {
+        out.EventIDs.push_back(in[w].EventID);
+        out.fWire_Channel.push_back(in[w].fWire_Channel);
+        out.fWire_View.push_back(in[w].fWire_View);
+        toSOARois(in[w].getSignalROI(), out.fSignalROI[w]);
+    }
+}
+
+SOAWireBase toSOAWireBase(const WireIndividual& wire) {
+    SOAWireBase base;
+    base.EventID = wire.EventID;
+    base.fWire_Channel = wire.fWire_Channel;
+    base.fWire_View = wire.fWire_View;
+    return base;
+}
+
+// Contiguous slice s of n, as the spill writers cut an event
+template <typename T>
+void spillSlice(const std::vector<T>& in, int s, int n, std::vector<T>& out) {
+    out.assign(in.begin() + in.size() * s / n, in.begin() + in.size() * (s + 1) / n);
+}
+
+// ---------------------------------------------------------------------------------------------
+// Decoding: any input entry -> elements of one EventAOS
+
+struct PendingRoi {
+    unsigned int wireId;
+    RegionOfInterest roi;
+};
+
+class EventBuilder {
+public:
+    void begin(long long eventId) {
+        fEventId = eventId;
+        event.hits.clear();
+        event.wires.clear();
+        fPending.clear();
+    }
+
+    long long eventId() const { return fEventId; }
+
+    template <typename Hit>
+    void addHit(const Hit& in) {
+        event.hits.emplace_back();
+        copyHit(in, event.hits.back());
+    }
+
+    WireIndividual& addWire(long long eventId, unsigned int channel, int view) {
+        event.wires.emplace_back();
+        auto& wire = event.wires.back();
+        wire.EventID = eventId;
+        wire.fWire_Channel = channel;
+        wire.fWire_View = view;
+        return wire;
+    }
+
+    // ROI stored without its wire; attached by finish()
+    void addRoi(unsigned int wireId, std::size_t offset, const std::vector<float>& data) {
+        fPending.push_back({wireId, RegionOfInterest{}});
+        fPending.back().roi.offset = offset;
+        fPending.back().roi.data = data;
+    }
+
+    // ROI stored with a copy of its wire (WireROI): consecutive ROIs of a channel share one wire
+    void addWireRoi(const WireROI& in) {
+        if (event.wires.empty() || event.wires.back().fWire_Channel != in.fWire_Channel) {
+            addWire(in.EventID, in.fWire_Channel, in.fWire_View);
+        }
+        event.wires.back().getSignalROI().push_back(in.roi);
+    }
+
+    // Pending ROIs go to the next wire with their channel, scanning forward from the previous
+    // match, so wires keep their ROIs when both ntuples list them in the same order. ROIs
+    // without any wire get a wire of their own.
+    void finish() {
+        std::size_t cursor = 0;
+        for (auto& pending : fPending) {
+            auto& wires = event.wires;
+            std::size_t w = cursor;
+            while (w < wires.size() && wires[w].fWire_Channel != pending.wireId) ++w;
+            if (w == wires.size()) {
+                w = 0;
+                while (w < cursor && wires[w].fWire_Channel != pending.wireId) ++w;
+                if (w == cursor) {
+                    addWire(fEventId, pending.wireId, 0);
+                    w = wires.size() - 1;
+                }
+            }
+            wires[w].getSignalROI().push_back(std::move(pending.roi));
+            cursor = w;
+        }
+        fPending.clear();
+    }
+
+    EventAOS event;
+
+private:
+    long long fEventId = 0;
+    std::vector<PendingRoi> fPending;
+};
+
+class SideDecoder {
+public:
+    virtual ~SideDecoder() = default;
+    virtual void decode(std::uint64_t first, std::uint64_t last, EventBuilder& builder) = 0;
+};
+
+template <typename T, typename Fn>
+class ViewDecoder : public SideDecoder {
+public:
+    ViewDecoder(ROOT::RNTupleReader& reader, const std::string& field, Fn append)
+        : fView(reader.GetView<T>(field)), fAppend(append) {}
+    void decode(std::uint64_t first, std::uint64_t last, EventBuilder& builder) override {
+        for (auto e = first; e < last; ++e) fAppend(fView(e), builder);
+    }
+
+private:
+    decltype(std::declval<ROOT::RNTupleReader&>().GetView<T>(std::string())) fView;
+    Fn fAppend;
+};
+
+template <typename T, typename Fn>
+std::unique_ptr<SideDecoder> viewDecoder(ROOT::RNTupleReader& reader, const std::string& field, Fn append) {
+    return std::make_unique<ViewDecoder<T, Fn>>(reader, field, append);
+}
+
+void appendChannels(const SOAWireBase& wire, std::vector<unsigned int>& channels) {
+    channels.push_back(wire.fWire_Channel);
+}
+
+void appendChannels(const std::vector<SOAWireBase>& wires, std::vector<unsigned int>& channels) {
+    for (const auto& wire : wires) channels.push_back(wire.fWire_Channel);
+}
+
+// SOAROI vectors without EventID or WireID (SOA event, spill and topObject perGroup): entry e
+// holds the ROIs of the wires of entry e of the parallel wire ntuple, the same number per wire
+template <typename Wires>
+class ParallelRoiDecoder : public SideDecoder {
+public:
+    ParallelRoiDecoder(ROOT::RNTupleReader& reader, const std::string& field,
+                       std::unique_ptr<ROOT::RNTupleReader> wireReader, const std::string& wireField)
+        : fRois(reader.GetView<std::vector<SOAROI>>(field)),
+          fWireReader(std::move(wireReader)),
+          fWires(fWireReader->GetView<Wires>(wireField)) {}
+
+    void decode(std::uint64_t first, std::uint64_t last, EventBuilder& builder) override {
+        for (auto e = first; e < last; ++e) {
+            const auto& rois = fRois(e);
+            if (rois.empty()) continue;
+            fChannels.clear();
+            appendChannels(fWires(e), fChannels);
+            if (fChannels.empty() || rois.size() % fChannels.size() != 0) {
+                throw std::runtime_error("entry " + std::to_string(e) + ": " + std::to_string(rois.size()) +
+                                         " ROIs do not split evenly over " + std::to_string(fChannels.size()) + " wires");
+            }
+            const std::size_t perWire = rois.size() / fChannels.size();
+            for (std::size_t r = 0; r < rois.size(); ++r) builder.addRoi(fChannels[r / perWire], 0, rois[r].data);
+        }
+    }
+
+private:
+    decltype(std::declval<ROOT::RNTupleReader&>().GetView<std::vector<SOAROI>>(std::string())) fRois;
+    std::unique_ptr<ROOT::RNTupleReader> fWireReader;
+    decltype(std::declval<ROOT::RNTupleReader&>().GetView<Wires>(std::string())) fWires;
+    std::vector<unsigned int> fChannels;
+};
+
+std::unique_ptr<SideDecoder> parallelRoiDecoder(ROOT::RNTupleReader& reader, const std::string& field,
+                                                const std::string& fileName) {
+    const std::string ntupleName = reader.GetDescriptor().GetName();
+    const std::string wireNtuple = findParallelKeyNtuple(ntupleName, listDataNtuples(fileName));
+    if (wireNtuple.empty()) throw std::runtime_error(ntupleName + " has no parallel wire ntuple");
+    auto wireReader = ROOT::RNTupleReader::Open(wireNtuple, fileName);
+    const auto& desc = wireReader->GetDescriptor();
+    for (const auto& wireField : desc.GetFieldIterable(desc.GetFieldZeroId())) {
+        const std::string name = wireField.GetFieldName();
+        const std::string type = wireField.GetTypeName();
+        if (type == "SOAWireBase") {
+            return std::make_unique<ParallelRoiDecoder<SOAWireBase>>(reader, field, std::move(wireReader), name);
+        }
+        if (type == "std::vector<SOAWireBase>") {
+            return std::make_unique<ParallelRoiDecoder<std::vector<SOAWireBase>>>(reader, field, std::move(wireReader), name);
+        }
+    }
+    throw std::runtime_error(wireNtuple + " holds no SOA wires for " + ntupleName);
+}
+
+void addWire(const WireIndividual& wire, EventBuilder& b) {
+    b.event.wires.push_back(wire);
+}
+
+void addWireBase(const WireBase& wire, EventBuilder& b) {
+    b.addWire(wire.EventID, wire.fWire_Channel, wire.fWire_View);
+}
+
+void addSOAWireBase(const SOAWireBase& wire, EventBuilder& b) {
+    b.addWire(wire.EventID, wire.fWire_Channel, wire.fWire_View);
+}
+
+void addFlatRoi(const FlatROI& roi, EventBuilder& b) {
+    b.addRoi(roi.WireID, roi.offset, roi.data);
+}
+
+void addFlatSOARoi(const FlatSOAROI& roi, EventBuilder& b) {
+    b.addRoi(roi.WireID, roi.offset, roi.data);
+}
+
+void addSOAWires(const SOAWireVector& wires, EventBuilder& b) {
+    for (std::size_t w = 0; w < wires.fWire_Channel.size(); ++w) {
+        auto& wire = b.addWire(wires.EventIDs[w], wires.fWire_Channel[w], wires.fWire_View[w]);
+        for (const auto& roi : wires.fSignalROI[w]) {
+            wire.getSignalROI().emplace_back();
+            wire.getSignalROI().back().offset = 0;
+            wire.getSignalROI().back().data = roi.data;
+        }
+    }
+}
+
+void addSOAHits(const SOAHitVector& hits, EventBuilder& b) {
+    for (std::size_t h = 0; h < hits.fChannel.size(); ++h) b.event.hits.push_back(hitAt(hits, h));
+}
+
+// Picks the decoder from the type of the ntuple's top-level field
+std::unique_ptr<SideDecoder> makeDecoder(ROOT::RNTupleReader& reader, const std::string& fileName) {
+    const auto& desc = reader.GetDescriptor();
+    for (const auto& field : desc.GetFieldIterable(desc.GetFieldZeroId())) {
+        const std::string name = field.GetFieldName();
+        const std::string type = field.GetTypeName();
+        if (type == "EventAOS") {
+            return viewDecoder<EventAOS>(reader, name, [](const EventAOS& e, EventBuilder& b) {
+                for (const auto& hit : e.hits) b.addHit(hit);
+                for (const auto& wire : e.wires) addWire(wire, b);
+            });
+        }
+        if (type == "EventSOA") {
+            return viewDecoder<EventSOA>(reader, name, [](const EventSOA& e, EventBuilder& b) {
+                addSOAHits(e.hits, b);
+                addSOAWires(e.wires, b);
+            });
+        }
+        if (type == "std::vector<HitIndividual>") {
+            return viewDecoder<std::vector<HitIndividual>>(reader, name, [](const std::vector<HitIndividual>& v, EventBuilder& b) {
+                for (const auto& hit : v) b.addHit(hit);
+            });
+        }
+        if (type == "std::vector<WireIndividual>") {
+            return viewDecoder<std::vector<WireIndividual>>(reader, name, [](const std::vector<WireIndividual>& v, EventBuilder& b) {
+                for (const auto& wire : v) addWire(wire, b);
+            });
+        }
+        if (type == "std::vector<WireBase>") {
+            return viewDecoder<std::vector<WireBase>>(reader, name, [](const std::vector<WireBase>& v, EventBuilder& b) {
+                for (const auto& wire : v) addWireBase(wire, b);
+            });
+        }
+        if (type == "std::vector<FlatROI>") {
+            return viewDecoder<std::vector<FlatROI>>(reader, name, [](const std::vector<FlatROI>& v, EventBuilder& b) {
+                for (const auto& roi : v) addFlatRoi(roi, b);
+            });
+        }
+        if (type == "SOAHitVector") return viewDecoder<SOAHitVector>(reader, name, addSOAHits);
+        if (type == "SOAWireVector") return viewDecoder<SOAWireVector>(reader, name, addSOAWires);
+        if (type == "std::vector<SOAWireBase>") {
+            return viewDecoder<std::vector<SOAWireBase>>(reader, name, [](const std::vector<SOAWireBase>& v, EventBuilder& b) {
+                for (const auto& wire : v) addSOAWireBase(wire, b);
+            });
+        }
+        if (type == "std::vector<SOAROI>") return parallelRoiDecoder(reader, name, fileName);
+        if (type == "HitIndividual") {
+            return viewDecoder<HitIndividual>(reader, name, [](const HitIndividual& hit, EventBuilder& b) { b.addHit(hit); });
+        }
+        if (type == "SOAHit") {
+            return viewDecoder<SOAHit>(reader, name, [](const SOAHit& hit, EventBuilder& b) { b.addHit(hit); });
+        }
+        if (type == "WireIndividual") return viewDecoder<WireIndividual>(reader, name, addWire);
+        if (type == "WireBase") return viewDecoder<WireBase>(reader, name, addWireBase);
+        if (type == "SOAWireBase") return viewDecoder<SOAWireBase>(reader, name, addSOAWireBase);
+        if (type == "FlatROI") return viewDecoder<FlatROI>(reader, name, addFlatRoi);
+        if (type == "FlatSOAROI") return viewDecoder<FlatSOAROI>(reader, name, addFlatSOARoi);
+        if (type == "WireROI") {
+            return viewDecoder<WireROI>(reader, name, [](const WireROI& roi, EventBuilder& b) { b.addWireRoi(roi); });
+        }
+        if (type == "SOAWire") {
+            return viewDecoder<SOAWire>(reader, name, [](const SOAWire& w, EventBuilder& b) {
+                auto& wire = b.addWire(w.EventID, w.fWire_Channel, w.fWire_View);
+                for (const auto& roi : w.fSignalROI) {
+                    wire.getSignalROI().emplace_back();
+                    wire.getSignalROI().back().offset = 0;
+                    wire.getSignalROI().back().data = roi.data;
+                }
+            });
+        }
+        if (type == "AOSTopBatchRow") {
+            return viewDecoder<AOSTopBatchRow>(reader, name, [](const AOSTopBatchRow& row, EventBuilder& b) {
+                if (row.hasHit) b.addHit(row.hit);
+                if (!row.hasWire) return;
+                auto& wire = b.addWire(row.wire.EventID, row.wire.fWire_Channel, row.wire.fWire_View);
+                for (const auto& roi : row.rois) {
+                    wire.getSignalROI().emplace_back();
+                    wire.getSignalROI().back().offset = roi.offset;
+                    wire.getSignalROI().back().data = roi.data;
+                }
+            });
+        }
+        if (type == "SOATopBatchRow") {
+            return viewDecoder<SOATopBatchRow>(reader, name, [](const SOATopBatchRow& row, EventBuilder& b) {
+                if (row.hasHit) b.addHit(row.hit);
+                if (!row.hasWire) return;
+                auto& wire = b.addWire(row.wire.EventID, row.wire.fWire_Channel, row.wire.fWire_View);
+                for (const auto& roi : row.rois) {
+                    wire.getSignalROI().emplace_back();
+                    wire.getSignalROI().back().offset = 0;
+                    wire.getSignalROI().back().data = roi.data;
+                }
+            });
+        }
+        if (type == "AOSUnionRow") {
+            return viewDecoder<AOSUnionRow>(reader, name, [](const AOSUnionRow& row, EventBuilder& b) {
+                if (row.recordType == 0) b.addHit(row.hit);
+                if (row.recordType == 1) addWireBase(row.wire, b);
+                if (row.recordType == 2) addFlatRoi(row.roi, b);
+            });
+        }
+        if (type == "SOAUnionRow") {
+            return viewDecoder<SOAUnionRow>(reader, name, [](const SOAUnionRow& row, EventBuilder& b) {
+                if (row.recordType == 0) b.addHit(row.hit);
+                if (row.recordType == 1) addSOAWireBase(row.wire, b);
+                if (row.recordType == 2) addFlatSOARoi(row.roi, b);
+            });
+        }
+        throw std::runtime_error("cannot convert field '" + name + "' of type " + type);
+    }
+    throw std::runtime_error("ntuple has no fields");
+}
+
+// ---------------------------------------------------------------------------------------------
+// Encoding: one EventAOS -> entries of the target layout
+
+struct OutputNtuple {
+    std::unique_ptr<ROOT::Experimental::RNTupleParallelWriter> writer;
+    ROOT::RFieldToken token;
+    std::optional<ROOT::RFieldToken> eventIdToken; // spill_allDataProduct only
+    std::optional<ROOT::RFieldToken> spillIdToken;
+};
+
+template <typename T>
+void addOutput(std::vector<OutputNtuple>& outputs, TFile& file, const std::string& ntupleName,
+               const std::string& fieldName, std::uint64_t expectedBytes) {
+    auto model = ROOT::RNTupleModel::Create();
+    model->MakeField<T>(fieldName);
+    auto token = model->GetToken(fieldName);
+    auto writer = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(model), ntupleName, file, makeWriteOptions(expectedBytes));
+    outputs.push_back({std::move(writer), token});
+}
+
+// Same model as the spill_allDataProduct writers, event record plus the EventID and SpillID of the spill
+void addSpillOutput(std::vector<OutputNtuple>& outputs, TFile& file, bool soa, std::uint64_t expectedBytes) {
+    auto [model, token, eventIdToken, spillIdToken] = soa ? CreateSOASpillModelAndTokens() : CreateAOSSpillModelAndTokens();
+    auto writer = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(model), soa ? "soa_spill_all" : "aos_spills", file, makeWriteOptions(expectedBytes));
+    outputs.push_back({std::move(writer), token, eventIdToken, spillIdToken});
+}
+
+// Same ntuple names, field names and types as the writer benchmarks
+std::vector<OutputNtuple> createOutputs(TFile& file, const StorageLayout& layout, std::uint64_t bytes) {
+    std::vector<OutputNtuple> out;
+    const bool spill = layout.group == LayoutGroup::Spill;
+    switch (layout.group) {
+    case LayoutGroup::Event:
+    case LayoutGroup::Spill: {
+        const std::string prefix = std::string(layout.soa ? "soa_" : "aos_") + (spill ? "spill_" : "");
+        if (layout.product == LayoutProduct::All) {
+            if (spill) addSpillOutput(out, file, layout.soa, bytes);
+            else if (layout.soa) addOutput<EventSOA>(out, file, "soa_events", "EventSOA", bytes);
+            else addOutput<EventAOS>(out, file, "aos_events", "EventAOS", bytes);
+        } else if (layout.soa) {
+            addOutput<SOAHitVector>(out, file, prefix + "hits", "hits", bytes);
+            if (layout.product == LayoutProduct::PerData) {
+                addOutput<SOAWireVector>(out, file, prefix + "wires", "wires", bytes);
+            } else {
+                addOutput<std::vector<SOAWireBase>>(out, file, prefix + "wires", "wires", bytes);
+                addOutput<std::vector<SOAROI>>(out, file, prefix + "rois", "rois", bytes);
+            }
+        } else {
+            addOutput<std::vector<HitIndividual>>(out, file, prefix + "hits", "hits", bytes);
+            if (layout.product == LayoutProduct::PerData) {
+                addOutput<std::vector<WireIndividual>>(out, file, prefix + "wires", "wires", bytes);
+            } else {
+                addOutput<std::vector<WireBase>>(out, file, prefix + "wires", "wires", bytes);
+                addOutput<std::vector<FlatROI>>(out, file, prefix + "rois", "rois", bytes);
+            }
+        }
+        break;
+    }
+    case LayoutGroup::TopObject:
+        if (layout.product == LayoutProduct::All) {
+            if (layout.soa) addOutput<SOATopBatchRow>(out, file, "soa_top_all", "row", bytes);
+            else addOutput<AOSTopBatchRow>(out, file, "aos_top_all", "row", bytes);
+        } else if (layout.soa) {
+            addOutput<SOAHit>(out, file, "soa_top_hits", "hit", bytes);
+            if (layout.product == LayoutProduct::PerData) {
+                addOutput<SOAWire>(out, file, "soa_top_wires", "wire", bytes);
+            } else {
+                addOutput<SOAWireBase>(out, file, "soa_top_wires", "wire", bytes);
+                addOutput<std::vector<SOAROI>>(out, file, "soa_top_rois", "rois", bytes);
+            }
+        } else {
+            addOutput<HitIndividual>(out, file, "aos_top_hits", "hit", bytes);
+            if (layout.product == LayoutProduct::PerData) {
+                addOutput<WireIndividual>(out, file, "aos_top_wires", "wire", bytes);
+            } else {
+                addOutput<WireBase>(out, file, "aos_top_wires", "wire", bytes);
+                addOutput<std::vector<FlatROI>>(out, file, "aos_top_rois", "rois", bytes);
+            }
+        }
+        break;
+    case LayoutGroup::Element:
+        if (layout.product == LayoutProduct::All) {
+            if (layout.soa) addOutput<SOAUnionRow>(out, file, "soa_element_all", "row", bytes);
+            else addOutput<AOSUnionRow>(out, file, "aos_element_all", "row", bytes);
+        } else if (layout.soa) {
+            addOutput<SOAHit>(out, file, "soa_element_hits", "hit", bytes);
+            if (layout.product == LayoutProduct::PerGroup) addOutput<SOAWireBase>(out, file, "soa_element_wires", "wire", bytes);
+            addOutput<FlatSOAROI>(out, file, "soa_element_rois", "roi", bytes);
+        } else {
+            addOutput<HitIndividual>(out, file, "element_hits", "hit", bytes);
+            if (layout.product == LayoutProduct::PerData) {
+                addOutput<WireROI>(out, file, "element_wire_rois", "wire_roi", bytes);
+            } else {
+                addOutput<WireBase>(out, file, "element_wires", "wire", bytes);
+                addOutput<FlatROI>(out, file, "element_rois", "roi", bytes);
+            }
+        }
+        break;
+    }
+    return out;
+}
+
+// Per-thread fill context of one output ntuple
+class Filler {
+public:
+    Filler(OutputNtuple& output, std::mutex& mutex)
+        : fContext(output.writer->CreateFillContext()),
+          fEntry(fContext->GetModel().CreateRawPtrWriteEntry()),
+          fToken(output.token),
+          fEventIdToken(output.eventIdToken),
+          fSpillIdToken(output.spillIdToken),
+          fMutex(mutex) {}
+
+    // EventID and SpillID written with the following entries, if the ntuple has those fields
+    void setEventId(long long eventId) { fEventId = eventId; }
+    void setSpillId(int spillId) { fSpillId = spillId; }
+
+    template <typename T>
+    void fill(T& value) {
+        if (fillNoFlush(value)) flush();
+    }
+
+    // Fills without flushing; true if the context wants its cluster flushed
+    template <typename T>
+    bool fillNoFlush(T& value) {
+        fEntry->BindRawPtr(fToken, &value);
+        if (fEventIdToken) fEntry->BindRawPtr(*fEventIdToken, &fEventId);
+        if (fSpillIdToken) fEntry->BindRawPtr(*fSpillIdToken, &fSpillId);
+        ROOT::RNTupleFillStatus status;
+        fContext->FillNoFlush(*fEntry, status);
+        return status.ShouldFlushCluster();
+    }
+
+    void flush() {
+        fContext->FlushColumns();
+        std::lock_guard<std::mutex> lock(fMutex);
+        fContext->FlushCluster();
+    }
+
+    // Commits the clusters of both fillers under one lock, so the two ntuples get the same
+    // entry order even when other threads flush in between
+    static void flushTogether(Filler& a, Filler& b) {
+        a.fContext->FlushColumns();
+        b.fContext->FlushColumns();
+        std::lock_guard<std::mutex> lock(a.fMutex);
+        a.fContext->FlushCluster();
+        b.fContext->FlushCluster();
+    }
+
+private:
+    std::shared_ptr<ROOT::Experimental::RNTupleFillContext> fContext;
+    std::unique_ptr<ROOT::Experimental::Detail::RRawPtrWriteEntry> fEntry;
+    ROOT::RFieldToken fToken;
+    std::optional<ROOT::RFieldToken> fEventIdToken;
+    std::optional<ROOT::RFieldToken> fSpillIdToken;
+    long long fEventId = 0;
+    int fSpillId = 0;
+    std::mutex& fMutex;
+};
+
+// Encodes events into the fill contexts of one thread; the member buffers are reused
+class LayoutEncoder {
+public:
+    LayoutEncoder(std::vector<OutputNtuple>& outputs, std::mutex& mutex, const StorageLayout& layout, int numSpills)
+        : fLayout(layout), fNumSpills(std::max(1, numSpills)) {
+        for (auto& output : outputs) fFillers.emplace_back(output, mutex);
+    }
+
+    void write(EventAOS& event, long long eventId) {
+        switch (fLayout.group) {
+        case LayoutGroup::Event:
+            writeEventEntry(event);
+            break;
+        case LayoutGroup::Spill:
+            fFillers[0].setEventId(eventId);
+            for (int s = 0; s < fNumSpills; ++s) {
+                fFillers[0].setSpillId(s);
+                spillSlice(event.hits, s, fNumSpills, fSpill.hits);
+                spillSlice(event.wires, s, fNumSpills, fSpill.wires);
+                writeEventEntry(fSpill);
+            }
+            break;
+        case LayoutGroup::TopObject:
+            if (fLayout.soa) writeSOATopObjects(event, eventId);
+            else writeAOSTopObjects(event, eventId);
+            break;
+        case LayoutGroup::Element:
+            if (fLayout.soa) writeSOAElements(event, eventId);
+            else writeAOSElements(event, eventId);
+            break;
+        }
+    }
+
+    void flush() {
+        for (auto& filler : fFillers) filler.flush();
+    }
+
+private:
+    // SOA perGroup wires and their SOAROI vectors: the ROI ntuple has no EventID and is matched
+    // to the wires by entry number, so both stay in lockstep
+    template <typename Wires>
+    void fillParallelRois(Wires& wires, std::vector<SOAROI>& rois) {
+        const bool flushWires = fFillers[1].fillNoFlush(wires);
+        const bool flushRois = fFillers[2].fillNoFlush(rois);
+        if (flushWires || flushRois) Filler::flushTogether(fFillers[1], fFillers[2]);
+    }
+
+    // One entry per event (or spill)
+    void writeEventEntry(EventAOS& event) {
+        if (!fLayout.soa) {
+            if (fLayout.product == LayoutProduct::All) {
+                fFillers[0].fill(event);
+                return;
+            }
+            fFillers[0].fill(event.hits);
+            if (fLayout.product == LayoutProduct::PerData) {
+                fFillers[1].fill(event.wires);
+                return;
+            }
+            fBaseWires.clear();
+            for (const auto& wire : event.wires) fBaseWires.push_back(extractWireBase(wire));
+            fRois = flattenROIs(event.wires);
+            fFillers[1].fill(fBaseWires);
+            fFillers[2].fill(fRois);
+            return;
+        }
+        toSOAHits(event.hits, fSoaEvent.hits);
+        toSOAWires(event.wires, fSoaEvent.wires);
+        if (fLayout.product == LayoutProduct::All) {
+            fFillers[0].fill(fSoaEvent);
+            return;
+        }
+        fFillers[0].fill(fSoaEvent.hits);
+        if (fLayout.product == LayoutProduct::PerData) {
+            fFillers[1].fill(fSoaEvent.wires);
+            return;
+        }
+        fSoaBaseWires = extractSOABaseWires(fSoaEvent.wires);
+        fSoaRois = flattenSOAROIs(fSoaEvent.wires);
+        fillParallelRois(fSoaBaseWires, fSoaRois);
+    }
+
+    // One entry per hit and per wire; allDataProduct pairs hit k with wire k
+    void writeAOSTopObjects(EventAOS& event, long long eventId) {
+        if (fLayout.product == LayoutProduct::All) {
+            const std::size_t k = std::max(event.hits.size(), event.wires.size());
+            for (std::size_t i = 0; i < k; ++i) {
+                fTopRow.EventID = static_cast<unsigned int>(eventId);
+                fTopRow.hasHit = i < event.hits.size();
+                if (fTopRow.hasHit) fTopRow.hit = event.hits[i];
+                fTopRow.hasWire = i < event.wires.size();
+                fTopRow.rois.clear();
+                if (fTopRow.hasWire) {
+                    fTopRow.wire = extractWireBase(event.wires[i]);
+                    fTopRow.rois = flattenROIs({event.wires[i]});
+                }
+                fFillers[0].fill(fTopRow);
+            }
+            return;
+        }
+        for (auto& hit : event.hits) fFillers[0].fill(hit);
+        for (auto& wire : event.wires) {
+            if (fLayout.product == LayoutProduct::PerData) {
+                fFillers[1].fill(wire);
+                continue;
+            }
+            fWireBase = extractWireBase(wire);
+            fRois = flattenROIs({wire});
+            fFillers[1].fill(fWireBase);
+            fFillers[2].fill(fRois);
+        }
+    }
+
+    void writeSOATopObjects(EventAOS& event, long long eventId) {
+        if (fLayout.product == LayoutProduct::All) {
+            const std::size_t k = std::max(event.hits.size(), event.wires.size());
+            for (std::size_t i = 0; i < k; ++i) {
+                fSoaTopRow.EventID = static_cast<unsigned int>(eventId);
+                fSoaTopRow.hasHit = i < event.hits.size();
+                if (fSoaTopRow.hasHit) copyHit(event.hits[i], fSoaTopRow.hit);
+                fSoaTopRow.hasWire = i < event.wires.size();
+                fSoaTopRow.rois.clear();
+                if (fSoaTopRow.hasWire) {
+                    fSoaTopRow.wire = toSOAWireBase(event.wires[i]);
+                    toSOARois(event.wires[i].getSignalROI(), fSoaTopRow.rois);
+                }
+                fFillers[0].fill(fSoaTopRow);
+            }
+            return;
+        }
+        for (const auto& hit : event.hits) {
+            copyHit(hit, fSoaHit);
+            fFillers[0].fill(fSoaHit);
+        }
+        for (const auto& wire : event.wires) {
+            if (fLayout.product == LayoutProduct::PerData) {
+                fSoaWire.EventID = wire.EventID;
+                fSoaWire.fWire_Channel = wire.fWire_Channel;
+                fSoaWire.fWire_View = wire.fWire_View;
+                toSOARois(wire.getSignalROI(), fSoaWire.fSignalROI);
+                fFillers[1].fill(fSoaWire);
+                continue;
+            }
+            fSoaWireBase = toSOAWireBase(wire);
+            toSOARois(wire.getSignalROI(), fSoaRois);
+            fillParallelRois(fSoaWireBase, fSoaRois);
+        }
+    }
+
+    // One entry per hit, wire and ROI
+    void writeAOSElements(EventAOS& event, long long eventId) {
+        if (fLayout.product == LayoutProduct::All) {
+            for (const auto& hit : event.hits) {
+                fUnionRow = AOSUnionRow{};
+                fUnionRow.EventID = static_cast<unsigned int>(eventId);
+                fUnionRow.recordType = 0;
+                fUnionRow.hit = hit;
+                fFillers[0].fill(fUnionRow);
+            }
+            for (const auto& wire : event.wires) {
+                fUnionRow = AOSUnionRow{};
+                fUnionRow.EventID = static_cast<unsigned int>(eventId);
+                fUnionRow.recordType = 1;
+                fUnionRow.WireID = wire.fWire_Channel;
+                fUnionRow.wire = extractWireBase(wire);
+                fFillers[0].fill(fUnionRow);
+                for (const auto& roi : wire.getSignalROI()) {
+                    fUnionRow = AOSUnionRow{};
+                    fUnionRow.EventID = static_cast<unsigned int>(eventId);
+                    fUnionRow.recordType = 2;
+                    fUnionRow.WireID = wire.fWire_Channel;
+                    fUnionRow.roi.EventID = static_cast<unsigned int>(eventId);
+                    fUnionRow.roi.WireID = wire.fWire_Channel;
+                    fUnionRow.roi.offset = roi.offset;
+                    fUnionRow.roi.data = roi.data;
+                    fFillers[0].fill(fUnionRow);
+                }
+            }
+            return;
+        }
+        for (auto& hit : event.hits) fFillers[0].fill(hit);
+        if (fLayout.product == LayoutProduct::PerData) {
+            for (auto& wireRoi : flattenWiresToROIs(event.wires)) fFillers[1].fill(wireRoi);
+            return;
+        }
+        for (const auto& wire : event.wires) {
+            fWireBase = extractWireBase(wire);
+            fFillers[1].fill(fWireBase);
+        }
+        for (auto& roi : flattenROIs(event.wires)) fFillers[2].fill(roi);
+    }
+
+    void writeSOAElements(EventAOS& event, long long eventId) {
+        if (fLayout.product == LayoutProduct::All) {
+            for (const auto& hit : event.hits) {
+                fSoaUnionRow = SOAUnionRow{};
+                fSoaUnionRow.EventID = static_cast<unsigned int>(eventId);
+                fSoaUnionRow.recordType = 0;
+                copyHit(hit, fSoaUnionRow.hit);
+                fFillers[0].fill(fSoaUnionRow);
+            }
+            for (const auto& wire : event.wires) {
+                fSoaUnionRow = SOAUnionRow{};
+                fSoaUnionRow.EventID = static_cast<unsigned int>(eventId);
+                fSoaUnionRow.recordType = 1;
+                fSoaUnionRow.WireID = wire.fWire_Channel;
+                fSoaUnionRow.wire = toSOAWireBase(wire);
+                fFillers[0].fill(fSoaUnionRow);
+                for (const auto& roi : wire.getSignalROI()) {
+                    fSoaUnionRow = SOAUnionRow{};
+                    fSoaUnionRow.EventID = static_cast<unsigned int>(eventId);
+                    fSoaUnionRow.recordType = 2;
+                    fSoaUnionRow.WireID = wire.fWire_Channel;
+                    fSoaUnionRow.roi.EventID = static_cast<unsigned int>(eventId);
+                    fSoaUnionRow.roi.WireID = wire.fWire_Channel;
+                    fSoaUnionRow.roi.offset = roi.offset;
+                    fSoaUnionRow.roi.data = roi.data;
+                    fFillers[0].fill(fSoaUnionRow);
+                }
+            }
+            return;
+        }
+        for (const auto& hit : event.hits) {
+            copyHit(hit, fSoaHit);
+            fFillers[0].fill(fSoaHit);
+        }
+        auto& roiFiller = fFillers[fLayout.product == LayoutProduct::PerGroup ? 2 : 1];
+        for (const auto& wire : event.wires) {
+            if (fLayout.product == LayoutProduct::PerGroup) {
+                fSoaWireBase = toSOAWireBase(wire);
+                fFillers[1].fill(fSoaWireBase);
+            }
+            for (const auto& roi : wire.getSignalROI()) {
+                fFlatSoaRoi.EventID = static_cast<unsigned int>(eventId);
+                fFlatSoaRoi.WireID = wire.fWire_Channel;
+                fFlatSoaRoi.offset = roi.offset;
+                fFlatSoaRoi.data = roi.data;
+                roiFiller.fill(fFlatSoaRoi);
+            }
+        }
+    }
+
+    StorageLayout fLayout;
+    int fNumSpills;
+    std::vector<Filler> fFillers; // in createOutputs order
+    EventAOS fSpill;
+    EventSOA fSoaEvent;
+    std::vector<WireBase> fBaseWires;
+    std::vector<FlatROI> fRois;
+    std::vector<SOAWireBase> fSoaBaseWires;
+    std::vector<SOAROI> fSoaRois;
+    WireBase fWireBase;
+    SOAHit fSoaHit;
+    SOAWire fSoaWire;
+    SOAWireBase fSoaWireBase;
+    FlatSOAROI fFlatSoaRoi;
+    AOSTopBatchRow fTopRow;
+    SOATopBatchRow fSoaTopRow;
+    AOSUnionRow fUnionRow;
+    SOAUnionRow fSoaUnionRow;
+};
+
+// Join visitor of one chunk: decodes each event's entry ranges and hands the event on
+class ConvertVisitor : public JoinVisitor {
+public:
+    ConvertVisitor(LayoutEncoder& encoder, ConversionResult& totals, std::mutex& totalsMutex, const std::string& inFile)
+        : fEncoder(encoder), fTotals(totals), fTotalsMutex(totalsMutex), fInFile(inFile) {}
+
+    ~ConvertVisitor() override {
+        std::lock_guard<std::mutex> lock(fTotalsMutex);
+        fTotals.hits += fCounts.hits;
+        fTotals.wires += fCounts.wires;
+        fTotals.rois += fCounts.rois;
+    }
+
+    void beginEvent(long long key) override { fBuilder.begin(key); }
+
+    void visitRange(std::size_t side, ROOT::RNTupleReader& reader, std::uint64_t first, std::uint64_t last) override {
+        if (side >= fDecoders.size()) fDecoders.resize(side + 1);
+        if (!fDecoders[side]) fDecoders[side] = makeDecoder(reader, fInFile);
+        fDecoders[side]->decode(first, last, fBuilder);
+    }
+
+    void endEvent() override {
+        fBuilder.finish();
+        auto& event = fBuilder.event;
+        fCounts.hits += event.hits.size();
+        fCounts.wires += event.wires.size();
+        for (const auto& wire : event.wires) fCounts.rois += wire.getSignalROI().size();
+        fEncoder.write(event, fBuilder.eventId());
+    }
+
+private:
+    LayoutEncoder& fEncoder;
+    ConversionResult& fTotals;
+    std::mutex& fTotalsMutex;
+    std::string fInFile;
+    ConversionResult fCounts;
+    EventBuilder fBuilder;
+    std::vector<std::unique_ptr<SideDecoder>> fDecoders; // by join side
+};
+
+} // namespace
+
+StorageLayout parseStorageLayout(const std::string& name) {
+    for (const auto& layout : allStorageLayouts()) {
+        if (storageLayoutName(layout) == name) return layout;
+    }
+    throw std::invalid_argument("unknown layout '" + name + "' (expected e.g. aos_event_all or soa_element_perGroup)");
+}
+
+std::string storageLayoutName(const StorageLayout& layout) {
+    return std::string(layout.soa ? "soa_" : "aos_") + kGroupNames[static_cast<int>(layout.group)] + "_" +
+           kProductNames[static_cast<int>(layout.product)];
+}
+
+std::vector<StorageLayout> allStorageLayouts() {
+    std::vector<StorageLayout> layouts;
+    for (bool soa : {false, true}) {
+        for (auto group : {LayoutGroup::Event, LayoutGroup::Spill, LayoutGroup::TopObject, LayoutGroup::Element}) {
+            for (auto product : {LayoutProduct::All, LayoutProduct::PerData, LayoutProduct::PerGroup}) {
+                layouts.push_back({soa, group, product});
+            }
+        }
+    }
+    return layouts;
+}
+
+void forEachSelectedLayout(int mask, bool runAOS, bool runSOA, const std::function<void(const StorageLayout&)>& fn) {
+    const auto layouts = allStorageLayouts();
+    const std::size_t perHalf = layouts.size() / 2;
+    for (std::size_t i = 0; i < layouts.size(); ++i) {
+        const int idx = static_cast<int>(i % perHalf);
+        if (mask >= 0 && (mask & (1 << idx)) == 0) continue;
+        if (layouts[i].soa ? !runSOA : !runAOS) continue;
+        fn(layouts[i]);
+    }
+}
+
+ConversionResult convertLayout(const std::string& inFile, const std::string& outFile, const StorageLayout& target,
+                               const ConversionConfig& config) {
+    ConversionResult result;
+    std::uint64_t inputEntries = 0;
+    for (const auto& name : listDataNtuples(inFile)) {
+        auto reader = ROOT::RNTupleReader::Open(name, inFile);
+        inputEntries += reader->GetNEntries();
+        result.inputBytes += Utils::total_weight(*reader, Utils::ClusterWeight::UncompressedBytes);
+    }
+
+    TStopwatch sw; sw.Start();
+    auto file = std::make_unique<TFile>(outFile.c_str(), "RECREATE");
+    if (file->IsZombie()) throw std::runtime_error("cannot create " + outFile);
+    std::mutex flushMutex, totalsMutex;
+    // Contexts must go before their writers, and the writers before the file
+    auto outputs = createOutputs(*file, target, result.inputBytes);
+    std::vector<std::unique_ptr<LayoutEncoder>> encoders; // one per chunk, flushed after the join
+    auto join = joinEventsByKey(inFile, config.nThreads, JoinMode::Window, [&](std::size_t) -> std::unique_ptr<JoinVisitor> {
+        std::lock_guard<std::mutex> lock(totalsMutex);
+        encoders.push_back(std::make_unique<LayoutEncoder>(outputs, flushMutex, target, config.numSpills));
+        return std::make_unique<ConvertVisitor>(*encoders.back(), result, totalsMutex, inFile);
+    });
+    for (auto& encoder : encoders) encoder->flush();
+    result.events = join.events;
+    result.skippedEntries = inputEntries - join.entries;
+    result.keyScan = join.keyScan + join.build;
+    encoders.clear();
+    outputs.clear();
+    file->Close();
+    sw.Stop();
+    result.convert = sw.RealTime() - result.keyScan;
+    return result;
+}
+
+void benchmarkConversion(const std::string& inFile, const std::vector<StorageLayout>& targets,
+                         const std::string& outputDir, const ConversionConfig& config) {
+    std::filesystem::create_directories(outputDir);
+    const int col1 = 24, col2 = 12;
+    std::cout << "\nLayout Conversion from " << std::filesystem::path(inFile).stem().string() << " ("
+              << config.nThreads << " threads, times in s)" << std::endl;
+    std::cout << std::left
+              << std::setw(col1) << "Target"
+              << std::setw(col2) << "Events"
+              << std::setw(col2) << "Hits"
+              << std::setw(col2) << "Wires"
+              << std::setw(col2) << "ROIs"
+              << std::setw(col2) << "Skipped"
+              << std::setw(col2) << "Key scan"
+              << std::setw(col2) << "Convert"
+              << std::setw(col2) << "MB/s"
+              << std::setw(col2) << "Out MB" << std::endl;
+    std::cout << std::string(col1 + 9 * col2, '-') << std::endl;
+
+    for (const auto& target : targets) {
+        const std::string name = storageLayoutName(target);
+        const std::string outFile = outputDir + "/" + name + ".root";
+        std::cout << std::left << std::setw(col1) << name;
+        try {
+            Affinity::resetSlots();
+            auto r = convertLayout(inFile, outFile, target, config);
+            const double mb = r.inputBytes / (1024.0 * 1024.0);
+            std::cout << std::setw(col2) << r.events
+                      << std::setw(col2) << r.hits
+                      << std::setw(col2) << r.wires
+                      << std::setw(col2) << r.rois
+                      << std::setw(col2) << r.skippedEntries
+                      << std::setw(col2) << r.keyScan
+                      << std::setw(col2) << r.convert
+                      << std::setw(col2) << (r.total() > 0.0 ? mb / r.total() : 0.0)
+                      << std::setw(col2) << std::filesystem::file_size(outFile) / (1024.0 * 1024.0) << std::endl;
+        } catch (const std::exception& e) {
+            std::cout << "FAILED: " << e.what() << std::endl;
+        }
+    }
+    std::cout << std::string(col1 + 9 * col2, '-') << std::endl;
+}
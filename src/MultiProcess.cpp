@@ -0,0 +1,307 @@
+#include "MultiProcess.hpp"
+#include "HitWireWriters.hpp"
+#include "LayoutConverter.hpp"
+#include "ShardedWrite.hpp"
+#include <TStopwatch.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Fixed-size record a rank sends back once its writer is done
+struct RankReport {
+    double seconds = 0.0;
+    int ok = 0;
+    char error[256] = {};
+};
+
+constexpr char kReady = 'R';
+constexpr char kGo = 'G';
+
+#ifdef __linux__
+bool readAll(int fd, void* buffer, std::size_t size) {
+    auto* p = static_cast<char*>(buffer);
+    while (size > 0) {
+        ssize_t n = ::read(fd, p, size);
+        if (n <= 0) return false;
+        p += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+bool writeAll(int fd, const void* buffer, std::size_t size) {
+    const auto* p = static_cast<const char*>(buffer);
+    while (size > 0) {
+        ssize_t n = ::write(fd, p, size);
+        if (n <= 0) return false;
+        p += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+struct Rank {
+    pid_t pid = -1;
+    int goFd = -1;     // parent -> rank
+    int resultFd = -1; // rank -> parent
+};
+
+// Forks and re-executes this binary as one rank; the rank keeps stderr but not stdout
+Rank spawnRank(const std::vector<std::string>& args, RankTask task) {
+    // Close-on-exec, so later ranks do not inherit the pipes of earlier ones
+    int go[2], result[2];
+    if (::pipe2(go, O_CLOEXEC) != 0) throw std::runtime_error("pipe failed");
+    if (::pipe2(result, O_CLOEXEC) != 0) {
+        ::close(go[0]); ::close(go[1]);
+        throw std::runtime_error("pipe failed");
+    }
+    // The task names the rank's ends of the pipes, which survive exec
+    task.goFd = go[0];
+    task.resultFd = result[1];
+    std::vector<std::string> argStrings = {"hitwire"};
+    argStrings.insert(argStrings.end(), args.begin(), args.end());
+    argStrings.push_back("--rank-task");
+    argStrings.push_back(formatRankTask(task));
+    std::vector<char*> argv;
+    for (auto& a : argStrings) argv.push_back(a.data());
+    argv.push_back(nullptr);
+
+    pid_t pid = ::fork();
+    if (pid < 0) {
+        ::close(go[0]); ::close(go[1]);
+        ::close(result[0]); ::close(result[1]);
+        throw std::runtime_error("fork failed");
+    }
+    if (pid == 0) {
+        ::fcntl(go[0], F_SETFD, 0);
+        ::fcntl(result[1], F_SETFD, 0);
+        int devNull = ::open("/dev/null", O_WRONLY);
+        if (devNull >= 0) ::dup2(devNull, STDOUT_FILENO);
+        ::execv("/proc/self/exe", argv.data());
+        ::_exit(127);
+    }
+    ::close(go[0]);
+    ::close(result[1]);
+    return {pid, go[1], result[0]};
+}
+#endif
+
+} // namespace
+
+std::vector<RankTask> planRankTasks(const std::string& layout, const MultiProcessConfig& config, int numEvents,
+                                    const std::string& outputDir) {
+    std::vector<RankTask> tasks;
+    const int chunk = numEvents / config.ranks;
+    for (int r = 0; r < config.ranks; ++r) {
+        const int first = r * chunk;
+        const int last = (r == config.ranks - 1) ? numEvents : first + chunk;
+        if (first >= last) continue;
+        RankTask task;
+        task.layout = layout;
+        task.file = outputDir + "/" + layout + "_rank" + std::to_string(r) + ".root";
+        task.firstEvent = first;
+        task.events = last - first;
+        task.threads = config.threadsPerRank;
+        task.firstSlot = r * config.threadsPerRank;
+        tasks.push_back(task);
+    }
+    return tasks;
+}
+
+std::string formatRankTask(const RankTask& task) {
+    std::ostringstream text;
+    text << task.layout << "," << task.file << "," << task.firstEvent << "," << task.events << ","
+         << task.threads << "," << task.firstSlot << "," << task.goFd << "," << task.resultFd;
+    return text.str();
+}
+
+RankTask parseRankTask(const std::string& text) {
+    std::vector<std::string> parts;
+    std::stringstream ss(text);
+    std::string part;
+    while (std::getline(ss, part, ',')) parts.push_back(part);
+    if (parts.size() != 8 || parts[0].empty() || parts[1].empty()) {
+        throw std::invalid_argument("invalid --rank-task '" + text + "'");
+    }
+    auto number = [&text](const std::string& field) {
+        std::size_t used = 0;
+        int value = 0;
+        try { value = std::stoi(field, &used); } catch (const std::exception&) { used = 0; }
+        if (used == 0 || used != field.size()) throw std::invalid_argument("invalid --rank-task '" + text + "'");
+        return value;
+    };
+    RankTask task;
+    task.layout = parts[0];
+    task.file = parts[1];
+    task.firstEvent = number(parts[2]);
+    task.events = number(parts[3]);
+    task.threads = number(parts[4]);
+    task.firstSlot = number(parts[5]);
+    task.goFd = number(parts[6]);
+    task.resultFd = number(parts[7]);
+    if (task.firstEvent < 0 || task.events < 0 || task.threads < 1 || task.firstSlot < 0) {
+        throw std::invalid_argument("invalid --rank-task '" + text + "'");
+    }
+    return task;
+}
+
+double writeRankSlice(const RankTask& task, int numSpills, int hitsPerEvent, int wiresPerEvent, int roisPerWire) {
+    // The shard starts at an event; each writer converts it to its own work items
+    setThreadWriterShard({task.firstEvent, task.firstSlot});
+    TStopwatch sw; sw.Start();
+    writeLayout(task.layout, task.events, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire, task.file, task.threads);
+    sw.Stop();
+    setThreadWriterShard({});
+    return sw.RealTime();
+}
+
+MultiProcessResult runMultiProcessWrite(const std::string& layout, const MultiProcessConfig& config, int numEvents,
+                                        int numSpills, const std::string& outputDir) {
+#ifdef __linux__
+    MultiProcessResult result;
+    result.layout = layout;
+    std::vector<Rank> ranks;
+    std::vector<std::string> files;
+    for (auto& task : planRankTasks(layout, config, numEvents, outputDir)) {
+        files.push_back(task.file);
+        ranks.push_back(spawnRank(config.rankArgs, task));
+    }
+    result.ranks = static_cast<int>(ranks.size());
+
+    std::string error;
+    for (auto& rank : ranks) {
+        char c = 0;
+        if (!readAll(rank.resultFd, &c, 1) || c != kReady) error = "rank did not start";
+    }
+    TStopwatch sw; sw.Start();
+    for (auto& rank : ranks) {
+        if (error.empty()) writeAll(rank.goFd, &kGo, 1);
+        ::close(rank.goFd); // a rank waiting for the signal sees EOF and gives up
+    }
+    for (auto& rank : ranks) {
+        RankReport report;
+        if (error.empty()) {
+            if (!readAll(rank.resultFd, &report, sizeof(report))) {
+                error = "rank exited without a report";
+            } else if (!report.ok) {
+                error = report.error;
+            }
+        }
+        result.slowestRank = std::max(result.slowestRank, report.seconds);
+    }
+    sw.Stop();
+    result.wall = sw.RealTime();
+    for (auto& rank : ranks) {
+        ::close(rank.resultFd);
+        int status = 0;
+        ::waitpid(rank.pid, &status, 0);
+        if (error.empty() && (!WIFEXITED(status) || WEXITSTATUS(status) != 0)) error = "rank exited with an error";
+    }
+    if (!error.empty()) throw std::runtime_error(error);
+
+    for (const auto& file : files) result.bytes += std::filesystem::file_size(file);
+    if (config.merge) {
+        result.merge = mergeFiles(files, outputDir + "/" + layout + "_merged.root");
+        for (const auto& file : files) std::filesystem::remove(file);
+    }
+    return result;
+#else
+    (void)layout; (void)config; (void)numEvents; (void)numSpills; (void)outputDir;
+    throw std::runtime_error("multi-process writing needs Linux");
+#endif
+}
+
+int runWriterRank(const std::string& task, int numSpills, int hitsPerEvent, int wiresPerEvent, int roisPerWire) {
+#ifdef __linux__
+    RankTask rank;
+    try {
+        rank = parseRankTask(task);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << std::endl;
+        return 2;
+    }
+
+    char c = 0;
+    if (!writeAll(rank.resultFd, &kReady, 1) || !readAll(rank.goFd, &c, 1) || c != kGo) return 1;
+
+    RankReport report;
+    try {
+        report.seconds = writeRankSlice(rank, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire);
+        report.ok = 1;
+    } catch (const std::exception& e) {
+        std::strncpy(report.error, e.what(), sizeof(report.error) - 1);
+    }
+    if (!writeAll(rank.resultFd, &report, sizeof(report))) return 1;
+    return report.ok ? 0 : 1;
+#else
+    (void)task; (void)numSpills; (void)hitsPerEvent; (void)wiresPerEvent; (void)roisPerWire;
+    std::cerr << "multi-process writing needs Linux" << std::endl;
+    return 1;
+#endif
+}
+
+void compareProcessScaling(const MultiProcessConfig& config, int nThreads, int iter, int numEvents, int hitsPerEvent,
+                           int wiresPerEvent, int roisPerWire, int numSpills, int mask, bool runAOS, bool runSOA) {
+    const std::string outputDir = "./output_processes";
+    std::filesystem::create_directories(outputDir);
+
+    const int col1 = 28, col2 = 12;
+    std::cout << "\nThreads vs Processes (wall-clock, " << nThreads << " threads vs " << config.ranks << " ranks x "
+              << config.threadsPerRank << " threads, times in s)" << std::endl;
+    std::cout << std::left
+              << std::setw(col1) << "Layout"
+              << std::setw(col2) << "Threads"
+              << std::setw(col2) << "Processes"
+              << std::setw(col2) << "Slowest"
+              << std::setw(col2) << "Merge"
+              << std::setw(col2) << "Thr ev/s"
+              << std::setw(col2) << "Proc ev/s"
+              << std::setw(col2) << "Speedup" << std::endl;
+    std::cout << std::string(col1 + 7 * col2, '-') << std::endl;
+
+    forEachSelectedLayout(mask, runAOS, runSOA, [&](const StorageLayout& layout) {
+        const std::string name = storageLayoutName(layout);
+        std::cout << std::left << std::setw(col1) << name;
+        try {
+            double threaded = 0.0;
+            MultiProcessResult avg;
+            for (int it = 0; it < iter; ++it) {
+                TStopwatch sw; sw.Start();
+                writeLayout(name, numEvents, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire,
+                            outputDir + "/" + name + ".root", nThreads);
+                sw.Stop();
+                threaded += sw.RealTime() / iter;
+                auto r = runMultiProcessWrite(name, config, numEvents, numSpills, outputDir);
+                avg.wall += r.wall / iter;
+                avg.slowestRank += r.slowestRank / iter;
+                avg.merge += r.merge / iter;
+            }
+            const double processes = avg.wall + avg.merge;
+            std::cout << std::setw(col2) << threaded
+                      << std::setw(col2) << avg.wall
+                      << std::setw(col2) << avg.slowestRank;
+            if (config.merge) std::cout << std::setw(col2) << avg.merge;
+            else std::cout << std::setw(col2) << "-";
+            std::cout << std::setw(col2) << std::fixed << std::setprecision(0) << numEvents / threaded
+                      << std::setw(col2) << numEvents / processes
+                      << std::setw(col2) << std::setprecision(2) << threaded / processes << std::endl;
+            std::cout.unsetf(std::ios::fixed);
+            std::cout << std::setprecision(6);
+        } catch (const std::exception& e) {
+            std::cout << "FAILED: " << e.what() << std::endl;
+        }
+    });
+    std::cout << std::string(col1 + 7 * col2, '-') << std::endl;
+}
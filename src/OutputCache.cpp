@@ -0,0 +1,129 @@
+#include "OutputCache.hpp"
+#include "ClusterTargeting.hpp"
+#include "EventIndex.hpp"
+#include "EventSizes.hpp"
+#include "HitWireGenerators.hpp"
+#include "HitWireWriters.hpp"
+#include "Utils.hpp"
+#include "ZoneMap.hpp"
+#include <RVersion.h>
+#include <TFile.h>
+#include <TNamed.h>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+namespace {
+
+OutputCacheConfig gOutputCache;
+
+constexpr const char* kDatasetTag = "hitwire_dataset"; // TNamed, title "<hash> <description>"
+
+std::string cachedFileName(const std::string& hash) {
+    return (std::filesystem::path(gOutputCache.cacheDir) / (hash + ".root")).string();
+}
+
+// Hard link where the file system allows it, a copy otherwise. Writers recreate their
+// output files rather than overwrite them, so a link never sees later runs.
+void linkOrCopy(const std::string& from, const std::string& to) {
+    std::error_code ec;
+    std::filesystem::remove(to, ec);
+    std::filesystem::create_hard_link(from, to, ec);
+    if (ec) std::filesystem::copy_file(from, to, std::filesystem::copy_options::overwrite_existing);
+}
+
+} // namespace
+
+void setOutputCacheConfig(const OutputCacheConfig& config) {
+    gOutputCache = config;
+}
+
+const OutputCacheConfig& getOutputCacheConfig() {
+    return gOutputCache;
+}
+
+std::string describeDataset(const std::string& layout, int numEvents, int numSpills, int hitsPerEvent,
+                            int wiresPerEvent, int roisPerWire, int nThreads) {
+    const auto& clusters = getClusterTargetConfig();
+    const auto& overrides = getWriteOptionOverrides();
+    const auto& commit = getWriterCommitConfig();
+    std::ostringstream os;
+    os << "layout=" << layout << " events=" << numEvents << " hits=" << hitsPerEvent << " wires=" << wiresPerEvent
+       << " rois=" << roisPerWire;
+    // Only the spill writers split events
+    if (layout.find("_spill_") != std::string::npos) os << " spills=" << numSpills;
+    os << " threads=" << nThreads << " generator=" << generatorModeName(getGeneratorMode()) << "/v" << kGeneratorVersion
+       << " sizes=" << describeEventSizeConfig(getEventSizeConfig()) << " seed=" << std::hex << Utils::kBaseSeed
+       << std::dec << " compression=" << overrides.compression << " cluster=" << overrides.clusterBytes
+       << " page=" << overrides.pageBytes;
+    if (clusters.clustersPerReader > 0) {
+        os << " target=" << clusters.clustersPerReader << "x" << clusters.readerThreads << "/"
+           << clusters.minClusterBytes;
+    }
+    os << " commit=" << (commit.ordered ? "ordered/" + std::to_string(commit.blockEvents) : "free")
+       << " index=" << getEmitEventIndex() << " zonemaps=" << getEmitZoneMaps() << " root=" << ROOT_RELEASE;
+    return os.str();
+}
+
+std::string datasetHash(const std::string& description) {
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : description) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    std::ostringstream os;
+    os << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return os.str();
+}
+
+std::string readDatasetHash(const std::string& fileName) {
+    if (!std::filesystem::exists(fileName)) return "";
+    std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+    if (!file || file->IsZombie()) return "";
+    std::unique_ptr<TNamed> tag(file->Get<TNamed>(kDatasetTag));
+    if (!tag) return "";
+    const std::string title = tag->GetTitle();
+    return title.substr(0, title.find(' '));
+}
+
+bool reuseCachedDataset(const std::string& fileName, const std::string& hash) {
+    if (readDatasetHash(fileName) == hash) return true;
+    if (gOutputCache.cacheDir.empty()) return false;
+    const std::string cached = cachedFileName(hash);
+    if (readDatasetHash(cached) != hash) return false;
+    try {
+        linkOrCopy(cached, fileName);
+    } catch (const std::filesystem::filesystem_error&) {
+        return false; // the writer recreates the file
+    }
+    return true;
+}
+
+void storeDataset(const std::string& fileName, const std::string& description) {
+    const std::string hash = datasetHash(description);
+    {
+        std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "UPDATE"));
+        if (!file || file->IsZombie()) throw std::runtime_error("cannot open " + fileName + " for tagging");
+        TNamed tag(kDatasetTag, (hash + " " + description).c_str());
+        file->WriteTObject(&tag, kDatasetTag, "Overwrite");
+    }
+    if (gOutputCache.cacheDir.empty()) return;
+    std::filesystem::create_directories(gOutputCache.cacheDir);
+    linkOrCopy(fileName, cachedFileName(hash));
+}
+
+void storeDatasets(const std::vector<std::pair<std::string, std::string>>& datasets) {
+    if (!gOutputCache.reuse) return;
+    for (const auto& [fileName, description] : datasets) {
+        try {
+            storeDataset(fileName, description);
+        } catch (const std::exception& e) {
+            std::cout << "Dataset tag for " << fileName << " failed: " << e.what() << std::endl;
+        }
+    }
+}
@@ -0,0 +1,158 @@
+#include "OutputSink.hpp"
+#include "ClusterTargeting.hpp"
+#include "HitWireWriters.hpp"
+#include "LayoutConverter.hpp"
+#include <TMemFile.h>
+#include <TStopwatch.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+SinkMode gSinkMode = SinkMode::File;
+
+// A TMemFile that only keeps track of offsets. TFile positions every write with a seek, so
+// reads (which a writing file never issues) return zeros and the offset is all there is.
+class NullFile : public TMemFile {
+public:
+    explicit NullFile(const char* name) : TMemFile(name, "RECREATE") {}
+    // Close while the overrides below are still in place; the base destructors would write
+    // the trailer through TMemFile, past the end of its (empty) buffer
+    ~NullFile() override { Close(); }
+
+    Long64_t GetSize() const override { return std::max(fNullSize, TMemFile::GetSize()); }
+
+protected:
+    Int_t SysRead(Int_t, void* buf, Int_t len) override {
+        std::memset(buf, 0, len);
+        fNullOffset += len;
+        return len;
+    }
+
+    Int_t SysWrite(Int_t, const void*, Int_t len) override {
+        fNullOffset += len;
+        fNullSize = std::max(fNullSize, fNullOffset);
+        return len;
+    }
+
+    Long64_t SysSeek(Int_t, Long64_t offset, Int_t whence) override {
+        if (whence == SEEK_SET) fNullOffset = offset;
+        else if (whence == SEEK_CUR) fNullOffset += offset;
+        else if (whence == SEEK_END) fNullOffset = fNullSize + offset;
+        else return -1;
+        return fNullOffset;
+    }
+
+private:
+    Long64_t fNullOffset = 0;
+    Long64_t fNullSize = 0;
+};
+
+} // namespace
+
+SinkMode parseSinkMode(const std::string& name) {
+    if (name == "file") return SinkMode::File;
+    if (name == "memory") return SinkMode::Memory;
+    if (name == "null") return SinkMode::Null;
+    throw std::invalid_argument("unknown sink '" + name + "' (expected file, memory or null)");
+}
+
+std::string sinkModeName(SinkMode mode) {
+    switch (mode) {
+        case SinkMode::File: return "file";
+        case SinkMode::Memory: return "memory";
+        case SinkMode::Null: return "null";
+    }
+    return "unknown";
+}
+
+void setSinkMode(SinkMode mode) {
+    gSinkMode = mode;
+}
+
+SinkMode getSinkMode() {
+    return gSinkMode;
+}
+
+std::unique_ptr<TFile> openOutputFile(const std::string& fileName) {
+    std::unique_ptr<TFile> file;
+    switch (gSinkMode) {
+        case SinkMode::File: file = std::make_unique<TFile>(fileName.c_str(), "RECREATE"); break;
+        case SinkMode::Memory: file = std::make_unique<TMemFile>(fileName.c_str(), "RECREATE"); break;
+        case SinkMode::Null: file = std::make_unique<NullFile>(fileName.c_str()); break;
+    }
+    if (!file || file->IsZombie()) throw std::runtime_error("cannot create " + fileName);
+    return file;
+}
+
+void compareSinkModes(int nThreads, int iter, int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire,
+                      int numSpills, int mask, bool runAOS, bool runSOA) {
+    const std::string outputDir = "./output_sinks";
+    std::filesystem::create_directories(outputDir);
+    const SinkMode savedMode = getSinkMode();
+    const WriteOptionOverrides savedOverrides = getWriteOptionOverrides();
+    WriteOptionOverrides uncompressed = savedOverrides;
+    uncompressed.compression = 0;
+
+    const int col1 = 28, col2 = 12;
+    std::cout << "\nWrite Time by Sink (wall-clock, " << nThreads << " threads, times in s)" << std::endl;
+    std::cout << std::left
+              << std::setw(col1) << "Layout"
+              << std::setw(col2) << "File"
+              << std::setw(col2) << "Memory"
+              << std::setw(col2) << "Null"
+              << std::setw(col2) << "Null raw"
+              << std::setw(col2) << "Storage %"
+              << std::setw(col2) << "Compress %"
+              << std::setw(col2) << "Null ev/s"
+              << std::setw(col2) << "File MB" << std::endl;
+    std::cout << std::string(col1 + 8 * col2, '-') << std::endl;
+
+    forEachSelectedLayout(mask, runAOS, runSOA, [&](const StorageLayout& layout) {
+        const std::string name = storageLayoutName(layout);
+        const std::string fileName = outputDir + "/" + name + ".root";
+        std::cout << std::left << std::setw(col1) << name << std::flush;
+        try {
+            auto timeWith = [&](SinkMode mode, const WriteOptionOverrides& overrides) {
+                setSinkMode(mode);
+                setWriteOptionOverrides(overrides);
+                double avg = 0.0;
+                for (int it = 0; it < iter; ++it) {
+                    TStopwatch sw; sw.Start();
+                    writeLayout(name, numEvents, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire, fileName, nThreads);
+                    sw.Stop();
+                    avg += sw.RealTime() / iter;
+                }
+                return avg;
+            };
+            const double file = timeWith(SinkMode::File, savedOverrides);
+            const double memory = timeWith(SinkMode::Memory, savedOverrides);
+            const double null = timeWith(SinkMode::Null, savedOverrides);
+            const double raw = timeWith(SinkMode::Null, uncompressed);
+            setSinkMode(savedMode);
+            setWriteOptionOverrides(savedOverrides);
+            std::cout << std::setw(col2) << file
+                      << std::setw(col2) << memory
+                      << std::setw(col2) << null
+                      << std::setw(col2) << raw
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(col2) << (file > 0.0 ? 100.0 * std::max(0.0, file - null) / file : 0.0)
+                      << std::setw(col2) << (file > 0.0 ? 100.0 * std::max(0.0, null - raw) / file : 0.0)
+                      << std::setprecision(0)
+                      << std::setw(col2) << (null > 0.0 ? numEvents / null : 0.0)
+                      << std::setprecision(2)
+                      << std::setw(col2) << std::filesystem::file_size(fileName) / (1024.0 * 1024.0) << std::endl;
+            std::cout.unsetf(std::ios::fixed);
+            std::cout << std::setprecision(6);
+        } catch (const std::exception& e) {
+            setSinkMode(savedMode);
+            setWriteOptionOverrides(savedOverrides);
+            std::cout << "FAILED: " << e.what() << std::endl;
+        }
+    });
+    std::cout << std::string(col1 + 8 * col2, '-') << std::endl;
+}
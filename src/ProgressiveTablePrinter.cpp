@@ -8,8 +8,8 @@ void ProgressiveTablePrinter<WriterResult>::printRow(const WriterResult& result)
     std::cout << std::left
               << std::setw(columnWidths[0]) << result.label;
     
-    if (result.failed) {
-        std::cout << std::setw(columnWidths[1]) << "FAILED"
+    if (result.failed || result.cached) {
+        std::cout << std::setw(columnWidths[1]) << (result.failed ? "FAILED" : "cached")
                   << std::setw(columnWidths[2]) << "-";
         // Fill remaining columns with "-" if there are iteration columns
         for (size_t i = 3; i < columnWidths.size(); ++i) {
@@ -0,0 +1,307 @@
+#include "ScalingAnalysis.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+// Least squares for y = c * x (single coefficient, no intercept), clamped to >= 0.
+double fitSingleCoefficient(const std::vector<double>& x, const std::vector<double>& y) {
+    double sxx = 0.0, sxy = 0.0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        sxx += x[i] * x[i];
+        sxy += x[i] * y[i];
+    }
+    if (sxx <= 0.0) return 0.0;
+    return std::max(0.0, sxy / sxx);
+}
+
+std::string formatOptimum(const ScalingFit& fit) {
+    if (!fit.valid) return "n/a";
+    if (fit.optimalThreadsInt <= 0) return "unbounded";
+    return std::to_string(fit.optimalThreadsInt);
+}
+
+} // namespace
+
+double uslSpeedup(double sigma, double kappa, double n) {
+    return n / (1.0 + sigma * (n - 1.0) + kappa * n * (n - 1.0));
+}
+
+ScalingFit fitScaling(const std::string& label, const std::vector<std::pair<int, double>>& points) {
+    ScalingFit fit;
+    fit.label = label;
+
+    // Keep valid points, sorted by thread count; later duplicates overwrite earlier ones
+    std::map<int, double> byThreads;
+    for (const auto& [threads, time] : points) {
+        if (threads > 0 && time > 0.0 && std::isfinite(time)) byThreads[threads] = time;
+    }
+    for (const auto& [threads, time] : byThreads) {
+        fit.threads.push_back(threads);
+        fit.times.push_back(time);
+    }
+    if (fit.threads.empty()) return fit;
+
+    // Baseline is the smallest thread count (1 when measured), assumed to scale ideally
+    fit.baselineThreads = fit.threads.front();
+    const double baseTime = fit.times.front();
+    for (size_t i = 0; i < fit.threads.size(); ++i) {
+        double s = baseTime / fit.times[i] * fit.baselineThreads;
+        fit.speedup.push_back(s);
+        fit.efficiency.push_back(s / fit.threads[i]);
+    }
+    if (fit.threads.size() < 2) return fit;
+    fit.valid = true;
+
+    // Linearized form: N / S(N) - 1 = sigma (N - 1) + kappa N (N - 1)
+    std::vector<double> x1, x2, y;
+    for (size_t i = 0; i < fit.threads.size(); ++i) {
+        double n = fit.threads[i];
+        x1.push_back(n - 1.0);
+        x2.push_back(n * (n - 1.0));
+        y.push_back(n / fit.speedup[i] - 1.0);
+    }
+
+    // Amdahl is the USL with kappa = 0
+    fit.amdahlSerial = std::min(1.0, fitSingleCoefficient(x1, y));
+
+    double a11 = 0.0, a12 = 0.0, a22 = 0.0, b1 = 0.0, b2 = 0.0;
+    for (size_t i = 0; i < y.size(); ++i) {
+        a11 += x1[i] * x1[i];
+        a12 += x1[i] * x2[i];
+        a22 += x2[i] * x2[i];
+        b1 += x1[i] * y[i];
+        b2 += x2[i] * y[i];
+    }
+    double det = a11 * a22 - a12 * a12;
+    double sigma = 0.0, kappa = 0.0;
+    // Two distinct thread counts make the system singular; fall back to Amdahl then
+    if (std::abs(det) > 1e-12 * std::max(1.0, a11 * a22)) {
+        sigma = (b1 * a22 - b2 * a12) / det;
+        kappa = (a11 * b2 - a12 * b1) / det;
+    } else {
+        sigma = fit.amdahlSerial;
+    }
+    // Enforce non-negative coefficients by refitting the remaining one
+    if (kappa < 0.0) {
+        kappa = 0.0;
+        sigma = fitSingleCoefficient(x1, y);
+    } else if (sigma < 0.0) {
+        sigma = 0.0;
+        kappa = fitSingleCoefficient(x2, y);
+    }
+    // Round-off on perfectly Amdahl-shaped data leaves a tiny kappa that would place N* at ~1e8
+    if (kappa < 1e-12) kappa = 0.0;
+    fit.uslSigma = std::min(1.0, sigma);
+    fit.uslKappa = kappa;
+
+    // Goodness of fit evaluated on S(N) itself
+    double meanS = 0.0;
+    for (double s : fit.speedup) meanS += s;
+    meanS /= fit.speedup.size();
+    double ssRes = 0.0, ssTot = 0.0;
+    for (size_t i = 0; i < fit.speedup.size(); ++i) {
+        double pred = uslSpeedup(fit.uslSigma, fit.uslKappa, fit.threads[i]);
+        ssRes += (fit.speedup[i] - pred) * (fit.speedup[i] - pred);
+        ssTot += (fit.speedup[i] - meanS) * (fit.speedup[i] - meanS);
+    }
+    fit.uslR2 = ssTot > 0.0 ? 1.0 - ssRes / ssTot : 1.0;
+
+    if (fit.uslKappa > 0.0) {
+        fit.optimalThreads = std::sqrt(std::max(0.0, 1.0 - fit.uslSigma) / fit.uslKappa);
+        int lo = std::max(1, static_cast<int>(std::floor(fit.optimalThreads)));
+        int hi = std::max(1, static_cast<int>(std::ceil(fit.optimalThreads)));
+        double sLo = uslSpeedup(fit.uslSigma, fit.uslKappa, lo);
+        double sHi = uslSpeedup(fit.uslSigma, fit.uslKappa, hi);
+        fit.optimalThreadsInt = sHi > sLo ? hi : lo;
+        fit.peakSpeedup = std::max(sLo, sHi);
+    } else {
+        // No coherency penalty: speedup grows monotonically towards the Amdahl limit
+        fit.optimalThreads = 0.0;
+        fit.optimalThreadsInt = 0;
+        fit.peakSpeedup = fit.amdahlSerial > 0.0 ? 1.0 / fit.amdahlSerial
+                                                 : std::numeric_limits<double>::infinity();
+    }
+    return fit;
+}
+
+std::vector<ScalingFit> analyzeScaling(const ScalingData& data) {
+    std::vector<ScalingFit> fits;
+    fits.reserve(data.size());
+    for (const auto& [label, points] : data) {
+        fits.push_back(fitScaling(label, points));
+    }
+    return fits;
+}
+
+void printScalingAnalysis(const std::string& title, const std::vector<ScalingFit>& fits) {
+    if (fits.empty()) return;
+
+    const int labelWidth = 32;
+    const int colWidth = 12;
+
+    // Speedup / efficiency per measured thread count
+    std::cout << "\n" << title << " - Speedup / Efficiency" << std::endl;
+    for (const auto& fit : fits) {
+        std::cout << std::left << std::setw(labelWidth) << fit.label
+                  << "(baseline " << fit.baselineThreads << " thread"
+                  << (fit.baselineThreads == 1 ? "" : "s") << ")" << std::endl;
+        std::cout << std::left << std::setw(labelWidth) << "  Threads"
+                  << std::setw(colWidth) << "Time (s)"
+                  << std::setw(colWidth) << "Speedup"
+                  << std::setw(colWidth) << "Efficiency"
+                  << std::setw(colWidth) << "USL pred." << std::endl;
+        for (size_t i = 0; i < fit.threads.size(); ++i) {
+            std::cout << std::left << std::setw(labelWidth) << ("  " + std::to_string(fit.threads[i]))
+                      << std::setw(colWidth) << fit.times[i]
+                      << std::setw(colWidth) << fit.speedup[i]
+                      << std::setw(colWidth) << fit.efficiency[i];
+            if (fit.valid) {
+                std::cout << std::setw(colWidth) << uslSpeedup(fit.uslSigma, fit.uslKappa, fit.threads[i]);
+            } else {
+                std::cout << std::setw(colWidth) << "n/a";
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    // One line per label with the fitted model parameters
+    std::cout << "\n" << title << " - Amdahl / USL Fit" << std::endl;
+    std::cout << std::left
+              << std::setw(labelWidth) << "Writer"
+              << std::setw(colWidth) << "Amdahl s"
+              << std::setw(colWidth) << "USL sigma"
+              << std::setw(colWidth) << "USL kappa"
+              << std::setw(colWidth) << "USL R^2"
+              << std::setw(colWidth) << "N* (USL)"
+              << std::setw(colWidth) << "Peak S" << std::endl;
+    std::cout << std::string(labelWidth + 6 * colWidth, '-') << std::endl;
+    for (const auto& fit : fits) {
+        std::cout << std::left << std::setw(labelWidth) << fit.label;
+        if (!fit.valid) {
+            std::cout << "insufficient data (need >= 2 thread counts)" << std::endl;
+            continue;
+        }
+        std::cout << std::setw(colWidth) << fit.amdahlSerial
+                  << std::setw(colWidth) << fit.uslSigma
+                  << std::setw(colWidth) << fit.uslKappa
+                  << std::setw(colWidth) << fit.uslR2
+                  << std::setw(colWidth) << formatOptimum(fit)
+                  << std::setw(colWidth) << fit.peakSpeedup << std::endl;
+    }
+    std::cout << std::string(labelWidth + 6 * colWidth, '-') << std::endl;
+}
+
+std::vector<int> defaultScalingThreadCounts(int maxThreads) {
+    // Powers of two up to maxThreads (e.g. maxThreads=10 -> 1,2,4,8,10)
+    std::vector<int> threadCounts;
+    for (int t = 1; t > 0 && t <= maxThreads; t *= 2) {
+        threadCounts.push_back(t);
+    }
+    if (maxThreads > 0 && (maxThreads & (maxThreads - 1)) != 0) {
+        threadCounts.push_back(maxThreads);
+    }
+    return threadCounts;
+}
+
+std::vector<int> parseThreadCounts(const std::string& spec) {
+    std::vector<int> threadCounts;
+    std::stringstream ss(spec);
+    std::string token;
+    while (std::getline(ss, token, ',')) {
+        if (token.empty()) continue;
+        try {
+            auto dash = token.find('-', 1);
+            if (dash != std::string::npos) {
+                int lo = std::stoi(token.substr(0, dash));
+                int hi = std::stoi(token.substr(dash + 1));
+                for (int t = std::max(1, lo); t <= hi; ++t) threadCounts.push_back(t);
+            } else {
+                int t = std::stoi(token);
+                if (t > 0) threadCounts.push_back(t);
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Ignoring invalid thread count '" << token << "'" << std::endl;
+        }
+    }
+    std::sort(threadCounts.begin(), threadCounts.end());
+    threadCounts.erase(std::unique(threadCounts.begin(), threadCounts.end()), threadCounts.end());
+    return threadCounts;
+}
+
+const std::vector<EventShape>& presetEventShapes() {
+    // hits, wires, roisPerWire, spills; spill layouts split hits/wires evenly across spills
+    static const std::vector<EventShape> presets = {
+        {"small",    10,   10,   2,  10},
+        {"medium",   100,  100,  10, 10},
+        {"huge",     1000, 1000, 10, 10},
+        {"roiHeavy", 20,   100,  50, 10},
+        {"hitHeavy", 1000, 20,   2,  10},
+    };
+    return presets;
+}
+
+std::vector<EventShape> parseEventShapes(const std::string& spec) {
+    std::vector<EventShape> shapes;
+    std::stringstream ss(spec);
+    std::string token;
+    while (std::getline(ss, token, ',')) {
+        if (token.empty()) continue;
+        if (token.find(':') == std::string::npos) {
+            const auto& presets = presetEventShapes();
+            auto it = std::find_if(presets.begin(), presets.end(),
+                                   [&](const EventShape& p) { return p.name == token; });
+            if (it != presets.end()) {
+                shapes.push_back(*it);
+            } else {
+                std::cerr << "Ignoring unknown event shape '" << token << "'" << std::endl;
+            }
+            continue;
+        }
+        // name:hits:wires:roisPerWire:spills
+        std::vector<std::string> parts;
+        std::stringstream ts(token);
+        std::string part;
+        while (std::getline(ts, part, ':')) parts.push_back(part);
+        try {
+            if (parts.size() != 5 || parts[0].empty()) throw std::invalid_argument("expected name:hits:wires:rois:spills");
+            EventShape shape{parts[0], std::stoi(parts[1]), std::stoi(parts[2]), std::stoi(parts[3]), std::stoi(parts[4])};
+            if (shape.hitsPerEvent < 0 || shape.wiresPerEvent < 0 || shape.roisPerWire < 0 || shape.numSpills <= 0) {
+                throw std::invalid_argument("negative size or non-positive spills");
+            }
+            shapes.push_back(shape);
+        } catch (const std::exception& e) {
+            std::cerr << "Ignoring invalid event shape '" << token << "' (" << e.what() << ")" << std::endl;
+        }
+    }
+    return shapes;
+}
+
+bool writeScalingCsv(const std::string& path, const EventShape& shape, const std::vector<ScalingFit>& fits) {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << "# shape=" << shape.name << " hitsPerEvent=" << shape.hitsPerEvent
+        << " wiresPerEvent=" << shape.wiresPerEvent << " roisPerWire=" << shape.roisPerWire
+        << " numSpills=" << shape.numSpills << "\n";
+    out << "label,threads,time_s,speedup,efficiency,usl_sigma,usl_kappa,usl_optimal_threads\n";
+    for (const auto& fit : fits) {
+        for (size_t i = 0; i < fit.threads.size(); ++i) {
+            out << fit.label << ',' << fit.threads[i] << ',' << fit.times[i] << ','
+                << fit.speedup[i] << ',' << fit.efficiency[i] << ',';
+            if (fit.valid) {
+                out << fit.uslSigma << ',' << fit.uslKappa << ',' << fit.optimalThreadsInt;
+            } else {
+                out << ",,";
+            }
+            out << '\n';
+        }
+    }
+    return true;
+}
@@ -0,0 +1,131 @@
+#include "ShardedWrite.hpp"
+#include "HitWireWriters.hpp"
+#include "LayoutConverter.hpp"
+#include "Utils.hpp"
+#include <ROOT/RNTupleReader.hxx>
+#include <ROOT/RNTupleWriteOptions.hxx>
+#include <TFileMerger.h>
+#include <TStopwatch.h>
+#include <filesystem>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+
+namespace {
+
+std::map<std::string, std::uint64_t> entriesPerNtuple(const std::string& fileName) {
+    std::map<std::string, std::uint64_t> entries;
+    for (const auto& name : Utils::list_ntuples(fileName)) {
+        entries[name] = ROOT::RNTupleReader::Open(name, fileName)->GetNEntries();
+    }
+    return entries;
+}
+
+} // namespace
+
+double mergeFiles(const std::vector<std::string>& inputs, const std::string& output) {
+    TStopwatch sw; sw.Start();
+    TFileMerger merger(kFALSE, kFALSE);
+    merger.SetPrintLevel(0);
+    if (!merger.OutputFile(output.c_str(), "RECREATE", ROOT::RNTupleWriteOptions().GetCompression())) {
+        throw std::runtime_error("cannot create " + output);
+    }
+    for (const auto& input : inputs) {
+        if (!merger.AddFile(input.c_str(), kFALSE)) throw std::runtime_error("cannot open " + input);
+    }
+    if (!merger.Merge()) throw std::runtime_error("merging into " + output + " failed");
+    sw.Stop();
+    return sw.RealTime();
+}
+
+ShardedWriteResult runShardedWrite(const std::string& layout, int nThreads, int numEvents, int numSpills,
+                                   int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& outputDir) {
+    ShardedWriteResult result;
+    result.layout = layout;
+    const std::string sharedFile = outputDir + "/" + layout + ".root";
+    const std::string mergedFile = outputDir + "/" + layout + "_merged.root";
+
+    TStopwatch sw; sw.Start();
+    writeLayout(layout, numEvents, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire, sharedFile, nThreads);
+    sw.Stop();
+    result.shared = sw.RealTime();
+
+    // Same event split as the shared writer, one single-threaded writer and file per slice
+    std::vector<std::string> shardFiles;
+    std::vector<std::future<void>> futures;
+    const int chunk = numEvents / nThreads;
+    sw.Start();
+    for (int th = 0; th < nThreads; ++th) {
+        const int first = th * chunk;
+        const int last = (th == nThreads - 1) ? numEvents : first + chunk;
+        if (first >= last) continue;
+        shardFiles.push_back(outputDir + "/" + layout + "_shard" + std::to_string(th) + ".root");
+        futures.push_back(std::async(std::launch::async, [&, first, last, th, file = shardFiles.back()]() {
+            setThreadWriterShard({first, th}); // in events, converted to spills or slots by the writer
+            writeLayout(layout, last - first, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire, file, 1);
+        }));
+    }
+    for (auto& f : futures) f.get();
+    sw.Stop();
+    result.shardWrite = sw.RealTime();
+    result.shards = static_cast<int>(shardFiles.size());
+
+    result.merge = mergeFiles(shardFiles, mergedFile);
+    for (const auto& file : shardFiles) std::filesystem::remove(file);
+
+    result.sharedBytes = std::filesystem::file_size(sharedFile);
+    result.mergedBytes = std::filesystem::file_size(mergedFile);
+    result.entriesMatch = entriesPerNtuple(sharedFile) == entriesPerNtuple(mergedFile);
+    return result;
+}
+
+void compareShardedWrite(int nThreads, int iter, int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire,
+                         int numSpills, int mask, bool runAOS, bool runSOA) {
+    const std::string outputDir = "./output_sharded";
+    std::filesystem::create_directories(outputDir);
+
+    const int col1 = 28, col2 = 12;
+    std::cout << "\nShared Writer vs File per Thread + Merge (wall-clock, " << nThreads << " threads, times in s)" << std::endl;
+    std::cout << std::left
+              << std::setw(col1) << "Layout"
+              << std::setw(col2) << "Shared"
+              << std::setw(col2) << "Shards"
+              << std::setw(col2) << "Merge"
+              << std::setw(col2) << "Sharded"
+              << std::setw(col2) << "Sh/Shared"
+              << std::setw(col2) << "Shared MB"
+              << std::setw(col2) << "Merged MB"
+              << std::setw(col2) << "Entries" << std::endl;
+    std::cout << std::string(col1 + 8 * col2, '-') << std::endl;
+
+    forEachSelectedLayout(mask, runAOS, runSOA, [&](const StorageLayout& layout) {
+        const std::string name = storageLayoutName(layout);
+        std::cout << std::left << std::setw(col1) << name;
+        try {
+            ShardedWriteResult avg;
+            bool match = true;
+            for (int it = 0; it < iter; ++it) {
+                auto r = runShardedWrite(name, nThreads, numEvents, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire, outputDir);
+                avg.shared += r.shared / iter;
+                avg.shardWrite += r.shardWrite / iter;
+                avg.merge += r.merge / iter;
+                avg.sharedBytes = r.sharedBytes;
+                avg.mergedBytes = r.mergedBytes;
+                match = match && r.entriesMatch;
+            }
+            std::cout << std::setw(col2) << avg.shared
+                      << std::setw(col2) << avg.shardWrite
+                      << std::setw(col2) << avg.merge
+                      << std::setw(col2) << avg.sharded()
+                      << std::setw(col2) << (avg.shared > 0.0 ? avg.sharded() / avg.shared : 0.0)
+                      << std::setw(col2) << avg.sharedBytes / (1024.0 * 1024.0)
+                      << std::setw(col2) << avg.mergedBytes / (1024.0 * 1024.0)
+                      << std::setw(col2) << (match ? "OK" : "MISMATCH") << std::endl;
+        } catch (const std::exception& e) {
+            std::cout << "FAILED: " << e.what() << std::endl;
+        }
+    });
+    std::cout << std::string(col1 + 8 * col2, '-') << std::endl;
+}
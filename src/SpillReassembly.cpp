@@ -0,0 +1,411 @@
+#include "SpillReassembly.hpp"
+#include "Affinity.hpp"
+#include "HitWireWriterHelpers.hpp"
+#include "Utils.hpp"
+#include <ROOT/RNTupleReader.hxx>
+#include <TStopwatch.h>
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr long long kNoKey = std::numeric_limits<long long>::min();
+constexpr int kNoSpill = -1; // files without SpillID: spills stay in arrival order
+
+// Copies src[begin, begin + n) behind the first `at` elements of dst. Existing elements are
+// assigned rather than recreated, so nested vectors (ROIs) keep their capacity across pooled events.
+template <typename T>
+void copyColumn(std::vector<T>& dst, std::size_t at, const std::vector<T>& src, std::size_t begin, std::size_t n) {
+    if (dst.size() < at + n) dst.resize(at + n);
+    std::copy(src.begin() + begin, src.begin() + begin + n, dst.begin() + at);
+}
+
+// Where one spill sits in an event buffer
+struct SpillSlot {
+    int spill = kNoSpill;
+    std::size_t firstHit = 0;
+    std::size_t hits = 0;
+    std::size_t firstWire = 0;
+    std::size_t wires = 0;
+};
+
+// Calls fn(dstColumn, srcColumn) for every per-hit / per-wire column of the event type
+template <typename Fn>
+void forEachHitColumn(EventAOS& d, const EventAOS& s, Fn&& fn) {
+    fn(d.hits, s.hits);
+}
+
+template <typename Fn>
+void forEachWireColumn(EventAOS& d, const EventAOS& s, Fn&& fn) {
+    fn(d.wires, s.wires);
+}
+
+template <typename Fn>
+void forEachHitColumn(EventSOA& d, const EventSOA& s, Fn&& fn) {
+    fn(d.hits.EventIDs, s.hits.EventIDs);
+    fn(d.hits.fChannel, s.hits.fChannel);
+    fn(d.hits.fView, s.hits.fView);
+    fn(d.hits.fStartTick, s.hits.fStartTick);
+    fn(d.hits.fEndTick, s.hits.fEndTick);
+    fn(d.hits.fPeakTime, s.hits.fPeakTime);
+    fn(d.hits.fSigmaPeakTime, s.hits.fSigmaPeakTime);
+    fn(d.hits.fRMS, s.hits.fRMS);
+    fn(d.hits.fPeakAmplitude, s.hits.fPeakAmplitude);
+    fn(d.hits.fSigmaPeakAmplitude, s.hits.fSigmaPeakAmplitude);
+    fn(d.hits.fROISummedADC, s.hits.fROISummedADC);
+    fn(d.hits.fHitSummedADC, s.hits.fHitSummedADC);
+    fn(d.hits.fIntegral, s.hits.fIntegral);
+    fn(d.hits.fSigmaIntegral, s.hits.fSigmaIntegral);
+    fn(d.hits.fMultiplicity, s.hits.fMultiplicity);
+    fn(d.hits.fLocalIndex, s.hits.fLocalIndex);
+    fn(d.hits.fGoodnessOfFit, s.hits.fGoodnessOfFit);
+    fn(d.hits.fNDF, s.hits.fNDF);
+    fn(d.hits.fSignalType, s.hits.fSignalType);
+    fn(d.hits.fWireID_Cryostat, s.hits.fWireID_Cryostat);
+    fn(d.hits.fWireID_TPC, s.hits.fWireID_TPC);
+    fn(d.hits.fWireID_Plane, s.hits.fWireID_Plane);
+    fn(d.hits.fWireID_Wire, s.hits.fWireID_Wire);
+}
+
+template <typename Fn>
+void forEachWireColumn(EventSOA& d, const EventSOA& s, Fn&& fn) {
+    fn(d.wires.EventIDs, s.wires.EventIDs);
+    fn(d.wires.fWire_Channel, s.wires.fWire_Channel);
+    fn(d.wires.fWire_View, s.wires.fWire_View);
+    fn(d.wires.fSignalROI, s.wires.fSignalROI);
+}
+
+std::size_t hitCount(const EventAOS& e) { return e.hits.size(); }
+std::size_t wireCount(const EventAOS& e) { return e.wires.size(); }
+std::size_t hitCount(const EventSOA& e) { return e.hits.EventIDs.size(); }
+std::size_t wireCount(const EventSOA& e) { return e.wires.EventIDs.size(); }
+
+// Key of a spill without an EventID field: the EventID of its first hit or wire
+long long eventKey(const EventAOS& e) {
+    if (!e.hits.empty()) return e.hits.front().EventID;
+    if (!e.wires.empty()) return e.wires.front().EventID;
+    return kNoKey;
+}
+
+long long eventKey(const EventSOA& e) {
+    if (!e.hits.EventIDs.empty()) return e.hits.EventIDs.front();
+    if (!e.wires.EventIDs.empty()) return e.wires.EventIDs.front();
+    return kNoKey;
+}
+
+// Touches the same values as the reader traversals
+void consumeEvent(const EventAOS& event) {
+    for (const auto& h : event.hits) {
+        volatile float sink = h.fPeakAmplitude; (void)sink;
+    }
+    for (const auto& w : event.wires) {
+        volatile unsigned int sink = w.fWire_Channel; (void)sink;
+        for (const auto& r : w.fSignalROI) {
+            if (!r.data.empty()) {
+                volatile float sink2 = r.data[0]; (void)sink2;
+            }
+        }
+    }
+}
+
+void consumeEvent(const EventSOA& event) {
+    for (std::size_t i = 0; i < event.hits.EventIDs.size(); ++i) {
+        volatile float sink = event.hits.fPeakAmplitude[i]; (void)sink;
+    }
+    for (std::size_t w = 0; w < event.wires.EventIDs.size(); ++w) {
+        volatile unsigned int sink = event.wires.fWire_Channel[w]; (void)sink;
+        for (const auto& roi : event.wires.fSignalROI[w]) {
+            if (!roi.data.empty()) {
+                volatile float sink2 = roi.data[0]; (void)sink2;
+            }
+        }
+    }
+}
+
+// Collects spills per EventID into pooled event buffers; single-threaded. Spills are appended
+// as they arrive and put into SpillID order once the event is complete.
+template <typename Event>
+class SpillReassembler {
+public:
+    struct Pending {
+        std::unique_ptr<Event> event;
+        std::size_t hits = 0;
+        std::size_t wires = 0;
+        std::vector<SpillSlot> slots;
+    };
+
+    explicit SpillReassembler(int spillsPerEvent) : fSpillsPerEvent(spillsPerEvent) {}
+
+    // Adds one spill
+    template <typename Fn>
+    void add(long long key, int spill, const Event& data, Fn&& onEvent) {
+        const SpillSlot slot{spill, 0, hitCount(data), 0, wireCount(data)};
+        add(key, data, &slot, 1, onEvent);
+    }
+
+    // Adds a trimmed partial event whose spills sit in data as described by slots
+    template <typename Fn>
+    void add(long long key, const Event& data, const SpillSlot* slots, std::size_t nSlots, Fn&& onEvent) {
+        auto [it, inserted] = fPending.try_emplace(key);
+        Pending& p = it->second;
+        if (inserted) p.event = acquire();
+        const std::size_t hits = hitCount(data), wires = wireCount(data);
+        forEachHitColumn(*p.event, data, [&](auto& d, const auto& s) { copyColumn(d, p.hits, s, 0, hits); });
+        forEachWireColumn(*p.event, data, [&](auto& d, const auto& s) { copyColumn(d, p.wires, s, 0, wires); });
+        for (std::size_t k = 0; k < nSlots; ++k) {
+            SpillSlot slot = slots[k];
+            slot.firstHit += p.hits;
+            slot.firstWire += p.wires;
+            p.slots.push_back(slot);
+        }
+        p.hits += hits;
+        p.wires += wires;
+        fPeakPending = std::max(fPeakPending, fPending.size());
+        if (p.slots.size() >= static_cast<std::size_t>(fSpillsPerEvent)) {
+            order(p);
+            trim(p);
+            onEvent(key, *p.event);
+            fFree.push_back(std::move(p.event));
+            fPending.erase(it);
+        }
+    }
+
+    // Open events, trimmed to their filled size; the reassembler is left empty
+    std::vector<std::pair<long long, Pending>> takePending() {
+        std::vector<std::pair<long long, Pending>> open;
+        for (auto& [key, p] : fPending) {
+            trim(p);
+            open.emplace_back(key, std::move(p));
+        }
+        fPending.clear();
+        return open;
+    }
+
+    std::size_t pending() const { return fPending.size(); }
+    std::size_t peakPending() const { return fPeakPending; }
+    std::size_t allocations() const { return fAllocations; }
+
+private:
+    std::unique_ptr<Event> acquire() {
+        if (fFree.empty()) {
+            ++fAllocations;
+            return std::make_unique<Event>();
+        }
+        auto event = std::move(fFree.back());
+        fFree.pop_back();
+        return event;
+    }
+
+    // Rewrites the event with its spills in SpillID order; the scratch buffer takes the old one
+    void order(Pending& p) {
+        auto bySpill = [](const SpillSlot& a, const SpillSlot& b) { return a.spill < b.spill; };
+        if (std::is_sorted(p.slots.begin(), p.slots.end(), bySpill)) return;
+        std::stable_sort(p.slots.begin(), p.slots.end(), bySpill);
+        if (!fScratch) fScratch = acquire();
+        std::size_t hits = 0, wires = 0;
+        for (const auto& slot : p.slots) {
+            forEachHitColumn(*fScratch, *p.event, [&](auto& d, const auto& s) { copyColumn(d, hits, s, slot.firstHit, slot.hits); });
+            forEachWireColumn(*fScratch, *p.event, [&](auto& d, const auto& s) { copyColumn(d, wires, s, slot.firstWire, slot.wires); });
+            hits += slot.hits;
+            wires += slot.wires;
+        }
+        std::swap(p.event, fScratch);
+    }
+
+    static void trim(Pending& p) {
+        forEachHitColumn(*p.event, *p.event, [&](auto& d, const auto&) { d.resize(p.hits); });
+        forEachWireColumn(*p.event, *p.event, [&](auto& d, const auto&) { d.resize(p.wires); });
+    }
+
+    int fSpillsPerEvent;
+    std::unordered_map<long long, Pending> fPending;
+    std::vector<std::unique_ptr<Event>> fFree;
+    std::unique_ptr<Event> fScratch;
+    std::size_t fPeakPending = 0;
+    std::size_t fAllocations = 0;
+};
+
+template <typename Event>
+SpillReassemblyResult reassemble(const std::string& fileName, const std::string& ntupleName, const std::string& fieldName,
+                                 int numSpills, int nThreads, const std::function<void(long long, const Event&)>& visit) {
+    using Reassembler = SpillReassembler<Event>;
+    SpillReassemblyResult result;
+    auto pilot = ROOT::RNTupleReader::Open(ntupleName, fileName);
+    auto chunks = Utils::split_range_by_clusters(*pilot, nThreads);
+    // Spill files keep the EventID and SpillID of every spill next to the event record; older
+    // files only have the EventID in the hits and wires, so their empty spills cannot be
+    // attributed, or lack the SpillID, so their spills stay in entry order
+    const bool explicitKey = pilot->GetDescriptor().FindFieldId("EventID") != ROOT::kInvalidDescriptorId;
+    const bool explicitSpill = pilot->GetDescriptor().FindFieldId("SpillID") != ROOT::kInvalidDescriptorId;
+
+    std::mutex mutex;
+    std::vector<std::pair<long long, typename Reassembler::Pending>> leftovers;
+    TStopwatch sw; sw.Start();
+    std::vector<std::future<void>> futures;
+    for (const auto& chunk : chunks) {
+        futures.emplace_back(std::async(std::launch::async, [&, chunk]() {
+            Affinity::pinCurrentThreadToNextSlot();
+            auto reader = ROOT::RNTupleReader::Open(ntupleName, fileName);
+            auto view = reader->GetView<Event>(fieldName);
+            Reassembler reassembler(numSpills);
+            std::uint64_t spills = 0, events = 0, hits = 0, wires = 0;
+            auto onEvent = [&](long long key, const Event& event) {
+                consumeEvent(event);
+                if (visit) visit(key, event);
+                ++events;
+                hits += hitCount(event);
+                wires += wireCount(event);
+            };
+            auto addSpills = [&](auto&& keyOf, auto&& spillOf) {
+                for (auto i = chunk.first; i < chunk.second; ++i) {
+                    const Event& spill = view(i);
+                    ++spills;
+                    const long long key = keyOf(i, spill);
+                    if (key != kNoKey) reassembler.add(key, spillOf(i), spill, onEvent);
+                }
+            };
+            auto noSpill = [](auto) { return kNoSpill; };
+            if (explicitSpill) {
+                auto keys = reader->GetView<long long>("EventID");
+                auto spillIds = reader->GetView<int>("SpillID");
+                addSpills([&](auto i, const Event&) { return static_cast<long long>(keys(i)); },
+                          [&](auto i) { return static_cast<int>(spillIds(i)); });
+            } else if (explicitKey) {
+                auto keys = reader->GetView<long long>("EventID");
+                addSpills([&](auto i, const Event&) { return static_cast<long long>(keys(i)); }, noSpill);
+            } else {
+                addSpills([](auto, const Event& spill) { return eventKey(spill); }, noSpill);
+            }
+            auto open = reassembler.takePending();
+            std::lock_guard<std::mutex> lock(mutex);
+            result.spills += spills;
+            result.events += events;
+            result.hits += hits;
+            result.wires += wires;
+            result.peakPending = std::max(result.peakPending, reassembler.peakPending());
+            result.allocations += reassembler.allocations();
+            for (auto& entry : open) leftovers.push_back(std::move(entry));
+        }));
+    }
+    for (auto& f : futures) f.get();
+
+    // Events whose spills landed in different ranges
+    Reassembler merger(numSpills);
+    for (const auto& [key, partial] : leftovers) {
+        merger.add(key, *partial.event, partial.slots.data(), partial.slots.size(), [&](long long eventId, const Event& event) {
+            consumeEvent(event);
+            if (visit) visit(eventId, event);
+            ++result.events;
+            ++result.mergedEvents;
+            result.hits += hitCount(event);
+            result.wires += wireCount(event);
+        });
+    }
+    result.incompleteEvents = merger.pending();
+    result.allocations += merger.allocations();
+    sw.Stop();
+    result.seconds = sw.RealTime();
+    return result;
+}
+
+template <typename Event>
+double readDirect(const std::string& fileName, const std::string& ntupleName, const std::string& fieldName, int nThreads) {
+    auto pilot = ROOT::RNTupleReader::Open(ntupleName, fileName);
+    auto chunks = Utils::split_range_by_clusters(*pilot, nThreads);
+    TStopwatch sw; sw.Start();
+    std::vector<std::future<void>> futures;
+    for (const auto& chunk : chunks) {
+        futures.emplace_back(std::async(std::launch::async, [&, chunk]() {
+            Affinity::pinCurrentThreadToNextSlot();
+            auto reader = ROOT::RNTupleReader::Open(ntupleName, fileName);
+            auto view = reader->GetView<Event>(fieldName);
+            for (auto i = chunk.first; i < chunk.second; ++i) consumeEvent(view(i));
+        }));
+    }
+    for (auto& f : futures) f.get();
+    sw.Stop();
+    return sw.RealTime();
+}
+
+} // namespace
+
+SpillReassemblyResult reassembleSpills(const std::string& fileName, SpillLayout layout, int numSpills, int nThreads) {
+    numSpills = std::max(1, numSpills);
+    if (layout == SpillLayout::AOS) return reassemble<EventAOS>(fileName, "aos_spills", "EventAOS", numSpills, nThreads, {});
+    return reassemble<EventSOA>(fileName, "soa_spill_all", "EventSOA", numSpills, nThreads, {});
+}
+
+SpillReassemblyResult reassembleSpills(const std::string& fileName, int numSpills, int nThreads,
+                                       const std::function<void(long long, const EventAOS&)>& onEvent) {
+    return reassemble<EventAOS>(fileName, "aos_spills", "EventAOS", std::max(1, numSpills), nThreads, onEvent);
+}
+
+SpillReassemblyResult reassembleSpills(const std::string& fileName, int numSpills, int nThreads,
+                                       const std::function<void(long long, const EventSOA&)>& onEvent) {
+    return reassemble<EventSOA>(fileName, "soa_spill_all", "EventSOA", std::max(1, numSpills), nThreads, onEvent);
+}
+
+double readEventsDirect(const std::string& fileName, SpillLayout layout, int nThreads) {
+    if (layout == SpillLayout::AOS) return readDirect<EventAOS>(fileName, "aos_events", "EventAOS", nThreads);
+    return readDirect<EventSOA>(fileName, "soa_events", "EventSOA", nThreads);
+}
+
+void benchmarkSpillReassembly(const std::string& outputDir, int numSpills, int nThreads, bool runAOS, bool runSOA) {
+    const int col1 = 8, col2 = 12;
+    std::cout << "\nSpill Reassembly vs Event Layout (" << numSpills << " spills/event, " << nThreads << " threads)" << std::endl;
+    std::cout << std::left
+              << std::setw(col1) << "Layout"
+              << std::setw(col2) << "Spills"
+              << std::setw(col2) << "Events"
+              << std::setw(col2) << "Merged"
+              << std::setw(col2) << "Incomplete"
+              << std::setw(col2) << "Peak open"
+              << std::setw(col2) << "Buffers"
+              << std::setw(col2) << "Spill (s)"
+              << std::setw(col2) << "Event (s)"
+              << std::setw(col2) << "Slowdown" << std::endl;
+    std::cout << std::string(col1 + 9 * col2, '-') << std::endl;
+
+    auto run = [&](const std::string& label, SpillLayout layout, const std::string& prefix) {
+        const std::string spillFile = outputDir + "/" + prefix + "_spill_all.root";
+        const std::string eventFile = outputDir + "/" + prefix + "_event_all.root";
+        if (!std::filesystem::exists(spillFile)) return;
+        std::cout << std::left << std::setw(col1) << label;
+        try {
+            Affinity::resetSlots();
+            auto result = reassembleSpills(spillFile, layout, numSpills, nThreads);
+            double direct = 0.0;
+            if (std::filesystem::exists(eventFile)) {
+                Affinity::resetSlots();
+                direct = readEventsDirect(eventFile, layout, nThreads);
+            }
+            std::cout << std::setw(col2) << result.spills
+                      << std::setw(col2) << result.events
+                      << std::setw(col2) << result.mergedEvents
+                      << std::setw(col2) << result.incompleteEvents
+                      << std::setw(col2) << result.peakPending
+                      << std::setw(col2) << result.allocations
+                      << std::setw(col2) << result.seconds;
+            if (direct > 0.0) {
+                std::cout << std::setw(col2) << direct << std::setw(col2) << result.seconds / direct;
+            } else {
+                std::cout << std::setw(col2) << "-" << std::setw(col2) << "-";
+            }
+            std::cout << std::endl;
+        } catch (const std::exception& e) {
+            std::cout << "FAILED: " << e.what() << std::endl;
+        }
+    };
+    if (runAOS) run("AOS", SpillLayout::AOS, "aos");
+    if (runSOA) run("SOA", SpillLayout::SOA, "soa");
+    std::cout << std::string(col1 + 9 * col2, '-') << std::endl;
+}
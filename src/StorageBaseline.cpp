@@ -0,0 +1,299 @@
+#include "StorageBaseline.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t kAlignment = 4096; // O_DIRECT buffer, offset and size alignment
+constexpr std::size_t kMaxMemcpyBytes = 256ull << 20;
+
+struct AlignedBuffer {
+    explicit AlignedBuffer(std::size_t size) : size(size) {
+        if (posix_memalign(&data, kAlignment, std::max(size, kAlignment)) != 0) throw std::bad_alloc();
+    }
+    ~AlignedBuffer() { std::free(data); }
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+    void* data = nullptr;
+    std::size_t size = 0;
+};
+
+// Incompressible content, so file systems with transparent compression see the real bytes
+void fillRandom(AlignedBuffer& buffer, unsigned seed) {
+    std::mt19937 rng(seed);
+    auto* words = static_cast<std::uint32_t*>(buffer.data);
+    for (std::size_t i = 0; i < buffer.size / sizeof(std::uint32_t); ++i) words[i] = rng();
+}
+
+// Starts nThreads copies of work together and returns the wall-clock time until all are done
+template <typename Work>
+double timeParallel(int nThreads, Work work) {
+    std::promise<void> go;
+    std::shared_future<void> ready = go.get_future().share();
+    std::vector<std::future<void>> done;
+    for (int th = 0; th < nThreads; ++th) {
+        done.push_back(std::async(std::launch::async, [&, th]() {
+            ready.wait();
+            work(th);
+        }));
+    }
+    const auto start = std::chrono::steady_clock::now();
+    go.set_value();
+    for (auto& f : done) f.get();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int openFlags(bool direct) {
+#ifdef O_DIRECT
+    return direct ? O_DIRECT : 0;
+#else
+    (void)direct;
+    return 0;
+#endif
+}
+
+bool directSupported(const std::string& directory) {
+#ifdef O_DIRECT
+    const std::string probe = directory + "/baseline_probe.bin";
+    int fd = ::open(probe.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+    if (fd >= 0) ::close(fd);
+    std::filesystem::remove(probe);
+    return fd >= 0;
+#else
+    (void)directory;
+    return false;
+#endif
+}
+
+std::string fileOf(const std::string& directory, int th) {
+    return directory + "/baseline_" + std::to_string(th) + ".bin";
+}
+
+void writeFile(const std::string& path, const AlignedBuffer& block, std::uint64_t blocks, bool direct) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | openFlags(direct), 0644);
+    if (fd < 0) throw std::runtime_error("cannot create " + path + ": " + std::strerror(errno));
+    for (std::uint64_t b = 0; b < blocks; ++b) {
+        std::size_t left = block.size;
+        const char* p = static_cast<const char*>(block.data);
+        while (left > 0) {
+            ssize_t n = ::write(fd, p, left);
+            if (n <= 0) {
+                ::close(fd);
+                throw std::runtime_error("write to " + path + " failed: " + std::strerror(errno));
+            }
+            p += n;
+            left -= static_cast<std::size_t>(n);
+        }
+    }
+    ::fsync(fd);
+    ::close(fd);
+}
+
+// Reads the whole file; a failed or short read would otherwise show up as a fast one
+void readFile(const std::string& path, AlignedBuffer& block, std::uint64_t fileBytes, bool direct) {
+    int fd = ::open(path.c_str(), O_RDONLY | openFlags(direct));
+    if (fd < 0) throw std::runtime_error("cannot open " + path + ": " + std::strerror(errno));
+    std::uint64_t total = 0;
+    while (true) {
+        ssize_t n = ::read(fd, block.data, block.size);
+        if (n == 0) break;
+        if (n < 0) {
+            const std::string error = std::strerror(errno);
+            ::close(fd);
+            throw std::runtime_error("read from " + path + " failed: " + error);
+        }
+        total += static_cast<std::uint64_t>(n);
+    }
+    ::close(fd);
+    if (total < fileBytes) {
+        throw std::runtime_error("short read from " + path + ": " + std::to_string(total) + " of " +
+                                 std::to_string(fileBytes) + " bytes");
+    }
+}
+
+void dropFromPageCache(const std::string& path) {
+#ifdef POSIX_FADV_DONTNEED
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+#else
+    (void)path;
+#endif
+}
+
+} // namespace
+
+std::vector<BaselineResult> runStorageBaseline(const BaselineConfig& config) {
+    std::filesystem::create_directories(config.directory);
+    std::vector<BaselineResult> results;
+    std::vector<bool> modes = {false};
+    if (config.direct && directSupported(config.directory)) modes.push_back(true);
+
+    for (bool direct : modes) {
+        for (std::size_t blockBytes : config.blockSizes) {
+            // O_DIRECT transfers must be multiples of the alignment
+            const std::size_t size = direct ? (blockBytes + kAlignment - 1) / kAlignment * kAlignment : blockBytes;
+            const std::uint64_t blocks = std::max<std::uint64_t>(1, config.bytesPerThread / size);
+            for (int nThreads : config.threads) {
+                std::vector<std::unique_ptr<AlignedBuffer>> buffers;
+                for (int th = 0; th < nThreads; ++th) {
+                    buffers.push_back(std::make_unique<AlignedBuffer>(size));
+                    fillRandom(*buffers.back(), static_cast<unsigned>(th + 1));
+                }
+                BaselineResult write{"write", direct, size, nThreads, blocks * size * nThreads};
+                write.seconds = timeParallel(nThreads, [&](int th) {
+                    writeFile(fileOf(config.directory, th), *buffers[th], blocks, direct);
+                });
+                results.push_back(write);
+
+                for (int th = 0; th < nThreads; ++th) dropFromPageCache(fileOf(config.directory, th));
+                BaselineResult read = write;
+                read.test = "read";
+                read.seconds = timeParallel(nThreads, [&](int th) {
+                    readFile(fileOf(config.directory, th), *buffers[th], blocks * size, direct);
+                });
+                results.push_back(read);
+                for (int th = 0; th < nThreads; ++th) std::filesystem::remove(fileOf(config.directory, th));
+            }
+        }
+    }
+    if (config.direct && modes.size() == 1) {
+        BaselineResult refused{"write", true};
+        refused.supported = false;
+        results.push_back(refused);
+    }
+
+    const std::size_t copyBytes = static_cast<std::size_t>(std::min<std::uint64_t>(config.bytesPerThread, kMaxMemcpyBytes));
+    constexpr int kCopies = 4;
+    for (int nThreads : config.threads) {
+        std::vector<std::unique_ptr<AlignedBuffer>> src, dst;
+        for (int th = 0; th < nThreads; ++th) {
+            src.push_back(std::make_unique<AlignedBuffer>(copyBytes));
+            dst.push_back(std::make_unique<AlignedBuffer>(copyBytes));
+            fillRandom(*src.back(), static_cast<unsigned>(th + 1));
+            std::memset(dst.back()->data, 0, copyBytes); // fault the pages in before timing
+        }
+        BaselineResult copy{"memcpy", false, 0, nThreads, static_cast<std::uint64_t>(copyBytes) * kCopies * nThreads};
+        copy.seconds = timeParallel(nThreads, [&](int th) {
+            for (int c = 0; c < kCopies; ++c) std::memcpy(dst[th]->data, src[th]->data, copyBytes);
+        });
+        results.push_back(copy);
+    }
+    return results;
+}
+
+BaselineCeilings baselineCeilings(const std::vector<BaselineResult>& results) {
+    BaselineCeilings ceilings;
+    for (const auto& r : results) {
+        if (!r.supported) continue;
+        double& best = r.test == "write" ? ceilings.writeMBps : r.test == "read" ? ceilings.readMBps : ceilings.memcpyMBps;
+        best = std::max(best, r.mbPerSecond());
+    }
+    return ceilings;
+}
+
+void printBaselineTable(const std::vector<BaselineResult>& results) {
+    const int col1 = 12, col2 = 12;
+    std::cout << "\nStorage and Memory Baseline (MiB/s)" << std::endl;
+    std::cout << std::left
+              << std::setw(col1) << "Test"
+              << std::setw(col2) << "Mode"
+              << std::setw(col2) << "Block"
+              << std::setw(col2) << "Threads"
+              << std::setw(col2) << "MiB"
+              << std::setw(col2) << "Time (s)"
+              << std::setw(col2) << "MiB/s" << std::endl;
+    std::cout << std::string(col1 + 6 * col2, '-') << std::endl;
+    for (const auto& r : results) {
+        std::cout << std::left << std::setw(col1) << r.test;
+        if (!r.supported) {
+            std::cout << std::setw(col2) << "direct" << "not supported by the file system" << std::endl;
+            continue;
+        }
+        const std::string block = r.blockBytes == 0 ? "-"
+                                  : r.blockBytes >= (1u << 20) ? std::to_string(r.blockBytes >> 20) + " MiB"
+                                                               : std::to_string(r.blockBytes >> 10) + " KiB";
+        std::cout << std::setw(col2) << (r.test == "memcpy" ? "-" : r.direct ? "direct" : "buffered")
+                  << std::setw(col2) << block
+                  << std::setw(col2) << r.threads
+                  << std::setw(col2) << r.bytes / (1024 * 1024)
+                  << std::setw(col2) << r.seconds
+                  << std::fixed << std::setprecision(0) << std::setw(col2) << r.mbPerSecond() << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setprecision(6);
+    }
+    std::cout << std::string(col1 + 6 * col2, '-') << std::endl;
+    const auto ceilings = baselineCeilings(results);
+    std::cout << std::fixed << std::setprecision(0) << "Ceilings: write " << ceilings.writeMBps << " MiB/s, read "
+              << ceilings.readMBps << " MiB/s, memcpy " << ceilings.memcpyMBps << " MiB/s" << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+bool writeBaselineCsv(const std::string& path, const std::vector<BaselineResult>& results) {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << "test,direct,block_bytes,threads,bytes,time_s,mib_per_s\n";
+    for (const auto& r : results) {
+        if (!r.supported) continue;
+        out << r.test << ',' << r.direct << ',' << r.blockBytes << ',' << r.threads << ',' << r.bytes << ','
+            << r.seconds << ',' << r.mbPerSecond() << '\n';
+    }
+    return true;
+}
+
+void printRooflineTable(const std::string& title, const BaselineCeilings& ceilings,
+                        const std::vector<WriterResult>& writers, const std::vector<ReaderResult>& readers,
+                        const std::map<std::string, double>& fileMBByLabel) {
+    auto percent = [](double mbps, double ceiling) { return ceiling > 0.0 ? 100.0 * mbps / ceiling : 0.0; };
+    const int col1 = 32, col2 = 12;
+    std::cout << "\n" << title << " (MiB/s and % of the baseline ceilings)" << std::endl;
+    std::cout << std::left
+              << std::setw(col1) << "Benchmark"
+              << std::setw(col2) << "File MiB"
+              << std::setw(col2) << "Write"
+              << std::setw(col2) << "% write"
+              << std::setw(col2) << "Cold read"
+              << std::setw(col2) << "% read"
+              << std::setw(col2) << "Warm read"
+              << std::setw(col2) << "% memcpy" << std::endl;
+    std::cout << std::string(col1 + 7 * col2, '-') << std::endl;
+    for (const auto& [label, mb] : fileMBByLabel) {
+        auto w = std::find_if(writers.begin(), writers.end(), [&](const WriterResult& r) { return r.label == label; });
+        auto r = std::find_if(readers.begin(), readers.end(), [&](const ReaderResult& x) { return x.label == label; });
+        const bool hasWrite = w != writers.end() && !w->failed && w->avg > 0.0;
+        const bool hasRead = r != readers.end() && !r->failed && r->cold > 0.0;
+        if (!hasWrite && !hasRead) continue;
+        std::cout << std::left << std::setw(col1) << label << std::fixed << std::setprecision(1) << std::setw(col2) << mb;
+        if (hasWrite) {
+            std::cout << std::setw(col2) << mb / w->avg << std::setw(col2) << percent(mb / w->avg, ceilings.writeMBps);
+        } else {
+            std::cout << std::setw(col2) << "-" << std::setw(col2) << "-";
+        }
+        if (hasRead) {
+            std::cout << std::setw(col2) << mb / r->cold << std::setw(col2) << percent(mb / r->cold, ceilings.readMBps);
+            if (r->warmAvg > 0.0) {
+                std::cout << std::setw(col2) << mb / r->warmAvg << std::setw(col2) << percent(mb / r->warmAvg, ceilings.memcpyMBps);
+            }
+        }
+        std::cout << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setprecision(6);
+    }
+    std::cout << std::string(col1 + 7 * col2, '-') << std::endl;
+}
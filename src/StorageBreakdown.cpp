@@ -0,0 +1,197 @@
+#include "StorageBreakdown.hpp"
+#include "ZoneMap.hpp"
+#include <ROOT/RNTupleReader.hxx>
+#include <TFile.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+bool startsWith(const std::string& s, const std::string& prefix) {
+    return s.compare(0, prefix.size(), prefix) == 0;
+}
+
+// Class and data member of the field; collection items ("_0") and base classes (":_0") hang off
+// their parent, so the same member gets the same name in every layout
+std::string memberName(const ROOT::RNTupleDescriptor& desc, ROOT::DescriptorId_t fieldId) {
+    const auto& field = desc.GetFieldDescriptor(fieldId);
+    const auto parentId = field.GetParentId();
+    const std::string& name = field.GetFieldName();
+    if (parentId == ROOT::kInvalidDescriptorId || parentId == desc.GetFieldZeroId()) return name;
+    if (startsWith(name, "_")) return memberName(desc, parentId) + "." + name;
+    return desc.GetFieldDescriptor(parentId).GetTypeName() + "::" + name;
+}
+
+bool isCollectionType(const std::string& type) {
+    return startsWith(type, "std::vector<") || startsWith(type, "ROOT::RVec<") || type == "std::string";
+}
+
+void analyzeNtuple(const std::string& fileName, const std::string& ntupleName, std::vector<ColumnStorage>& out) {
+    auto reader = ROOT::RNTupleReader::Open(ntupleName, fileName);
+    const auto& desc = reader->GetDescriptor();
+    std::map<ROOT::DescriptorId_t, std::size_t> rows; // physical column id -> index in out
+    for (std::uint64_t cid = 0; cid < desc.GetNClusters(); ++cid) {
+        const auto& clusterDesc = desc.GetClusterDescriptor(cid);
+        for (const auto& columnRange : clusterDesc.GetColumnRangeIterable()) {
+            if (columnRange.IsSuppressed()) continue;
+            const auto columnId = columnRange.GetPhysicalColumnId();
+            const auto& columnDesc = desc.GetColumnDescriptor(columnId);
+            auto it = rows.find(columnId);
+            if (it == rows.end()) {
+                ColumnStorage column;
+                column.ntuple = ntupleName;
+                column.field = desc.GetQualifiedFieldName(columnDesc.GetFieldId());
+                column.member = memberName(desc, columnDesc.GetFieldId());
+                column.offsets = isCollectionType(desc.GetFieldDescriptor(columnDesc.GetFieldId()).GetTypeName()) &&
+                                 columnDesc.GetIndex() == 0;
+                column.bitsOnStorage = columnDesc.GetBitsOnStorage();
+                it = rows.emplace(columnId, out.size()).first;
+                out.push_back(std::move(column));
+            }
+            auto& column = out[it->second];
+            column.elements += columnRange.GetNElements();
+            column.uncompressedBytes += (columnRange.GetNElements() * columnDesc.GetBitsOnStorage() + 7) / 8;
+            for (const auto& pageInfo : clusterDesc.GetPageRange(columnId).GetPageInfos()) {
+                column.compressedBytes += pageInfo.GetLocator().GetNBytesOnStorage();
+                ++column.pages;
+            }
+        }
+    }
+}
+
+} // namespace
+
+FileStorage analyzeFileStorage(const std::string& fileName) {
+    FileStorage storage;
+    storage.fileName = fileName;
+    {
+        std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+        if (!file || file->IsZombie()) throw std::runtime_error("cannot open " + fileName);
+        storage.fileBytes = file->GetSize();
+    }
+    for (const auto& name : listDataNtuples(fileName)) analyzeNtuple(fileName, name, storage.columns);
+    return storage;
+}
+
+std::vector<ColumnStorage> aggregateByMember(const std::vector<FileStorage>& files) {
+    std::map<std::pair<std::string, bool>, ColumnStorage> byMember;
+    for (const auto& file : files) {
+        for (const auto& c : file.columns) {
+            auto& sum = byMember[{c.member, c.offsets}];
+            sum.member = c.member;
+            sum.offsets = c.offsets;
+            sum.bitsOnStorage = std::max(sum.bitsOnStorage, c.bitsOnStorage);
+            sum.elements += c.elements;
+            sum.compressedBytes += c.compressedBytes;
+            sum.uncompressedBytes += c.uncompressedBytes;
+            sum.pages += c.pages;
+        }
+    }
+    std::vector<ColumnStorage> members;
+    for (auto& [key, sum] : byMember) members.push_back(std::move(sum));
+    std::stable_sort(members.begin(), members.end(), [](const ColumnStorage& a, const ColumnStorage& b) {
+        return a.compressedBytes > b.compressedBytes;
+    });
+    return members;
+}
+
+bool writeStorageBreakdownCsv(const std::string& path, const std::vector<FileStorage>& files) {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << "file,ntuple,field,member,role,bits,elements,compressed_bytes,uncompressed_bytes,pages,avg_page_bytes,ratio\n";
+    for (const auto& file : files) {
+        const std::string stem = std::filesystem::path(file.fileName).stem().string();
+        for (const auto& c : file.columns) {
+            out << stem << ',' << c.ntuple << ',' << c.field << ',' << '"' << c.member << '"' << ','
+                << (c.offsets ? "offsets" : "values") << ',' << c.bitsOnStorage << ',' << c.elements << ','
+                << c.compressedBytes << ',' << c.uncompressedBytes << ',' << c.pages << ','
+                << c.avgPageBytes() << ',' << c.ratio() << '\n';
+        }
+    }
+    return true;
+}
+
+void reportStorageBreakdown(const std::string& title, const std::vector<std::string>& fileNames, const std::string& csvPath) {
+    const int col1 = 36, col2 = 10, col3 = 12;
+    const int width = col1 + 3 * col2 + 5 * col3;
+    std::vector<FileStorage> files;
+    std::cout << "\n" << title << std::endl;
+    for (const auto& fileName : fileNames) {
+        if (!std::filesystem::exists(fileName)) continue;
+        try {
+            files.push_back(analyzeFileStorage(fileName));
+        } catch (const std::exception& e) {
+            std::cout << std::left << std::setw(col1) << std::filesystem::path(fileName).stem().string()
+                      << "FAILED: " << e.what() << std::endl;
+        }
+    }
+
+    std::uint64_t fileBytes = 0, columnBytes = 0, rawBytes = 0, pages = 0;
+    for (const auto& file : files) {
+        fileBytes += file.fileBytes;
+        for (const auto& c : file.columns) {
+            columnBytes += c.compressedBytes;
+            rawBytes += c.uncompressedBytes;
+            pages += c.pages;
+        }
+    }
+    const double kMB = 1024.0 * 1024.0;
+    auto share = [&](std::uint64_t bytes) { return fileBytes > 0 ? 100.0 * bytes / fileBytes : 0.0; };
+
+    std::cout << std::left
+              << std::setw(col1) << "Member"
+              << std::setw(col2) << "Role"
+              << std::setw(col2) << "Bits"
+              << std::setw(col3) << "Comp. MB"
+              << std::setw(col3) << "Uncomp. MB"
+              << std::setw(col3) << "Pages"
+              << std::setw(col3) << "Avg page KB"
+              << std::setw(col2) << "Ratio"
+              << std::setw(col3) << "Share %" << std::endl;
+    std::cout << std::string(width, '-') << std::endl;
+    for (const auto& m : aggregateByMember(files)) {
+        std::cout << std::left
+                  << std::setw(col1) << m.member
+                  << std::setw(col2) << (m.offsets ? "offsets" : "values")
+                  << std::setw(col2) << m.bitsOnStorage
+                  << std::setw(col3) << m.compressedBytes / kMB
+                  << std::setw(col3) << m.uncompressedBytes / kMB
+                  << std::setw(col3) << m.pages
+                  << std::setw(col3) << m.avgPageBytes() / 1024.0
+                  << std::setw(col2) << m.ratio()
+                  << std::setw(col3) << share(m.compressedBytes) << std::endl;
+    }
+    std::cout << std::string(width, '-') << std::endl;
+    std::cout << std::left
+              << std::setw(col1 + 2 * col2) << "Column pages"
+              << std::setw(col3) << columnBytes / kMB
+              << std::setw(col3) << rawBytes / kMB
+              << std::setw(col3) << pages
+              << std::setw(col3) << (pages > 0 ? columnBytes / 1024.0 / pages : 0.0)
+              << std::setw(col2) << (columnBytes > 0 ? static_cast<double>(rawBytes) / columnBytes : 0.0)
+              << std::setw(col3) << share(columnBytes) << std::endl;
+    const std::uint64_t otherBytes = fileBytes > columnBytes ? fileBytes - columnBytes : 0;
+    std::cout << std::left
+              << std::setw(col1 + 2 * col2) << "Metadata, sidecars, ROOT file"
+              << std::setw(col3) << otherBytes / kMB
+              << std::setw(col3 * 4 + col2) << ""
+              << std::setw(col3) << share(otherBytes) << std::endl;
+    std::cout << std::string(width, '-') << std::endl;
+    std::cout << "Summed over " << files.size() << " files (" << fileBytes / kMB
+              << " MB); Ratio is uncompressed / compressed, Share is of the file sizes." << std::endl;
+
+    if (!csvPath.empty() && !files.empty()) {
+        if (writeStorageBreakdownCsv(csvPath, files)) {
+            std::cout << "Per-column breakdown written to " << csvPath << std::endl;
+        } else {
+            std::cerr << "Cannot write " << csvPath << std::endl;
+        }
+    }
+}
@@ -0,0 +1,332 @@
+#include "SweepConfig.hpp"
+#include "EventSizes.hpp"
+#include "HitWireGenerators.hpp"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+std::string trim(const std::string& s) {
+    const auto first = s.find_first_not_of(" \t\r");
+    if (first == std::string::npos) return "";
+    const auto last = s.find_last_not_of(" \t\r");
+    return s.substr(first, last - first + 1);
+}
+
+// Drops a # comment unless it is inside a string
+std::string stripComment(const std::string& line) {
+    bool quoted = false;
+    for (std::size_t i = 0; i < line.size(); ++i) {
+        if (line[i] == '"') quoted = !quoted;
+        if (line[i] == '#' && !quoted) return line.substr(0, i);
+    }
+    return line;
+}
+
+bool closesList(const std::string& value) {
+    bool quoted = false;
+    for (char c : value) {
+        if (c == '"') quoted = !quoted;
+        if (c == ']' && !quoted) return true;
+    }
+    return false;
+}
+
+// Items of a value: a bare or quoted scalar is one item, [a, "b", ...] one per element
+std::vector<std::string> splitValue(const std::string& value, bool& isList) {
+    std::string body = value;
+    isList = !body.empty() && body.front() == '[';
+    if (isList) {
+        if (body.back() != ']') throw std::invalid_argument("unterminated list");
+        body = body.substr(1, body.size() - 2);
+    }
+    std::vector<std::string> items;
+    std::string item;
+    bool quoted = false, wasQuoted = false;
+    auto finish = [&]() {
+        std::string t = wasQuoted ? item : trim(item);
+        if (!t.empty() || wasQuoted) items.push_back(t);
+        item.clear();
+        wasQuoted = false;
+    };
+    for (char c : body) {
+        if (c == '"') {
+            if (!quoted) item.clear();
+            quoted = !quoted;
+            wasQuoted = true;
+        } else if (c == ',' && !quoted) {
+            if (!isList) throw std::invalid_argument("use [a, b] for a list");
+            finish();
+        } else if (quoted || !wasQuoted) {
+            item += c;
+        }
+    }
+    if (quoted) throw std::invalid_argument("unterminated string");
+    finish();
+    return items;
+}
+
+double toNumber(const std::string& s) {
+    std::size_t used = 0;
+    double v = 0.0;
+    try {
+        v = std::stod(s, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used == 0 || used != s.size()) throw std::invalid_argument("invalid number '" + s + "'");
+    return v;
+}
+
+int toInt(const std::string& s) {
+    const double v = toNumber(s);
+    if (v != static_cast<int>(v)) throw std::invalid_argument("expected an integer, got '" + s + "'");
+    return static_cast<int>(v);
+}
+
+std::string single(const std::vector<std::string>& items, bool isList) {
+    if (isList || items.size() != 1) throw std::invalid_argument("expected a single value");
+    return items.front();
+}
+
+void assignKey(SweepConfig& config, const std::string& key, const std::string& value) {
+    bool isList = false;
+    const auto items = splitValue(value, isList);
+    if (items.empty() && key != "name") throw std::invalid_argument("empty value");
+    if (key == "name") {
+        config.name = single(items, isList);
+    } else if (key == "output") {
+        config.outputDir = single(items, isList);
+    } else if (key == "iterations") {
+        config.iterations = toInt(single(items, isList));
+        if (config.iterations <= 0) throw std::invalid_argument("iterations must be positive");
+    } else if (key == "events") {
+        config.numEvents = toInt(single(items, isList));
+        if (config.numEvents <= 0) throw std::invalid_argument("events must be positive");
+    } else if (key == "layouts") {
+        config.layouts = items;
+    } else if (key == "threads") {
+        config.threads.clear();
+        for (const auto& item : items) {
+            config.threads.push_back(toInt(item));
+            if (config.threads.back() <= 0) throw std::invalid_argument("thread counts must be positive");
+        }
+    } else if (key == "shapes") {
+        config.shapes.clear();
+        for (const auto& item : items) {
+            auto shapes = parseEventShapes(item);
+            if (shapes.size() != 1) throw std::invalid_argument("invalid event shape '" + item + "'");
+            config.shapes.push_back(shapes.front());
+        }
+    } else if (key == "event_sizes") {
+        config.eventSizes = items;
+    } else if (key == "generators") {
+        config.generators = items;
+    } else if (key == "compression") {
+        config.compression = items;
+    } else if (key == "cluster_mb" || key == "page_kb") {
+        auto& axis = key == "cluster_mb" ? config.clusterMB : config.pageKB;
+        axis.clear();
+        for (const auto& item : items) {
+            axis.push_back(toNumber(item));
+            if (axis.back() < 0.0) throw std::invalid_argument(key + " must not be negative");
+        }
+    } else {
+        throw std::invalid_argument("unknown key '" + key + "'");
+    }
+}
+
+std::string csvField(const std::string& s) {
+    if (s.find_first_of(",\"\n") == std::string::npos) return s;
+    std::string quoted = "\"";
+    for (char c : s) {
+        if (c == '\n') c = ' ';
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+std::vector<std::string> splitCsvLine(const std::string& line) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (std::size_t i = 0; i < line.size(); ++i) {
+        const char c = line[i];
+        if (c == '"') {
+            if (quoted && i + 1 < line.size() && line[i + 1] == '"') {
+                fields.back() += '"';
+                ++i;
+            } else {
+                quoted = !quoted;
+            }
+        } else if (c == ',' && !quoted) {
+            fields.emplace_back();
+        } else {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+
+} // namespace
+
+std::string SweepCell::key() const {
+    std::ostringstream os;
+    os << layout << ";threads=" << threads << ";shape=" << shape.name << ':' << shape.hitsPerEvent << ':'
+       << shape.wiresPerEvent << ':' << shape.roisPerWire << ':' << shape.numSpills << ";sizes=" << eventSizes
+       << ";generator=" << generator << ";compression=" << compressionSetting << ";cluster_mb=" << clusterMB
+       << ";page_kb=" << pageKB << ";events=" << numEvents;
+    return os.str();
+}
+
+SweepConfig parseSweepConfig(const std::string& text) {
+    SweepConfig config;
+    std::istringstream in(text);
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        const int keyLine = lineNo;
+        line = trim(stripComment(line));
+        if (line.empty()) continue;
+        try {
+            if (line.front() == '[') throw std::invalid_argument("sections are not supported");
+            const auto eq = line.find('=');
+            if (eq == std::string::npos) throw std::invalid_argument("expected key = value");
+            const std::string key = trim(line.substr(0, eq));
+            std::string value = trim(line.substr(eq + 1));
+            // A list may continue over the following lines up to its closing bracket
+            if (!value.empty() && value.front() == '[') {
+                std::string next;
+                while (!closesList(value) && std::getline(in, next)) {
+                    ++lineNo;
+                    value += " " + trim(stripComment(next));
+                }
+                value = trim(value);
+            }
+            assignKey(config, key, value);
+        } catch (const std::exception& e) {
+            throw std::runtime_error("sweep config line " + std::to_string(keyLine) + ": " + e.what());
+        }
+    }
+    return config;
+}
+
+SweepConfig loadSweepConfig(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("cannot open sweep config " + path);
+    std::ostringstream text;
+    text << in.rdbuf();
+    return parseSweepConfig(text.str());
+}
+
+int parseCompressionSetting(const std::string& name) {
+    if (name == "default") return -1;
+    if (name == "none") return 0;
+    if (!name.empty() && std::all_of(name.begin(), name.end(), [](unsigned char c) { return std::isdigit(c); })) {
+        const int setting = std::stoi(name);
+        if (setting != 0 && (setting / 100 < 1 || setting / 100 > 5 || setting % 100 > 9)) {
+            throw std::invalid_argument("invalid compression setting " + name);
+        }
+        return setting;
+    }
+    const auto colon = name.find(':');
+    const std::string algorithm = name.substr(0, colon);
+    // ROOT::RCompressionSetting algorithms with their default levels
+    int base = 0, level = 0;
+    if (algorithm == "zlib") { base = 100; level = 1; }
+    else if (algorithm == "lzma") { base = 200; level = 7; }
+    else if (algorithm == "lz4") { base = 400; level = 4; }
+    else if (algorithm == "zstd") { base = 500; level = 5; }
+    else throw std::invalid_argument("unknown compression '" + name + "' (expected default, none, zlib, lzma, lz4, zstd[:level] or a number)");
+    if (colon != std::string::npos) {
+        const std::string levelText = name.substr(colon + 1);
+        if (levelText.size() != 1 || !std::isdigit(static_cast<unsigned char>(levelText[0])) || levelText[0] == '0') {
+            throw std::invalid_argument("compression level of '" + name + "' must be 1-9");
+        }
+        level = levelText[0] - '0';
+    }
+    return base + level;
+}
+
+std::vector<SweepCell> expandSweepPlan(const SweepConfig& config, const std::vector<std::string>& allLayouts) {
+    std::vector<std::string> layouts;
+    for (const auto& name : config.layouts) {
+        if (name == "all" || name == "aos" || name == "soa") {
+            for (const auto& layout : allLayouts) {
+                if (name == "all" || layout.compare(0, 4, name + "_") == 0) layouts.push_back(layout);
+            }
+        } else if (std::find(allLayouts.begin(), allLayouts.end(), name) != allLayouts.end()) {
+            layouts.push_back(name);
+        } else {
+            throw std::invalid_argument("unknown layout '" + name + "'");
+        }
+    }
+    for (const auto& spec : config.eventSizes) parseEventSizeSpec(spec);
+    for (const auto& generator : config.generators) parseGeneratorMode(generator);
+
+    std::vector<SweepCell> cells;
+    for (const auto& shape : config.shapes)
+        for (const auto& sizes : config.eventSizes)
+            for (const auto& generator : config.generators)
+                for (const auto& compression : config.compression)
+                    for (double clusterMB : config.clusterMB)
+                        for (double pageKB : config.pageKB)
+                            for (const auto& layout : layouts)
+                                for (int threads : config.threads) {
+                                    SweepCell cell;
+                                    cell.layout = layout;
+                                    cell.threads = threads;
+                                    cell.shape = shape;
+                                    cell.eventSizes = sizes;
+                                    cell.generator = generator;
+                                    cell.compression = compression;
+                                    cell.compressionSetting = parseCompressionSetting(compression);
+                                    cell.clusterMB = clusterMB;
+                                    cell.pageKB = pageKB;
+                                    cell.numEvents = config.numEvents;
+                                    cells.push_back(cell);
+                                }
+    return cells;
+}
+
+std::set<std::string> readCompletedCells(const std::string& path) {
+    std::set<std::string> done;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        const auto fields = splitCsvLine(line);
+        if (fields.size() > 1 && fields.front() != "key" && fields.back() == "ok") done.insert(fields.front());
+    }
+    return done;
+}
+
+bool appendSweepResult(const std::string& path, const SweepConfig& config, const SweepCell& cell,
+                       const SweepCellResult& result) {
+    const bool isNew = !std::filesystem::exists(path);
+    std::ofstream out(path, std::ios::app);
+    if (!out) return false;
+    if (isNew) {
+        out << "# sweep=" << config.name << "\n";
+        out << "key,layout,threads,shape,hits_per_event,wires_per_event,rois_per_wire,spills,event_sizes,generator,"
+               "compression,cluster_mb,page_kb,events,iterations,time_s,min_time_s,events_per_s,file_mb,mb_per_s,status\n";
+    }
+    const auto& s = cell.shape;
+    out << csvField(cell.key()) << ',' << cell.layout << ',' << cell.threads << ',' << csvField(s.name) << ','
+        << s.hitsPerEvent << ',' << s.wiresPerEvent << ',' << s.roisPerWire << ',' << s.numSpills << ','
+        << csvField(cell.eventSizes) << ',' << cell.generator << ',' << csvField(cell.compression) << ','
+        << cell.clusterMB << ',' << cell.pageKB << ',' << cell.numEvents << ',' << config.iterations << ',';
+    if (result.ok) {
+        out << result.time << ',' << result.minTime << ',' << (result.time > 0.0 ? cell.numEvents / result.time : 0.0)
+            << ',' << result.fileMB << ',' << (result.time > 0.0 ? result.fileMB / result.time : 0.0) << ",ok\n";
+    } else {
+        out << ",,,,," << csvField("failed: " + result.error) << "\n";
+    }
+    out.flush();
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,118 @@
+#include "SweepRunner.hpp"
+#include "ClusterTargeting.hpp"
+#include "EventSizes.hpp"
+#include "HitWireGenerators.hpp"
+#include "HitWireWriters.hpp"
+#include "LayoutConverter.hpp"
+#include <TStopwatch.h>
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+// Everything but layout and threads; cells sharing it are printed as one group
+std::string groupLabel(const SweepCell& cell) {
+    std::ostringstream os;
+    os << "shape=" << cell.shape.name << " (" << cell.shape.hitsPerEvent << "/" << cell.shape.wiresPerEvent << "/"
+       << cell.shape.roisPerWire << "/" << cell.shape.numSpills << ")"
+       << "  sizes=" << cell.eventSizes << "  generator=" << cell.generator << "  compression=" << cell.compression;
+    if (cell.clusterMB > 0.0) os << "  cluster=" << cell.clusterMB << " MB";
+    if (cell.pageKB > 0.0) os << "  page=" << cell.pageKB << " KB";
+    return os.str();
+}
+
+} // namespace
+
+void runSweep(const SweepConfig& config, bool planOnly) {
+    std::vector<std::string> layoutNames;
+    for (const auto& layout : allStorageLayouts()) layoutNames.push_back(storageLayoutName(layout));
+    const auto cells = expandSweepPlan(config, layoutNames);
+
+    const std::string resultsFile = config.outputDir + "/results.csv";
+    const auto done = readCompletedCells(resultsFile);
+    const auto finished = std::count_if(cells.begin(), cells.end(),
+                                        [&done](const SweepCell& cell) { return done.count(cell.key()) > 0; });
+    std::cout << "\nSweep '" << config.name << "': " << cells.size() << " cells, " << finished << " done, "
+              << cells.size() - finished << " to run (" << config.numEvents << " events, " << config.iterations
+              << " iterations each), results in " << resultsFile << std::endl;
+    if (!planOnly) std::filesystem::create_directories(config.outputDir);
+
+    // Every cell sets the writer configuration, restored once the sweep is done
+    const GeneratorMode savedGenerator = getGeneratorMode();
+    const EventSizeConfig savedSizes = getEventSizeConfig();
+    const WriteOptionOverrides savedOverrides = getWriteOptionOverrides();
+
+    const int col0 = 8, col1 = 28, col2 = 12;
+    std::string group;
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        const auto& cell = cells[i];
+        if (groupLabel(cell) != group) {
+            group = groupLabel(cell);
+            std::cout << "\n" << group << std::endl;
+            std::cout << std::left
+                      << std::setw(col0) << "Cell"
+                      << std::setw(col1) << "Layout"
+                      << std::setw(col2) << "Threads"
+                      << std::setw(col2) << "Time (s)"
+                      << std::setw(col2) << "Min (s)"
+                      << std::setw(col2) << "ev/s"
+                      << std::setw(col2) << "File MB" << std::endl;
+            std::cout << std::string(col0 + col1 + 5 * col2, '-') << std::endl;
+        }
+        std::cout << std::left << std::setw(col0) << i + 1 << std::setw(col1) << cell.layout << std::setw(col2)
+                  << cell.threads;
+        if (done.count(cell.key()) > 0) {
+            std::cout << "done" << std::endl;
+            continue;
+        }
+        if (planOnly) {
+            std::cout << "pending" << std::endl;
+            continue;
+        }
+        std::cout << std::flush;
+
+        SweepCellResult result;
+        try {
+            setGeneratorMode(parseGeneratorMode(cell.generator));
+            setEventSizeConfig(parseEventSizeSpec(cell.eventSizes));
+            WriteOptionOverrides overrides;
+            overrides.compression = cell.compressionSetting;
+            overrides.clusterBytes = static_cast<std::uint64_t>(cell.clusterMB * 1024 * 1024);
+            overrides.pageBytes = static_cast<std::uint64_t>(cell.pageKB * 1024);
+            setWriteOptionOverrides(overrides);
+
+            const std::string file = config.outputDir + "/" + cell.layout + ".root";
+            const auto& shape = cell.shape;
+            result.minTime = -1.0;
+            for (int it = 0; it < config.iterations; ++it) {
+                TStopwatch sw; sw.Start();
+                writeLayout(cell.layout, cell.numEvents, shape.numSpills, shape.hitsPerEvent, shape.wiresPerEvent,
+                            shape.roisPerWire, file, cell.threads);
+                sw.Stop();
+                result.time += sw.RealTime() / config.iterations;
+                result.minTime = result.minTime < 0.0 ? sw.RealTime() : std::min(result.minTime, sw.RealTime());
+            }
+            result.fileMB = std::filesystem::file_size(file) / (1024.0 * 1024.0);
+            result.ok = true;
+            std::cout << std::setw(col2) << result.time
+                      << std::setw(col2) << result.minTime
+                      << std::setw(col2) << std::fixed << std::setprecision(0) << cell.numEvents / result.time
+                      << std::setw(col2) << std::setprecision(2) << result.fileMB << std::endl;
+            std::cout.unsetf(std::ios::fixed);
+            std::cout << std::setprecision(6);
+        } catch (const std::exception& e) {
+            result.error = e.what();
+            std::cout << "FAILED: " << e.what() << std::endl;
+        }
+        if (!appendSweepResult(resultsFile, config, cell, result)) {
+            std::cerr << "cannot append to " << resultsFile << std::endl;
+        }
+    }
+
+    setGeneratorMode(savedGenerator);
+    setEventSizeConfig(savedSizes);
+    setWriteOptionOverrides(savedOverrides);
+}
@@ -0,0 +1,468 @@
+#include "TTreeBaseline.hpp"
+#include "Affinity.hpp"
+#include "ClusterTargeting.hpp"
+#include "EventSizes.hpp"
+#include "HitWireGenerators.hpp"
+#include "HitWireWriterHelpers.hpp"
+#include "ProgressiveTablePrinter.hpp"
+#include "Utils.hpp"
+#include <ROOT/TBufferMerger.hxx>
+#include <TFile.h>
+#include <TKey.h>
+#include <TROOT.h>
+#include <TStopwatch.h>
+#include <TTree.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+// Trees of one fill thread. Each tree flushes a cluster once about clusterBytes are compressed,
+// and every such cluster goes to the merger right away, so a thread never holds more than one.
+class WorkerTrees {
+public:
+    WorkerTrees(ROOT::TBufferMerger& merger, Long64_t clusterBytes)
+        : file_(merger.GetFile()), clusterBytes_(clusterBytes) {}
+
+    TTree* makeTree(const char* name) {
+        file_->cd();
+        auto* tree = new TTree(name, name); // owned by the file
+        tree->SetAutoFlush(-clusterBytes_);
+        return tree;
+    }
+
+    void fill(TTree* tree) {
+        tree->Fill();
+        if (tree->GetZipBytes() >= clusterBytes_) file_->Write();
+    }
+
+    void close() { file_->Write(); }
+
+private:
+    std::shared_ptr<ROOT::TBufferMergerFile> file_;
+    Long64_t clusterBytes_;
+};
+
+// Splits items like the RNTuple writers and runs work(out, first, last) on every thread
+double runTreeWriter(const std::string& fileName, int items, int nThreads, std::uint64_t expectedBytes,
+                     const std::function<void(WorkerTrees&, int, int)>& work) {
+    const auto options = makeWriteOptions(expectedBytes);
+    const auto clusterBytes = static_cast<Long64_t>(
+        std::min<std::uint64_t>(options.GetApproxZippedClusterSize(), options.GetMaxUnzippedClusterSize()));
+    ROOT::EnableThreadSafety(); // trees are filled and read from several threads
+    TStopwatch sw; sw.Start();
+    {
+        ROOT::TBufferMerger merger(fileName.c_str(), "RECREATE", static_cast<Int_t>(options.GetCompression()));
+        const int chunk = items / nThreads;
+        std::vector<std::future<void>> futures;
+        for (int th = 0; th < nThreads; ++th) {
+            const int first = th * chunk;
+            const int last = (th == nThreads - 1) ? items : first + chunk;
+            if (first >= last) continue;
+            futures.push_back(std::async(std::launch::async, [&, first, last, th]() {
+                Affinity::pinCurrentThread(th);
+                WorkerTrees out(merger, clusterBytes);
+                work(out, first, last);
+                out.close();
+            }));
+        }
+        for (auto& f : futures) f.get();
+    } // the merger writes the last buffers on destruction
+    sw.Stop();
+    return sw.RealTime();
+}
+
+// Conversions from the deterministic AOS individuals into the branch types
+void append(std::vector<HitIndividual>& hits, const HitIndividual& h) { hits.push_back(h); }
+void append(std::vector<WireIndividual>& wires, const WireIndividual& w) { wires.push_back(w); }
+
+void append(SOAHitVector& hits, const HitIndividual& h) {
+    hits.EventIDs.push_back(h.EventID);
+    hits.fChannel.push_back(h.fChannel);
+    hits.fView.push_back(h.fView);
+    hits.fStartTick.push_back(h.fStartTick);
+    hits.fEndTick.push_back(h.fEndTick);
+    hits.fPeakTime.push_back(h.fPeakTime);
+    hits.fSigmaPeakTime.push_back(h.fSigmaPeakTime);
+    hits.fRMS.push_back(h.fRMS);
+    hits.fPeakAmplitude.push_back(h.fPeakAmplitude);
+    hits.fSigmaPeakAmplitude.push_back(h.fSigmaPeakAmplitude);
+    hits.fROISummedADC.push_back(h.fROISummedADC);
+    hits.fHitSummedADC.push_back(h.fHitSummedADC);
+    hits.fIntegral.push_back(h.fIntegral);
+    hits.fSigmaIntegral.push_back(h.fSigmaIntegral);
+    hits.fMultiplicity.push_back(h.fMultiplicity);
+    hits.fLocalIndex.push_back(h.fLocalIndex);
+    hits.fGoodnessOfFit.push_back(h.fGoodnessOfFit);
+    hits.fNDF.push_back(h.fNDF);
+    hits.fSignalType.push_back(h.fSignalType);
+    hits.fWireID_Cryostat.push_back(h.fWireID_Cryostat);
+    hits.fWireID_TPC.push_back(h.fWireID_TPC);
+    hits.fWireID_Plane.push_back(h.fWireID_Plane);
+    hits.fWireID_Wire.push_back(h.fWireID_Wire);
+}
+
+void append(SOAWireVector& wires, const WireIndividual& w) {
+    wires.EventIDs.push_back(w.EventID);
+    wires.fWire_Channel.push_back(w.fWire_Channel);
+    wires.fWire_View.push_back(w.fWire_View);
+    auto& rois = wires.fSignalROI.emplace_back(w.getSignalROI().size());
+    for (std::size_t r = 0; r < rois.size(); ++r) rois[r].data = w.getSignalROI()[r].data;
+}
+
+void convert(const HitIndividual& h, HitIndividual& out) { out = h; }
+void convert(const WireIndividual& w, WireIndividual& out) { out = w; }
+void convert(const WireIndividual& w, WireBase& out) { out = extractWireBase(w); }
+
+void convert(const HitIndividual& h, SOAHit& out) {
+    out.EventID = h.EventID;
+    out.fChannel = h.fChannel;
+    out.fView = h.fView;
+    out.fStartTick = h.fStartTick;
+    out.fEndTick = h.fEndTick;
+    out.fPeakTime = h.fPeakTime;
+    out.fSigmaPeakTime = h.fSigmaPeakTime;
+    out.fRMS = h.fRMS;
+    out.fPeakAmplitude = h.fPeakAmplitude;
+    out.fSigmaPeakAmplitude = h.fSigmaPeakAmplitude;
+    out.fROISummedADC = h.fROISummedADC;
+    out.fHitSummedADC = h.fHitSummedADC;
+    out.fIntegral = h.fIntegral;
+    out.fSigmaIntegral = h.fSigmaIntegral;
+    out.fMultiplicity = h.fMultiplicity;
+    out.fLocalIndex = h.fLocalIndex;
+    out.fGoodnessOfFit = h.fGoodnessOfFit;
+    out.fNDF = h.fNDF;
+    out.fSignalType = h.fSignalType;
+    out.fWireID_Cryostat = h.fWireID_Cryostat;
+    out.fWireID_TPC = h.fWireID_TPC;
+    out.fWireID_Plane = h.fWireID_Plane;
+    out.fWireID_Wire = h.fWireID_Wire;
+}
+
+void convert(const WireIndividual& w, SOAWire& out) {
+    out.EventID = w.EventID;
+    out.fWire_Channel = w.fWire_Channel;
+    out.fWire_View = w.fWire_View;
+    out.fSignalROI.resize(w.getSignalROI().size());
+    for (std::size_t r = 0; r < out.fSignalROI.size(); ++r) out.fSignalROI[r].data = w.getSignalROI()[r].data;
+}
+
+void convert(const WireIndividual& w, SOAWireBase& out) {
+    out.EventID = w.EventID;
+    out.fWire_Channel = w.fWire_Channel;
+    out.fWire_View = w.fWire_View;
+}
+
+// Hit h of event evt as the RNTuple topObject and element writers store it: the seed of the
+// per-event layouts, but an ID unique within the file, evt * idStride + h
+HitIndividual elementHit(int evt, int h, int idStride) {
+    std::mt19937 rng(Utils::make_seed(Utils::kBaseSeed, static_cast<std::uint64_t>('H'), static_cast<std::uint64_t>(evt),
+                                      static_cast<std::uint64_t>(h)));
+    return generateRandomHitIndividual(static_cast<long long>(evt) * idStride + h, rng);
+}
+
+// Branch types of the AOS and SOA trees
+struct AOSTypes {
+    using Hits = std::vector<HitIndividual>;
+    using Wires = std::vector<WireIndividual>;
+    using Hit = HitIndividual;
+    using Wire = WireIndividual;
+    using WireHeader = WireBase;
+    using ROI = FlatROI;
+};
+
+struct SOATypes {
+    using Hits = SOAHitVector;
+    using Wires = SOAWireVector;
+    using Hit = SOAHit;
+    using Wire = SOAWire;
+    using WireHeader = SOAWireBase;
+    using ROI = FlatSOAROI;
+};
+
+// One entry per event (numSpills == 1) or per spill, each spill an equal share of its event
+template <typename Types>
+double writeEventTrees(const char* treeName, int numEvents, int numSpills, int hitsPerEvent, int wiresPerEvent,
+                       int roisPerWire, const std::string& fileName, int nThreads) {
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
+    return runTreeWriter(fileName, numEvents * numSpills, nThreads, numEvents * bytes.all(),
+                         [&](WorkerTrees& out, int first, int last) {
+        typename Types::Hits hits;
+        typename Types::Wires wires;
+        TTree* tree = out.makeTree(treeName);
+        tree->Branch("hits", &hits, 32000, 99);
+        tree->Branch("wires", &wires, 32000, 99);
+        for (int idx = first; idx < last; ++idx) {
+            const int evt = idx / numSpills;
+            const int spill = idx % numSpills;
+            const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
+            const int spillHits = size.hits / numSpills;
+            const int spillWires = size.wires / numSpills;
+            hits = {};
+            wires = {};
+            for (const auto& h : generateEventHitsDeterministicRange(evt, spill * spillHits, spillHits)) append(hits, h);
+            for (const auto& w : generateEventWiresDeterministicRange(evt, spill * spillWires, spillWires, size.roisPerWire)) {
+                append(wires, w);
+            }
+            out.fill(tree);
+        }
+    });
+}
+
+// One entry per hit and per wire with its ROIs
+template <typename Types>
+double writeTopObjectTrees(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire,
+                           const std::string& fileName, int nThreads) {
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
+    const int hitIdStride = maxEventSize(hitsPerEvent, wiresPerEvent, roisPerWire).hits;
+    return runTreeWriter(fileName, numEvents, nThreads, numEvents * bytes.wiresWithRois(),
+                         [&](WorkerTrees& out, int first, int last) {
+        typename Types::Hit hit;
+        typename Types::Wire wire;
+        TTree* hitsTree = out.makeTree("hits");
+        hitsTree->Branch("hit", &hit, 32000, 99);
+        TTree* wiresTree = out.makeTree("wires");
+        wiresTree->Branch("wire", &wire, 32000, 99);
+        for (int evt = first; evt < last; ++evt) {
+            const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
+            for (int h = 0; h < size.hits; ++h) {
+                convert(elementHit(evt, h, hitIdStride), hit);
+                out.fill(hitsTree);
+            }
+            for (const auto& w : generateEventWiresDeterministic(evt, size.wires, size.roisPerWire)) {
+                convert(w, wire);
+                out.fill(wiresTree);
+            }
+        }
+    });
+}
+
+// One entry per hit, per wire header and per ROI
+template <typename Types>
+double writeElementTrees(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire,
+                         const std::string& fileName, int nThreads) {
+    const auto bytes = estimateEventBytes(hitsPerEvent, wiresPerEvent, roisPerWire);
+    const int hitIdStride = maxEventSize(hitsPerEvent, wiresPerEvent, roisPerWire).hits;
+    return runTreeWriter(fileName, numEvents, nThreads, numEvents * bytes.rois,
+                         [&](WorkerTrees& out, int first, int last) {
+        typename Types::Hit hit;
+        typename Types::WireHeader wire;
+        typename Types::ROI roi;
+        TTree* hitsTree = out.makeTree("hits");
+        hitsTree->Branch("hit", &hit, 32000, 99);
+        TTree* wiresTree = out.makeTree("wires");
+        wiresTree->Branch("wire", &wire, 32000, 99);
+        TTree* roisTree = out.makeTree("rois");
+        roisTree->Branch("roi", &roi, 32000, 99);
+        for (int evt = first; evt < last; ++evt) {
+            const EventSize size = eventSize(evt, hitsPerEvent, wiresPerEvent, roisPerWire);
+            for (int h = 0; h < size.hits; ++h) {
+                convert(elementHit(evt, h, hitIdStride), hit);
+                out.fill(hitsTree);
+            }
+            for (const auto& w : generateEventWiresDeterministic(evt, size.wires, size.roisPerWire)) {
+                convert(w, wire);
+                out.fill(wiresTree);
+                for (const auto& r : w.getSignalROI()) {
+                    roi.EventID = static_cast<unsigned int>(w.EventID);
+                    roi.WireID = w.fWire_Channel;
+                    roi.offset = r.offset;
+                    roi.data = r.data;
+                    out.fill(roisTree);
+                }
+            }
+        }
+    });
+}
+
+// Contiguous runs of whole clusters, about equal in entries, one per thread
+std::vector<std::pair<Long64_t, Long64_t>> splitByClusters(TTree& tree, int nThreads) {
+    const Long64_t entries = tree.GetEntries();
+    std::vector<Long64_t> starts;
+    auto it = tree.GetClusterIterator(0);
+    for (Long64_t start = it(); start < entries; start = it()) starts.push_back(start);
+    starts.push_back(entries);
+    std::vector<std::pair<Long64_t, Long64_t>> ranges;
+    const std::size_t clusters = starts.size() - 1;
+    const std::size_t parts = std::min<std::size_t>(std::max(1, nThreads), clusters);
+    for (std::size_t p = 0; p < parts; ++p) {
+        ranges.emplace_back(starts[p * clusters / parts], starts[(p + 1) * clusters / parts]);
+    }
+    return ranges;
+}
+
+void readTreeRange(const std::string& fileName, const std::string& treeName, Long64_t first, Long64_t last) {
+    Affinity::pinCurrentThreadToNextSlot();
+    std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+    if (!file || file->IsZombie()) throw std::runtime_error("cannot open " + fileName);
+    auto* tree = file->Get<TTree>(treeName.c_str());
+    if (!tree) throw std::runtime_error("no tree " + treeName + " in " + fileName);
+    tree->SetCacheEntryRange(first, last);
+    // Without addresses every branch reads into objects it allocates itself
+    for (Long64_t i = first; i < last; ++i) tree->GetEntry(i);
+}
+
+WriterResult summarizeWriter(const std::string& label, const std::vector<double>& times) {
+    WriterResult result = {label, 0.0, 0.0, times, false, ""};
+    result.avg = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+    if (times.size() > 1) {
+        double sq_sum = std::inner_product(times.begin(), times.end(), times.begin(), 0.0);
+        result.stddev = std::sqrt(std::max(0.0, (sq_sum - times.size() * result.avg * result.avg) / (times.size() - 1)));
+    }
+    return result;
+}
+
+const std::vector<std::string> kGranularities = {"event", "spill", "topObject", "element"};
+
+} // namespace
+
+double AOS_event_TTree(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
+    return writeEventTrees<AOSTypes>("events", numEvents, 1, hitsPerEvent, wiresPerEvent, roisPerWire, fileName, nThreads);
+}
+
+double AOS_spill_TTree(int numEvents, int numSpills, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
+    return writeEventTrees<AOSTypes>("spills", numEvents, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire, fileName, nThreads);
+}
+
+double AOS_topObject_TTree(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
+    return writeTopObjectTrees<AOSTypes>(numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, fileName, nThreads);
+}
+
+double AOS_element_TTree(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
+    return writeElementTrees<AOSTypes>(numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, fileName, nThreads);
+}
+
+double SOA_event_TTree(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
+    return writeEventTrees<SOATypes>("events", numEvents, 1, hitsPerEvent, wiresPerEvent, roisPerWire, fileName, nThreads);
+}
+
+double SOA_spill_TTree(int numEvents, int numSpills, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
+    return writeEventTrees<SOATypes>("spills", numEvents, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire, fileName, nThreads);
+}
+
+double SOA_topObject_TTree(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
+    return writeTopObjectTrees<SOATypes>(numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, fileName, nThreads);
+}
+
+double SOA_element_TTree(int numEvents, int hitsPerEvent, int wiresPerEvent, int roisPerWire, const std::string& fileName, int nThreads) {
+    return writeElementTrees<SOATypes>(numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, fileName, nThreads);
+}
+
+double readTTreeFile(const std::string& fileName, int nThreads) {
+    ROOT::EnableThreadSafety();
+    TStopwatch sw; sw.Start();
+    std::vector<std::string> treeNames;
+    {
+        std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+        if (!file || file->IsZombie()) throw std::runtime_error("cannot open " + fileName);
+        for (auto* key : TRangeDynCast<TKey>(file->GetListOfKeys())) {
+            if (key && std::string(key->GetClassName()) == "TTree") treeNames.push_back(key->GetName());
+        }
+        if (treeNames.empty()) throw std::runtime_error("no trees in " + fileName);
+        for (const auto& name : treeNames) {
+            auto ranges = splitByClusters(*file->Get<TTree>(name.c_str()), nThreads);
+            std::vector<std::future<void>> futures;
+            for (const auto& [first, last] : ranges) {
+                futures.push_back(std::async(std::launch::async, readTreeRange, fileName, name, first, last));
+            }
+            for (auto& f : futures) f.get();
+        }
+    }
+    sw.Stop();
+    return sw.RealTime();
+}
+
+std::vector<std::string> ttreeFiles(bool soa, const std::string& outputDir) {
+    std::vector<std::string> files;
+    for (const auto& g : kGranularities) files.push_back(outputDir + (soa ? "/soa_TTree_" : "/aos_TTree_") + g + ".root");
+    return files;
+}
+
+std::vector<WriterResult> outTTree(bool soa, int nThreads, int iter, int numEvents, int hitsPerEvent, int wiresPerEvent,
+                                   int roisPerWire, int numSpills, const std::string& outputDir, int mask) {
+    std::vector<WriterResult> results;
+    ProgressiveTablePrinter<WriterResult> tablePrinter(
+        soa ? "SOA TTree Writer Benchmarks (Progressive Results)" : "AOS TTree Writer Benchmarks (Progressive Results)",
+        {"Writer", "Average (s)", "StdDev (s)", "Itr 1 (s)", "Itr 2 (s)", "Itr 3 (s)"},
+        {32, 16, 16, 12, 12, 12}
+    );
+    const std::string prefix = soa ? "SOA_TTree_" : "AOS_TTree_";
+    const auto files = ttreeFiles(soa, outputDir);
+    for (std::size_t g = 0; g < kGranularities.size(); ++g) {
+        if (mask >= 0 && (mask & (0x7 << (3 * g))) == 0) continue;
+        const std::string label = prefix + kGranularities[g];
+        WriterResult result;
+        try {
+            std::vector<double> times;
+            for (int i = 0; i < iter; ++i) {
+                double t = 0.0;
+                switch (g) {
+                    case 0: t = soa ? SOA_event_TTree(numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, files[g], nThreads)
+                                    : AOS_event_TTree(numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, files[g], nThreads); break;
+                    case 1: t = soa ? SOA_spill_TTree(numEvents, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire, files[g], nThreads)
+                                    : AOS_spill_TTree(numEvents, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire, files[g], nThreads); break;
+                    case 2: t = soa ? SOA_topObject_TTree(numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, files[g], nThreads)
+                                    : AOS_topObject_TTree(numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, files[g], nThreads); break;
+                    case 3: t = soa ? SOA_element_TTree(numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, files[g], nThreads)
+                                    : AOS_element_TTree(numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, files[g], nThreads); break;
+                }
+                times.push_back(t);
+            }
+            result = summarizeWriter(label, times);
+        } catch (const std::exception& e) {
+            std::cout << "Running " << label << "... FAILED" << std::endl;
+            result = {label, 0.0, 0.0, {}, true, e.what()};
+        }
+        results.push_back(result);
+        tablePrinter.addRow(result);
+    }
+    tablePrinter.printFooter();
+    return results;
+}
+
+std::vector<ReaderResult> inTTree(bool soa, int nThreads, int iter, const std::string& outputDir, int mask) {
+    std::vector<ReaderResult> results;
+    ProgressiveTablePrinter<ReaderResult> tablePrinter(
+        soa ? "SOA TTree Reader Benchmarks (Progressive Results)" : "AOS TTree Reader Benchmarks (Progressive Results)",
+        {"Reader", "Cold (s)", "Warm Avg (s)", "Warm StdDev (s)", "Itr 1 (s)", "Itr 2 (s)", "Itr 3 (s)"},
+        {32, 16, 16, 16, 12, 12, 12}
+    );
+    const std::string prefix = soa ? "SOA_TTree_" : "AOS_TTree_";
+    const auto files = ttreeFiles(soa, outputDir);
+    for (std::size_t g = 0; g < kGranularities.size(); ++g) {
+        if (mask >= 0 && (mask & (0x7 << (3 * g))) == 0) continue;
+        ReaderResult result = {prefix + kGranularities[g], 0.0, 0.0, 0.0, {}, {}, false, ""};
+        try {
+            // The first read is the cold one, as for the RNTuple readers
+            for (int i = 0; i < iter; ++i) {
+                Affinity::resetSlots();
+                const double t = readTTreeFile(files[g], nThreads);
+                (i == 0 ? result.coldTimes : result.warmTimes).push_back(t);
+            }
+            result.cold = result.coldTimes.empty() ? 0.0 : result.coldTimes.front();
+            const auto& warm = result.warmTimes;
+            if (!warm.empty()) {
+                result.warmAvg = std::accumulate(warm.begin(), warm.end(), 0.0) / warm.size();
+                double sq_sum = std::inner_product(warm.begin(), warm.end(), warm.begin(), 0.0);
+                double denom = static_cast<double>(warm.size() > 1 ? warm.size() - 1 : 1);
+                result.warmStddev = std::sqrt(std::max(0.0, (sq_sum - warm.size() * result.warmAvg * result.warmAvg) / denom));
+            }
+        } catch (const std::exception& e) {
+            std::cout << "Running " << result.label << "... FAILED" << std::endl;
+            result.failed = true;
+            result.errorMessage = e.what();
+        }
+        results.push_back(result);
+        tablePrinter.addRow(result);
+    }
+    tablePrinter.printFooter();
+    return results;
+}
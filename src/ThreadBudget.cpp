@@ -0,0 +1,161 @@
+#include "ThreadBudget.hpp"
+#include "HitWireWriters.hpp"
+#include "HitWireReaders.hpp"
+#include <TROOT.h>
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+namespace {
+
+bool gSplitReaderThreads = false;
+
+} // namespace
+
+ThreadBudget makeThreadBudget(int cores, int imtThreads, int fillWorkers, int readerThreads) {
+    ThreadBudget budget;
+    budget.cores = std::max(1, cores);
+    budget.legacy = imtThreads < 0 && fillWorkers <= 0 && readerThreads <= 0;
+    if (imtThreads < 0) {
+        // Legacy: every consumer assumes it owns all cores
+        budget.imtThreads = budget.cores;
+        budget.fillWorkers = fillWorkers > 0 ? fillWorkers : budget.cores;
+        budget.readerThreads = readerThreads > 0 ? readerThreads : budget.cores;
+        return budget;
+    }
+    budget.imtThreads = std::min(imtThreads, budget.cores - 1);
+    int remaining = std::max(1, budget.cores - budget.imtThreads);
+    budget.fillWorkers = fillWorkers > 0 ? fillWorkers : remaining;
+    budget.readerThreads = readerThreads > 0 ? readerThreads : remaining;
+    return budget;
+}
+
+void applyImplicitMT(int nThreads) {
+    ROOT::DisableImplicitMT();
+    if (nThreads > 0) ROOT::EnableImplicitMT(nThreads);
+}
+
+void applyThreadBudget(const ThreadBudget& budget) {
+    applyImplicitMT(budget.imtThreads);
+    gSplitReaderThreads = !budget.legacy;
+}
+
+int readerThreadsPerNtuple(int nThreads, int nNtuples) {
+    if (!gSplitReaderThreads || nNtuples <= 1) return nThreads;
+    return std::max(1, nThreads / nNtuples);
+}
+
+std::string describeThreadBudget(const ThreadBudget& budget) {
+    std::ostringstream os;
+    os << "fill=" << budget.fillWorkers << " imt=" << budget.imtThreads
+       << " reader=" << budget.readerThreads << " (cores=" << budget.cores << ")";
+    return os.str();
+}
+
+std::vector<ThreadBudget> candidateThreadBudgets(int cores) {
+    cores = std::max(1, cores);
+    std::vector<ThreadBudget> candidates = {makeThreadBudget(cores)};
+    std::vector<int> imtSizes = {0, 1, cores / 4, cores / 2, (3 * cores) / 4};
+    std::sort(imtSizes.begin(), imtSizes.end());
+    imtSizes.erase(std::unique(imtSizes.begin(), imtSizes.end()), imtSizes.end());
+    for (int imt : imtSizes) {
+        if (imt > cores - 1) continue;
+        candidates.push_back(makeThreadBudget(cores, imt));
+    }
+    return candidates;
+}
+
+namespace {
+
+// label -> (candidate index, time); keeps only the fastest successful candidate
+using BestSplits = std::map<std::string, std::pair<int, double>>;
+
+void recordBest(BestSplits& best, const std::string& label, int candidate, double time) {
+    if (time <= 0.0) return;
+    auto it = best.find(label);
+    if (it == best.end() || time < it->second.second) best[label] = {candidate, time};
+}
+
+void printBestSplits(const std::string& title, const BestSplits& best, const std::vector<ThreadBudget>& candidates,
+                     const std::map<std::string, double>& legacyTimes) {
+    if (best.empty()) return;
+    const int col1 = 32, col2 = 40, col3 = 14;
+    std::cout << "\n" << title << std::endl;
+    std::cout << std::left
+              << std::setw(col1) << "Benchmark"
+              << std::setw(col2) << "Best split"
+              << std::setw(col3) << "Time (s)"
+              << std::setw(col3) << "Legacy (s)" << std::endl;
+    std::cout << std::string(col1 + col2 + 2 * col3, '-') << std::endl;
+    for (const auto& [label, entry] : best) {
+        auto legacy = legacyTimes.find(label);
+        std::cout << std::left
+                  << std::setw(col1) << label
+                  << std::setw(col2) << describeThreadBudget(candidates[entry.first])
+                  << std::setw(col3) << entry.second;
+        if (legacy != legacyTimes.end()) {
+            std::cout << std::setw(col3) << legacy->second;
+        } else {
+            std::cout << std::setw(col3) << "-";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::string(col1 + col2 + 2 * col3, '-') << std::endl;
+}
+
+double readerTime(const ReaderResult& r) {
+    return r.warmTimes.empty() ? r.cold : r.warmAvg;
+}
+
+} // namespace
+
+void runThreadBudgetSweep(int cores, int iter, int numEvents, int hitsPerEvent, int wiresPerEvent,
+                          int roisPerWire, int numSpills, int writerMask, int readerMask,
+                          bool runAOS, bool runSOA) {
+    const std::string outputDir = "./output_budget";
+    std::filesystem::create_directories(outputDir);
+
+    auto candidates = candidateThreadBudgets(cores);
+    BestSplits bestWrite, bestRead;
+    std::map<std::string, double> legacyWrite, legacyRead;
+
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        const auto& budget = candidates[c];
+        std::cout << "\nThread budget " << (c + 1) << "/" << candidates.size() << ": "
+                  << describeThreadBudget(budget) << std::endl;
+        applyThreadBudget(budget);
+
+        std::vector<WriterResult> writes;
+        std::vector<ReaderResult> reads;
+        // Wall time: summed worker fill times would favour the splits with few fill workers
+        if (runAOS) {
+            auto w = outAOS(budget.fillWorkers, iter, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, numSpills, outputDir, writerMask, /*measureWallTime=*/true);
+            auto r = inAOS(budget.readerThreads, iter, outputDir, readerMask);
+            writes.insert(writes.end(), w.begin(), w.end());
+            reads.insert(reads.end(), r.begin(), r.end());
+        }
+        if (runSOA) {
+            auto w = outSOA(budget.fillWorkers, iter, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, numSpills, outputDir, writerMask, /*measureWallTime=*/true);
+            auto r = inSOA(budget.readerThreads, iter, outputDir, readerMask);
+            writes.insert(writes.end(), w.begin(), w.end());
+            reads.insert(reads.end(), r.begin(), r.end());
+        }
+
+        for (const auto& w : writes) {
+            if (w.failed) continue;
+            recordBest(bestWrite, w.label, static_cast<int>(c), w.avg);
+            if (c == 0) legacyWrite[w.label] = w.avg;
+        }
+        for (const auto& r : reads) {
+            if (r.failed) continue;
+            recordBest(bestRead, r.label, static_cast<int>(c), readerTime(r));
+            if (c == 0) legacyRead[r.label] = readerTime(r);
+        }
+    }
+
+    printBestSplits("Best Thread Budget per Writer", bestWrite, candidates, legacyWrite);
+    printBestSplits("Best Thread Budget per Reader (warm)", bestRead, candidates, legacyRead);
+}
@@ -3,7 +3,12 @@
 #include <vector>
 #include <utility>
 #include <cstddef>
+#include <algorithm>
 #include <ROOT/RNTupleReader.hxx>
+#include <TFile.h>
+#include <TKey.h>
+#include <TList.h>
+#include <memory>
 
 namespace Utils {
 
@@ -42,5 +47,175 @@ std::vector<std::pair<std::size_t, std::size_t>> split_range_by_clusters(ROOT::R
     return chunks;
 }
 
+std::vector<ClusterSpan> cluster_spans(ROOT::RNTupleReader& reader, ClusterWeight weight) {
+    const auto& desc = reader.GetDescriptor();
+    auto nClusters = desc.GetNClusters();
+    std::vector<ClusterSpan> spans;
+    spans.reserve(nClusters);
+    for (std::uint64_t cid = 0; cid < nClusters; ++cid) {
+        const auto& clusterDesc = desc.GetClusterDescriptor(cid);
+        ClusterSpan span;
+        span.firstEntry = clusterDesc.GetFirstEntryIndex();
+        span.nEntries = clusterDesc.GetNEntries();
+        if (weight == ClusterWeight::Entries) {
+            span.weight = span.nEntries;
+        } else {
+            for (const auto& columnRange : clusterDesc.GetColumnRangeIterable()) {
+                if (columnRange.IsSuppressed()) continue;
+                auto columnId = columnRange.GetPhysicalColumnId();
+                if (weight == ClusterWeight::CompressedBytes) {
+                    for (const auto& pageInfo : clusterDesc.GetPageRange(columnId).GetPageInfos()) {
+                        span.weight += pageInfo.GetLocator().GetNBytesOnStorage();
+                    }
+                } else {
+                    const auto& columnDesc = desc.GetColumnDescriptor(columnId);
+                    span.weight += (columnRange.GetNElements() * columnDesc.GetBitsOnStorage() + 7) / 8;
+                }
+            }
+        }
+        spans.push_back(span);
+    }
+    return spans;
+}
+
+std::uint64_t total_weight(ROOT::RNTupleReader& reader, ClusterWeight weight) {
+    std::uint64_t total = 0;
+    for (const auto& span : cluster_spans(reader, weight)) total += span.weight;
+    return total;
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> split_weighted_clusters(const std::vector<ClusterSpan>& clustersIn, int nChunks, bool allowSubCluster) {
+    std::vector<std::pair<std::size_t, std::size_t>> chunks;
+    if (nChunks <= 0) return chunks;
+
+    // Empty clusters carry no entries; without any weight information fall back to entry counts
+    std::vector<ClusterSpan> clusters;
+    bool anyWeight = false;
+    for (const auto& c : clustersIn) {
+        if (c.nEntries == 0) continue;
+        clusters.push_back(c);
+        anyWeight = anyWeight || c.weight > 0;
+    }
+    if (clusters.empty()) return chunks;
+    if (!anyWeight) {
+        for (auto& c : clusters) c.weight = c.nEntries;
+    }
+    const std::size_t n = clusters.size();
+    const std::size_t wanted = static_cast<std::size_t>(nChunks);
+
+    if (allowSubCluster && n < wanted) {
+        // Hand out the extra pieces one by one to the cluster with the heaviest piece
+        std::vector<std::size_t> pieces(n, 1);
+        for (std::size_t extra = wanted - n; extra > 0; --extra) {
+            std::size_t best = n;
+            double bestLoad = -1.0;
+            for (std::size_t i = 0; i < n; ++i) {
+                if (pieces[i] >= clusters[i].nEntries) continue;
+                double load = static_cast<double>(clusters[i].weight) / pieces[i];
+                if (load > bestLoad) {
+                    bestLoad = load;
+                    best = i;
+                }
+            }
+            if (best == n) break; // every cluster is already split into single entries
+            ++pieces[best];
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            std::size_t base = clusters[i].nEntries / pieces[i];
+            std::size_t rem = clusters[i].nEntries % pieces[i];
+            std::size_t start = clusters[i].firstEntry;
+            for (std::size_t p = 0; p < pieces[i]; ++p) {
+                std::size_t len = base + (p < rem ? 1 : 0);
+                chunks.emplace_back(start, start + len);
+                start += len;
+            }
+        }
+        return chunks;
+    }
+
+    // Number of chunks greedy packing of clusters[from..] needs with the given capacity
+    auto chunksNeeded = [&](std::size_t from, std::uint64_t cap) {
+        std::size_t count = 0;
+        std::uint64_t cur = 0;
+        for (std::size_t i = from; i < n; ++i) {
+            if (count == 0 || cur + clusters[i].weight > cap) {
+                ++count;
+                cur = clusters[i].weight;
+            } else {
+                cur += clusters[i].weight;
+            }
+        }
+        return count;
+    };
+
+    // Smallest capacity (max chunk weight) that still fits into nChunks contiguous chunks
+    std::uint64_t total = 0, lo = 0;
+    for (const auto& c : clusters) {
+        lo = std::max(lo, c.weight);
+        total += c.weight;
+    }
+    std::uint64_t hi = total;
+    while (lo < hi) {
+        std::uint64_t mid = lo + (hi - lo) / 2;
+        if (chunksNeeded(0, mid) <= wanted) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    const std::uint64_t cap = lo;
+
+    // Fill chunks towards an even share of the remaining weight without exceeding cap and
+    // without leaving more clusters than the remaining chunks can hold
+    std::uint64_t remaining = total;
+    std::size_t i = 0;
+    for (std::size_t left = wanted; left > 0 && i < n; --left) {
+        double target = static_cast<double>(remaining) / left;
+        std::size_t first = i;
+        std::uint64_t cur = 0;
+        while (i < n) {
+            std::uint64_t w = clusters[i].weight;
+            if (cur > 0) {
+                if (cur + w > cap) break;
+                if (cur + w / 2.0 > target && chunksNeeded(i, cap) <= left - 1) break;
+            }
+            cur += w;
+            ++i;
+        }
+        remaining -= cur;
+        const auto& last = clusters[i - 1];
+        chunks.emplace_back(clusters[first].firstEntry, last.firstEntry + last.nEntries);
+    }
+    return chunks;
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> split_range_by_bytes(ROOT::RNTupleReader& reader, int nChunks,
+                                                                      ClusterWeight weight, bool allowSubCluster) {
+    if (nChunks <= 0) return {};
+    return split_weighted_clusters(cluster_spans(reader, weight), nChunks, allowSubCluster);
+}
+
+std::vector<std::string> list_ntuples(const std::string& fileName) {
+    std::vector<std::string> names;
+    std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+    if (!file || file->IsZombie()) return names;
+    TIter next(file->GetListOfKeys());
+    while (auto* key = static_cast<TKey*>(next())) {
+        if (std::string(key->GetClassName()).find("RNTuple") != std::string::npos) {
+            names.emplace_back(key->GetName());
+        }
+    }
+    return names;
+}
+
+std::string find_record_subfield(ROOT::RNTupleReader& reader, const std::string& name) {
+    const auto& desc = reader.GetDescriptor();
+    for (const auto& field : desc.GetFieldIterable(desc.GetFieldZeroId())) {
+        if (desc.FindFieldId(name, field.GetId()) != ROOT::kInvalidDescriptorId) {
+            return field.GetFieldName() + "." + name;
+        }
+    }
+    return "";
+}
 
 } // namespace Utils 
\ No newline at end of file
@@ -0,0 +1,309 @@
+#include "ZoneMap.hpp"
+#include "Utils.hpp"
+#include "EventIndex.hpp"
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleWriter.hxx>
+#include <TFile.h>
+#include <TStopwatch.h>
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+bool gEmitZoneMaps = false;
+const std::string kZoneMapSuffix = "_zoneMap";
+
+// Calls fn with a typed view of a numeric field
+template <typename Fn>
+void visitNumericView(ROOT::RNTupleReader& reader, const std::string& field, Fn&& fn) {
+    const auto& desc = reader.GetDescriptor();
+    const std::string type = desc.GetFieldDescriptor(desc.FindFieldId(field)).GetTypeName();
+    if (type == "std::int64_t") {
+        fn(reader.GetView<std::int64_t>(field));
+    } else if (type == "std::uint64_t") {
+        fn(reader.GetView<std::uint64_t>(field));
+    } else if (type == "std::int32_t") {
+        fn(reader.GetView<std::int32_t>(field));
+    } else if (type == "std::uint32_t") {
+        fn(reader.GetView<std::uint32_t>(field));
+    } else if (type == "std::int16_t") {
+        fn(reader.GetView<std::int16_t>(field));
+    } else if (type == "std::uint16_t") {
+        fn(reader.GetView<std::uint16_t>(field));
+    } else if (type == "float") {
+        fn(reader.GetView<float>(field));
+    } else if (type == "double") {
+        fn(reader.GetView<double>(field));
+    } else {
+        throw std::runtime_error("unsupported zone map field type '" + type + "' for " + field);
+    }
+}
+
+std::string leafName(const std::string& path) {
+    auto dot = path.rfind('.');
+    return dot == std::string::npos ? path : path.substr(dot + 1);
+}
+
+// Reads the predicate column over the given entry ranges and loads every matching entry
+std::uint64_t readMatching(ROOT::RNTupleReader& reader, const std::string& field, const RangePredicate& predicate,
+                           const std::vector<std::pair<std::uint64_t, std::uint64_t>>& ranges) {
+    std::uint64_t matches = 0;
+    visitNumericView(reader, field, [&](auto&& view) {
+        for (const auto& [first, last] : ranges) {
+            for (auto i = first; i < last; ++i) {
+                if (predicate.matches(static_cast<double>(view(i)))) {
+                    reader.LoadEntry(i);
+                    ++matches;
+                }
+            }
+        }
+    });
+    return matches;
+}
+
+// Best of two runs, each on a fresh reader so no pages are shared between the two modes
+double timeMatching(const std::string& fileName, const std::string& ntupleName, const std::string& field,
+                    const RangePredicate& predicate, const std::vector<std::pair<std::uint64_t, std::uint64_t>>& ranges,
+                    std::uint64_t& matches) {
+    double best = -1.0;
+    for (int run = 0; run < 2; ++run) {
+        auto reader = ROOT::RNTupleReader::Open(ntupleName, fileName);
+        TStopwatch sw; sw.Start();
+        matches = readMatching(*reader, field, predicate, ranges);
+        sw.Stop();
+        if (best < 0.0 || sw.RealTime() < best) best = sw.RealTime();
+    }
+    return best;
+}
+
+} // namespace
+
+int ZoneMap::fieldIndex(const std::string& name) const {
+    for (std::size_t f = 0; f < fields.size(); ++f) {
+        if (fields[f] == name || leafName(fields[f]) == name) return static_cast<int>(f);
+    }
+    return -1;
+}
+
+std::vector<RangePredicate> parseRangePredicates(const std::string& spec) {
+    std::vector<RangePredicate> predicates;
+    std::stringstream ss(spec);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        std::stringstream parts(item);
+        std::string field, lo, hi;
+        if (!std::getline(parts, field, ':') || !std::getline(parts, lo, ':') || !std::getline(parts, hi, ':')) continue;
+        try {
+            RangePredicate p;
+            p.field = field;
+            p.lo = std::stod(lo);
+            p.hi = std::stod(hi);
+            if (!field.empty() && p.lo <= p.hi) predicates.push_back(p);
+        } catch (const std::exception&) {
+        }
+    }
+    return predicates;
+}
+
+const std::vector<std::string>& defaultZoneMapFields() {
+    static const std::vector<std::string> fields = {"EventID", "fChannel", "fPeakAmplitude", "fWire_Channel"};
+    return fields;
+}
+
+void setEmitZoneMaps(bool enabled) {
+    gEmitZoneMaps = enabled;
+}
+
+bool getEmitZoneMaps() {
+    return gEmitZoneMaps;
+}
+
+std::string zoneMapName(const std::string& ntupleName) {
+    return ntupleName + kZoneMapSuffix;
+}
+
+bool isZoneMapName(const std::string& ntupleName) {
+    return ntupleName.size() > kZoneMapSuffix.size() &&
+           ntupleName.compare(ntupleName.size() - kZoneMapSuffix.size(), kZoneMapSuffix.size(), kZoneMapSuffix) == 0;
+}
+
+std::vector<std::string> listDataNtuples(const std::string& fileName) {
+    std::vector<std::string> names;
+    for (const auto& name : Utils::list_ntuples(fileName)) {
+        if (!isEventIndexName(name) && !isZoneMapName(name)) names.push_back(name);
+    }
+    return names;
+}
+
+ZoneMap buildZoneMap(ROOT::RNTupleReader& reader, const std::vector<std::string>& leafNames) {
+    ZoneMap zoneMap;
+    for (const auto& name : leafNames) {
+        std::string path = Utils::find_record_subfield(reader, name);
+        if (!path.empty()) zoneMap.fields.push_back(path);
+    }
+    for (const auto& span : Utils::cluster_spans(reader, Utils::ClusterWeight::Entries)) {
+        zoneMap.clusters.emplace_back(span.firstEntry, span.firstEntry + span.nEntries);
+    }
+    zoneMap.stats.assign(zoneMap.clusters.size(), std::vector<ZoneStats>(zoneMap.fields.size()));
+
+    for (std::size_t f = 0; f < zoneMap.fields.size(); ++f) {
+        visitNumericView(reader, zoneMap.fields[f], [&](auto&& view) {
+            for (std::size_t c = 0; c < zoneMap.clusters.size(); ++c) {
+                auto& stats = zoneMap.stats[c][f];
+                for (auto i = zoneMap.clusters[c].first; i < zoneMap.clusters[c].second; ++i) {
+                    stats.add(static_cast<double>(view(i)));
+                }
+            }
+        });
+    }
+    return zoneMap;
+}
+
+int writeZoneMaps(const std::string& fileName, const std::vector<std::string>& leafNames) {
+    // Scan everything first; the file is reopened for update only once the readers are gone
+    auto names = Utils::list_ntuples(fileName);
+    std::map<std::string, ZoneMap> zoneMaps;
+    for (const auto& name : names) {
+        if (isZoneMapName(name) || isEventIndexName(name)) continue;
+        if (std::find(names.begin(), names.end(), zoneMapName(name)) != names.end()) continue;
+        auto reader = ROOT::RNTupleReader::Open(name, fileName);
+        auto zoneMap = buildZoneMap(*reader, leafNames);
+        if (!zoneMap.fields.empty()) zoneMaps[name] = std::move(zoneMap);
+    }
+    if (zoneMaps.empty()) return 0;
+
+    std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "UPDATE"));
+    if (!file || file->IsZombie()) throw std::runtime_error("cannot update " + fileName);
+    for (const auto& [name, zoneMap] : zoneMaps) {
+        auto model = ROOT::RNTupleModel::Create();
+        auto firstEntry = model->MakeField<std::uint64_t>("firstEntry");
+        auto nEntries = model->MakeField<std::uint64_t>("nEntries");
+        auto field = model->MakeField<std::string>("field");
+        auto min = model->MakeField<double>("min");
+        auto max = model->MakeField<double>("max");
+        auto count = model->MakeField<std::uint64_t>("count");
+        auto writer = ROOT::RNTupleWriter::Append(std::move(model), zoneMapName(name), *file);
+        for (std::size_t c = 0; c < zoneMap.clusters.size(); ++c) {
+            for (std::size_t f = 0; f < zoneMap.fields.size(); ++f) {
+                *firstEntry = zoneMap.clusters[c].first;
+                *nEntries = zoneMap.clusters[c].second - zoneMap.clusters[c].first;
+                *field = zoneMap.fields[f];
+                *min = zoneMap.stats[c][f].min;
+                *max = zoneMap.stats[c][f].max;
+                *count = zoneMap.stats[c][f].count;
+                writer->Fill();
+            }
+        }
+    }
+    return static_cast<int>(zoneMaps.size());
+}
+
+ZoneMap loadZoneMap(const std::string& fileName, const std::string& ntupleName) {
+    auto reader = ROOT::RNTupleReader::Open(zoneMapName(ntupleName), fileName);
+    auto firstEntry = reader->GetView<std::uint64_t>("firstEntry");
+    auto nEntries = reader->GetView<std::uint64_t>("nEntries");
+    auto field = reader->GetView<std::string>("field");
+    auto min = reader->GetView<double>("min");
+    auto max = reader->GetView<double>("max");
+    auto count = reader->GetView<std::uint64_t>("count");
+
+    ZoneMap zoneMap;
+    std::map<std::uint64_t, std::size_t> clusterByFirst;
+    for (auto i : reader->GetEntryRange()) {
+        int f = zoneMap.fieldIndex(field(i));
+        if (f < 0) {
+            zoneMap.fields.push_back(field(i));
+            for (auto& row : zoneMap.stats) row.emplace_back();
+            f = static_cast<int>(zoneMap.fields.size()) - 1;
+        }
+        auto [it, inserted] = clusterByFirst.try_emplace(firstEntry(i), zoneMap.clusters.size());
+        if (inserted) {
+            zoneMap.clusters.emplace_back(firstEntry(i), firstEntry(i) + nEntries(i));
+            zoneMap.stats.emplace_back(zoneMap.fields.size());
+        }
+        auto& stats = zoneMap.stats[it->second][f];
+        stats.min = min(i);
+        stats.max = max(i);
+        stats.count = count(i);
+    }
+    return zoneMap;
+}
+
+std::vector<std::pair<std::uint64_t, std::uint64_t>> selectClusters(const ZoneMap& zoneMap, const RangePredicate& predicate) {
+    int f = zoneMap.fieldIndex(predicate.field);
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> selected;
+    for (std::size_t c = 0; c < zoneMap.clusters.size(); ++c) {
+        if (f >= 0 && !predicate.mayMatch(zoneMap.stats[c][f])) continue;
+        // Adjacent kept clusters form one range
+        if (!selected.empty() && selected.back().second == zoneMap.clusters[c].first) {
+            selected.back().second = zoneMap.clusters[c].second;
+        } else {
+            selected.push_back(zoneMap.clusters[c]);
+        }
+    }
+    return selected;
+}
+
+void benchmarkFilteredRead(const std::vector<std::string>& files, const std::vector<RangePredicate>& predicates) {
+    const int col1 = 32, col2 = 30, col3 = 12;
+    std::cout << "\nZone Map Filtered Read (best of 2 runs)" << std::endl;
+    std::cout << std::left
+              << std::setw(col1) << "Ntuple"
+              << std::setw(col2) << "Predicate"
+              << std::setw(col3) << "Clusters"
+              << std::setw(col3) << "Skipped"
+              << std::setw(col3) << "Matches"
+              << std::setw(col3) << "Full (s)"
+              << std::setw(col3) << "Pruned (s)"
+              << std::setw(col3) << "Speedup" << std::endl;
+    std::cout << std::string(col1 + col2 + 6 * col3, '-') << std::endl;
+
+    for (const auto& fileName : files) {
+        if (!std::filesystem::exists(fileName)) continue;
+        const std::string stem = std::filesystem::path(fileName).stem().string();
+        auto names = Utils::list_ntuples(fileName);
+        for (const auto& name : names) {
+            if (std::find(names.begin(), names.end(), zoneMapName(name)) == names.end()) continue;
+            try {
+                ZoneMap zoneMap = loadZoneMap(fileName, name);
+                for (const auto& predicate : predicates) {
+                    int f = zoneMap.fieldIndex(predicate.field);
+                    if (f < 0) continue;
+                    auto kept = selectClusters(zoneMap, predicate);
+                    std::size_t keptClusters = 0;
+                    for (const auto& c : zoneMap.clusters) {
+                        for (const auto& [first, last] : kept) {
+                            if (c.first >= first && c.second <= last) { ++keptClusters; break; }
+                        }
+                    }
+                    std::uint64_t fullMatches = 0, prunedMatches = 0;
+                    double full = timeMatching(fileName, name, zoneMap.fields[f], predicate, zoneMap.clusters, fullMatches);
+                    double pruned = timeMatching(fileName, name, zoneMap.fields[f], predicate, kept, prunedMatches);
+
+                    std::ostringstream pred;
+                    pred << predicate.field << " in [" << predicate.lo << ", " << predicate.hi << "]";
+                    std::cout << std::left
+                              << std::setw(col1) << (stem + "/" + name)
+                              << std::setw(col2) << pred.str()
+                              << std::setw(col3) << zoneMap.clusters.size()
+                              << std::setw(col3) << (zoneMap.clusters.size() - keptClusters)
+                              << std::setw(col3) << prunedMatches
+                              << std::setw(col3) << full
+                              << std::setw(col3) << pruned
+                              << std::setw(col3) << (pruned > 0.0 ? full / pruned : 0.0);
+                    if (fullMatches != prunedMatches) std::cout << " MISMATCH (full " << fullMatches << ")";
+                    std::cout << std::endl;
+                }
+            } catch (const std::exception& e) {
+                std::cout << std::left << std::setw(col1) << (stem + "/" + name) << "FAILED: " << e.what() << std::endl;
+            }
+        }
+    }
+    std::cout << std::string(col1 + col2 + 6 * col3, '-') << std::endl;
+}
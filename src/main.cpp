@@ -12,11 +12,34 @@
 #include <filesystem>
 #include <iomanip>
 #include <string>
+#include <sstream>
 #include <cstring>
 #include <cstdlib>
 #include <algorithm>
+#include <map>
 
 #include "HitWireWriters.hpp"
+#include "HitWireGenerators.hpp"
+#include "EventSizes.hpp"
+#include "ScalingAnalysis.hpp"
+#include "ThreadBudget.hpp"
+#include "Affinity.hpp"
+#include "ClusterTargeting.hpp"
+#include "EventIndex.hpp"
+#include "ZoneMap.hpp"
+#include "JoinReader.hpp"
+#include "SpillReassembly.hpp"
+#include "Compaction.hpp"
+#include "LayoutConverter.hpp"
+#include "ShardedWrite.hpp"
+#include "MultiProcess.hpp"
+#include "SweepRunner.hpp"
+#include "OutputCache.hpp"
+#include "OutputSink.hpp"
+#include "StorageBaseline.hpp"
+#include "FlatColumns.hpp"
+#include "StorageBreakdown.hpp"
+#include "TTreeBaseline.hpp"
 #include <TFile.h>
 
 
@@ -67,11 +90,16 @@ static void print_file_sizes_table(const std::string& title,
     std::cout << std::string(col1 + col2, '-') << std::endl;
 }
 
+// Reused output files were not written, so they have no write time to plot
+static void drop_cached_results(std::vector<WriterResult>& results) {
+    results.erase(std::remove_if(results.begin(), results.end(), [](const WriterResult& r) { return r.cached; }),
+                  results.end());
+}
+
 int main(int argc, char** argv) {
     ROOT::EnableThreadSafety();
     int nThreads = std::thread::hardware_concurrency();
     std::cout << "nThreads: " << nThreads << std::endl;
-    ROOT::EnableImplicitMT(nThreads);
     gSystem->Load("libWireDict");
     
     // Configuration parameters (defaults)
@@ -90,6 +118,47 @@ int main(int argc, char** argv) {
     int scalingMaxThreads = 32;
     int scalingIter = 3;
     int scalingEvents = 10000;
+    std::vector<int> scalingThreads; // empty -> defaultScalingThreadCounts(scalingMaxThreads)
+    std::vector<EventShape> scalingShapes; // empty -> single shape from the parameters above
+    int imtThreads = -1;    // -1 -> legacy: implicit MT, fill workers and readers all use nThreads
+    int fillWorkers = -1;   // -1 -> derived from the thread budget
+    int readerThreads = -1; // -1 -> derived from the thread budget
+    bool runBudgetSweep = false;
+    Affinity::Policy affinityPolicy = Affinity::Policy::None;
+    ReadSplitConfig readSplit;
+    ClusterTargetConfig clusterTarget; // clustersPerReader 0 -> ROOT's default cluster size
+    double minClusterMB = 1.0;
+    WriterCommitConfig commitConfig;
+    bool runCommitCompare = false;
+    bool runShardedCompare = false;
+    int processRanks = 0;       // 0 -> no multi-process comparison
+    bool processMerge = false;
+    std::string rankTask;       // set only in the ranks spawned by the multi-process mode
+    bool emitEventIndex = false;
+    int lookupBench = 0; // random single-event lookups per file, 0 -> off
+    bool emitZoneMaps = false;
+    std::vector<RangePredicate> filterPredicates; // empty -> no filtered-read benchmark
+    bool runJoinBench = false;
+    JoinMode joinMode = JoinMode::Auto;
+    bool runSpillReassembly = false;
+    std::string compactSpec; // empty -> no compaction; "all" or comma-separated files
+    double compactMemMB = 256.0;
+    std::string convertFile; // empty -> no layout conversion
+    std::string convertTargets = "all";
+    std::string convertOutDir = "./output_converted";
+    GeneratorMode generatorMode = GeneratorMode::Uniform;
+    EventSizeConfig eventSizes;
+    std::string sweepFile; // empty -> no config-driven sweep
+    bool sweepPlanOnly = false;
+    OutputCacheConfig outputCache; // reuse off -> every writer runs
+    SinkMode sinkMode = SinkMode::File;
+    bool runSinkCompare = false;
+    bool runBaseline = false;      // measure raw bandwidth first, report results against it
+    bool baselineOnly = false;
+    double baselineMB = 256.0;     // per thread and test
+    bool runFlatCompare = false;
+    bool runTTree = false;         // TTree writers and readers next to the RNTuple ones
+    bool runStorageBreakdown = false;
 
     // Very simple CLI parsing: supports --writer-mask, --reader-mask, --aos-only, --soa-only, --iter
     for (int i = 1; i < argc; ++i) {
@@ -119,34 +188,381 @@ int main(int argc, char** argv) {
             scalingIter = std::max(1, std::atoi(argv[++i]));
         } else if (arg == "--scaling-events" && i + 1 < argc) {
             scalingEvents = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--scaling-threads" && i + 1 < argc) {
+            scalingThreads = parseThreadCounts(argv[++i]);
+        } else if (arg == "--scaling-shapes" && i + 1 < argc) {
+            scalingShapes = parseEventShapes(argv[++i]);
+        } else if (arg == "--imt-threads" && i + 1 < argc) {
+            imtThreads = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--fill-workers" && i + 1 < argc) {
+            fillWorkers = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--reader-threads" && i + 1 < argc) {
+            readerThreads = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--budget-sweep") {
+            runBudgetSweep = true;
+        } else if (arg == "--read-split" && i + 1 < argc) {
+            std::string mode = argv[++i];
+            readSplit.byBytes = (mode == "bytes" || mode == "ubytes");
+            readSplit.weight = (mode == "ubytes") ? Utils::ClusterWeight::UncompressedBytes
+                                                  : Utils::ClusterWeight::CompressedBytes;
+        } else if (arg == "--read-queue") {
+            readSplit.dynamicQueue = true;
+        } else if (arg == "--read-queue-grab" && i + 1 < argc) {
+            readSplit.dynamicQueue = true;
+            readSplit.clustersPerGrab = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--read-subcluster") {
+            readSplit.byBytes = true;
+            readSplit.allowSubCluster = true;
+        } else if (arg == "--clusters-per-reader" && i + 1 < argc) {
+            clusterTarget.clustersPerReader = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--min-cluster-mb" && i + 1 < argc) {
+            minClusterMB = std::max(0.0, std::atof(argv[++i]));
+        } else if (arg == "--ordered-commit") {
+            commitConfig.ordered = true;
+        } else if (arg == "--commit-block" && i + 1 < argc) {
+            commitConfig.blockEvents = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--commit-compare") {
+            runCommitCompare = true;
+        } else if (arg == "--file-per-thread") {
+            runShardedCompare = true;
+        } else if (arg == "--processes" && i + 1 < argc) {
+            processRanks = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--process-merge") {
+            processMerge = true;
+        } else if (arg == "--rank-task" && i + 1 < argc) {
+            rankTask = argv[++i];
+        } else if (arg == "--event-index") {
+            emitEventIndex = true;
+        } else if (arg == "--lookup-bench" && i + 1 < argc) {
+            emitEventIndex = true;
+            lookupBench = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--zone-map") {
+            emitZoneMaps = true;
+        } else if (arg == "--filter-bench" && i + 1 < argc) {
+            emitZoneMaps = true;
+            filterPredicates = parseRangePredicates(argv[++i]);
+        } else if (arg == "--join-bench") {
+            runJoinBench = true;
+        } else if (arg == "--join-mode" && i + 1 < argc) {
+            runJoinBench = true;
+            try {
+                joinMode = parseJoinMode(argv[++i]);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+                return 1;
+            }
+        } else if (arg == "--spill-reassembly") {
+            runSpillReassembly = true;
+        } else if (arg == "--compact" && i + 1 < argc) {
+            compactSpec = argv[++i];
+        } else if (arg == "--compact-mem" && i + 1 < argc) {
+            compactMemMB = std::max(1.0, std::atof(argv[++i]));
+        } else if (arg == "--convert" && i + 1 < argc) {
+            convertFile = argv[++i];
+        } else if (arg == "--convert-to" && i + 1 < argc) {
+            convertTargets = argv[++i];
+        } else if (arg == "--convert-out" && i + 1 < argc) {
+            convertOutDir = argv[++i];
+        } else if (arg == "--generator" && i + 1 < argc) {
+            try {
+                generatorMode = parseGeneratorMode(argv[++i]);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+                return 1;
+            }
+        } else if (arg == "--event-sizes" && i + 1 < argc) {
+            try {
+                eventSizes = parseEventSizeSpec(argv[++i]);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+                return 1;
+            }
+        } else if (arg == "--sweep" && i + 1 < argc) {
+            sweepFile = argv[++i];
+        } else if (arg == "--sweep-plan") {
+            sweepPlanOnly = true;
+        } else if (arg == "--reuse-output") {
+            outputCache.reuse = true;
+        } else if (arg == "--output-cache" && i + 1 < argc) {
+            outputCache.reuse = true;
+            outputCache.cacheDir = argv[++i];
+        } else if (arg == "--sink" && i + 1 < argc) {
+            try {
+                sinkMode = parseSinkMode(argv[++i]);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+                return 1;
+            }
+        } else if (arg == "--sink-compare") {
+            runSinkCompare = true;
+        } else if (arg == "--ttree") {
+            runTTree = true;
+        } else if (arg == "--storage-breakdown") {
+            runStorageBreakdown = true;
+        } else if (arg == "--flat-baseline") {
+            runFlatCompare = true;
+        } else if (arg == "--baseline") {
+            runBaseline = true;
+        } else if (arg == "--baseline-only") {
+            runBaseline = baselineOnly = true;
+        } else if (arg == "--baseline-mb" && i + 1 < argc) {
+            baselineMB = std::atof(argv[++i]);
+        } else if (arg == "--affinity" && i + 1 < argc) {
+            try {
+                affinityPolicy = Affinity::parsePolicy(argv[++i]);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+                return 1;
+            }
         }
     }
     
+    // Split the cores between fill workers, implicit-MT compression and reader consumers
+    ThreadBudget budget = makeThreadBudget(nThreads, imtThreads, fillWorkers, readerThreads);
+    applyThreadBudget(budget);
+    std::cout << "Thread budget: " << describeThreadBudget(budget) << std::endl;
+    setGeneratorMode(generatorMode);
+    setEventSizeConfig(eventSizes);
+    std::cout << "Generator: " << generatorModeName(generatorMode)
+              << ", event sizes: " << describeEventSizeConfig(eventSizes) << std::endl;
+    Affinity::setPolicy(affinityPolicy);
+    setReadSplitConfig(readSplit);
+    // Size clusters for the reader threads that will consume the files
+    clusterTarget.readerThreads = budget.readerThreads;
+    clusterTarget.minClusterBytes = static_cast<std::uint64_t>(minClusterMB * 1024 * 1024);
+    setClusterTargetConfig(clusterTarget);
+    setWriterCommitConfig(commitConfig);
+    setEmitEventIndex(emitEventIndex);
+    setEmitZoneMaps(emitZoneMaps);
+
+    // A rank of the multi-process mode only runs its slice of one writer
+    if (!rankTask.empty()) {
+        return runWriterRank(rankTask, numSpills, hitsPerEvent, wiresPerEvent, roisPerWire);
+    }
+
     // Create output directory if it doesn't exist
     std::filesystem::create_directories(kOutputDir);
 
-    // Optional: scaling study (write time vs thread count), generates:
-    // - ../experiments/aos_scaling_plot.pdf
-    // - ../experiments/soa_scaling_plot.pdf
+    // Raw storage and memory bandwidth of this node, the ceiling for every result below
+    BaselineCeilings baseline;
+    if (runBaseline) {
+        BaselineConfig baselineConfig;
+        baselineConfig.directory = kOutputDir;
+        baselineConfig.bytesPerThread = static_cast<std::uint64_t>(std::max(1.0, baselineMB) * 1024 * 1024);
+        baselineConfig.threads = {1, budget.fillWorkers, budget.readerThreads};
+        std::sort(baselineConfig.threads.begin(), baselineConfig.threads.end());
+        baselineConfig.threads.erase(std::unique(baselineConfig.threads.begin(), baselineConfig.threads.end()),
+                                     baselineConfig.threads.end());
+        try {
+            auto results = runStorageBaseline(baselineConfig);
+            printBaselineTable(results);
+            std::filesystem::create_directories("../experiments");
+            writeBaselineCsv("../experiments/baseline.csv", results);
+            baseline = baselineCeilings(results);
+        } catch (const std::exception& e) {
+            std::cerr << "Baseline failed: " << e.what() << std::endl;
+            return 1;
+        }
+        if (baselineOnly) return 0;
+    }
+
+    // Optional: post-processing only, sort existing output files by EventID
+    if (!compactSpec.empty()) {
+        std::vector<std::string> files;
+        if (compactSpec == "all") {
+            for (const std::string layout : {"event", "spill", "topObject", "element"}) {
+                for (const std::string product : {"all", "perData", "perGroup"}) {
+                    if (runAOS) files.push_back(kOutputDir + "/aos_" + layout + "_" + product + ".root");
+                    if (runSOA) files.push_back(kOutputDir + "/soa_" + layout + "_" + product + ".root");
+                }
+            }
+        } else {
+            std::stringstream ss(compactSpec);
+            std::string file;
+            while (std::getline(ss, file, ',')) {
+                if (!file.empty()) files.push_back(file);
+            }
+        }
+        CompactionConfig compaction;
+        compaction.memoryBytes = static_cast<std::uint64_t>(compactMemMB * 1024 * 1024);
+        compaction.nThreads = budget.readerThreads;
+        runCompaction(files, compaction);
+        Affinity::printPlacementReport("Thread Placement");
+        return 0;
+    }
+
+    // Optional: post-processing only, rewrite one file into other storage layouts
+    if (!convertFile.empty()) {
+        std::vector<StorageLayout> targets;
+        try {
+            if (convertTargets == "all") {
+                for (const auto& layout : allStorageLayouts()) {
+                    if ((layout.soa && runSOA) || (!layout.soa && runAOS)) targets.push_back(layout);
+                }
+            } else {
+                std::stringstream ss(convertTargets);
+                std::string name;
+                while (std::getline(ss, name, ',')) {
+                    if (!name.empty()) targets.push_back(parseStorageLayout(name));
+                }
+            }
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        ConversionConfig conversion;
+        conversion.nThreads = budget.readerThreads;
+        conversion.numSpills = numSpills;
+        benchmarkConversion(convertFile, targets, convertOutDir, conversion);
+        Affinity::printPlacementReport("Thread Placement");
+        return 0;
+    }
+
+    // Optional: parameter sweep from a config file, resuming from its results file
+    if (!sweepFile.empty()) {
+        try {
+            runSweep(loadSweepConfig(sweepFile), sweepPlanOnly);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        Affinity::printPlacementReport("Thread Placement");
+        return 0;
+    }
+
+    // Optional: try several core splits and report the best one per layout
+    if (runBudgetSweep) {
+        runThreadBudgetSweep(nThreads, iter, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, numSpills,
+                             writerMask, readerMask, runAOS, runSOA);
+        Affinity::printPlacementReport("Thread Placement");
+        return 0;
+    }
+
+    // Optional: free-for-all vs ordered cluster commit throughput
+    if (runCommitCompare) {
+        compareCommitModes(budget.fillWorkers, iter, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, numSpills,
+                           writerMask, runAOS, runSOA);
+        Affinity::printPlacementReport("Thread Placement");
+        return 0;
+    }
+
+    // Optional: shared parallel writer vs one file per thread plus merge
+    if (runShardedCompare) {
+        compareShardedWrite(budget.fillWorkers, iter, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, numSpills,
+                            writerMask, runAOS, runSOA);
+        Affinity::printPlacementReport("Thread Placement");
+        return 0;
+    }
+
+    // Optional: file vs in-memory vs discarding sink, to split write time into its parts
+    if (runSinkCompare) {
+        compareSinkModes(budget.fillWorkers, iter, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, numSpills,
+                         writerMask, runAOS, runSOA);
+        Affinity::printPlacementReport("Thread Placement");
+        return 0;
+    }
+
+    // Optional: hand-rolled flat columns as the lower bound for write time, read time and size
+    if (runFlatCompare) {
+        compareFlatColumns(budget.fillWorkers, iter, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, numSpills,
+                           writerMask, runAOS, runSOA);
+        Affinity::printPlacementReport("Thread Placement");
+        return 0;
+    }
+
+    // Optional: threads in one process vs several local processes sharing the same cores
+    if (processRanks > 0) {
+        MultiProcessConfig processes;
+        processes.ranks = processRanks;
+        processes.threadsPerRank = std::max(1, budget.fillWorkers / processRanks);
+        processes.merge = processMerge;
+        // Ranks see the same options, with the fill and implicit-MT threads divided between them
+        processes.rankArgs.assign(argv + 1, argv + argc);
+        processes.rankArgs.push_back("--fill-workers");
+        processes.rankArgs.push_back(std::to_string(processes.threadsPerRank));
+        processes.rankArgs.push_back("--imt-threads");
+        processes.rankArgs.push_back(std::to_string(budget.imtThreads / processRanks));
+        compareProcessScaling(processes, budget.fillWorkers, iter, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire,
+                              numSpills, writerMask, runAOS, runSOA);
+        Affinity::printPlacementReport("Thread Placement");
+        return 0;
+    }
+
+    // Optional: scaling study (write time vs thread count), per event shape generates:
+    // - ../experiments/aos_scaling_plot[_<shape>].pdf, ../experiments/aos_scaling_speedup[_<shape>].pdf
+    // - ../experiments/soa_scaling_plot[_<shape>].pdf, ../experiments/soa_scaling_speedup[_<shape>].pdf
+    // - ../experiments/{aos,soa}_scaling[_<shape>].csv
     if (runScaling) {
-        if (runAOS) {
-            auto aos_scaling = benchmarkAOSScaling(scalingMaxThreads, scalingIter, scalingEvents, writerMask);
-            visualize_aos_scaling(aos_scaling);
+        if (scalingThreads.empty()) {
+            scalingThreads = defaultScalingThreadCounts(scalingMaxThreads);
         }
-        if (runSOA) {
-            auto soa_scaling = benchmarkSOAScaling(scalingMaxThreads, scalingIter, scalingEvents, writerMask);
-            visualize_soa_scaling(soa_scaling);
+        // Without --scaling-shapes keep the untagged file names of a single sweep
+        const bool tagByShape = !scalingShapes.empty();
+        if (scalingShapes.empty()) {
+            scalingShapes.push_back({"default", hitsPerEvent, wiresPerEvent, roisPerWire, numSpills});
         }
+        std::filesystem::create_directories("../experiments");
+        for (const auto& shape : scalingShapes) {
+            const std::string tag = tagByShape ? shape.name : "";
+            const std::string suffix = tag.empty() ? "" : "_" + tag;
+            std::cout << "\nScaling shape '" << shape.name << "': hits=" << shape.hitsPerEvent
+                      << " wires=" << shape.wiresPerEvent << " roisPerWire=" << shape.roisPerWire
+                      << " spills=" << shape.numSpills << std::endl;
+            if (runAOS) {
+                auto aos_scaling = benchmarkAOSScaling(scalingThreads, scalingIter, scalingEvents, shape, writerMask);
+                visualize_aos_scaling(aos_scaling, tag);
+                auto aos_fits = analyzeScaling(aos_scaling);
+                printScalingAnalysis("AOS Writer Scaling [" + shape.name + "]", aos_fits);
+                visualize_scaling_speedup("AOS", aos_fits, tag);
+                writeScalingCsv("../experiments/aos_scaling" + suffix + ".csv", shape, aos_fits);
+            }
+            if (runSOA) {
+                auto soa_scaling = benchmarkSOAScaling(scalingThreads, scalingIter, scalingEvents, shape, writerMask);
+                visualize_soa_scaling(soa_scaling, tag);
+                auto soa_fits = analyzeScaling(soa_scaling);
+                printScalingAnalysis("SOA Writer Scaling [" + shape.name + "]", soa_fits);
+                visualize_scaling_speedup("SOA", soa_fits, tag);
+                writeScalingCsv("../experiments/soa_scaling" + suffix + ".csv", shape, soa_fits);
+            }
+        }
+        Affinity::printPlacementReport("Thread Placement");
         return 0;
     }
 
+    // Only the writer benchmarks below skip writers whose output is already there
+    setOutputCacheConfig(outputCache);
+
+    // Optional: writers only, without a file to read back or post-process
+    if (sinkMode != SinkMode::File) {
+        setSinkMode(sinkMode);
+        std::cout << "\nWriting into the " << sinkModeName(sinkMode) << " sink, readers skipped" << std::endl;
+        if (runAOS) outAOS(budget.fillWorkers, iter, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, numSpills, kOutputDir, writerMask);
+        if (runSOA) outSOA(budget.fillWorkers, iter, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, numSpills, kOutputDir, writerMask);
+        Affinity::printPlacementReport("Thread Placement");
+        return 0;
+    }
+
+    // The baseline rates files by MiB per second of wall time, and the TTree rows are wall times
+    // including the merge, so then the writers report wall time instead of the summed fill time
+    // of their workers
+    const bool writerWallTime = runBaseline || runTTree;
+
     // Commented: AOS writer/reader benchmarks
     std::vector<WriterResult> aos_writer_results;
     std::vector<ReaderResult> aos_reader_results;
     if (runAOS) {
-        aos_writer_results = outAOS(nThreads, iter, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, numSpills, kOutputDir, writerMask);
+        aos_writer_results = outAOS(budget.fillWorkers, iter, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, numSpills, kOutputDir, writerMask, writerWallTime);
+        drop_cached_results(aos_writer_results);
+        if (runTTree) {
+            auto trees = outTTree(false, budget.fillWorkers, iter, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, numSpills, kOutputDir, writerMask);
+            aos_writer_results.insert(aos_writer_results.end(), trees.begin(), trees.end());
+        }
         visualize_aos_writer_results(aos_writer_results);
-        aos_reader_results = inAOS(nThreads, iter, kOutputDir, readerMask);
+        aos_reader_results = inAOS(budget.readerThreads, iter, kOutputDir, readerMask);
+        if (runTTree) {
+            auto trees = inTTree(false, budget.readerThreads, iter, kOutputDir, readerMask);
+            aos_reader_results.insert(aos_reader_results.end(), trees.begin(), trees.end());
+        }
         visualize_aos_reader_results(aos_reader_results);
     }
 
@@ -167,7 +583,13 @@ int main(int argc, char** argv) {
         kOutputDir + "/aos_element_all.root"
     };
     if (runAOS) {
-        for (const auto& f : aos_files) {
+        // TTree files only join the sizes, the sidecar benchmarks below read RNTuple only
+        auto sizeFiles = aos_files;
+        if (runTTree) {
+            const auto trees = ttreeFiles(false, kOutputDir);
+            sizeFiles.insert(sizeFiles.end(), trees.begin(), trees.end());
+        }
+        for (const auto& f : sizeFiles) {
             auto tfile = TFile::Open(f.c_str(), "READ");
             if (tfile) {
                 double sizeMB = tfile->GetSize() / (1024.0 * 1024.0);
@@ -186,9 +608,18 @@ int main(int argc, char** argv) {
     std::vector<WriterResult> soa_writer_results;
     std::vector<ReaderResult> soa_reader_results;
     if (runSOA) {
-        soa_writer_results = outSOA(nThreads, iter, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, numSpills, kOutputDir, writerMask);
+        soa_writer_results = outSOA(budget.fillWorkers, iter, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, numSpills, kOutputDir, writerMask, writerWallTime);
+        drop_cached_results(soa_writer_results);
+        if (runTTree) {
+            auto trees = outTTree(true, budget.fillWorkers, iter, numEvents, hitsPerEvent, wiresPerEvent, roisPerWire, numSpills, kOutputDir, writerMask);
+            soa_writer_results.insert(soa_writer_results.end(), trees.begin(), trees.end());
+        }
         visualize_soa_writer_results(soa_writer_results);
-        soa_reader_results = inSOA(nThreads, iter, kOutputDir, readerMask);
+        soa_reader_results = inSOA(budget.readerThreads, iter, kOutputDir, readerMask);
+        if (runTTree) {
+            auto trees = inTTree(true, budget.readerThreads, iter, kOutputDir, readerMask);
+            soa_reader_results.insert(soa_reader_results.end(), trees.begin(), trees.end());
+        }
         visualize_soa_reader_results(soa_reader_results);
     }
 
@@ -209,7 +640,13 @@ int main(int argc, char** argv) {
         kOutputDir + "/soa_element_all.root"
     };
     if (runSOA) {
-        for (const auto& f : soa_files) {
+        // TTree files only join the sizes, the sidecar benchmarks below read RNTuple only
+        auto sizeFiles = soa_files;
+        if (runTTree) {
+            const auto trees = ttreeFiles(true, kOutputDir);
+            sizeFiles.insert(sizeFiles.end(), trees.begin(), trees.end());
+        }
+        for (const auto& f : sizeFiles) {
             auto tfile = TFile::Open(f.c_str(), "READ");
             if (tfile) {
                 double sizeMB = tfile->GetSize() / (1024.0 * 1024.0);
@@ -223,6 +660,51 @@ int main(int argc, char** argv) {
         visualize_soa_file_sizes(soa_file_sizes);
     }
 
+    // Optional: which columns the file sizes above are made of, from the ntuple descriptors
+    if (runStorageBreakdown) {
+        std::filesystem::create_directories("../experiments");
+        if (runAOS) reportStorageBreakdown("AOS Storage Breakdown (all layouts)", aos_files, "../experiments/aos_storage_breakdown.csv");
+        if (runSOA) reportStorageBreakdown("SOA Storage Breakdown (all layouts)", soa_files, "../experiments/soa_storage_breakdown.csv");
+    }
+
+    // Optional: single-event lookup latency through the EventID sidecar indexes
+    if (lookupBench > 0) {
+        std::vector<std::string> lookupFiles;
+        if (runAOS) lookupFiles.insert(lookupFiles.end(), aos_files.begin(), aos_files.end());
+        if (runSOA) lookupFiles.insert(lookupFiles.end(), soa_files.begin(), soa_files.end());
+        benchmarkEventLookup(lookupFiles, numEvents, lookupBench);
+    }
+
+    // Optional: predicate pushdown through per-cluster zone maps
+    if (!filterPredicates.empty()) {
+        std::vector<std::string> filterFiles;
+        if (runAOS) filterFiles.insert(filterFiles.end(), aos_files.begin(), aos_files.end());
+        if (runSOA) filterFiles.insert(filterFiles.end(), soa_files.begin(), soa_files.end());
+        benchmarkFilteredRead(filterFiles, filterPredicates);
+    }
+
+    // Optional: reassemble events across the split ntuples and compare with allDataProduct
+    if (runJoinBench) {
+        std::vector<std::string> joinFiles;
+        if (runAOS) joinFiles.insert(joinFiles.end(), aos_files.begin(), aos_files.end());
+        if (runSOA) joinFiles.insert(joinFiles.end(), soa_files.begin(), soa_files.end());
+        benchmarkJoinRead(joinFiles, budget.readerThreads, joinMode);
+    }
+
+    // Optional: rebuild events from spill entries and compare with reading the event layout
+    if (runSpillReassembly) {
+        benchmarkSpillReassembly(kOutputDir, numSpills, budget.readerThreads, runAOS, runSOA);
+    }
+
+    // Every writer and reader against the baseline ceilings
+    if (runBaseline) {
+        std::map<std::string, double> aosMB, soaMB;
+        for (const auto& [path, mb] : aos_file_sizes) aosMB[build_label_from_path(path)] = mb;
+        for (const auto& [path, mb] : soa_file_sizes) soaMB[build_label_from_path(path)] = mb;
+        if (runAOS) printRooflineTable("AOS vs Baseline", baseline, aos_writer_results, aos_reader_results, aosMB);
+        if (runSOA) printRooflineTable("SOA vs Baseline", baseline, soa_writer_results, soa_reader_results, soaMB);
+    }
+
     // Add comparison visualizations
     // Commented: comparison visualizations
     if (runAOS && runSOA) {
@@ -231,6 +713,7 @@ int main(int argc, char** argv) {
         visualize_comparison_file_sizes(aos_file_sizes, soa_file_sizes);
     }
 
+    Affinity::printPlacementReport("Thread Placement");
     return 0;
 }
 
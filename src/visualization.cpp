@@ -19,9 +19,11 @@
 #include <TAxis.h>
 #include <limits>
 #include <cmath>
+#include <cctype>
 
 #include "WriterResult.hpp"
 #include "ReaderResult.hpp"
+#include "ScalingAnalysis.hpp"
 
 using namespace std;
 
@@ -75,6 +77,10 @@ int getSortOrder(const std::string& label) {
     if (cleanLabel == "element_allDataProduct") return 10;
     if (cleanLabel == "element_perDataProduct") return 11;
     if (cleanLabel == "element_perGroup") return 12;
+    if (cleanLabel == "TTree_event") return 13;
+    if (cleanLabel == "TTree_spill") return 14;
+    if (cleanLabel == "TTree_topObject") return 15;
+    if (cleanLabel == "TTree_element") return 16;
     
     // Default for any other labels
     return 999;
@@ -293,7 +299,7 @@ void visualize_aos_file_sizes(const std::vector<std::pair<std::string, double>>&
     cout << "AOS File sizes plot saved to ../experiments/aos_file_sizes.pdf" << endl;
 }
 
-void visualize_aos_scaling(const std::map<std::string, std::vector<std::pair<int, double>>>& data) {
+void visualize_aos_scaling(const std::map<std::string, std::vector<std::pair<int, double>>>& data, const std::string& tag) {
     if (data.empty()) return;
 
     filesystem::create_directory("../experiments");
@@ -339,9 +345,10 @@ void visualize_aos_scaling(const std::map<std::string, std::vector<std::pair<int
         graph->SetMarkerColor(kRed);
     }
 
-    canvas->SaveAs("../experiments/aos_scaling_plot.pdf");
+    std::string outPath = "../experiments/aos_scaling_plot" + (tag.empty() ? "" : "_" + tag) + ".pdf";
+    canvas->SaveAs(outPath.c_str());
     delete canvas;
-    cout << "AOS Scaling plot saved to ../experiments/aos_scaling_plot.pdf" << endl;
+    cout << "AOS Scaling plot saved to " << outPath << endl;
 }
 
 // SOA visualization functions
@@ -525,7 +532,7 @@ void visualize_soa_file_sizes(const std::vector<std::pair<std::string, double>>&
     cout << "SOA File sizes plot saved to ../experiments/soa_file_sizes.pdf" << endl;
 }
 
-void visualize_soa_scaling(const std::map<std::string, std::vector<std::pair<int, double>>>& data) {
+void visualize_soa_scaling(const std::map<std::string, std::vector<std::pair<int, double>>>& data, const std::string& tag) {
     if (data.empty()) return;
 
     filesystem::create_directory("../experiments");
@@ -571,9 +578,89 @@ void visualize_soa_scaling(const std::map<std::string, std::vector<std::pair<int
         graph->SetMarkerColor(kBlue);
     }
 
-    canvas->SaveAs("../experiments/soa_scaling_plot.pdf");
+    std::string outPath = "../experiments/soa_scaling_plot" + (tag.empty() ? "" : "_" + tag) + ".pdf";
+    canvas->SaveAs(outPath.c_str());
     delete canvas;
-    cout << "SOA Scaling plot saved to ../experiments/soa_scaling_plot.pdf" << endl;
+    cout << "SOA Scaling plot saved to " << outPath << endl;
+}
+
+// Measured speedup per label with the fitted USL curve and the ideal line, one pad per label
+void visualize_scaling_speedup(const std::string& layout, const std::vector<ScalingFit>& fits, const std::string& tag) {
+    if (fits.empty()) return;
+
+    filesystem::create_directory("../experiments");
+
+    std::string prefix = layout;
+    std::transform(prefix.begin(), prefix.end(), prefix.begin(), [](unsigned char c) { return std::tolower(c); });
+    const Color_t color = (layout == "SOA") ? kBlue : kRed;
+
+    int n = fits.size();
+    int cols = 3;
+    int rows = (n + cols - 1) / cols; // Ceiling division
+
+    TCanvas* canvas = new TCanvas((prefix + "_speedup_canvas").c_str(), (layout + " Write Speedup and USL Fit").c_str(), 1800, 1200);
+    canvas->Divide(cols, rows);
+
+    int padIndex = 1;
+    for (const auto& fit : fits) {
+        if (fit.threads.empty()) continue;
+        canvas->cd(padIndex++);
+        gPad->SetGrid(1, 1);
+
+        double maxX = fit.threads.back();
+        double maxY = 1.0;
+        for (double s : fit.speedup) maxY = std::max(maxY, s);
+
+        TMultiGraph* mg = new TMultiGraph();
+        TString title;
+        if (fit.valid) {
+            title.Form("%s %s (#sigma=%.3g, #kappa=%.3g);Number of Threads;Speedup", layout.c_str(), fit.label.c_str(), fit.uslSigma, fit.uslKappa);
+        } else {
+            title.Form("%s %s;Number of Threads;Speedup", layout.c_str(), fit.label.c_str());
+        }
+        mg->SetTitle(title);
+
+        TGraph* measured = new TGraph(fit.threads.size());
+        for (size_t i = 0; i < fit.threads.size(); ++i) {
+            measured->SetPoint(i, fit.threads[i], fit.speedup[i]);
+        }
+        measured->SetMarkerStyle(20);
+        measured->SetMarkerColor(color);
+        measured->SetLineColor(color);
+        measured->SetLineWidth(2);
+        mg->Add(measured, "P");
+
+        TGraph* ideal = new TGraph(2);
+        ideal->SetPoint(0, 1, 1);
+        ideal->SetPoint(1, maxX, maxX);
+        ideal->SetLineStyle(2);
+        ideal->SetLineColor(kGray + 1);
+        mg->Add(ideal, "L");
+
+        if (fit.valid) {
+            // Extend the model curve past the measurements to show where it turns over
+            double curveMaxX = std::max(maxX, fit.optimalThreadsInt > 0 ? 1.5 * fit.optimalThreads : maxX);
+            const int nCurve = 200;
+            TGraph* usl = new TGraph(nCurve);
+            for (int i = 0; i < nCurve; ++i) {
+                double x = 1.0 + (curveMaxX - 1.0) * i / (nCurve - 1);
+                double y = uslSpeedup(fit.uslSigma, fit.uslKappa, x);
+                usl->SetPoint(i, x, y);
+                maxY = std::max(maxY, y);
+            }
+            usl->SetLineColor(color);
+            usl->SetLineWidth(2);
+            mg->Add(usl, "L");
+        }
+
+        mg->Draw("A");
+        mg->GetYaxis()->SetRangeUser(0, maxY * 1.1);
+    }
+
+    std::string outPath = "../experiments/" + prefix + "_scaling_speedup" + (tag.empty() ? "" : "_" + tag) + ".pdf";
+    canvas->SaveAs(outPath.c_str());
+    delete canvas;
+    cout << layout << " Scaling speedup plot saved to " << outPath << endl;
 }
 
 // Comparison functions for AOS vs SOA
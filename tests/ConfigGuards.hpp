@@ -0,0 +1,38 @@
+#ifndef CONFIG_GUARDS_HPP
+#define CONFIG_GUARDS_HPP
+
+#include "EventSizes.hpp"
+#include "HitWireGenerators.hpp"
+#include "HitWireWriters.hpp"
+#include "JoinReader.hpp"
+#include "OutputCache.hpp"
+#include "OutputSink.hpp"
+
+// Each guard restores one piece of global configuration to its default when the test ends,
+// whatever the test selected, so tests do not depend on the order they run in.
+
+struct GeneratorModeGuard {
+    ~GeneratorModeGuard() { setGeneratorMode(GeneratorMode::Uniform); }
+};
+
+struct EventSizeGuard {
+    ~EventSizeGuard() { setEventSizeConfig(EventSizeConfig{}); }
+};
+
+struct SinkGuard {
+    ~SinkGuard() { setSinkMode(SinkMode::File); }
+};
+
+struct CacheGuard {
+    ~CacheGuard() { setOutputCacheConfig(OutputCacheConfig{}); }
+};
+
+struct CommitGuard {
+    ~CommitGuard() { setWriterCommitConfig(WriterCommitConfig{}); }
+};
+
+struct JoinWindowGuard {
+    ~JoinWindowGuard() { setJoinWindowEntries(kDefaultJoinWindowEntries); }
+};
+
+#endif // CONFIG_GUARDS_HPP
@@ -3,6 +3,8 @@
 #include <memory>
 #include <string>
 #include <random>  // For random data generation
+#include <utility>
+#include <vector>
 
 void GenerateTestNTuple(const std::string& filePath, int numEntries, std::size_t approxClusterSize, int payloadSize = 4) {
     auto model = ROOT::RNTupleModel::Create();
@@ -28,6 +30,34 @@ void GenerateTestNTuple(const std::string& filePath, int numEntries, std::size_t
     // Writer auto-closes on destruction
 }
 
+// Writes one cluster per (numEntries, payloadSize) pair, committing clusters explicitly so that
+// their sizes can be skewed on purpose (e.g. a few heavy trailing clusters).
+void GenerateClusteredTestNTuple(const std::string& filePath, const std::vector<std::pair<int, int>>& clusters) {
+    auto model = ROOT::RNTupleModel::Create();
+    auto val = model->MakeField<std::vector<char>>("value");
+
+    ROOT::RNTupleWriteOptions options;
+    // Large enough that only the explicit CommitCluster calls close clusters
+    options.SetApproxZippedClusterSize(std::size_t(1) << 30);
+    options.SetMaxUnzippedClusterSize(std::size_t(1) << 31);
+
+    auto writer = ROOT::RNTupleWriter::Recreate(std::move(model), "hits", filePath, options);
+
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<int> dist(0, 255);  // Random bytes for poor compression
+
+    for (const auto& [numEntries, payloadSize] : clusters) {
+        for (int i = 0; i < numEntries; ++i) {
+            val->resize(payloadSize);
+            for (auto& byte : *val) {
+                byte = static_cast<char>(dist(gen));
+            }
+            writer->Fill();
+        }
+        writer->CommitCluster();
+    }
+}
+
 int main() {
     GenerateTestNTuple("test_file.root", 1000000, 1024, 4);
     return 0;
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleReader.hxx>
+#include <ROOT/RNTupleWriter.hxx>
+#include <filesystem>
+#include <random>
+#include <vector>
+#include "ClusterTargeting.hpp"
+#include "EventSizes.hpp"
+
+TEST(ClusterTargetingTest, TargetBytesHonoursCountAndFloor) {
+    ClusterTargetConfig config;
+    EXPECT_EQ(targetClusterBytes(100 << 20, config, 0), 0u); // disabled by default
+
+    config.clustersPerReader = 4;
+    config.readerThreads = 8;
+    config.minClusterBytes = 1 << 20;
+    EXPECT_EQ(targetClusterBytes(64ull << 20, config, 0), 2ull << 20);
+    // Never below the floor, even if that means fewer clusters than asked for
+    EXPECT_EQ(targetClusterBytes(8ull << 20, config, 0), 1ull << 20);
+    // Never above the default: targeting only shrinks clusters
+    EXPECT_EQ(targetClusterBytes(64ull << 30, config, 128ull << 20), 128ull << 20);
+}
+
+TEST(ClusterTargetingTest, EventBytesScaleWithShape) {
+    auto one = estimateEventBytes(100, 100, 10);
+    auto two = estimateEventBytes(200, 100, 20);
+    EXPECT_EQ(two.hits, 2 * one.hits);
+    EXPECT_EQ(two.wires, one.wires);
+    EXPECT_EQ(two.rois, 2 * one.rois);
+    EXPECT_EQ(one.all(), one.hits + one.wiresWithRois());
+    EXPECT_EQ(estimateEventBytes(0, 0, 0).all(), 0u);
+}
+
+TEST(ClusterTargetingTest, WriterProducesEnoughClusters) {
+    const std::string path = "temp_cluster_target.root";
+    const int numEntries = 20000, payload = 64;
+    ClusterTargetConfig config;
+    config.clustersPerReader = 2;
+    config.readerThreads = 4;
+    config.minClusterBytes = 64 * 1024;
+    setClusterTargetConfig(config);
+
+    {
+        auto model = ROOT::RNTupleModel::Create();
+        auto val = model->MakeField<std::vector<float>>("value");
+        // Leave out the offset column so the estimate errs towards smaller clusters
+        std::uint64_t expected = static_cast<std::uint64_t>(numEntries) * payload * sizeof(float);
+        auto writer = ROOT::RNTupleWriter::Recreate(std::move(model), "hits", path, makeWriteOptions(expected));
+        std::mt19937 gen(7);
+        std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+        for (int i = 0; i < numEntries; ++i) {
+            val->resize(payload);
+            for (auto& v : *val) v = dist(gen);
+            writer->Fill();
+        }
+    }
+
+    auto reader = ROOT::RNTupleReader::Open("hits", path);
+    EXPECT_GE(reader->GetDescriptor().GetNClusters(), 8u);
+    setClusterTargetConfig(ClusterTargetConfig{});
+    std::filesystem::remove(path);
+}
+
+TEST(ClusterTargetingTest, RoiBytesFollowRoiLengths) {
+    const auto fixed = estimateEventBytes(100, 100, 10);
+    EventSizeConfig config;
+    config.roiLengthSigma = 1.5; // the cap at 8x nominal pulls the mean below 10 samples
+    setEventSizeConfig(config);
+    const double meanLength = meanROILength();
+    const auto variable = estimateEventBytes(100, 100, 10);
+    setEventSizeConfig(EventSizeConfig{});
+    EXPECT_LT(meanLength, 10.0);
+    EXPECT_EQ(variable.hits, fixed.hits);
+    EXPECT_EQ(variable.wires, fixed.wires);
+    // 1000 ROIs, each shorter by the difference in mean samples
+    const double perRoi = static_cast<double>(fixed.rois - variable.rois) / 1000.0;
+    EXPECT_NEAR(perRoi, (10.0 - meanLength) * sizeof(float), 1.0);
+}
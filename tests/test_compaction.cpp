@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleReader.hxx>
+#include <ROOT/RNTupleWriter.hxx>
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include "Hit.hpp"
+#include "Compaction.hpp"
+
+TEST(CompactionTest, CompactedFileName) {
+    EXPECT_EQ(compactedFileName("out/aos_event_perData.root"), "out/aos_event_perData_sorted.root");
+    EXPECT_EQ(compactedFileName("soa_spill_all.root"), "soa_spill_all_sorted.root");
+}
+
+TEST(CompactionTest, SortsAcrossRunsAndKeepsTies) {
+    const std::string path = "temp_compaction.root";
+    const std::string sorted = compactedFileName(path);
+    // fChannel records the input position, so ties can be checked after sorting
+    const std::vector<long long> ids = {3, 1, 2, 0, 3, 1, 0, 2, 1, 3, 0, 2, 2, 1, 0, 3};
+    {
+        auto model = ROOT::RNTupleModel::Create();
+        auto hit = model->MakeField<HitIndividual>("hit");
+        auto writer = ROOT::RNTupleWriter::Recreate(std::move(model), "split_hits", path);
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            *hit = HitIndividual{};
+            hit->EventID = ids[i];
+            hit->fChannel = static_cast<unsigned int>(i);
+            writer->Fill();
+            if ((i + 1) % 4 == 0) writer->CommitCluster();
+        }
+    }
+
+    CompactionConfig config;
+    config.memoryBytes = 1; // one entry per run
+    config.nThreads = 2;
+    auto reports = compactFile(path, sorted, config);
+    ASSERT_EQ(reports.size(), 1u);
+    EXPECT_TRUE(reports[0].sorted);
+    EXPECT_EQ(reports[0].entries, ids.size());
+    EXPECT_GT(reports[0].runs, 2);
+    EXPECT_GT(reports[0].mergePasses, 1); // 16 runs, at most 2 merged at a time
+
+    auto reader = ROOT::RNTupleReader::Open("split_hits", sorted);
+    ASSERT_EQ(reader->GetNEntries(), ids.size());
+    auto hit = reader->GetView<HitIndividual>("hit");
+    long long lastId = -1;
+    unsigned int lastChannel = 0;
+    for (std::uint64_t i = 0; i < reader->GetNEntries(); ++i) {
+        const auto& h = hit(i);
+        ASSERT_GE(h.EventID, lastId);
+        if (h.EventID == lastId) EXPECT_GT(h.fChannel, lastChannel);
+        EXPECT_EQ(ids[h.fChannel], h.EventID);
+        lastId = h.EventID;
+        lastChannel = h.fChannel;
+    }
+    std::filesystem::remove(path);
+    std::filesystem::remove(sorted);
+}
+
+TEST(CompactionTest, SortsByEventThenWire) {
+    const std::string path = "temp_compaction_rois.root";
+    const std::string sorted = compactedFileName(path);
+    // Flat ROI rows: several ROIs per wire, wires out of order within and across events
+    const std::vector<std::pair<long long, unsigned int>> rows = {
+        {1, 7}, {0, 5}, {1, 2}, {0, 5}, {0, 1}, {1, 7}, {1, 2}, {0, 9}, {0, 1}, {1, 4}};
+    {
+        auto model = ROOT::RNTupleModel::Create();
+        auto eventId = model->MakeField<long long>("EventID");
+        auto wireId = model->MakeField<unsigned int>("WireID");
+        auto position = model->MakeField<int>("position");
+        auto writer = ROOT::RNTupleWriter::Recreate(std::move(model), "split_rois", path);
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            *eventId = rows[i].first;
+            *wireId = rows[i].second;
+            *position = static_cast<int>(i);
+            writer->Fill();
+            if ((i + 1) % 3 == 0) writer->CommitCluster();
+        }
+    }
+
+    CompactionConfig config;
+    config.memoryBytes = 1;
+    config.nThreads = 2;
+    auto reports = compactFile(path, sorted, config);
+    ASSERT_EQ(reports.size(), 1u);
+    EXPECT_TRUE(reports[0].sorted);
+
+    auto reader = ROOT::RNTupleReader::Open("split_rois", sorted);
+    ASSERT_EQ(reader->GetNEntries(), rows.size());
+    auto eventId = reader->GetView<long long>("EventID");
+    auto wireId = reader->GetView<unsigned int>("WireID");
+    auto position = reader->GetView<int>("position");
+    for (std::uint64_t i = 0; i < reader->GetNEntries(); ++i) {
+        EXPECT_EQ(rows[position(i)], std::make_pair(eventId(i), wireId(i)));
+        if (i == 0) continue;
+        const auto previous = std::make_tuple(eventId(i - 1), wireId(i - 1), position(i - 1));
+        EXPECT_LT(previous, std::make_tuple(eventId(i), wireId(i), position(i)));
+    }
+    std::filesystem::remove(path);
+    std::filesystem::remove(sorted);
+}
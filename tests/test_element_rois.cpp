@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <ROOT/RNTupleReader.hxx>
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "ConfigGuards.hpp"
+#include "HitWireGenerators.hpp"
+#include "HitWireWriterHelpers.hpp"
+#include "HitWireWriters.hpp"
+
+namespace {
+
+using WireKey = std::pair<long long, unsigned int>; // EventID, channel
+using RoiList = std::vector<std::pair<std::size_t, std::vector<float>>>; // offset, samples
+
+std::map<WireKey, RoiList> eventRois(const std::string& fileName) {
+    std::map<WireKey, RoiList> rois;
+    auto reader = ROOT::RNTupleReader::Open("aos_events", fileName);
+    auto event = reader->GetView<EventAOS>("EventAOS");
+    for (auto i : reader->GetEntryRange()) {
+        for (const auto& wire : event(i).wires) {
+            auto& list = rois[{wire.EventID, wire.fWire_Channel}];
+            for (const auto& roi : wire.getSignalROI()) list.emplace_back(roi.offset, roi.data);
+        }
+    }
+    return rois;
+}
+
+// Entries of one event come from one thread, so the ROIs of a wire stay in order
+template <typename Roi>
+std::map<WireKey, RoiList> elementRois(const std::string& fileName, const std::string& ntupleName) {
+    std::map<WireKey, RoiList> rois;
+    auto reader = ROOT::RNTupleReader::Open(ntupleName, fileName);
+    auto roi = reader->GetView<Roi>("roi");
+    for (auto i : reader->GetEntryRange()) {
+        const auto& r = roi(i);
+        rois[{static_cast<long long>(r.EventID), r.WireID}].emplace_back(r.offset, r.data);
+    }
+    return rois;
+}
+
+using HitValue = std::tuple<long long, unsigned int, float, float>; // event, channel, peak time, integral
+
+std::vector<HitValue> eventHits(const std::string& fileName) {
+    std::vector<HitValue> hits;
+    auto reader = ROOT::RNTupleReader::Open("aos_events", fileName);
+    auto event = reader->GetView<EventAOS>("EventAOS");
+    for (auto i : reader->GetEntryRange()) {
+        for (const auto& h : event(i).hits) hits.emplace_back(h.EventID, h.fChannel, h.fPeakTime, h.fIntegral);
+    }
+    std::sort(hits.begin(), hits.end());
+    return hits;
+}
+
+// Element hits carry the hit ID event * hitsPerEvent + index instead of the event number
+template <typename Hit>
+std::vector<HitValue> elementHits(const std::string& fileName, const std::string& ntupleName, int hitsPerEvent) {
+    std::vector<HitValue> hits;
+    auto reader = ROOT::RNTupleReader::Open(ntupleName, fileName);
+    auto hit = reader->GetView<Hit>("hit");
+    for (auto i : reader->GetEntryRange()) {
+        const auto& h = hit(i);
+        hits.emplace_back(h.EventID / hitsPerEvent, h.fChannel, h.fPeakTime, h.fIntegral);
+    }
+    std::sort(hits.begin(), hits.end());
+    return hits;
+}
+
+} // namespace
+
+// Physics samples depend on the channel (pedestal, plane), so ROIs keyed on anything but the
+// wire's channel differ between layouts
+TEST(ElementRoisTest, ElementRoisMatchEventRoisOfTheSameWire) {
+    GeneratorModeGuard guard;
+    const std::string eventFile = "temp_rois_event.root";
+    const std::string aosFile = "temp_rois_aos_element.root";
+    const std::string soaFile = "temp_rois_soa_element.root";
+    for (auto mode : {GeneratorMode::Uniform, GeneratorMode::Physics}) {
+        SCOPED_TRACE(generatorModeName(mode));
+        setGeneratorMode(mode);
+        writeLayout("aos_event_all", 12, 1, 3, 4, 2, eventFile, 2);
+        writeLayout("aos_element_perGroup", 12, 1, 3, 4, 2, aosFile, 2);
+        writeLayout("soa_element_perGroup", 12, 1, 3, 4, 2, soaFile, 2);
+
+        const auto expected = eventRois(eventFile);
+        ASSERT_FALSE(expected.empty());
+        EXPECT_EQ(elementRois<FlatROI>(aosFile, "element_rois"), expected);
+        EXPECT_EQ(elementRois<FlatSOAROI>(soaFile, "soa_element_rois"), expected);
+    }
+    std::filesystem::remove(eventFile);
+    std::filesystem::remove(aosFile);
+    std::filesystem::remove(soaFile);
+}
+
+TEST(ElementRoisTest, ElementHitsMatchEventHits) {
+    const std::string eventFile = "temp_hits_event.root";
+    const std::string aosFile = "temp_hits_aos_element.root";
+    const std::string soaFile = "temp_hits_soa_element.root";
+    writeLayout("aos_event_all", 12, 1, 3, 4, 2, eventFile, 2);
+    writeLayout("aos_element_perGroup", 12, 1, 3, 4, 2, aosFile, 2);
+    writeLayout("soa_element_perGroup", 12, 1, 3, 4, 2, soaFile, 3);
+
+    const auto expected = eventHits(eventFile);
+    ASSERT_EQ(expected.size(), 36u);
+    EXPECT_EQ(elementHits<HitIndividual>(aosFile, "element_hits", 3), expected);
+    EXPECT_EQ(elementHits<SOAHit>(soaFile, "soa_element_hits", 3), expected);
+    std::filesystem::remove(eventFile);
+    std::filesystem::remove(aosFile);
+    std::filesystem::remove(soaFile);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleReader.hxx>
+#include <ROOT/RNTupleWriter.hxx>
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <vector>
+#include "EventIndex.hpp"
+#include "EventSizes.hpp"
+#include "Hit.hpp"
+#include "HitWireWriters.hpp"
+#include "Wire.hpp"
+
+TEST(EventIndexTest, SortMergesTouchingRuns) {
+    auto ranges = sortEventRanges({{2, 10, 3}, {1, 0, 2}, {2, 13, 2}, {1, 5, 1}, {3, 20, 0}});
+    ASSERT_EQ(ranges.size(), 3u);
+    EXPECT_EQ(ranges[0].eventId, 1);
+    EXPECT_EQ(ranges[0].firstEntry, 0u);
+    EXPECT_EQ(ranges[1].firstEntry, 5u);
+    EXPECT_EQ(ranges[2].eventId, 2);
+    EXPECT_EQ(ranges[2].nEntries, 5u); // [10,13) and [13,15) merged
+
+    EventIndex index(ranges);
+    using Ranges = std::vector<std::pair<std::uint64_t, std::uint64_t>>;
+    EXPECT_EQ(index.lookup(1), (Ranges{{0, 2}, {5, 6}}));
+    EXPECT_EQ(index.lookup(2), (Ranges{{10, 15}}));
+    EXPECT_TRUE(index.lookup(3).empty());
+}
+
+TEST(EventIndexTest, SidecarRoundTrip) {
+    const std::string path = "temp_event_index.root";
+    // Interleaved like clusters committed by different fill threads
+    const std::vector<long long> eventIds = {0, 0, 1, 1, 1, 0, 2, 2};
+    {
+        auto model = ROOT::RNTupleModel::Create();
+        auto hit = model->MakeField<HitIndividual>("hit");
+        auto writer = ROOT::RNTupleWriter::Recreate(std::move(model), "element_hits", path);
+        for (std::size_t i = 0; i < eventIds.size(); ++i) {
+            *hit = HitIndividual{};
+            hit->EventID = eventIds[i];
+            hit->fChannel = static_cast<unsigned int>(i);
+            writer->Fill();
+        }
+    }
+
+    auto report = writeEventIndexes(path);
+    EXPECT_EQ(report.ntuples, 1);
+    EXPECT_EQ(report.ranges, 4u);
+    EXPECT_EQ(writeEventIndexes(path).ntuples, 0); // already indexed
+
+    auto index = EventIndex::load(path, "element_hits");
+    auto reader = ROOT::RNTupleReader::Open("element_hits", path);
+    EXPECT_EQ(findEventIdField(*reader), "hit.EventID");
+    auto hits = fetchEventObjects<HitIndividual>(*reader, index, "hit", 0);
+    ASSERT_EQ(hits.size(), 3u);
+    EXPECT_EQ(hits[0].fChannel, 0u);
+    EXPECT_EQ(hits[2].fChannel, 5u);
+
+    EventLookup lookup(path);
+    EXPECT_EQ(lookup.fetch(1), 3u);
+    EXPECT_EQ(lookup.fetchByScan(1), 3u);
+    std::filesystem::remove(path);
+}
+
+// The ROI ntuples of topObject perGroup keep the EventID inside vector<FlatROI> (AOS) or not at
+// all (SOA, parallel to the wires); both must come back whole through the index
+TEST(EventIndexTest, TopObjectPerGroupRoundTrip) {
+    const int kEvents = 6, kHits = 4, kWires = 3, kRois = 2;
+    const std::string aosPath = "temp_event_index_aos_top.root";
+    const std::string soaPath = "temp_event_index_soa_top.root";
+    writeLayout("aos_topObject_perGroup", kEvents, 1, kHits, kWires, kRois, aosPath, 2);
+    writeLayout("soa_topObject_perGroup", kEvents, 1, kHits, kWires, kRois, soaPath, 2);
+    EXPECT_EQ(writeEventIndexes(aosPath).ntuples, 3);
+    EXPECT_EQ(writeEventIndexes(soaPath).ntuples, 3);
+
+    auto aosWires = ROOT::RNTupleReader::Open("aos_top_wires", aosPath);
+    auto aosRois = ROOT::RNTupleReader::Open("aos_top_rois", aosPath);
+    auto soaWires = ROOT::RNTupleReader::Open("soa_top_wires", soaPath);
+    auto soaRois = ROOT::RNTupleReader::Open("soa_top_rois", soaPath);
+    auto aosWireIndex = EventIndex::load(aosPath, "aos_top_wires");
+    auto aosRoiIndex = EventIndex::load(aosPath, "aos_top_rois");
+    auto soaWireIndex = EventIndex::load(soaPath, "soa_top_wires");
+    auto soaRoiIndex = EventIndex::load(soaPath, "soa_top_rois");
+
+    EventLookup aosLookup(aosPath), soaLookup(soaPath);
+    EXPECT_EQ(aosLookup.ntuples().size(), 3u);
+    EXPECT_EQ(soaLookup.ntuples().size(), 3u);
+    for (long long evt = 0; evt < kEvents; ++evt) {
+        const EventSize size = eventSize(evt, kHits, kWires, kRois);
+        const std::size_t entries = size.hits + 2 * size.wires; // one ROI row per wire
+        EXPECT_EQ(aosLookup.fetch(evt), entries) << "event " << evt;
+        EXPECT_EQ(aosLookup.fetchByScan(evt), entries) << "event " << evt;
+        EXPECT_EQ(soaLookup.fetch(evt), entries) << "event " << evt;
+        EXPECT_EQ(soaLookup.fetchByScan(evt), entries) << "event " << evt;
+
+        // ROI samples per channel: AOS rows carry the WireID, SOA rows sit next to their wire
+        std::map<unsigned int, std::vector<std::vector<float>>> expected, actual;
+        for (const auto& rois : fetchEventObjects<std::vector<FlatROI>>(*aosRois, aosRoiIndex, "rois", evt)) {
+            for (const auto& r : rois) {
+                EXPECT_EQ(static_cast<long long>(r.EventID), evt);
+                expected[r.WireID].push_back(r.data);
+            }
+        }
+        auto wires = fetchEventObjects<SOAWireBase>(*soaWires, soaWireIndex, "wire", evt);
+        auto rois = fetchEventObjects<std::vector<SOAROI>>(*soaRois, soaRoiIndex, "rois", evt);
+        ASSERT_EQ(wires.size(), rois.size()) << "event " << evt;
+        for (std::size_t w = 0; w < wires.size(); ++w) {
+            EXPECT_EQ(wires[w].EventID, evt);
+            for (const auto& r : rois[w]) actual[wires[w].fWire_Channel].push_back(r.data);
+        }
+        EXPECT_EQ(fetchEventObjects<WireBase>(*aosWires, aosWireIndex, "wire", evt).size(), wires.size());
+        for (auto* m : {&expected, &actual}) {
+            for (auto& [channel, data] : *m) std::sort(data.begin(), data.end());
+        }
+        EXPECT_FALSE(expected.empty()) << "event " << evt;
+        EXPECT_TRUE(expected == actual) << "event " << evt << ": SOA ROIs differ from AOS";
+    }
+    std::filesystem::remove(aosPath);
+    std::filesystem::remove(soaPath);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include "ConfigGuards.hpp"
+#include "EventSizes.hpp"
+
+TEST(EventSizesTest, ParseSpec) {
+    auto config = parseEventSizeSpec("lognormal:0.8,huge:0.01:20,roilen");
+    EXPECT_EQ(config.distribution, SizeDistribution::LogNormal);
+    EXPECT_DOUBLE_EQ(config.sigma, 0.8);
+    EXPECT_DOUBLE_EQ(config.hugeFraction, 0.01);
+    EXPECT_DOUBLE_EQ(config.hugeFactor, 20.0);
+    EXPECT_DOUBLE_EQ(config.roiLengthSigma, 0.5);
+    EXPECT_EQ(parseEventSizeSpec("poisson").distribution, SizeDistribution::Poisson);
+    EXPECT_THROW(parseEventSizeSpec("gamma"), std::invalid_argument);
+    EXPECT_THROW(parseEventSizeSpec("huge:2"), std::invalid_argument);
+    EXPECT_THROW(parseEventSizeSpec("lognormal:x"), std::invalid_argument);
+}
+
+TEST(EventSizesTest, FixedKeepsNominalSizes) {
+    EventSizeGuard guard;
+    setEventSizeConfig(EventSizeConfig{});
+    for (long long evt = 0; evt < 100; ++evt) {
+        const auto size = eventSize(evt, 100, 50, 10);
+        EXPECT_EQ(size.hits, 100);
+        EXPECT_EQ(size.wires, 50);
+        EXPECT_EQ(size.roisPerWire, 10);
+    }
+    const auto max = maxEventSize(100, 50, 10);
+    EXPECT_EQ(max.hits, 100);
+    EXPECT_EQ(max.wires, 50);
+    std::mt19937 a(3), b(3);
+    EXPECT_EQ(drawROILength(a), 10u);
+    EXPECT_EQ(a(), b()); // fixed ROI length does not consume the generator
+}
+
+TEST(EventSizesTest, LogNormalKeepsMeanWithinCap) {
+    EventSizeGuard guard;
+    setEventSizeConfig(parseEventSizeSpec("lognormal:0.8"));
+    const auto max = maxEventSize(100, 50, 10);
+    const int n = 20000;
+    double hits = 0.0;
+    bool varies = false;
+    for (long long evt = 0; evt < n; ++evt) {
+        const auto size = eventSize(evt, 100, 50, 10);
+        EXPECT_LE(size.hits, max.hits);
+        EXPECT_LE(size.wires, max.wires);
+        EXPECT_LE(size.roisPerWire, max.roisPerWire);
+        varies = varies || size.hits != 100;
+        hits += size.hits;
+    }
+    EXPECT_TRUE(varies);
+    EXPECT_NEAR(hits / n, 100.0, 5.0);
+    // Same event, same size
+    EXPECT_EQ(eventSize(42, 100, 50, 10).hits, eventSize(42, 100, 50, 10).hits);
+}
+
+TEST(EventSizesTest, HugeEventsRaiseTheMean) {
+    EventSizeGuard guard;
+    setEventSizeConfig(parseEventSizeSpec("huge:0.1:10"));
+    EXPECT_DOUBLE_EQ(meanEventScale(), 1.9);
+    int huge = 0;
+    for (long long evt = 0; evt < 10000; ++evt) {
+        const auto size = eventSize(evt, 100, 50, 10);
+        if (size.hits == 1000) ++huge;
+        EXPECT_EQ(size.roisPerWire, 10);
+    }
+    EXPECT_NEAR(huge / 10000.0, 0.1, 0.02);
+}
+
+TEST(EventSizesTest, MeanROILengthMatchesDraws) {
+    EventSizeGuard guard;
+    EXPECT_DOUBLE_EQ(meanROILength(), 10.0);
+    for (double sigma : {0.5, 1.5}) {
+        EventSizeConfig config;
+        config.roiLengthSigma = sigma;
+        setEventSizeConfig(config);
+        std::mt19937 rng(11);
+        const int n = 200000;
+        double sum = 0.0;
+        for (int i = 0; i < n; ++i) sum += drawROILength(rng);
+        EXPECT_NEAR(meanROILength(), sum / n, 0.1) << "sigma " << sigma;
+    }
+}
@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <stdexcept>
+#include "FlatColumns.hpp"
+
+TEST(FlatColumnsTest, RoundTripHasExpectedSizes) {
+    const std::string dir = "test_flat_columns";
+    const auto written = writeFlatColumns(dir, 20, 5, 3, 2, 1);
+    const auto read = readFlatColumns(dir, 1);
+    EXPECT_EQ(read.events, 20u);
+    EXPECT_EQ(read.hits, 100u);
+    EXPECT_EQ(read.wires, 60u);
+    EXPECT_EQ(read.rois, 120u);
+    EXPECT_EQ(read.samples, 1200u); // nominal ROI length of 10
+
+    // Nothing but the values: 24 bytes per event, 84 per hit, 16 per wire and ROI, 4 per sample
+    EXPECT_EQ(written.bytes, 20u * 24 + 100u * 84 + 60u * 16 + 120u * 16 + 1200u * 4);
+    EXPECT_EQ(read.bytes, written.bytes);
+    std::filesystem::remove_all(dir);
+}
+
+TEST(FlatColumnsTest, ContentIndependentOfThreads) {
+    const std::string dir = "test_flat_columns_threads";
+    writeFlatColumns(dir, 25, 4, 3, 2, 1);
+    const auto single = readFlatColumns(dir, 1);
+    writeFlatColumns(dir, 25, 4, 3, 2, 3);
+    EXPECT_TRUE(std::filesystem::exists(dir + "/event_id_2.bin"));
+    const auto parts = readFlatColumns(dir, 2);
+    EXPECT_EQ(parts.events, single.events);
+    EXPECT_EQ(parts.hits, single.hits);
+    EXPECT_EQ(parts.samples, single.samples);
+    EXPECT_EQ(parts.bytes, single.bytes);
+    EXPECT_EQ(parts.checksum, single.checksum);
+
+    // A truncated column no longer matches its offsets
+    std::filesystem::resize_file(dir + "/hit_rms_1.bin", 4);
+    EXPECT_THROW(readFlatColumns(dir, 1), std::runtime_error);
+    std::filesystem::remove_all(dir);
+}
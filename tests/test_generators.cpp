@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include "ConfigGuards.hpp"
+#include "EventSizes.hpp"
+#include "HitWireGenerators.hpp"
+
+TEST(GeneratorTest, ModeNamesRoundTrip) {
+    EXPECT_EQ(parseGeneratorMode("uniform"), GeneratorMode::Uniform);
+    EXPECT_EQ(parseGeneratorMode(generatorModeName(GeneratorMode::Physics)), GeneratorMode::Physics);
+    EXPECT_THROW(parseGeneratorMode("gaussian"), std::invalid_argument);
+}
+
+TEST(GeneratorTest, PhysicsHitsFollowGeometry) {
+    GeneratorModeGuard guard;
+    setGeneratorMode(GeneratorMode::Physics);
+    std::mt19937 rng(42);
+    for (int i = 0; i < 1000; ++i) {
+        const auto hit = generateRandomHitIndividual(i, rng);
+        EXPECT_EQ(hit.fView, hit.fWireID_Plane);
+        EXPECT_EQ(hit.fChannel, static_cast<unsigned int>((hit.fWireID_TPC * 3 + hit.fWireID_Plane) * 800 + hit.fWireID_Wire));
+        EXPECT_EQ(hit.fSignalType, hit.fWireID_Plane == 2 ? 1 : 0);
+        EXPECT_LT(hit.fStartTick, hit.fEndTick);
+        EXPECT_GE(hit.fPeakAmplitude, 0.0f);
+        EXPECT_LT(hit.fLocalIndex, hit.fMultiplicity);
+    }
+}
+
+TEST(GeneratorTest, PhysicsWiresHaveOrderedIntegerROIs) {
+    GeneratorModeGuard guard;
+    setGeneratorMode(GeneratorMode::Physics);
+    std::mt19937 rng(7);
+    const auto wire = generateRandomWireIndividual(3, 8, rng);
+    ASSERT_EQ(wire.fSignalROI.size(), 8u);
+    for (std::size_t r = 0; r < wire.fSignalROI.size(); ++r) {
+        const auto& roi = wire.fSignalROI[r];
+        ASSERT_EQ(roi.data.size(), 10u);
+        if (r > 0) {
+            const auto& prev = wire.fSignalROI[r - 1];
+            EXPECT_GE(roi.offset, prev.offset + prev.data.size());
+        }
+        for (float v : roi.data) EXPECT_EQ(v, std::round(v));
+    }
+}
+
+TEST(GeneratorTest, UniformModeIsUnchanged) {
+    std::mt19937 a(11), b(11);
+    const auto wire = generateRandomWireIndividual(0, 2, a);
+    std::uniform_int_distribution<unsigned int> distWireChannel(0, 1023);
+    EXPECT_EQ(wire.fWire_Channel, distWireChannel(b));
+    for (const auto& roi : wire.fSignalROI) {
+        ASSERT_EQ(roi.data.size(), 10u);
+        for (float v : roi.data) {
+            EXPECT_GE(v, 0.0f);
+            EXPECT_LT(v, 100.0f);
+        }
+    }
+}
+
+TEST(GeneratorTest, VariableROILengths) {
+    GeneratorModeGuard guard;
+    EventSizeGuard sizeGuard;
+    setGeneratorMode(GeneratorMode::Physics);
+    setEventSizeConfig(parseEventSizeSpec("roilen:0.7"));
+    std::mt19937 rng(5);
+    const auto wire = generateRandomWireIndividual(1, 20, rng);
+    std::size_t shortest = maxROILength(), longest = 0;
+    for (std::size_t r = 0; r < wire.fSignalROI.size(); ++r) {
+        const auto& roi = wire.fSignalROI[r];
+        shortest = std::min(shortest, roi.data.size());
+        longest = std::max(longest, roi.data.size());
+        if (r > 0) {
+            const auto& prev = wire.fSignalROI[r - 1];
+            EXPECT_GE(roi.offset, prev.offset + prev.data.size());
+        }
+    }
+    EXPECT_GE(shortest, 1u);
+    EXPECT_LE(longest, maxROILength());
+    EXPECT_LT(shortest, longest);
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleWriter.hxx>
+#include <TFile.h>
+#include <filesystem>
+#include <memory>
+#include <vector>
+#include "ConfigGuards.hpp"
+#include "Hit.hpp"
+#include "JoinReader.hpp"
+#include "Wire.hpp"
+
+namespace {
+
+// "split_hits": one hit per entry; "split_events": one vector of hits per entry. A cluster is
+// committed after every clusterEvery entries of split_hits.
+void writeSplitFile(const std::string& path, const std::vector<long long>& hitIds,
+                    const std::vector<std::vector<long long>>& eventIds, int clusterEvery) {
+    {
+        auto model = ROOT::RNTupleModel::Create();
+        auto hit = model->MakeField<HitIndividual>("hit");
+        auto writer = ROOT::RNTupleWriter::Recreate(std::move(model), "split_hits", path);
+        for (std::size_t i = 0; i < hitIds.size(); ++i) {
+            *hit = HitIndividual{};
+            hit->EventID = hitIds[i];
+            writer->Fill();
+            if ((i + 1) % clusterEvery == 0) writer->CommitCluster();
+        }
+    }
+    std::unique_ptr<TFile> file(TFile::Open(path.c_str(), "UPDATE"));
+    auto model = ROOT::RNTupleModel::Create();
+    auto hits = model->MakeField<std::vector<HitIndividual>>("hits");
+    auto writer = ROOT::RNTupleWriter::Append(std::move(model), "split_events", *file);
+    for (const auto& ids : eventIds) {
+        hits->clear();
+        for (long long id : ids) {
+            HitIndividual h{};
+            h.EventID = id;
+            hits->push_back(h);
+        }
+        writer->Fill();
+    }
+}
+
+// SOA event layout: "soa_split_hits" and "soa_split_wires" keep their EventIDs in the
+// EventIDs vector of one record per entry, one event per entry
+void writeSOASplitFile(const std::string& path, const std::vector<std::vector<long long>>& hitEvents,
+                       const std::vector<std::vector<long long>>& wireEvents) {
+    {
+        auto model = ROOT::RNTupleModel::Create();
+        auto hits = model->MakeField<SOAHitVector>("hits");
+        auto writer = ROOT::RNTupleWriter::Recreate(std::move(model), "soa_split_hits", path);
+        for (const auto& ids : hitEvents) {
+            *hits = SOAHitVector{};
+            hits->EventIDs = ids;
+            writer->Fill();
+        }
+    }
+    std::unique_ptr<TFile> file(TFile::Open(path.c_str(), "UPDATE"));
+    auto model = ROOT::RNTupleModel::Create();
+    auto wires = model->MakeField<SOAWireVector>("wires");
+    auto writer = ROOT::RNTupleWriter::Append(std::move(model), "soa_split_wires", *file);
+    for (const auto& ids : wireEvents) {
+        *wires = SOAWireVector{};
+        wires->EventIDs = ids;
+        writer->Fill();
+    }
+}
+
+} // namespace
+
+TEST(JoinReaderTest, AllDataProductFileFor) {
+    EXPECT_EQ(allDataProductFileFor("out/aos_event_perGroup.root"), "out/aos_event_all.root");
+    EXPECT_EQ(allDataProductFileFor("out/soa_element_perData.root"), "out/soa_element_all.root");
+    EXPECT_EQ(allDataProductFileFor("out/aos_spill_perGroup.root"), "");
+    EXPECT_EQ(allDataProductFileFor("out/aos_event_all.root"), "");
+    EXPECT_EQ(parseJoinMode("window"), JoinMode::Window);
+    EXPECT_THROW(parseJoinMode("nested-loop"), std::invalid_argument);
+}
+
+TEST(JoinReaderTest, HashJoinOnInterleavedEntries) {
+    const std::string path = "temp_join_hash.root";
+    writeSplitFile(path, {0, 0, 1, 2, 1, 2, 0}, {{2, 2}, {0, 0}, {}, {1, 1}, {3, 3}}, 3);
+
+    auto result = joinEventsByKey(path, 2);
+    EXPECT_EQ(result.mode, JoinMode::Hash);
+    EXPECT_EQ(result.sides, 2);
+    EXPECT_EQ(result.events, 3u);
+    EXPECT_EQ(result.keyedEntries, 11u); // the empty vector has no EventID
+    EXPECT_EQ(result.entries, 10u);      // event 3 only exists in split_events
+    EXPECT_THROW(joinEventsByKey(path, 2, JoinMode::Merge), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(JoinReaderTest, MergeJoinAcrossChunks) {
+    const std::string path = "temp_join_merge.root";
+    // Event 1 straddles the two clusters of split_hits
+    writeSplitFile(path, {0, 0, 1, 1, 2}, {{0}, {1}, {2}}, 3);
+
+    auto merged = joinEventsByKey(path, 2);
+    EXPECT_EQ(merged.mode, JoinMode::Merge);
+    EXPECT_EQ(merged.events, 3u);
+    EXPECT_EQ(merged.entries, 8u);
+
+    auto hashed = joinEventsByKey(path, 2, JoinMode::Hash);
+    EXPECT_EQ(hashed.events, merged.events);
+    EXPECT_EQ(hashed.entries, merged.entries);
+    std::filesystem::remove(path);
+}
+
+TEST(JoinReaderTest, WindowJoinMatchesHash) {
+    JoinWindowGuard windowGuard;
+    const std::string path = "temp_join_window.root";
+    // The first cluster of split_hits and the only cluster of split_events span several
+    // EventIDs, so small windows read them more than once
+    writeSplitFile(path, {0, 4, 1, 1, 2, 2, 3, 3, 4}, {{0}, {1, 1}, {2}, {}, {3}, {4}, {5}}, 3);
+
+    auto hashed = joinEventsByKey(path, 2, JoinMode::Hash);
+    EXPECT_EQ(hashed.events, 5u);
+    EXPECT_EQ(hashed.entries, 14u); // event 5 only exists in split_events
+    for (std::uint64_t budget : {1u, 3u, 100u}) {
+        SCOPED_TRACE(budget);
+        setJoinWindowEntries(budget);
+        auto windowed = joinEventsByKey(path, 2, JoinMode::Window);
+        EXPECT_EQ(windowed.mode, JoinMode::Window);
+        EXPECT_EQ(windowed.sides, 2);
+        EXPECT_EQ(windowed.events, hashed.events);
+        EXPECT_EQ(windowed.entries, hashed.entries);
+        EXPECT_EQ(windowed.keyedEntries, hashed.keyedEntries);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(JoinReaderTest, JoinsOnSOAEventIDs) {
+    const std::string path = "temp_join_soa.root";
+    writeSOASplitFile(path, {{2, 2}, {0, 0, 0}, {1}}, {{1, 1}, {}, {0}, {2, 2}});
+
+    auto result = joinEventsByKey(path, 2);
+    EXPECT_EQ(result.mode, JoinMode::Hash);
+    EXPECT_EQ(result.sides, 2);
+    EXPECT_EQ(result.events, 3u);
+    EXPECT_EQ(result.keyedEntries, 6u); // the empty wire vector has no EventID
+    EXPECT_EQ(result.entries, 6u);
+
+    auto single = joinEventsByKey(path, 1, JoinMode::Hash);
+    EXPECT_EQ(single.events, result.events);
+    EXPECT_EQ(single.entries, result.entries);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleReader.hxx>
+#include <ROOT/RNTupleWriter.hxx>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include "ConfigGuards.hpp"
+#include "HitWireWriterHelpers.hpp"
+#include "JoinReader.hpp"
+#include "LayoutConverter.hpp"
+
+namespace {
+
+auto hitValues(const HitIndividual& h) {
+    return std::make_tuple(h.EventID, h.fChannel, h.fView, h.fStartTick, h.fEndTick, h.fPeakTime, h.fSigmaPeakTime,
+                           h.fRMS, h.fPeakAmplitude, h.fSigmaPeakAmplitude, h.fROISummedADC, h.fHitSummedADC,
+                           h.fIntegral, h.fSigmaIntegral, h.fMultiplicity, h.fLocalIndex, h.fGoodnessOfFit, h.fNDF,
+                           h.fSignalType, h.fWireID_Cryostat, h.fWireID_TPC, h.fWireID_Plane, h.fWireID_Wire);
+}
+
+std::vector<EventAOS> writeSourceEvents(const std::string& path, int nEvents) {
+    std::vector<EventAOS> events(nEvents);
+    auto model = ROOT::RNTupleModel::Create();
+    auto event = model->MakeField<EventAOS>("EventAOS");
+    auto writer = ROOT::RNTupleWriter::Recreate(std::move(model), "aos_events", path);
+    for (int e = 0; e < nEvents; ++e) {
+        events[e].hits = generateEventHitsDeterministic(e, 3);
+        events[e].wires = generateEventWiresDeterministic(e, 2, 2);
+        // Distinct channels, so ROIs stored apart from their wire find it unambiguously
+        for (std::size_t w = 0; w < events[e].wires.size(); ++w) events[e].wires[w].fWire_Channel = 100 + w;
+        *event = events[e];
+        writer->Fill();
+        if (e % 2 == 1) writer->CommitCluster();
+    }
+    return events;
+}
+
+} // namespace
+
+TEST(LayoutConverterTest, LayoutNamesRoundTrip) {
+    const auto layouts = allStorageLayouts();
+    ASSERT_EQ(layouts.size(), 24u);
+    for (const auto& layout : layouts) {
+        const auto parsed = parseStorageLayout(storageLayoutName(layout));
+        EXPECT_EQ(parsed.soa, layout.soa);
+        EXPECT_EQ(parsed.group, layout.group);
+        EXPECT_EQ(parsed.product, layout.product);
+    }
+    EXPECT_EQ(storageLayoutName(layouts.front()), "aos_event_all");
+    EXPECT_THROW(parseStorageLayout("aos_event_perHit"), std::invalid_argument);
+}
+
+TEST(LayoutConverterTest, EventAllToElementPerGroup) {
+    const std::string path = "temp_convert_in.root";
+    const std::string out = "temp_convert_out.root";
+    const int nEvents = 6, hitsPerEvent = 3, wiresPerEvent = 2, roisPerWire = 2;
+    {
+        auto model = ROOT::RNTupleModel::Create();
+        auto event = model->MakeField<EventAOS>("EventAOS");
+        auto writer = ROOT::RNTupleWriter::Recreate(std::move(model), "aos_events", path);
+        for (int e = 0; e < nEvents; ++e) {
+            event->hits = generateEventHitsDeterministic(e, hitsPerEvent);
+            event->wires = generateEventWiresDeterministic(e, wiresPerEvent, roisPerWire);
+            writer->Fill();
+            if (e % 2 == 1) writer->CommitCluster();
+        }
+    }
+
+    ConversionConfig config;
+    config.nThreads = 2;
+    auto result = convertLayout(path, out, parseStorageLayout("aos_element_perGroup"), config);
+    EXPECT_EQ(result.events, static_cast<std::uint64_t>(nEvents));
+    EXPECT_EQ(result.hits, static_cast<std::uint64_t>(nEvents * hitsPerEvent));
+    EXPECT_EQ(result.wires, static_cast<std::uint64_t>(nEvents * wiresPerEvent));
+    EXPECT_EQ(result.rois, static_cast<std::uint64_t>(nEvents * wiresPerEvent * roisPerWire));
+    EXPECT_EQ(result.skippedEntries, 0u);
+
+    EXPECT_EQ(ROOT::RNTupleReader::Open("element_hits", out)->GetNEntries(), result.hits);
+    EXPECT_EQ(ROOT::RNTupleReader::Open("element_wires", out)->GetNEntries(), result.wires);
+    auto rois = ROOT::RNTupleReader::Open("element_rois", out);
+    ASSERT_EQ(rois->GetNEntries(), result.rois);
+    auto roi = rois->GetView<FlatROI>("roi");
+    for (std::uint64_t i = 0; i < rois->GetNEntries(); ++i) EXPECT_FALSE(roi(i).data.empty());
+    std::filesystem::remove(path);
+    std::filesystem::remove(out);
+}
+
+// Every layout is written from aos_event_all and converted back, so each one is read as a source.
+// Small join windows make every conversion read its input over several EventID windows.
+TEST(LayoutConverterTest, ValuesRoundTripThroughEveryLayout) {
+    JoinWindowGuard windowGuard;
+    setJoinWindowEntries(4);
+    const std::string path = "temp_roundtrip_in.root";
+    const std::string via = "temp_roundtrip_via.root";
+    const std::string back = "temp_roundtrip_back.root";
+    const auto expected = writeSourceEvents(path, 6);
+    ConversionConfig config;
+    config.nThreads = 2;
+    config.numSpills = 2;
+    const auto eventAll = parseStorageLayout("aos_event_all");
+
+    for (const auto& layout : allStorageLayouts()) {
+        const std::string name = storageLayoutName(layout);
+        SCOPED_TRACE(name);
+        convertLayout(path, via, layout, config);
+        auto result = convertLayout(via, back, eventAll, config);
+        EXPECT_EQ(result.events, expected.size());
+        EXPECT_EQ(result.skippedEntries, 0u);
+
+        const bool keepsOffset = !layout.soa || layout.group == LayoutGroup::Element;
+        const bool keepsView = !(layout.soa && layout.group == LayoutGroup::Element && layout.product == LayoutProduct::PerData);
+        auto reader = ROOT::RNTupleReader::Open("aos_events", back);
+        ASSERT_EQ(reader->GetNEntries(), expected.size());
+        auto view = reader->GetView<EventAOS>("EventAOS");
+        std::map<long long, EventAOS> byId; // the parallel writer does not keep the event order
+        for (std::uint64_t i = 0; i < reader->GetNEntries(); ++i) {
+            ASSERT_FALSE(view(i).hits.empty());
+            byId[view(i).hits.front().EventID] = view(i);
+        }
+        ASSERT_EQ(byId.size(), expected.size());
+        for (std::size_t e = 0; e < expected.size(); ++e) {
+            const auto& want = expected[e];
+            const auto& got = byId[static_cast<long long>(e)];
+            ASSERT_EQ(got.hits.size(), want.hits.size());
+            for (std::size_t h = 0; h < want.hits.size(); ++h) EXPECT_EQ(hitValues(got.hits[h]), hitValues(want.hits[h]));
+            ASSERT_EQ(got.wires.size(), want.wires.size());
+            for (std::size_t w = 0; w < want.wires.size(); ++w) {
+                const auto& gw = got.wires[w];
+                const auto& ww = want.wires[w];
+                EXPECT_EQ(gw.EventID, ww.EventID);
+                EXPECT_EQ(gw.fWire_Channel, ww.fWire_Channel);
+                EXPECT_EQ(gw.fWire_View, keepsView ? ww.fWire_View : 0);
+                ASSERT_EQ(gw.getSignalROI().size(), ww.getSignalROI().size());
+                for (std::size_t r = 0; r < ww.getSignalROI().size(); ++r) {
+                    EXPECT_EQ(gw.getSignalROI()[r].data, ww.getSignalROI()[r].data);
+                    EXPECT_EQ(gw.getSignalROI()[r].offset, keepsOffset ? ww.getSignalROI()[r].offset : 0u);
+                }
+            }
+        }
+    }
+    std::filesystem::remove(path);
+    std::filesystem::remove(via);
+    std::filesystem::remove(back);
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <ROOT/RNTupleReader.hxx>
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "EventIndex.hpp"
+#include "HitWireWriters.hpp"
+#include "LayoutConverter.hpp"
+#include "MultiProcess.hpp"
+#include "Utils.hpp"
+
+namespace {
+
+// EventIDs of every ntuple, appended over files and sorted; empty for ntuples without one
+void appendEventIds(const std::string& fileName, std::map<std::string, std::vector<long long>>& ids) {
+    for (const auto& name : Utils::list_ntuples(fileName)) {
+        auto reader = ROOT::RNTupleReader::Open(name, fileName);
+        auto& keys = ids[name];
+        EventKeyColumn column;
+        if (!findEventKeyColumn(*reader, column)) continue;
+        const std::size_t offset = keys.size();
+        keys.resize(offset + reader->GetNEntries());
+        readEventKeys(*reader, column, 0, reader->GetNEntries(), keys.data() + offset);
+        std::sort(keys.begin(), keys.end());
+    }
+}
+
+} // namespace
+
+TEST(MultiProcessTest, RankTaskRoundTrip) {
+    RankTask task;
+    task.layout = "soa_topObject_perGroup";
+    task.file = "out/soa_topObject_perGroup_rank2.root";
+    task.firstEvent = 40;
+    task.events = 25;
+    task.threads = 2;
+    task.firstSlot = 4;
+    task.goFd = 7;
+    task.resultFd = 9;
+    EXPECT_EQ(formatRankTask(task), "soa_topObject_perGroup,out/soa_topObject_perGroup_rank2.root,40,25,2,4,7,9");
+    const auto parsed = parseRankTask(formatRankTask(task));
+    EXPECT_EQ(parsed.layout, task.layout);
+    EXPECT_EQ(parsed.file, task.file);
+    EXPECT_EQ(parsed.firstEvent, task.firstEvent);
+    EXPECT_EQ(parsed.events, task.events);
+    EXPECT_EQ(parsed.threads, task.threads);
+    EXPECT_EQ(parsed.firstSlot, task.firstSlot);
+    EXPECT_EQ(parsed.goFd, task.goFd);
+    EXPECT_EQ(parsed.resultFd, task.resultFd);
+
+    EXPECT_THROW(parseRankTask(""), std::invalid_argument);
+    EXPECT_THROW(parseRankTask("aos_event_all,f.root,0,10,1,0,3"), std::invalid_argument);
+    EXPECT_THROW(parseRankTask("aos_event_all,f.root,0,10,1,0,3,4,5"), std::invalid_argument);
+    EXPECT_THROW(parseRankTask("aos_event_all,f.root,zero,10,1,0,3,4"), std::invalid_argument);
+    EXPECT_THROW(parseRankTask("aos_event_all,f.root,0,10x,1,0,3,4"), std::invalid_argument);
+    EXPECT_THROW(parseRankTask("aos_event_all,f.root,-1,10,1,0,3,4"), std::invalid_argument);
+    EXPECT_THROW(parseRankTask("aos_event_all,f.root,0,10,0,0,3,4"), std::invalid_argument);
+    EXPECT_THROW(parseRankTask(",f.root,0,10,1,0,3,4"), std::invalid_argument);
+}
+
+TEST(MultiProcessTest, PlanCoversEveryEventOnce) {
+    for (int ranks = 1; ranks <= 5; ++ranks) {
+        for (int numEvents = 0; numEvents <= 12; ++numEvents) {
+            MultiProcessConfig config;
+            config.ranks = ranks;
+            config.threadsPerRank = 2;
+            std::vector<int> seen(numEvents, 0);
+            int nextSlot = 0;
+            for (const auto& task : planRankTasks("aos_event_all", config, numEvents, "out")) {
+                EXPECT_GT(task.events, 0);
+                EXPECT_GE(task.firstSlot, nextSlot); // ranks pin to disjoint slots
+                nextSlot = task.firstSlot + task.threads;
+                for (int e = task.firstEvent; e < task.firstEvent + task.events; ++e) {
+                    ASSERT_LT(e, numEvents);
+                    ++seen[e];
+                }
+            }
+            for (int e = 0; e < numEvents; ++e) EXPECT_EQ(seen[e], 1) << ranks << " ranks, event " << e;
+        }
+    }
+}
+
+// The ranks run one after the other in this process; spill and topObject ranks must start at
+// their first spill or slot, not at the event number
+TEST(MultiProcessTest, RanksTogetherWriteEveryEventOnce) {
+    const std::string dir = "temp_ranks";
+    std::filesystem::create_directories(dir);
+    const int numEvents = 10, numSpills = 2;
+    MultiProcessConfig config;
+    config.ranks = 3;
+    for (const auto& layout : allStorageLayouts()) {
+        const std::string name = storageLayoutName(layout);
+        SCOPED_TRACE(name);
+        std::map<std::string, std::vector<long long>> single, ranked;
+        const std::string singleFile = dir + "/" + name + ".root";
+        writeLayout(name, numEvents, numSpills, 4, 3, 2, singleFile, 1);
+        appendEventIds(singleFile, single);
+        for (const auto& task : planRankTasks(name, config, numEvents, dir)) {
+            writeRankSlice(task, numSpills, 4, 3, 2);
+            appendEventIds(task.file, ranked);
+        }
+        EXPECT_EQ(ranked, single);
+        for (const auto& [ntuple, ids] : ranked) {
+            if (ids.empty()) continue;
+            std::vector<long long> distinct = ids;
+            distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+            std::vector<long long> expected(numEvents);
+            for (int e = 0; e < numEvents; ++e) expected[e] = e;
+            EXPECT_EQ(distinct, expected) << ntuple;
+        }
+    }
+    std::filesystem::remove_all(dir);
+}
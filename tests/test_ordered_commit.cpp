@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <ROOT/RNTupleReader.hxx>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "ConfigGuards.hpp"
+#include "HitWireWriters.hpp"
+#include "Hit.hpp"
+#include "Wire.hpp"
+
+namespace {
+
+struct ElementColumns {
+    std::vector<long long> hitIDs;
+    std::vector<float> hitPeaks;
+    std::vector<long long> wireEvents;
+    std::vector<unsigned int> wireChannels;
+};
+
+// soa_element_perGroup draws its hits from the block seed, so it shows seed differences
+ElementColumns writeOrdered(const std::string& fileName, int nThreads) {
+    std::filesystem::remove(fileName);
+    writeLayout("soa_element_perGroup", 40, 1, 6, 4, 2, fileName, nThreads);
+    ElementColumns columns;
+    auto hits = ROOT::RNTupleReader::Open("soa_element_hits", fileName);
+    auto hit = hits->GetView<SOAHit>("hit");
+    for (auto i : hits->GetEntryRange()) {
+        columns.hitIDs.push_back(hit(i).EventID);
+        columns.hitPeaks.push_back(hit(i).fPeakTime);
+    }
+    auto wires = ROOT::RNTupleReader::Open("soa_element_wires", fileName);
+    auto wire = wires->GetView<SOAWireBase>("wire");
+    for (auto i : wires->GetEntryRange()) {
+        columns.wireEvents.push_back(wire(i).EventID);
+        columns.wireChannels.push_back(wire(i).fWire_Channel);
+    }
+    std::filesystem::remove(fileName);
+    return columns;
+}
+
+} // namespace
+
+TEST(OrderedCommitTest, EventOrderAndContentIndependentOfThreads) {
+    CommitGuard guard;
+    WriterCommitConfig config;
+    config.ordered = true;
+    config.blockEvents = 3;
+    setWriterCommitConfig(config);
+
+    auto single = writeOrdered("test_ordered_commit_1.root", 1);
+    auto multi = writeOrdered("test_ordered_commit_3.root", 3);
+
+    ASSERT_EQ(single.hitIDs.size(), 40u * 6);
+    ASSERT_EQ(single.wireEvents.size(), 40u * 4);
+    for (std::size_t i = 1; i < multi.hitIDs.size(); ++i) {
+        EXPECT_LT(multi.hitIDs[i - 1], multi.hitIDs[i]) << "hit entry " << i;
+    }
+    for (std::size_t i = 1; i < multi.wireEvents.size(); ++i) {
+        EXPECT_LE(multi.wireEvents[i - 1], multi.wireEvents[i]) << "wire entry " << i;
+    }
+    EXPECT_EQ(single.hitIDs, multi.hitIDs);
+    EXPECT_EQ(single.hitPeaks, multi.hitPeaks);
+    EXPECT_EQ(single.wireEvents, multi.wireEvents);
+    EXPECT_EQ(single.wireChannels, multi.wireChannels);
+}
+
+TEST(OrderedCommitTest, DefaultBlocksKeepEventOrder) {
+    CommitGuard guard;
+    WriterCommitConfig config;
+    config.ordered = true;
+    setWriterCommitConfig(config);
+
+    auto columns = writeOrdered("test_ordered_commit_default.root", 4);
+    ASSERT_EQ(columns.hitIDs.size(), 40u * 6);
+    for (std::size_t i = 1; i < columns.hitIDs.size(); ++i) {
+        EXPECT_LT(columns.hitIDs[i - 1], columns.hitIDs[i]) << "hit entry " << i;
+    }
+}
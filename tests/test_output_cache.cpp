@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleReader.hxx>
+#include <ROOT/RNTupleWriter.hxx>
+#include <filesystem>
+#include "ConfigGuards.hpp"
+#include "HitWireGenerators.hpp"
+#include "OutputCache.hpp"
+
+namespace {
+
+void writeSmallFile(const std::string& fileName, int entries) {
+    auto model = ROOT::RNTupleModel::Create();
+    auto value = model->MakeField<int>("value");
+    auto writer = ROOT::RNTupleWriter::Recreate(std::move(model), "values", fileName);
+    for (int i = 0; i < entries; ++i) {
+        *value = i;
+        writer->Fill();
+    }
+}
+
+} // namespace
+
+TEST(OutputCacheTest, DescriptionFollowsConfiguration) {
+    CacheGuard guard;
+    GeneratorModeGuard generatorGuard;
+    const auto base = describeDataset("aos_event_all", 100, 10, 100, 100, 10, 4);
+    EXPECT_EQ(base, describeDataset("aos_event_all", 100, 10, 100, 100, 10, 4));
+    EXPECT_EQ(datasetHash(base), datasetHash(base));
+    EXPECT_EQ(datasetHash(base).size(), 16u);
+    // Spills only matter to the spill writers
+    EXPECT_EQ(base, describeDataset("aos_event_all", 100, 5, 100, 100, 10, 4));
+    EXPECT_NE(describeDataset("aos_spill_all", 100, 10, 100, 100, 10, 4),
+              describeDataset("aos_spill_all", 100, 5, 100, 100, 10, 4));
+    EXPECT_NE(base, describeDataset("aos_event_all", 100, 10, 100, 100, 10, 8));
+
+    setGeneratorMode(GeneratorMode::Physics);
+    const auto physics = describeDataset("aos_event_all", 100, 10, 100, 100, 10, 4);
+    EXPECT_NE(datasetHash(base), datasetHash(physics));
+}
+
+TEST(OutputCacheTest, ReusesTaggedFilesInPlaceAndFromCache) {
+    CacheGuard guard;
+    const std::string dir = "test_output_cache";
+    const std::string file = dir + "/aos_event_all.root";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    OutputCacheConfig config;
+    config.reuse = true;
+    config.cacheDir = dir + "/cache";
+    setOutputCacheConfig(config);
+
+    const auto description = describeDataset("aos_event_all", 50, 10, 100, 100, 10, 1);
+    const auto hash = datasetHash(description);
+    EXPECT_FALSE(reuseCachedDataset(file, hash));
+    writeSmallFile(file, 50);
+    EXPECT_EQ(readDatasetHash(file), "");
+    EXPECT_FALSE(reuseCachedDataset(file, hash)); // untagged files are never reused
+
+    storeDataset(file, description);
+    EXPECT_EQ(readDatasetHash(file), hash);
+    EXPECT_TRUE(std::filesystem::exists(config.cacheDir + "/" + hash + ".root"));
+    EXPECT_TRUE(reuseCachedDataset(file, hash));
+    EXPECT_FALSE(reuseCachedDataset(file, datasetHash(description + " changed")));
+
+    // A different dataset replaces the output file, the cached one comes back from the cache
+    writeSmallFile(file, 7);
+    EXPECT_TRUE(reuseCachedDataset(file, hash));
+    EXPECT_EQ(ROOT::RNTupleReader::Open("values", file)->GetNEntries(), 50u);
+    std::filesystem::remove_all(dir);
+}
+
+TEST(OutputCacheTest, LeavesFilesUntaggedWithoutReuse) {
+    CacheGuard guard;
+    const std::string dir = "test_output_cache_off";
+    const std::string file = dir + "/aos_event_all.root";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    writeSmallFile(file, 5);
+    const auto description = describeDataset("aos_event_all", 5, 10, 100, 100, 10, 1);
+
+    storeDatasets({{file, description}});
+    EXPECT_EQ(readDatasetHash(file), "");
+
+    OutputCacheConfig config;
+    config.reuse = true;
+    setOutputCacheConfig(config);
+    storeDatasets({{file, description}});
+    EXPECT_EQ(readDatasetHash(file), datasetHash(description));
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleParallelWriter.hxx>
+#include <ROOT/RNTupleReader.hxx>
+#include <filesystem>
+#include <stdexcept>
+#include "ConfigGuards.hpp"
+#include "HitWireWriters.hpp"
+#include "OutputSink.hpp"
+
+namespace {
+
+Long64_t writeValues(TFile& file, int entries) {
+    auto model = ROOT::RNTupleModel::Create();
+    model->MakeField<int>("value");
+    {
+        auto writer = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(model), "values", file);
+        auto context = writer->CreateFillContext();
+        auto entry = context->CreateEntry();
+        for (int i = 0; i < entries; ++i) {
+            *entry->GetPtr<int>("value") = i;
+            context->Fill(*entry);
+        }
+    }
+    file.Write();
+    return file.GetEND();
+}
+
+} // namespace
+
+TEST(OutputSinkTest, ParseNames) {
+    EXPECT_EQ(parseSinkMode("file"), SinkMode::File);
+    EXPECT_EQ(parseSinkMode("memory"), SinkMode::Memory);
+    EXPECT_EQ(parseSinkMode("null"), SinkMode::Null);
+    EXPECT_EQ(sinkModeName(SinkMode::Null), "null");
+    EXPECT_THROW(parseSinkMode("disk"), std::invalid_argument);
+}
+
+TEST(OutputSinkTest, SinksSerializeTheSameBytes) {
+    SinkGuard guard;
+    const std::string fileName = "test_output_sink.root";
+    std::filesystem::remove(fileName);
+
+    setSinkMode(SinkMode::File);
+    Long64_t fileBytes = 0;
+    {
+        auto file = openOutputFile(fileName);
+        fileBytes = writeValues(*file, 10000);
+    }
+    EXPECT_EQ(ROOT::RNTupleReader::Open("values", fileName)->GetNEntries(), 10000u);
+    std::filesystem::remove(fileName);
+
+    for (SinkMode mode : {SinkMode::Memory, SinkMode::Null}) {
+        setSinkMode(mode);
+        auto file = openOutputFile(fileName);
+        // Same pages and metadata; only the file header records may differ
+        EXPECT_NEAR(writeValues(*file, 10000), fileBytes, 1024) << sinkModeName(mode);
+        file->Close();
+        EXPECT_FALSE(std::filesystem::exists(fileName)) << sinkModeName(mode);
+    }
+}
+
+TEST(OutputSinkTest, WritersRunIntoEverySink) {
+    SinkGuard guard;
+    const std::string fileName = "test_output_sink_writer.root";
+    for (SinkMode mode : {SinkMode::Memory, SinkMode::Null}) {
+        setSinkMode(mode);
+        std::filesystem::remove(fileName);
+        EXPECT_NO_THROW(writeLayout("aos_event_perGroup", 200, 4, 20, 20, 2, fileName, 2)) << sinkModeName(mode);
+        EXPECT_FALSE(std::filesystem::exists(fileName)) << sinkModeName(mode);
+    }
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include "ScalingAnalysis.hpp"
+
+// Builds (threads, time) points from an exact USL curve with a 1-thread time of t1
+static std::vector<std::pair<int, double>> MakeUSLPoints(const std::vector<int>& threads, double sigma, double kappa, double t1 = 10.0) {
+    std::vector<std::pair<int, double>> points;
+    for (int n : threads) {
+        points.emplace_back(n, t1 / uslSpeedup(sigma, kappa, n));
+    }
+    return points;
+}
+
+TEST(ScalingAnalysisTest, SpeedupAndEfficiencyRelativeToOneThread) {
+    auto fit = fitScaling("x", {{4, 2.5}, {1, 10.0}, {2, 5.0}});
+    ASSERT_TRUE(fit.valid);
+    EXPECT_EQ(fit.baselineThreads, 1);
+    EXPECT_EQ(fit.threads, (std::vector<int>{1, 2, 4}));
+    EXPECT_DOUBLE_EQ(fit.speedup[1], 2.0);
+    EXPECT_DOUBLE_EQ(fit.speedup[2], 4.0);
+    EXPECT_DOUBLE_EQ(fit.efficiency[2], 1.0);
+    EXPECT_NEAR(fit.amdahlSerial, 0.0, 1e-12);
+    EXPECT_NEAR(fit.uslKappa, 0.0, 1e-12);
+    EXPECT_EQ(fit.optimalThreadsInt, 0); // perfectly linear -> unbounded
+}
+
+TEST(ScalingAnalysisTest, RecoversUSLCoefficients) {
+    const double sigma = 0.05, kappa = 0.002;
+    auto fit = fitScaling("x", MakeUSLPoints({1, 2, 3, 4, 6, 8, 12, 16, 24, 32}, sigma, kappa));
+    ASSERT_TRUE(fit.valid);
+    EXPECT_NEAR(fit.uslSigma, sigma, 1e-9);
+    EXPECT_NEAR(fit.uslKappa, kappa, 1e-9);
+    EXPECT_NEAR(fit.uslR2, 1.0, 1e-9);
+    EXPECT_NEAR(fit.optimalThreads, std::sqrt((1 - sigma) / kappa), 1e-6);
+    // Integer optimum must be at least as good as its neighbours
+    int n = fit.optimalThreadsInt;
+    EXPECT_GE(uslSpeedup(sigma, kappa, n), uslSpeedup(sigma, kappa, n - 1));
+    EXPECT_GE(uslSpeedup(sigma, kappa, n), uslSpeedup(sigma, kappa, n + 1));
+}
+
+TEST(ScalingAnalysisTest, RecoversAmdahlSerialFraction) {
+    auto fit = fitScaling("x", MakeUSLPoints({1, 2, 4, 8}, 0.1, 0.0));
+    ASSERT_TRUE(fit.valid);
+    EXPECT_NEAR(fit.amdahlSerial, 0.1, 1e-9);
+    EXPECT_NEAR(fit.uslKappa, 0.0, 1e-9);
+    EXPECT_EQ(fit.optimalThreadsInt, 0);
+    EXPECT_NEAR(fit.peakSpeedup, 10.0, 1e-6);
+}
+
+TEST(ScalingAnalysisTest, NonOneBaselineAndSinglePoint) {
+    auto single = fitScaling("x", {{4, 1.0}});
+    EXPECT_FALSE(single.valid);
+    ASSERT_EQ(single.speedup.size(), 1u);
+    EXPECT_DOUBLE_EQ(single.speedup[0], 4.0);
+
+    auto fit = fitScaling("x", {{2, 4.0}, {4, 2.0}, {0, 1.0}, {8, -1.0}});
+    ASSERT_TRUE(fit.valid);
+    EXPECT_EQ(fit.baselineThreads, 2);
+    EXPECT_DOUBLE_EQ(fit.speedup[1], 4.0);
+}
+
+TEST(ScalingAnalysisTest, CoefficientsAreNonNegative) {
+    // Superlinear data would give negative coefficients without clamping
+    auto fit = fitScaling("x", {{1, 10.0}, {2, 4.0}, {4, 2.0}, {8, 1.0}});
+    ASSERT_TRUE(fit.valid);
+    EXPECT_GE(fit.uslSigma, 0.0);
+    EXPECT_GE(fit.uslKappa, 0.0);
+    EXPECT_GE(fit.amdahlSerial, 0.0);
+}
+
+TEST(ScalingAnalysisTest, ThreadCountLists) {
+    EXPECT_EQ(defaultScalingThreadCounts(8), (std::vector<int>{1, 2, 4, 8}));
+    EXPECT_EQ(defaultScalingThreadCounts(12), (std::vector<int>{1, 2, 4, 8, 12}));
+    EXPECT_EQ(parseThreadCounts("6,1,3-5,3,x,0"), (std::vector<int>{1, 3, 4, 5, 6}));
+}
+
+TEST(ScalingAnalysisTest, EventShapeLists) {
+    auto shapes = parseEventShapes("small,bogus,wide:50:400:4:10,bad:1:2:3,zero:1:1:1:0");
+    ASSERT_EQ(shapes.size(), 2u);
+    EXPECT_EQ(shapes[0].name, "small");
+    EXPECT_EQ(shapes[1].name, "wide");
+    EXPECT_EQ(shapes[1].hitsPerEvent, 50);
+    EXPECT_EQ(shapes[1].wiresPerEvent, 400);
+    EXPECT_EQ(shapes[1].roisPerWire, 4);
+    EXPECT_EQ(shapes[1].numSpills, 10);
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <ROOT/RNTupleReader.hxx>
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+#include "EventIndex.hpp"
+#include "LayoutConverter.hpp"
+#include "ShardedWrite.hpp"
+#include "Utils.hpp"
+
+namespace {
+
+// Sorted EventIDs of every ntuple (empty for ntuples without one); the shared writer commits
+// clusters in any order, so only the multiset is compared
+std::map<std::string, std::vector<long long>> eventIdsPerNtuple(const std::string& fileName) {
+    std::map<std::string, std::vector<long long>> ids;
+    for (const auto& name : Utils::list_ntuples(fileName)) {
+        auto reader = ROOT::RNTupleReader::Open(name, fileName);
+        auto& keys = ids[name];
+        EventKeyColumn column;
+        if (!findEventKeyColumn(*reader, column)) continue;
+        keys.resize(reader->GetNEntries());
+        readEventKeys(*reader, column, 0, keys.size(), keys.data());
+        std::sort(keys.begin(), keys.end());
+    }
+    return ids;
+}
+
+} // namespace
+
+// Shards start at events 0, 3 and 6; spill and topObject layouts count spills and slots, so
+// their shards must not start at the event number
+TEST(ShardedWriteTest, MergedShardsMatchSingleFileForEveryLayout) {
+    const std::string dir = "temp_sharded";
+    std::filesystem::create_directories(dir);
+    for (const auto& layout : allStorageLayouts()) {
+        const std::string name = storageLayoutName(layout);
+        SCOPED_TRACE(name);
+        auto result = runShardedWrite(name, 3, 10, 2, 4, 3, 2, dir);
+        EXPECT_EQ(result.shards, 3);
+        EXPECT_TRUE(result.entriesMatch);
+        const auto shared = eventIdsPerNtuple(dir + "/" + name + ".root");
+        const auto merged = eventIdsPerNtuple(dir + "/" + name + "_merged.root");
+        EXPECT_EQ(merged, shared);
+        for (const auto& [ntuple, ids] : shared) {
+            if (ids.empty()) continue;
+            EXPECT_EQ(ids.front(), 0) << ntuple;
+            EXPECT_EQ(ids.back(), 9) << ntuple;
+        }
+    }
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleReader.hxx>
+#include <ROOT/RNTupleWriter.hxx>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+#include "HitWireWriterHelpers.hpp"
+#include "HitWireWriters.hpp"
+#include "SpillReassembly.hpp"
+
+namespace {
+
+// Hits and wires of one event in stored order: EventID, channel, peak time / view, ROI samples
+using HitRow = std::tuple<long long, unsigned int, float>;
+using WireRow = std::tuple<long long, unsigned int, int, std::vector<std::vector<float>>>;
+using EventRows = std::pair<std::vector<HitRow>, std::vector<WireRow>>;
+
+EventRows rows(const EventAOS& event) {
+    EventRows r;
+    for (const auto& h : event.hits) r.first.emplace_back(h.EventID, h.fChannel, h.fPeakTime);
+    for (const auto& w : event.wires) {
+        std::vector<std::vector<float>> samples;
+        for (const auto& roi : w.fSignalROI) samples.push_back(roi.data);
+        r.second.emplace_back(w.EventID, w.fWire_Channel, w.fWire_View, samples);
+    }
+    return r;
+}
+
+EventRows rows(const EventSOA& event) {
+    EventRows r;
+    for (std::size_t i = 0; i < event.hits.EventIDs.size(); ++i) {
+        r.first.emplace_back(event.hits.EventIDs[i], event.hits.fChannel[i], event.hits.fPeakTime[i]);
+    }
+    for (std::size_t w = 0; w < event.wires.EventIDs.size(); ++w) {
+        std::vector<std::vector<float>> samples;
+        for (const auto& roi : event.wires.fSignalROI[w]) samples.push_back(roi.data);
+        r.second.emplace_back(event.wires.EventIDs[w], event.wires.fWire_Channel[w], event.wires.fWire_View[w], samples);
+    }
+    return r;
+}
+
+template <typename Event>
+std::map<long long, EventRows> readEvents(const std::string& path, const std::string& ntupleName, const std::string& fieldName) {
+    std::map<long long, EventRows> events;
+    auto reader = ROOT::RNTupleReader::Open(ntupleName, path);
+    auto view = reader->GetView<Event>(fieldName);
+    for (auto i : reader->GetEntryRange()) {
+        auto r = rows(view(i));
+        const long long id = r.first.empty() ? std::get<0>(r.second.front()) : std::get<0>(r.first.front());
+        events[id] = std::move(r);
+    }
+    return events;
+}
+
+template <typename Event>
+std::map<long long, EventRows> reassembledEvents(const std::string& path, int numSpills, int nThreads) {
+    std::map<long long, EventRows> events;
+    std::mutex mutex;
+    reassembleSpills(path, numSpills, nThreads, std::function<void(long long, const Event&)>([&](long long id, const Event& event) {
+        auto r = rows(event);
+        std::lock_guard<std::mutex> lock(mutex);
+        events[id] = std::move(r);
+    }));
+    return events;
+}
+
+// Copy of a spill_allDataProduct ntuple with the entries reversed, every spill out of place
+template <typename Event>
+void writeReversed(const std::string& from, const std::string& to, const std::string& ntupleName, const std::string& fieldName) {
+    auto reader = ROOT::RNTupleReader::Open(ntupleName, from);
+    auto spills = reader->GetView<Event>(fieldName);
+    auto eventIds = reader->GetView<long long>("EventID");
+    auto spillIds = reader->GetView<int>("SpillID");
+    auto model = ROOT::RNTupleModel::Create();
+    auto spill = model->MakeField<Event>(fieldName);
+    auto eventId = model->MakeField<long long>("EventID");
+    auto spillId = model->MakeField<int>("SpillID");
+    auto writer = ROOT::RNTupleWriter::Recreate(std::move(model), ntupleName, to);
+    for (auto i = reader->GetNEntries(); i-- > 0;) {
+        *spill = spills(i);
+        *eventId = eventIds(i);
+        *spillId = spillIds(i);
+        writer->Fill();
+    }
+}
+
+} // namespace
+
+TEST(SpillReassemblyTest, RebuildsInterleavedSpills) {
+    const std::string path = "temp_spill_reassembly.root";
+    // 4 events x 3 spills as out-of-order commits would leave them; 2 hits and 1 wire per spill
+    const std::vector<long long> order = {0, 1, 0, 2, 1, 0, 3, 2, 1, 3, 2, 3};
+    {
+        auto model = ROOT::RNTupleModel::Create();
+        auto spill = model->MakeField<EventAOS>("EventAOS");
+        auto writer = ROOT::RNTupleWriter::Recreate(std::move(model), "aos_spills", path);
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            spill->hits.assign(2, HitIndividual{});
+            for (auto& h : spill->hits) h.EventID = order[i];
+            spill->wires.assign(1, WireIndividual{});
+            spill->wires[0].EventID = order[i];
+            writer->Fill();
+            if (i % 5 == 4) writer->CommitCluster();
+        }
+    }
+
+    for (int threads : {1, 3}) {
+        auto result = reassembleSpills(path, SpillLayout::AOS, 3, threads);
+        EXPECT_EQ(result.spills, 12u);
+        EXPECT_EQ(result.events, 4u);
+        EXPECT_EQ(result.incompleteEvents, 0u);
+        EXPECT_EQ(result.hits, 24u);
+        EXPECT_EQ(result.wires, 12u);
+        if (threads == 1) EXPECT_EQ(result.mergedEvents, 0u);
+    }
+
+    // With 4 spills per event none can complete
+    auto result = reassembleSpills(path, SpillLayout::AOS, 4, 2);
+    EXPECT_EQ(result.events, 0u);
+    EXPECT_EQ(result.incompleteEvents, 4u);
+    std::filesystem::remove(path);
+}
+
+TEST(SpillReassemblyTest, EmptySpillsCompleteTheirEvent) {
+    const std::string path = "temp_spill_reassembly_empty.root";
+    // 3 events x 2 spills; the second spill of every event holds no hits and no wires
+    const std::vector<long long> order = {0, 1, 1, 2, 0, 2};
+    {
+        // Same fields as CreateSOASpillModelAndTokens
+        auto model = ROOT::RNTupleModel::Create();
+        auto spill = model->MakeField<EventSOA>("EventSOA");
+        auto eventId = model->MakeField<long long>("EventID");
+        auto spillId = model->MakeField<int>("SpillID");
+        auto writer = ROOT::RNTupleWriter::Recreate(std::move(model), "soa_spill_all", path);
+        std::vector<int> seen(3, 0);
+        for (long long id : order) {
+            *spill = EventSOA{};
+            *spillId = seen[id];
+            if (seen[id]++ == 0) {
+                spill->hits.EventIDs.assign(2, id);
+                spill->hits.fPeakAmplitude.assign(2, 1.0f);
+            }
+            *eventId = id;
+            writer->Fill();
+        }
+    }
+
+    for (int threads : {1, 2}) {
+        auto result = reassembleSpills(path, SpillLayout::SOA, 2, threads);
+        EXPECT_EQ(result.spills, 6u);
+        EXPECT_EQ(result.events, 3u);
+        EXPECT_EQ(result.incompleteEvents, 0u);
+        EXPECT_EQ(result.hits, 6u);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(SpillReassemblyTest, EventsMatchTheEventLayout) {
+    const std::string dir = "test_spill_reassembly";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    auto path = [&](const std::string& name) { return dir + "/" + name + ".root"; };
+    // Hit and wire counts divisible by the spill count, so the spills cover the whole event
+    const int kEvents = 8, kSpills = 3, kHits = 6, kWires = 3, kRois = 2;
+    for (const std::string prefix : {"aos", "soa"}) {
+        writeLayout(prefix + "_event_all", kEvents, kSpills, kHits, kWires, kRois, path(prefix + "_event_all"), 2);
+        writeLayout(prefix + "_spill_all", kEvents, kSpills, kHits, kWires, kRois, path(prefix + "_spill_all"), 3);
+    }
+    writeReversed<EventAOS>(path("aos_spill_all"), path("aos_spill_reversed"), "aos_spills", "EventAOS");
+    writeReversed<EventSOA>(path("soa_spill_all"), path("soa_spill_reversed"), "soa_spill_all", "EventSOA");
+
+    const auto aosEvents = readEvents<EventAOS>(path("aos_event_all"), "aos_events", "EventAOS");
+    const auto soaEvents = readEvents<EventSOA>(path("soa_event_all"), "soa_events", "EventSOA");
+    ASSERT_EQ(aosEvents.size(), static_cast<std::size_t>(kEvents));
+    ASSERT_EQ(soaEvents.size(), static_cast<std::size_t>(kEvents));
+    for (int threads : {1, 2}) {
+        EXPECT_TRUE(reassembledEvents<EventAOS>(path("aos_spill_all"), kSpills, threads) == aosEvents) << threads << " threads";
+        EXPECT_TRUE(reassembledEvents<EventAOS>(path("aos_spill_reversed"), kSpills, threads) == aosEvents) << threads << " threads";
+        EXPECT_TRUE(reassembledEvents<EventSOA>(path("soa_spill_all"), kSpills, threads) == soaEvents) << threads << " threads";
+        EXPECT_TRUE(reassembledEvents<EventSOA>(path("soa_spill_reversed"), kSpills, threads) == soaEvents) << threads << " threads";
+    }
+    std::filesystem::remove_all(dir);
+}
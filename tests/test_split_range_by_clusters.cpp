@@ -9,6 +9,20 @@
 
 // Assuming GenerateTestNTuple is declared in a header or externally linked
 extern void GenerateTestNTuple(const std::string& filePath, int numEntries, std::size_t approxClusterSize, int payloadSize = 4);
+extern void GenerateClusteredTestNTuple(const std::string& filePath, const std::vector<std::pair<int, int>>& clusters);
+
+// Chunks must be sorted, non-overlapping, non-empty and cover [0, numEntries)
+static void ExpectContiguousCover(const std::vector<std::pair<std::size_t, std::size_t>>& chunks, std::size_t numEntries) {
+    ASSERT_FALSE(chunks.empty());
+    EXPECT_EQ(chunks.front().first, 0u);
+    EXPECT_EQ(chunks.back().second, numEntries);
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        EXPECT_LT(chunks[i].first, chunks[i].second);
+        if (i > 0) {
+            EXPECT_EQ(chunks[i - 1].second, chunks[i].first);
+        }
+    }
+}
 
 class NTupleClusterTest : public ::testing::Test {
 protected:
@@ -142,4 +156,123 @@ TEST_F(NTupleClusterTest, InvalidFilePath) {
     auto reader = ROOT::RNTupleReader::Open("hits", "non_existent_file.root");
     EXPECT_FALSE(reader);  // Expect failure
     // No split possible
-} 
\ No newline at end of file
+}
+
+TEST_F(NTupleClusterTest, ByteBalancedCoversAllEntries) {
+    auto reader = ROOT::RNTupleReader::Open("hits", tempFilePath);
+    ASSERT_TRUE(reader);
+    for (int nChunks : {1, 2, 3, 7, 16}) {
+        auto chunks = Utils::split_range_by_bytes(*reader, nChunks);
+        EXPECT_LE(chunks.size(), static_cast<std::size_t>(nChunks));
+        ExpectContiguousCover(chunks, 1000000);
+    }
+}
+
+TEST_F(NTupleClusterTest, SkewedClustersByteBalanced) {
+    // Three light clusters followed by one heavy cluster with the same entry count
+    GenerateClusteredTestNTuple(tempFilePath, {{1000, 4}, {1000, 4}, {1000, 4}, {1000, 400}});
+    auto clusters = GetClusterBoundaries(tempFilePath, "hits");
+    ASSERT_EQ(clusters.size(), 4);
+
+    auto reader = ROOT::RNTupleReader::Open("hits", tempFilePath);
+    // Count-based splitting pairs the heavy cluster with a light one
+    auto byCount = Utils::split_range_by_clusters(*reader, 2);
+    ASSERT_EQ(byCount.size(), 2);
+    EXPECT_EQ(byCount[1], std::make_pair(2000ul, 4000ul));
+
+    // Byte-based splitting isolates it
+    for (auto weight : {Utils::ClusterWeight::CompressedBytes, Utils::ClusterWeight::UncompressedBytes}) {
+        auto chunks = Utils::split_range_by_bytes(*reader, 2, weight);
+        ASSERT_EQ(chunks.size(), 2);
+        EXPECT_EQ(chunks[0], std::make_pair(0ul, 3000ul));
+        EXPECT_EQ(chunks[1], std::make_pair(3000ul, 4000ul));
+    }
+
+    auto spans = Utils::cluster_spans(*reader, Utils::ClusterWeight::CompressedBytes);
+    ASSERT_EQ(spans.size(), 4);
+    EXPECT_GT(spans[3].weight, 10 * spans[0].weight);
+}
+
+TEST_F(NTupleClusterTest, SkewedTrailingClusters) {
+    // Many light clusters and two heavy trailing ones, as left behind by the last writer threads
+    std::vector<std::pair<int, int>> layout(12, {500, 4});
+    layout.push_back({500, 300});
+    layout.push_back({500, 300});
+    GenerateClusteredTestNTuple(tempFilePath, layout);
+
+    auto reader = ROOT::RNTupleReader::Open("hits", tempFilePath);
+    auto chunks = Utils::split_range_by_bytes(*reader, 4);
+    ExpectContiguousCover(chunks, 7000);
+    // Each heavy cluster gets a chunk of its own
+    EXPECT_EQ(chunks[chunks.size() - 1], std::make_pair(6500ul, 7000ul));
+    EXPECT_EQ(chunks[chunks.size() - 2], std::make_pair(6000ul, 6500ul));
+}
+
+TEST_F(NTupleClusterTest, SubClusterSplitWhenFewerClusters) {
+    GenerateTestNTuple(tempFilePath, 1000, 1 << 20, 4);
+    auto clusters = GetClusterBoundaries(tempFilePath, "hits");
+    ASSERT_EQ(clusters.size(), 1);
+
+    auto reader = ROOT::RNTupleReader::Open("hits", tempFilePath);
+    auto whole = Utils::split_range_by_bytes(*reader, 4);
+    ASSERT_EQ(whole.size(), 1);
+
+    auto pieces = Utils::split_range_by_bytes(*reader, 4, Utils::ClusterWeight::CompressedBytes, true);
+    ASSERT_EQ(pieces.size(), 4);
+    ExpectContiguousCover(pieces, 1000);
+    for (const auto& p : pieces) EXPECT_EQ(p.second - p.first, 250u);
+}
+
+TEST_F(NTupleClusterTest, SubClusterSplitFavoursHeavyClusters) {
+    GenerateClusteredTestNTuple(tempFilePath, {{1000, 4}, {1000, 400}});
+    auto reader = ROOT::RNTupleReader::Open("hits", tempFilePath);
+    auto pieces = Utils::split_range_by_bytes(*reader, 4, Utils::ClusterWeight::CompressedBytes, true);
+    ASSERT_EQ(pieces.size(), 4);
+    ExpectContiguousCover(pieces, 2000);
+    // The light cluster stays whole, the heavy one is cut into three
+    EXPECT_EQ(pieces[0], std::make_pair(0ul, 1000ul));
+}
+
+TEST_F(NTupleClusterTest, ByteBalancedEmptyAndInvalid) {
+    GenerateTestNTuple(tempFilePath, 0, 1024, 4);
+    auto reader = ROOT::RNTupleReader::Open("hits", tempFilePath);
+    EXPECT_TRUE(Utils::split_range_by_bytes(*reader, 4).empty());
+    EXPECT_TRUE(Utils::split_range_by_bytes(*reader, 4, Utils::ClusterWeight::CompressedBytes, true).empty());
+    EXPECT_TRUE(Utils::split_range_by_bytes(*reader, 0).empty());
+}
+
+TEST(SplitWeightedClustersTest, MinimizesLargestChunk) {
+    std::vector<Utils::ClusterSpan> spans = {{0, 10, 1}, {10, 10, 1}, {20, 10, 1}, {30, 10, 1},
+                                             {40, 10, 1}, {50, 10, 1}, {60, 10, 10}};
+    auto chunks = Utils::split_weighted_clusters(spans, 2);
+    ASSERT_EQ(chunks.size(), 2);
+    EXPECT_EQ(chunks[0], std::make_pair(0ul, 60ul));
+    EXPECT_EQ(chunks[1], std::make_pair(60ul, 70ul));
+}
+
+TEST(SplitWeightedClustersTest, EqualWeightsSpreadEvenly) {
+    std::vector<Utils::ClusterSpan> spans;
+    for (std::size_t i = 0; i < 10; ++i) spans.push_back({i * 100, 100, 7});
+    auto chunks = Utils::split_weighted_clusters(spans, 4);
+    ASSERT_EQ(chunks.size(), 4);
+    ExpectContiguousCover(chunks, 1000);
+    for (const auto& c : chunks) {
+        EXPECT_LE(c.second - c.first, 300u);
+        EXPECT_GE(c.second - c.first, 200u);
+    }
+}
+
+TEST(SplitWeightedClustersTest, ZeroWeightsFallBackToEntries) {
+    std::vector<Utils::ClusterSpan> spans = {{0, 100, 0}, {100, 100, 0}, {200, 0, 0}, {200, 100, 0}, {300, 100, 0}};
+    auto chunks = Utils::split_weighted_clusters(spans, 2);
+    ASSERT_EQ(chunks.size(), 2);
+    EXPECT_EQ(chunks[0], std::make_pair(0ul, 200ul));
+    EXPECT_EQ(chunks[1], std::make_pair(200ul, 400ul));
+}
+
+TEST(SplitWeightedClustersTest, SubClusterStopsAtSingleEntries) {
+    std::vector<Utils::ClusterSpan> spans = {{0, 2, 50}, {2, 1, 50}};
+    auto chunks = Utils::split_weighted_clusters(spans, 8, true);
+    ASSERT_EQ(chunks.size(), 3);
+    ExpectContiguousCover(chunks, 3);
+}
@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include "StorageBaseline.hpp"
+
+TEST(StorageBaselineTest, MeasuresEveryCombination) {
+    BaselineConfig config;
+    config.directory = "test_storage_baseline";
+    config.bytesPerThread = 4 << 20;
+    config.blockSizes = {64 << 10, 1 << 20};
+    config.threads = {1, 2};
+    auto results = runStorageBaseline(config);
+
+    int writes = 0, reads = 0, copies = 0;
+    for (const auto& r : results) {
+        if (!r.supported) continue;
+        EXPECT_GT(r.seconds, 0.0) << r.test;
+        EXPECT_EQ(r.bytes % r.threads, 0u);
+        if (r.test == "write") ++writes;
+        if (r.test == "read") ++reads;
+        if (r.test == "memcpy") ++copies;
+    }
+    // Buffered always, O_DIRECT where the file system allows it
+    EXPECT_TRUE(writes == 4 || writes == 8);
+    EXPECT_EQ(reads, writes);
+    EXPECT_EQ(copies, 2);
+
+    const auto ceilings = baselineCeilings(results);
+    EXPECT_GT(ceilings.writeMBps, 0.0);
+    EXPECT_GT(ceilings.readMBps, 0.0);
+    EXPECT_GT(ceilings.memcpyMBps, 0.0);
+    // Only the directory is left behind
+    EXPECT_TRUE(std::filesystem::is_empty(config.directory));
+    std::filesystem::remove_all(config.directory);
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleWriter.hxx>
+#include <algorithm>
+#include <filesystem>
+#include "Hit.hpp"
+#include "StorageBreakdown.hpp"
+
+TEST(StorageBreakdownTest, ColumnsAddUpToFile) {
+    const std::string path = "temp_storage_breakdown.root";
+    {
+        auto model = ROOT::RNTupleModel::Create();
+        auto hits = model->MakeField<std::vector<HitIndividual>>("hits");
+        auto writer = ROOT::RNTupleWriter::Recreate(std::move(model), "event_hits", path);
+        for (int evt = 0; evt < 30; ++evt) {
+            hits->assign(5, HitIndividual{});
+            for (auto& hit : *hits) hit.EventID = evt;
+            writer->Fill();
+            if (evt % 10 == 9) writer->CommitCluster();
+        }
+    }
+
+    auto storage = analyzeFileStorage(path);
+    ASSERT_FALSE(storage.columns.empty());
+    std::uint64_t compressed = 0;
+    for (const auto& c : storage.columns) {
+        EXPECT_EQ(c.ntuple, "event_hits");
+        EXPECT_GT(c.uncompressedBytes, 0u);
+        EXPECT_GE(c.pages, 3u); // one per cluster at least
+        compressed += c.compressedBytes;
+    }
+    EXPECT_LT(compressed, storage.fileBytes);
+
+    auto members = aggregateByMember({storage, storage});
+    auto find = [&](const std::string& member, bool offsets) {
+        auto it = std::find_if(members.begin(), members.end(), [&](const ColumnStorage& m) {
+            return m.member == member && m.offsets == offsets;
+        });
+        return it == members.end() ? nullptr : &*it;
+    };
+    const auto* offsets = find("hits", true);
+    ASSERT_NE(offsets, nullptr);
+    EXPECT_EQ(offsets->elements, 2u * 30);
+    const auto* channel = find("HitIndividual::fChannel", false);
+    ASSERT_NE(channel, nullptr);
+    EXPECT_EQ(channel->elements, 2u * 150);
+    EXPECT_EQ(channel->uncompressedBytes, 2u * 150 * 4);
+    for (std::size_t i = 1; i < members.size(); ++i) {
+        EXPECT_GE(members[i - 1].compressedBytes, members[i].compressedBytes);
+    }
+    std::filesystem::remove(path);
+}
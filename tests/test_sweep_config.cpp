@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <stdexcept>
+#include "SweepConfig.hpp"
+
+namespace {
+
+const std::vector<std::string> kLayouts = {"aos_event_all", "aos_spill_perGroup", "soa_event_all", "soa_spill_perGroup"};
+
+} // namespace
+
+TEST(SweepConfigTest, ParsesKeysAndLists) {
+    auto config = parseSweepConfig(R"(
+# overnight sweep
+name = "night"       # trailing comment
+events = 500
+iterations = 2
+layouts = ["aos", "soa_event_all"]
+threads = [1, 2,
+           4]
+shapes = ["small", "wide:50:400:4:10"]
+event_sizes = ["fixed", "lognormal:0.8,huge:0.01:20"]
+compression = "zstd:3"
+cluster_mb = [0, 16]
+page_kb = 64
+)");
+    EXPECT_EQ(config.name, "night");
+    EXPECT_EQ(config.numEvents, 500);
+    EXPECT_EQ(config.iterations, 2);
+    EXPECT_EQ(config.layouts, (std::vector<std::string>{"aos", "soa_event_all"}));
+    EXPECT_EQ(config.threads, (std::vector<int>{1, 2, 4}));
+    ASSERT_EQ(config.shapes.size(), 2u);
+    EXPECT_EQ(config.shapes[1].wiresPerEvent, 400);
+    EXPECT_EQ(config.eventSizes[1], "lognormal:0.8,huge:0.01:20");
+    EXPECT_EQ(config.compression, (std::vector<std::string>{"zstd:3"}));
+    EXPECT_EQ(config.clusterMB, (std::vector<double>{0.0, 16.0}));
+    EXPECT_EQ(config.pageKB, (std::vector<double>{64.0}));
+    EXPECT_EQ(config.generators, (std::vector<std::string>{"uniform"}));
+
+    EXPECT_THROW(parseSweepConfig("bogus = 1"), std::runtime_error);
+    EXPECT_THROW(parseSweepConfig("[section]"), std::runtime_error);
+    EXPECT_THROW(parseSweepConfig("threads = [1, x]"), std::runtime_error);
+    EXPECT_THROW(parseSweepConfig("events = [1, 2]"), std::runtime_error);
+    EXPECT_THROW(parseSweepConfig("threads = [1, 2"), std::runtime_error);
+    try {
+        parseSweepConfig("name = \"a\"\n\nshapes = [\"nope\"]");
+        FAIL() << "expected an error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("line 3"), std::string::npos);
+    }
+}
+
+TEST(SweepConfigTest, CompressionSettings) {
+    EXPECT_EQ(parseCompressionSetting("default"), -1);
+    EXPECT_EQ(parseCompressionSetting("none"), 0);
+    EXPECT_EQ(parseCompressionSetting("zstd"), 505);
+    EXPECT_EQ(parseCompressionSetting("lz4:9"), 409);
+    EXPECT_EQ(parseCompressionSetting("zlib"), 101);
+    EXPECT_EQ(parseCompressionSetting("207"), 207);
+    EXPECT_THROW(parseCompressionSetting("brotli"), std::invalid_argument);
+    EXPECT_THROW(parseCompressionSetting("zstd:0"), std::invalid_argument);
+    EXPECT_THROW(parseCompressionSetting("905"), std::invalid_argument);
+}
+
+TEST(SweepConfigTest, ExpandsCartesianProduct) {
+    auto config = parseSweepConfig("layouts = [\"soa\", \"aos_event_all\"]\nthreads = [1, 4]\n"
+                                   "compression = [\"default\", \"zstd\"]\nevents = 100");
+    auto cells = expandSweepPlan(config, kLayouts);
+    ASSERT_EQ(cells.size(), 2u * 3u * 2u);
+    // Threads vary fastest, then layouts, compression outermost of the swept axes
+    EXPECT_EQ(cells[0].layout, "soa_event_all");
+    EXPECT_EQ(cells[0].threads, 1);
+    EXPECT_EQ(cells[1].threads, 4);
+    EXPECT_EQ(cells[2].layout, "soa_spill_perGroup");
+    EXPECT_EQ(cells[4].layout, "aos_event_all");
+    EXPECT_EQ(cells[0].compressionSetting, -1);
+    EXPECT_EQ(cells[6].compressionSetting, 505);
+    EXPECT_EQ(cells[6].numEvents, 100);
+
+    // Every cell is a distinct measurement
+    std::set<std::string> keys;
+    for (const auto& cell : cells) keys.insert(cell.key());
+    EXPECT_EQ(keys.size(), cells.size());
+
+    config.layouts = {"aos_event_perData"};
+    EXPECT_THROW(expandSweepPlan(config, kLayouts), std::invalid_argument);
+    config.layouts = {"all"};
+    config.eventSizes = {"gamma"};
+    EXPECT_THROW(expandSweepPlan(config, kLayouts), std::invalid_argument);
+}
+
+TEST(SweepConfigTest, ResumesFromResultsFile) {
+    const std::string path = "test_sweep_results.csv";
+    std::filesystem::remove(path);
+    auto config = parseSweepConfig("layouts = \"aos\"\nevent_sizes = \"lognormal:0.8,huge:0.01\"");
+    auto cells = expandSweepPlan(config, kLayouts);
+    ASSERT_EQ(cells.size(), 2u);
+    EXPECT_TRUE(readCompletedCells(path).empty());
+
+    SweepCellResult ok;
+    ok.ok = true;
+    ok.time = ok.minTime = 0.5;
+    ok.fileMB = 3.0;
+    SweepCellResult failed;
+    failed.error = "disk full, \"really\"";
+    ASSERT_TRUE(appendSweepResult(path, config, cells[0], ok));
+    ASSERT_TRUE(appendSweepResult(path, config, cells[1], failed));
+
+    auto done = readCompletedCells(path);
+    EXPECT_EQ(done, (std::set<std::string>{cells[0].key()}));
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+#include <ROOT/RNTupleReader.hxx>
+#include <TFile.h>
+#include <TTree.h>
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "HitWireWriterHelpers.hpp"
+#include "HitWireWriters.hpp"
+#include "TTreeBaseline.hpp"
+
+namespace {
+
+constexpr int kEvents = 10, kSpills = 2, kHits = 5, kWires = 3, kRois = 2;
+
+using HitValue = std::tuple<long long, unsigned int, float, float>;  // EventID, channel, peak time, integral
+using WireValue = std::tuple<long long, unsigned int, int>;          // EventID, channel, view
+using RoiValue = std::tuple<long long, unsigned int, std::vector<float>>; // EventID, channel, samples
+
+// Everything a file holds, independent of layout and entry order. ROI offsets are left out,
+// the SOA wire classes do not keep them.
+struct Values {
+    std::vector<HitValue> hits;
+    std::vector<WireValue> wires;
+    std::vector<RoiValue> rois;
+
+    void sort() {
+        std::sort(hits.begin(), hits.end());
+        std::sort(wires.begin(), wires.end());
+        std::sort(rois.begin(), rois.end());
+    }
+};
+
+template <typename Hit>
+void addHit(Values& v, const Hit& h) { v.hits.emplace_back(h.EventID, h.fChannel, h.fPeakTime, h.fIntegral); }
+
+template <typename Wire>
+void addWireHeader(Values& v, const Wire& w) { v.wires.emplace_back(w.EventID, w.fWire_Channel, w.fWire_View); }
+
+template <typename Roi>
+void addROI(Values& v, const Roi& r) { v.rois.emplace_back(r.EventID, r.WireID, r.data); }
+
+void add(Values& v, const HitIndividual& h) { addHit(v, h); }
+void add(Values& v, const SOAHit& h) { addHit(v, h); }
+void add(Values& v, const WireBase& w) { addWireHeader(v, w); }
+void add(Values& v, const SOAWireBase& w) { addWireHeader(v, w); }
+void add(Values& v, const FlatROI& r) { addROI(v, r); }
+void add(Values& v, const FlatSOAROI& r) { addROI(v, r); }
+
+template <typename Wire>
+void addWire(Values& v, const Wire& w) {
+    addWireHeader(v, w);
+    for (const auto& r : w.fSignalROI) v.rois.emplace_back(w.EventID, w.fWire_Channel, r.data);
+}
+
+void add(Values& v, const WireIndividual& w) { addWire(v, w); }
+void add(Values& v, const SOAWire& w) { addWire(v, w); }
+
+void add(Values& v, const std::vector<HitIndividual>& hits) {
+    for (const auto& h : hits) add(v, h);
+}
+
+void add(Values& v, const std::vector<WireIndividual>& wires) {
+    for (const auto& w : wires) add(v, w);
+}
+
+void add(Values& v, const SOAHitVector& hits) {
+    for (std::size_t i = 0; i < hits.EventIDs.size(); ++i) {
+        v.hits.emplace_back(hits.EventIDs[i], hits.fChannel[i], hits.fPeakTime[i], hits.fIntegral[i]);
+    }
+}
+
+void add(Values& v, const SOAWireVector& wires) {
+    for (std::size_t i = 0; i < wires.EventIDs.size(); ++i) {
+        v.wires.emplace_back(wires.EventIDs[i], wires.fWire_Channel[i], wires.fWire_View[i]);
+        for (const auto& r : wires.fSignalROI[i]) v.rois.emplace_back(wires.EventIDs[i], wires.fWire_Channel[i], r.data);
+    }
+}
+
+void add(Values& v, const EventAOS& event) {
+    add(v, event.hits);
+    add(v, event.wires);
+}
+
+template <typename T>
+void addBranch(Values& v, const std::string& fileName, const char* treeName, const char* branchName) {
+    std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+    auto* tree = file ? file->Get<TTree>(treeName) : nullptr;
+    ASSERT_NE(tree, nullptr) << treeName << " in " << fileName;
+    T* value = nullptr;
+    tree->SetBranchAddress(branchName, &value);
+    for (Long64_t i = 0; i < tree->GetEntries(); ++i) {
+        tree->GetEntry(i);
+        add(v, *value);
+    }
+    tree->ResetBranchAddresses();
+    delete value;
+}
+
+template <typename T>
+void addField(Values& v, const std::string& fileName, const char* ntupleName, const char* fieldName) {
+    auto reader = ROOT::RNTupleReader::Open(ntupleName, fileName);
+    auto view = reader->GetView<T>(fieldName);
+    for (auto i : reader->GetEntryRange()) add(v, view(i));
+}
+
+template <typename Types>
+Values eventTreeValues(const std::string& fileName, const char* treeName) {
+    Values v;
+    addBranch<typename Types::Hits>(v, fileName, treeName, "hits");
+    addBranch<typename Types::Wires>(v, fileName, treeName, "wires");
+    v.sort();
+    return v;
+}
+
+template <typename Types>
+Values topObjectTreeValues(const std::string& fileName) {
+    Values v;
+    addBranch<typename Types::Hit>(v, fileName, "hits", "hit");
+    addBranch<typename Types::Wire>(v, fileName, "wires", "wire");
+    v.sort();
+    return v;
+}
+
+template <typename Types>
+Values elementTreeValues(const std::string& fileName) {
+    Values v;
+    addBranch<typename Types::Hit>(v, fileName, "hits", "hit");
+    addBranch<typename Types::WireHeader>(v, fileName, "wires", "wire");
+    addBranch<typename Types::ROI>(v, fileName, "rois", "roi");
+    v.sort();
+    return v;
+}
+
+struct AOSTypes {
+    using Hits = std::vector<HitIndividual>;
+    using Wires = std::vector<WireIndividual>;
+    using Hit = HitIndividual;
+    using Wire = WireIndividual;
+    using WireHeader = WireBase;
+    using ROI = FlatROI;
+};
+
+struct SOATypes {
+    using Hits = SOAHitVector;
+    using Wires = SOAWireVector;
+    using Hit = SOAHit;
+    using Wire = SOAWire;
+    using WireHeader = SOAWireBase;
+    using ROI = FlatSOAROI;
+};
+
+void expectSameValues(const Values& tree, const Values& ntuple, const std::string& label) {
+    EXPECT_FALSE(tree.hits.empty()) << label;
+    EXPECT_FALSE(tree.rois.empty()) << label;
+    EXPECT_TRUE(tree.hits == ntuple.hits) << label << ": hits differ";
+    EXPECT_TRUE(tree.wires == ntuple.wires) << label << ": wires differ";
+    EXPECT_TRUE(tree.rois == ntuple.rois) << label << ": ROIs differ";
+}
+
+} // namespace
+
+// Every layout stores the same values, so the AOS RNTuple file of each granularity is the
+// reference for both TTree writers of that granularity
+TEST(TTreeBaselineTest, TreesHoldTheRNTupleValues) {
+    const std::string dir = "test_ttree_baseline";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    auto path = [&](const std::string& name) { return dir + "/" + name + ".root"; };
+
+    Values event, spill, topObject, element;
+    AOS_event_allDataProduct(kEvents, kHits, kWires, kRois, path("aos_event_all"), 2);
+    addField<EventAOS>(event, path("aos_event_all"), "aos_events", "EventAOS");
+    AOS_spill_allDataProduct(kEvents, kSpills, kHits, kWires, kRois, path("aos_spill_all"), 2);
+    addField<EventAOS>(spill, path("aos_spill_all"), "aos_spills", "EventAOS");
+    AOS_topObject_perDataProduct(kEvents, kHits, kWires, kRois, path("aos_topObject_perData"), 2);
+    addField<HitIndividual>(topObject, path("aos_topObject_perData"), "aos_top_hits", "hit");
+    addField<WireIndividual>(topObject, path("aos_topObject_perData"), "aos_top_wires", "wire");
+    AOS_element_perGroup(kEvents, kHits, kWires, kRois, path("aos_element_perGroup"), 2);
+    addField<HitIndividual>(element, path("aos_element_perGroup"), "element_hits", "hit");
+    addField<WireBase>(element, path("aos_element_perGroup"), "element_wires", "wire");
+    addField<FlatROI>(element, path("aos_element_perGroup"), "element_rois", "roi");
+    for (auto* v : {&event, &spill, &topObject, &element}) v->sort();
+
+    // A different thread count than the references, so thread splits cannot hide differences
+    AOS_event_TTree(kEvents, kHits, kWires, kRois, path("aos_TTree_event"), 3);
+    SOA_event_TTree(kEvents, kHits, kWires, kRois, path("soa_TTree_event"), 3);
+    AOS_spill_TTree(kEvents, kSpills, kHits, kWires, kRois, path("aos_TTree_spill"), 3);
+    SOA_spill_TTree(kEvents, kSpills, kHits, kWires, kRois, path("soa_TTree_spill"), 3);
+    AOS_topObject_TTree(kEvents, kHits, kWires, kRois, path("aos_TTree_topObject"), 3);
+    SOA_topObject_TTree(kEvents, kHits, kWires, kRois, path("soa_TTree_topObject"), 3);
+    AOS_element_TTree(kEvents, kHits, kWires, kRois, path("aos_TTree_element"), 3);
+    SOA_element_TTree(kEvents, kHits, kWires, kRois, path("soa_TTree_element"), 3);
+
+    expectSameValues(eventTreeValues<AOSTypes>(path("aos_TTree_event"), "events"), event, "AOS event");
+    expectSameValues(eventTreeValues<SOATypes>(path("soa_TTree_event"), "events"), event, "SOA event");
+    expectSameValues(eventTreeValues<AOSTypes>(path("aos_TTree_spill"), "spills"), spill, "AOS spill");
+    expectSameValues(eventTreeValues<SOATypes>(path("soa_TTree_spill"), "spills"), spill, "SOA spill");
+    expectSameValues(topObjectTreeValues<AOSTypes>(path("aos_TTree_topObject")), topObject, "AOS topObject");
+    expectSameValues(topObjectTreeValues<SOATypes>(path("soa_TTree_topObject")), topObject, "SOA topObject");
+    expectSameValues(elementTreeValues<AOSTypes>(path("aos_TTree_element")), element, "AOS element");
+    expectSameValues(elementTreeValues<SOATypes>(path("soa_TTree_element")), element, "SOA element");
+
+    // Readers get through every tree of the merged files
+    EXPECT_GT(readTTreeFile(path("aos_TTree_event"), 2), 0.0);
+    EXPECT_GT(readTTreeFile(path("soa_TTree_spill"), 2), 0.0);
+    EXPECT_GT(readTTreeFile(path("aos_TTree_element"), 3), 0.0);
+    std::filesystem::remove_all(dir);
+}
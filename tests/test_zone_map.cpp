@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleWriter.hxx>
+#include <filesystem>
+#include "Hit.hpp"
+#include "ZoneMap.hpp"
+
+using Ranges = std::vector<std::pair<std::uint64_t, std::uint64_t>>;
+
+TEST(ZoneMapTest, SelectClustersMergesAdjacent) {
+    ZoneMap zoneMap;
+    zoneMap.fields = {"hit.fPeakAmplitude"};
+    zoneMap.clusters = {{0, 10}, {10, 20}, {20, 30}, {30, 40}};
+    zoneMap.stats.assign(4, std::vector<ZoneStats>(1));
+    const double values[4][2] = {{0, 5}, {4, 9}, {20, 30}, {6, 8}};
+    for (int c = 0; c < 4; ++c) {
+        zoneMap.stats[c][0].add(values[c][0]);
+        zoneMap.stats[c][0].add(values[c][1]);
+    }
+
+    auto predicates = parseRangePredicates("fPeakAmplitude:4:7,bogus,EventID:1:0,fChannel:-inf:inf");
+    ASSERT_EQ(predicates.size(), 2u);
+    EXPECT_EQ(selectClusters(zoneMap, predicates[0]), (Ranges{{0, 20}, {30, 40}}));
+    // Field not in the zone map: nothing can be skipped
+    EXPECT_EQ(selectClusters(zoneMap, predicates[1]), (Ranges{{0, 40}}));
+}
+
+TEST(ZoneMapTest, SidecarRoundTrip) {
+    const std::string path = "temp_zone_map.root";
+    {
+        auto model = ROOT::RNTupleModel::Create();
+        auto hit = model->MakeField<HitIndividual>("hit");
+        auto writer = ROOT::RNTupleWriter::Recreate(std::move(model), "element_hits", path);
+        for (int c = 0; c < 3; ++c) {
+            for (int i = 0; i < 4; ++i) {
+                *hit = HitIndividual{};
+                hit->EventID = c;
+                hit->fChannel = static_cast<unsigned int>(100 * c + i);
+                writer->Fill();
+            }
+            writer->CommitCluster();
+        }
+    }
+
+    EXPECT_EQ(writeZoneMaps(path), 1);
+    EXPECT_EQ(writeZoneMaps(path), 0); // already written
+
+    auto zoneMap = loadZoneMap(path, "element_hits");
+    ASSERT_EQ(zoneMap.clusters.size(), 3u);
+    int f = zoneMap.fieldIndex("fChannel");
+    ASSERT_GE(f, 0);
+    EXPECT_EQ(zoneMap.fields[f], "hit.fChannel");
+    EXPECT_EQ(zoneMap.stats[1][f].min, 100.0);
+    EXPECT_EQ(zoneMap.stats[1][f].max, 103.0);
+    EXPECT_EQ(zoneMap.stats[1][f].count, 4u);
+
+    auto kept = selectClusters(zoneMap, parseRangePredicates("EventID:2:2").front());
+    EXPECT_EQ(kept, (Ranges{{8, 12}}));
+    std::filesystem::remove(path);
+}